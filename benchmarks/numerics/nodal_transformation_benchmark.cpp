@@ -0,0 +1,149 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+
+
+// MAST includes
+#include "numerics/nodal_transformation.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   rotation matrix from three Euler angles
+     */
+    RealMatrixX
+    benchmark_rotation_matrix(const Real a, const Real b, const Real c) {
+        
+        RealMatrixX
+        Rx = RealMatrixX::Identity(3, 3),
+        Ry = RealMatrixX::Identity(3, 3),
+        Rz = RealMatrixX::Identity(3, 3);
+        
+        Rx(1,1) =  cos(a); Rx(1,2) = -sin(a); Rx(2,1) = sin(a); Rx(2,2) = cos(a);
+        Ry(0,0) =  cos(b); Ry(0,2) =  sin(b); Ry(2,0) =-sin(b); Ry(2,2) = cos(b);
+        Rz(0,0) =  cos(c); Rz(0,1) = -sin(c); Rz(1,0) = sin(c); Rz(1,1) = cos(c);
+        
+        return Rz * Ry * Rx;
+    }
+    
+    
+    /*!
+     *   the dense transformation matrix that the structured methods replace
+     */
+    RealMatrixX
+    benchmark_dense_transformation(const RealMatrixX& R,
+                                   const unsigned int n_nodes) {
+        
+        RealMatrixX T = RealMatrixX::Zero(6*n_nodes, 6*n_nodes);
+        
+        for (unsigned int i=0; i<n_nodes; i++)
+            for (unsigned int j=0; j<3; j++)
+                for (unsigned int k=0; k<3; k++) {
+                    T(j*n_nodes+i, k*n_nodes+i)         = R(j,k);
+                    T((j+3)*n_nodes+i, (k+3)*n_nodes+i) = R(j,k);
+                }
+        
+        return T;
+    }
+}
+
+
+
+/*!
+ *   Reports the time per call of the structured and dense local-to-global
+ *   matrix transformations for the node counts of the EDGE2, EDGE3, QUAD4
+ *   and QUAD9 elements. The number of repetitions can be provided as the
+ *   first argument.
+ */
+int main(int argc, char* const argv[]) {
+    
+    const unsigned int
+    n_reps     = (argc > 1)? (unsigned int)atoi(argv[1]) : 10000;
+    
+    const char*
+    elem_names[] = {"EDGE2", "EDGE3", "QUAD4", "QUAD9"};
+    
+    const unsigned int
+    n_nodes[]    = {2, 3, 4, 9};
+    
+    const RealMatrixX R = MAST::benchmark_rotation_matrix(0.3, -0.7, 1.1);
+    
+    std::cout
+    << std::setw(8)  << "elem"
+    << std::setw(16) << "structured (s)"
+    << std::setw(16) << "dense (s)"
+    << std::setw(10) << "speedup"
+    << std::setw(14) << "max diff" << std::endl;
+    
+    for (unsigned int i_elem=0; i_elem<4; i_elem++) {
+        
+        const unsigned int
+        n  = n_nodes[i_elem],
+        n2 = 6*n;
+        
+        const RealMatrixX T = MAST::benchmark_dense_transformation(R, n);
+        
+        RealMatrixX
+        local_mat  = RealMatrixX::Zero(n2, n2),
+        global_mat,
+        dense_mat,
+        work;
+        
+        for (unsigned int i=0; i<n2; i++)
+            for (unsigned int j=0; j<n2; j++)
+                local_mat(i,j) = cos(1.+i+2.*j);
+        
+        // the work matrix is reused across calls, as in the elements
+        std::chrono::high_resolution_clock::time_point
+        t0 = std::chrono::high_resolution_clock::now();
+        
+        for (unsigned int i=0; i<n_reps; i++)
+            MAST::transform_nodal_matrix_to_global(R, n, local_mat, global_mat, work);
+        
+        std::chrono::high_resolution_clock::time_point
+        t1 = std::chrono::high_resolution_clock::now();
+        
+        for (unsigned int i=0; i<n_reps; i++)
+            dense_mat.noalias() = T * local_mat * T.transpose();
+        
+        std::chrono::high_resolution_clock::time_point
+        t2 = std::chrono::high_resolution_clock::now();
+        
+        const Real
+        t_structured = std::chrono::duration<Real>(t1-t0).count()/n_reps,
+        t_dense      = std::chrono::duration<Real>(t2-t1).count()/n_reps;
+        
+        std::cout
+        << std::setw(8)  << elem_names[i_elem]
+        << std::setw(16) << t_structured
+        << std::setw(16) << t_dense
+        << std::setw(10) << t_dense/t_structured
+        << std::setw(14) << (dense_mat - global_mat).cwiseAbs().maxCoeff()
+        << std::endl;
+    }
+    
+    return 0;
+}
@@ -322,6 +322,19 @@ MAST::GAFDatabase::get_kr_mat(const Real kr,
 }
 
 
+void
+MAST::GAFDatabase::
+init_rational_function_approximation(const std::vector<Real>& lag_roots) {
+    
+    _rfa.init(_kr_to_gaf_map, lag_roots);
+    
+    libMesh::out
+    << " **** GAF rational function approximation with "
+    << lag_roots.size() << " lag terms, relative fit error: "
+    << _rfa.fit_error() << std::endl;
+}
+
+
 void
 MAST::GAFDatabase::assemble_generalized_aerodynamic_force_matrix
 (std::vector<libMesh::NumericVector<Real>*>& basis,
@@ -337,7 +350,13 @@ MAST::GAFDatabase::assemble_generalized_aerodynamic_force_matrix
         
         Real kr = 0.;
         (*_freq)(kr);
-        if (!p)
+        if (_rfa.initialized()) {
+            if (!p)
+                _rfa.value(kr, mat);
+            else
+                _rfa.derivative(kr, mat);
+        }
+        else if (!p)
             mat = this->get_kr_mat(kr, _kr_to_gaf_map);
         else
             mat = this->get_kr_mat(kr, _kr_to_gaf_kr_sens_map);
@@ -27,6 +27,7 @@
 // MAST includes
 #include "base/mast_data_types.h"
 #include "elasticity/fsi_generalized_aero_force_assembly.h"
+#include "aeroelasticity/gaf_rational_function_approximation.h"
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
@@ -79,6 +80,27 @@ namespace MAST{
                    const std::map<Real, ComplexMatrixX>& data);
         
         
+        /*!
+         *   fits a rational function approximation with lag roots
+         *   \p lag_roots to the tabulated GAFs. When not in evaluate mode,
+         *   the GAF and its kr-sensitivity are then obtained from the
+         *   approximation instead of the linear interpolation of the
+         *   tabulated data.
+         */
+        void
+        init_rational_function_approximation(const std::vector<Real>& lag_roots);
+        
+        
+        /*!
+         *   @returns a const reference to the rational function
+         *   approximation
+         */
+        const MAST::GAFRationalFunctionApproximation&
+        rational_function_approximation() const {
+            return _rfa;
+        }
+        
+        
         virtual void
         assemble_generalized_aerodynamic_force_matrix
         (std::vector<libMesh::NumericVector<Real>*>& basis,
@@ -94,6 +116,7 @@ namespace MAST{
         unsigned int                        _n_modes;
         std::map<Real, ComplexMatrixX>      _kr_to_gaf_map;
         std::map<Real, ComplexMatrixX>      _kr_to_gaf_kr_sens_map;
+        MAST::GAFRationalFunctionApproximation  _rfa;
     };
 }
 
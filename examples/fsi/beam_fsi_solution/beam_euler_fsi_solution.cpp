@@ -48,6 +48,7 @@
 #include "solver/first_order_newmark_transient_solver.h"
 #include "solver/second_order_newmark_transient_solver.h"
 #include "solver/multiphysics_nonlinear_solver.h"
+#include "solver/interface_coupling_assembly.h"
 #include "solver/slepc_eigen_solver.h"
 #include "examples/base/augment_ghost_elem_send_list.h"
 
@@ -60,6 +61,8 @@
 #include "libmesh/getpot.h"
 #include "libmesh/string_to_enum.h"
 #include "libmesh/nonlinear_solver.h"
+#include "libmesh/boundary_info.h"
+#include "libmesh/dof_map.h"
 
 
 extern libMesh::LibMeshInit* __init;
@@ -754,6 +757,60 @@ MAST::BeamEulerFSIAnalysis::solve(bool if_write_output,
     fsi_solver.set_system_assembly(0,      fluid_assembly);
     fsi_solver.set_system_assembly(1, structural_assembly);
     
+    // the coupling blocks of the fluid dofs on the panel and the structural
+    // dofs are assembled in the preconditioning matrix of a
+    // Schur-complement fieldsplit, if requested
+    MAST::InterfaceCouplingAssembly coupling(fsi_solver);
+    
+    if (libMesh::on_command_line("--fsi_assembled_coupling")) {
+        
+        // boundary id of the panel in the fluid mesh
+        const libMesh::boundary_id_type
+        panel_bc_id = 10;
+        
+        const libMesh::BoundaryInfo&
+        binfo = *_fluid_mesh->boundary_info;
+        
+        const libMesh::DofMap&
+        fluid_dof_map = _fluid_sys->get_dof_map();
+        
+        std::set<libMesh::dof_id_type>
+        fluid_dofs,
+        structural_dofs;
+        
+        std::vector<libMesh::dof_id_type>
+        dofs;
+        
+        libMesh::MeshBase::const_element_iterator
+        el     = _fluid_mesh->active_local_elements_begin();
+        const libMesh::MeshBase::const_element_iterator
+        end_el = _fluid_mesh->active_local_elements_end();
+        
+        for ( ; el != end_el; el++) {
+            
+            const libMesh::Elem* elem = *el;
+            
+            for (unsigned short int n=0; n<elem->n_sides(); n++)
+                if (binfo.has_boundary_id(elem, n, panel_bc_id)) {
+                    
+                    fluid_dof_map.dof_indices(elem, dofs);
+                    fluid_dofs.insert(dofs.begin(), dofs.end());
+                    break;
+                }
+        }
+        
+        // the pressure load depends on all structural dofs
+        for (libMesh::dof_id_type i=0; i<_structural_sys->n_dofs(); i++)
+            structural_dofs.insert(i);
+        
+        coupling.add_coupled_dofs(0, 1, fluid_dofs, structural_dofs);
+        coupling.add_coupled_dofs(1, 0, structural_dofs, fluid_dofs);
+        
+        fsi_solver.set_coupling_assembly(coupling,
+                                         MAST::MultiphysicsNonlinearSolverBase::ASSEMBLED_COUPLING_PC);
+        fsi_solver.set_fieldsplit_type(MAST::MultiphysicsNonlinearSolverBase::SCHUR_FIELDSPLIT);
+    }
+    
     while ((t_step <= _max_time_steps) && (vel_1  >=  1.e-8)) {
 
         // change dt if the iteration count has increased to threshold
@@ -442,6 +442,14 @@ MAST::TopologyOptimization2D::init(GetPot& infile,
     
     _assembly->attach_discipline_and_system(*_discipline, *_structural_sys);
     
+    // each density parameter influences a single element, so the
+    // sensitivity assembly is limited to that element
+    libMesh::ParameterVector params;
+    params.resize(_n_elems);
+    for (unsigned int i=0; i<_n_elems; i++)
+        params[i] = _elem_rho[_elems[i]]->ptr();
+    _assembly->init_sensitivity_elem_index(params);
+    
     
     _initialized = true;
 }
@@ -621,26 +629,29 @@ MAST::TopologyOptimization2D::evaluate(const std::vector<Real>& dvars,
     // sensitivity of the objective function
     if (eval_obj_grad) {
         
-        // we are going to choose to use one parametric sensitivity at a time
-        for (unsigned int i=0; i<_n_elems; i++) {
-            
-            MAST::Parameter* f = _elem_rho[_elems[i]];
-            
-            libMesh::ParameterVector params;
-            params.resize(1);
-            params[0]  = f->ptr();
-            
-            // iterate over each dv and calculate the sensitivity
-            _sys->add_sensitivity_solution(0).zero();
-            
-            // sensitivity analysis
-            _sys->sensitivity_solve(params);
-            _assembly->calculate_output_sensitivity(params,
-                                                    true,
-                                                    *_sys->solution);
-            
-            obj_grad[i] = _output->get_sensitivity(f);
-        }
+        // the compliance gradient is computed with a single adjoint
+        // solution, followed by a pass over the elements for all the
+        // density parameters
+        libMesh::ParameterVector params;
+        params.resize(_n_elems);
+        for (unsigned int i=0; i<_n_elems; i++)
+            params[i] = _elem_rho[_elems[i]]->ptr();
+        
+        _sys->adjoint_solve(*_output);
+        
+        // partial derivative of the compliance
+        _assembly->calculate_output_sensitivity(params,
+                                                false,
+                                                *_sys->solution);
+        
+        for (unsigned int i=0; i<_n_elems; i++)
+            obj_grad[i] = _output->get_sensitivity(_elem_rho[_elems[i]]);
+        
+        // adjoint contribution from the residual sensitivity
+        _assembly->calculate_output_adjoint_sensitivity(params,
+                                                        *_sys->solution,
+                                                        _sys->get_adjoint_solution(0),
+                                                        obj_grad);
     }
     
     // now check if the sensitivity of constraint function is requested
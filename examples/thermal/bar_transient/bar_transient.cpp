@@ -243,7 +243,8 @@ MAST::BarTransient::get_parameter(const std::string &nm) {
 
 
 const libMesh::NumericVector<Real>&
-MAST::BarTransient::solve(bool if_write_output) {
+MAST::BarTransient::solve(bool if_write_output,
+                          MAST::TransientSolverBase::JacobianUpdateType jac_update) {
     
     libmesh_assert(_initialized);
 
@@ -270,6 +271,7 @@ MAST::BarTransient::solve(bool if_write_output) {
     Real            tval = 0.;
     solver.dt            = 1.0e7;
     solver.beta          = 1.0;
+    solver.set_jacobian_update(jac_update);
     
     
     if (if_write_output)
@@ -28,6 +28,7 @@
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "solver/transient_solver_base.h"
 
 // libMesh includes
 #include "libmesh/libmesh.h"
@@ -76,10 +77,13 @@ namespace MAST {
         MAST::Parameter* get_parameter(const std::string& nm);
         
         /*!
-         *  solves the system and returns the final solution
+         *  solves the system using \p jac_update for the Jacobian updates
+         *  of the time steps, and returns the final solution
          */
         const libMesh::NumericVector<Real>&
-        solve(bool if_write_output = false);
+        solve(bool if_write_output = false,
+              MAST::TransientSolverBase::JacobianUpdateType jac_update =
+              MAST::TransientSolverBase::FULL_NEWTON);
         
         
         /*!
@@ -17,6 +17,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <algorithm>
+
+
 // MAST includes
 #include "aeroelasticity/flutter_solver_base.h"
 #include "aeroelasticity/flutter_solution_base.h"
@@ -27,14 +31,66 @@
 #include "base/physics_discipline_base.h"
 #include "base/boundary_condition_base.h"
 #include "numerics/lapack_dggev_interface.h"
+#include "numerics/lapack_zggev_interface.h"
+#include "numerics/eigenpair_continuation.h"
 #include "base/parameter.h"
+#include "base/nonlinear_system.h"
+
+
+// libMesh includes
+#include "libmesh/threads.h"
+#include "libmesh/libmesh.h"
+
+
+
+namespace MAST {
+    
+    /*!
+     *   Computes the eigensolutions for a range of pencils of a flutter
+     *   scan. This is used with libMesh::Threads::parallel_for. Each
+     *   pencil writes only to its own eigensolver object, so no locking
+     *   is needed.
+     */
+    class FlutterEigensolutionThread {
+    public:
+        
+        FlutterEigensolutionThread(const std::vector<ComplexMatrixX>& A,
+                                   const std::vector<ComplexMatrixX>& B,
+                                   std::vector<MAST::LAPACK_ZGGEV>&   ges):
+        _A(A),
+        _B(B),
+        _ges(ges)
+        { }
+        
+        
+        void operator() (const libMesh::Threads::BlockedRange<unsigned int>& range) const {
+            
+            for (unsigned int i=range.begin(); i<range.end(); i++) {
+                
+                _ges[i].compute(_A[i], _B[i]);
+                if (_ges[i].info() == 0)
+                    _ges[i].scale_eigenvectors_to_identity_innerproduct();
+            }
+        }
+        
+    protected:
+        
+        const std::vector<ComplexMatrixX>& _A;
+        
+        const std::vector<ComplexMatrixX>& _B;
+        
+        std::vector<MAST::LAPACK_ZGGEV>&   _ges;
+    };
+}
+
 
 
 MAST::FlutterSolverBase::FlutterSolverBase():
 _assembly(nullptr),
 _basis_vectors(nullptr),
 _output(nullptr),
-_steady_solver(nullptr) {
+_steady_solver(nullptr),
+_if_mode_tracking(libMesh::on_command_line("--flutter_mode_tracking")) {
     
 }
 
@@ -59,6 +115,7 @@ attach_assembly(MAST::StructuralFluidInteractionAssembly&   assembly) {
     libmesh_assert(!_assembly);
     
     _assembly = &assembly;
+    this->clear_reduced_order_matrices();
 }
 
 
@@ -69,6 +126,7 @@ MAST::FlutterSolverBase::clear() {
     
     _assembly         = nullptr;
     _basis_vectors    = nullptr;
+    _reduced_order_matrices.clear();
     if (_output) {
         delete _output;
         _output = nullptr;
@@ -81,6 +139,7 @@ void
 MAST::FlutterSolverBase::attach_steady_solver(MAST::FlutterSolverBase::SteadySolver &solver) {
     
     _steady_solver = &solver;
+    this->clear_reduced_order_matrices();
 }
 
 
@@ -90,6 +149,7 @@ MAST::FlutterSolverBase::clear_assembly_object() {
     
     _assembly      = nullptr;
     _steady_solver = nullptr;
+    _reduced_order_matrices.clear();
 }
 
 
@@ -101,8 +161,266 @@ initialize(std::vector<libMesh::NumericVector<Real> *>& basis) {
     
     
     _basis_vectors  = &basis;
+    this->clear_reduced_order_matrices();
+}
+
+
+
+void
+MAST::FlutterSolverBase::clear_reduced_order_matrices() {
+    
+    _reduced_order_matrices.clear();
+}
+
+
+
+bool
+MAST::FlutterSolverBase::
+_if_constant_reduced_order_quantity
+(MAST::StructuralQuantityType t,
+ const std::vector<const MAST::FunctionBase*>& scan_params) const {
+    
+    switch (t) {
+            
+        case MAST::MASS:
+            return true;
+            
+        case MAST::DAMPING:
+        case MAST::STIFFNESS: {
+            
+            // the steady solution is recomputed for each analysis
+            if (_steady_solver)
+                return false;
+            
+            const MAST::PhysicsDisciplineBase& discipline = _assembly->discipline();
+            
+            for (unsigned int i=0; i<scan_params.size(); i++) {
+                
+                MAST::SideBCMapType::const_iterator
+                s_it  = discipline.side_loads().begin(),
+                s_end = discipline.side_loads().end();
+                
+                for ( ; s_it != s_end; s_it++)
+                    if (s_it->second->depends_on(*scan_params[i]))
+                        return false;
+                
+                MAST::VolumeBCMapType::const_iterator
+                v_it  = discipline.volume_loads().begin(),
+                v_end = discipline.volume_loads().end();
+                
+                for ( ; v_it != v_end; v_it++)
+                    if (v_it->second->depends_on(*scan_params[i]))
+                        return false;
+            }
+            
+            return true;
+        }
+            
+        default:
+            return false;
+    }
+}
+
+
+
+void
+MAST::FlutterSolverBase::
+_assemble_reduced_order_quantity
+(const std::vector<const MAST::FunctionBase*>& scan_params,
+ std::map<MAST::StructuralQuantityType, RealMatrixX*>& qty_map) {
+    
+    // quantities that are neither retained, nor constant, are assembled
+    std::map<MAST::StructuralQuantityType, RealMatrixX*> assemble_map;
+    
+    std::map<MAST::StructuralQuantityType, RealMatrixX*>::iterator
+    it  = qty_map.begin(),
+    end = qty_map.end();
+    
+    for ( ; it != end; it++) {
+        
+        std::map<MAST::StructuralQuantityType, RealMatrixX>::const_iterator
+        m_it = _reduced_order_matrices.find(it->first);
+        
+        if (m_it != _reduced_order_matrices.end())
+            *it->second = m_it->second;
+        else
+            assemble_map[it->first] = it->second;
+    }
+    
+    if (assemble_map.empty())
+        return;
+    
+    _assembly->assemble_reduced_order_quantity(*_basis_vectors, assemble_map);
+    
+    // retain the quantities that do not change during the scan
+    for (it = assemble_map.begin(); it != assemble_map.end(); it++)
+        if (_if_constant_reduced_order_quantity(it->first, scan_params))
+            _reduced_order_matrices[it->first] = *it->second;
+}
+
+
+
+
+
+
+
+void
+MAST::FlutterSolverBase::
+_compute_eigensolutions(const std::vector<ComplexMatrixX>& A,
+                        const std::vector<ComplexMatrixX>& B,
+                        std::vector<MAST::LAPACK_ZGGEV>&   ges) {
+    
+    libmesh_assert(_assembly);
+    libmesh_assert_equal_to(A.size(), B.size());
+    
+    const libMesh::Parallel::Communicator&
+    comm = _assembly->system().comm();
+    
+    const unsigned int
+    n_pts   = (unsigned int)A.size(),
+    n_procs = comm.size(),
+    rank    = comm.rank(),
+    first   = (unsigned int)((rank*(unsigned long)n_pts)/n_procs),
+    last    = (unsigned int)(((rank+1)*(unsigned long)n_pts)/n_procs);
+    
+    ges.clear();
+    ges.resize(n_pts);
+    
+    // solve the pencils in the block of this processor
+    libMesh::Threads::parallel_for
+    (libMesh::Threads::BlockedRange<unsigned int>(first, last),
+     MAST::FlutterEigensolutionThread(A, B, ges));
+    
+    if (n_procs == 1)
+        return;
+    
+    // pack the solutions in a buffer with an offset for each pencil, so
+    // that the processors can exchange them with a sum. Each processor
+    // writes only its own block, and the rest of the buffer is zero.
+    std::vector<unsigned int> offsets(n_pts+1, 0);
+    for (unsigned int i=0; i<n_pts; i++) {
+        const unsigned int n = (unsigned int)A[i].rows();
+        offsets[i+1] = offsets[i] + 2*n + 2*n*n;
+    }
+    
+    std::vector<Complex> buffer(offsets[n_pts], Complex(0., 0.));
+    std::vector<int>     info(n_pts, 0);
+    
+    for (unsigned int i=first; i<last; i++) {
+        
+        info[i] = ges[i].info();
+        if (info[i] != 0)
+            continue;
+        
+        const unsigned int n = (unsigned int)A[i].rows();
+        Complex* v = &buffer[offsets[i]];
+        
+        Eigen::Map<ComplexVectorX>(v,           n)    = ges[i].alphas();
+        Eigen::Map<ComplexVectorX>(v+n,         n)    = ges[i].betas();
+        Eigen::Map<ComplexMatrixX>(v+2*n,       n, n) = ges[i].left_eigenvectors();
+        Eigen::Map<ComplexMatrixX>(v+2*n+n*n,   n, n) = ges[i].right_eigenvectors();
+    }
+    
+    comm.sum(buffer);
+    comm.sum(info);
+    
+    // now set the solutions computed on the other processors
+    for (unsigned int i=0; i<n_pts; i++) {
+        
+        if (i >= first && i < last)
+            continue;
+        
+        const unsigned int n = (unsigned int)A[i].rows();
+        Complex* v = &buffer[offsets[i]];
+        
+        ges[i].set_eigensolution(A[i], B[i],
+                                 Eigen::Map<ComplexVectorX>(v,         n),
+                                 Eigen::Map<ComplexVectorX>(v+n,       n),
+                                 Eigen::Map<ComplexMatrixX>(v+2*n,     n, n),
+                                 Eigen::Map<ComplexMatrixX>(v+2*n+n*n, n, n),
+                                 info[i]);
+    }
 }
 
 
 
+Real
+MAST::FlutterSolverBase::_safeguarded_newton_update(const Real x,
+                                                    const Real g,
+                                                    const Real dg_dx,
+                                                    const Real x_lower,
+                                                    const Real g_lower,
+                                                    const Real x_upper,
+                                                    const Real g_upper) {
+    
+    const bool
+    if_bracket = (g_lower <= 0. && g_upper > 0.);
+    
+    // without a bracket only the Newton update is possible
+    if (!if_bracket) {
+        
+        if (dg_dx == 0.)
+            return x;
+        else
+            return x - g/dg_dx;
+    }
+    
+    // the Newton iterate is accepted only if it is at least this fraction
+    // of the bracket width away from either end. Since the caller replaces
+    // one end of the bracket with the new iterate, each iteration reduces
+    // the bracket width by at least this fraction.
+    const Real
+    min_frac = 0.1,
+    x_mid    = 0.5*(x_lower+x_upper),
+    x_min    = std::min(x_lower, x_upper),
+    x_max    = std::max(x_lower, x_upper),
+    dx_min   = min_frac * (x_max-x_min);
+    
+    if (dg_dx == 0.)
+        return x_mid;
+    
+    const Real
+    x_new = x - g/dg_dx;
+    
+    if (x_new < x_min + dx_min || x_new > x_max - dx_min)
+        return x_mid;
+    else
+        return x_new;
+}
+
 
+
+bool
+MAST::FlutterSolverBase::
+_continue_eigensolution(const ComplexMatrixX& A,
+                        const ComplexMatrixX& B,
+                        const MAST::FlutterSolutionBase& prev_sol,
+                        MAST::EigenpairContinuation& cont) const {
+    
+    const unsigned int
+    n      = (unsigned int)A.rows(),
+    nvals  = prev_sol.n_roots();
+    
+    if (!nvals)
+        return false;
+    
+    ComplexVectorX lambda0 = ComplexVectorX::Zero(nvals);
+    ComplexMatrixX
+    VR0    = ComplexMatrixX::Zero(n, nvals),
+    VL0    = ComplexMatrixX::Zero(n, nvals);
+    
+    for (unsigned int i=0; i<nvals; i++) {
+        
+        const MAST::FlutterRootBase& root = prev_sol.get_root(i);
+        
+        if (root.eig_vec_right.size() != n ||
+            root.eig_vec_left.size()  != n)
+            return false;
+        
+        lambda0(i)  = root.root;
+        VR0.col(i)  = root.eig_vec_right;
+        VL0.col(i)  = root.eig_vec_left;
+    }
+    
+    return cont.compute(A, B, lambda0, VR0, VL0);
+}
@@ -24,10 +24,13 @@
 #include <string>
 #include <fstream>
 #include <iomanip>
+#include <map>
+#include <vector>
 
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "elasticity/structural_fluid_interaction_assembly.h"
 
 
 // libMesh includes
@@ -44,7 +47,9 @@ namespace MAST {
     class FlutterRootBase;
     class FlutterSolutionBase;
     class FlutterRootCrossoverBase;
-    class StructuralFluidInteractionAssembly;
+    class FunctionBase;
+    class LAPACK_ZGGEV;
+    class EigenpairContinuation;
     template <typename ValType> class BasisMatrix;
     
     
@@ -118,6 +123,31 @@ namespace MAST {
          *    initializes the data structres for a flutter solution.
          */
         void initialize(std::vector<libMesh::NumericVector<Real>*>& basis);
+        
+        
+        /*!
+         *   clears the reduced-order structural matrices retained from
+         *   previous analyses. This must be called if the design or the
+         *   structural model is modified after an analysis. It is called
+         *   automatically when a new basis, assembly or steady solver is
+         *   provided.
+         */
+        void clear_reduced_order_matrices();
+        
+        
+        /*!
+         *   tells the solver to compute the eigensolution at a new point of
+         *   a scan or root search by continuation of the eigenpairs of the
+         *   previous point, instead of a full eigensolution. The full
+         *   eigensolution is computed if the continuation fails. This is
+         *   false by default, unless \p --flutter_mode_tracking is
+         *   specified on the command line. It is used by the solvers that
+         *   store the complete eigenvectors with their roots.
+         */
+        void set_mode_tracking(bool f) {
+            _if_mode_tracking = f;
+        }
+        
 
         
         
@@ -146,6 +176,82 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   computes the reduced-order structural quantities requested in
+         *   \p qty_map. A quantity that does not change with any of the
+         *   parameters in \p scan_params is retained after it is first
+         *   computed, and is reused by the subsequent calls until
+         *   clear_reduced_order_matrices() is called.
+         */
+        void
+        _assemble_reduced_order_quantity
+        (const std::vector<const MAST::FunctionBase*>& scan_params,
+         std::map<MAST::StructuralQuantityType, RealMatrixX*>& qty_map);
+        
+        
+        /*!
+         *   @returns true if the reduced-order quantity \p t is independent
+         *   of the parameters in \p scan_params. The mass matrix depends
+         *   only on the structure. The stiffness and damping matrices
+         *   include the contribution of the loads, and also depend on the
+         *   steady-state solution if a steady solver is attached.
+         */
+        bool
+        _if_constant_reduced_order_quantity
+        (MAST::StructuralQuantityType t,
+         const std::vector<const MAST::FunctionBase*>& scan_params) const;
+        
+        
+        /*!
+         *   computes the eigensolutions of the pencils \p A[i] x = \lambda
+         *   \p B[i] x for all points of a flutter scan, with the right
+         *   eigenvectors scaled to identity inner product. The pencils are
+         *   split in contiguous blocks across the processors of the
+         *   assembly communicator, and each block is split across the
+         *   threads of the processor. The eigensolutions are then
+         *   communicated so that \p ges holds all of them, in the order of
+         *   \p A, on every processor. The matrices must be the same on all
+         *   processors.
+         */
+        void
+        _compute_eigensolutions(const std::vector<ComplexMatrixX>& A,
+                                const std::vector<ComplexMatrixX>& B,
+                                std::vector<MAST::LAPACK_ZGGEV>&   ges);
+        
+        
+        /*!
+         *   @returns the next iterate of the Newton search for the root of
+         *   the damping, \p g(x) = 0, from the current iterate \p x with
+         *   damping \p g and derivative \p dg_dx. If the bracket defined
+         *   by (\p x_lower, \p g_lower) and (\p x_upper, \p g_upper), with
+         *   negative and positive damping respectively, is valid and the
+         *   Newton update falls outside it, or within a tenth of its width
+         *   from either end, then the midpoint of the bracket is returned
+         *   instead. This guarantees that the bracket shrinks by at least
+         *   a tenth of its width in each iteration.
+         */
+        static Real
+        _safeguarded_newton_update(const Real x,
+                                   const Real g,
+                                   const Real dg_dx,
+                                   const Real x_lower,
+                                   const Real g_lower,
+                                   const Real x_upper,
+                                   const Real g_upper);
+        
+        
+        /*!
+         *   computes the eigenpairs of A x = \lambda B x by continuation
+         *   of the roots of \p prev_sol. @returns false if the eigenvectors
+         *   of the roots do not match the size of the matrices, or if the
+         *   continuation fails.
+         */
+        bool
+        _continue_eigensolution(const ComplexMatrixX& A,
+                                const ComplexMatrixX& B,
+                                const MAST::FlutterSolutionBase& prev_sol,
+                                MAST::EigenpairContinuation& cont) const;
+        
         
         /*!
          *   structural assembly that provides the assembly of the system
@@ -171,6 +277,16 @@ namespace MAST {
          */
         MAST::FlutterSolverBase::SteadySolver* _steady_solver;
         
+        /*!
+         *   flag to follow the roots by eigenpair continuation
+         */
+        bool _if_mode_tracking;
+        
+        /*!
+         *   reduced-order structural matrices retained across analyses
+         */
+        std::map<MAST::StructuralQuantityType, RealMatrixX> _reduced_order_matrices;
+        
     };
 }
 
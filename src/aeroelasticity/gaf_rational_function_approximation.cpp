@@ -0,0 +1,271 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// MAST includes
+#include "aeroelasticity/gaf_rational_function_approximation.h"
+
+
+MAST::GAFRationalFunctionApproximation::GAFRationalFunctionApproximation():
+_fit_error(0.) {
+    
+}
+
+
+
+MAST::GAFRationalFunctionApproximation::~GAFRationalFunctionApproximation() {
+    
+}
+
+
+
+void
+MAST::GAFRationalFunctionApproximation::
+init(const std::map<Real, ComplexMatrixX>& kr_to_gaf,
+     const std::vector<Real>& lag_roots) {
+    
+    libmesh_assert(kr_to_gaf.size());
+    
+    // the lag roots must be positive and distinct for a stable and
+    // well-posed fit
+    for (unsigned int i=0; i<lag_roots.size(); i++) {
+        libmesh_assert_greater(lag_roots[i], 0.);
+        for (unsigned int j=0; j<i; j++)
+            libmesh_assert_not_equal_to(lag_roots[i], lag_roots[j]);
+    }
+    
+    this->clear();
+    _lag_roots = lag_roots;
+    
+    const unsigned int
+    n_terms = 3 + (unsigned int)_lag_roots.size(),
+    n_kr    = (unsigned int)kr_to_gaf.size(),
+    n_rows  = (unsigned int)kr_to_gaf.begin()->second.rows(),
+    n_cols  = (unsigned int)kr_to_gaf.begin()->second.cols();
+    
+    // each reduced frequency provides a real and an imaginary equation
+    libmesh_assert_greater_equal(2*n_kr, n_terms);
+    
+    // the least-squares problem  phi X = Y, where each column of X and Y
+    // corresponds to an entry of the matrix
+    RealMatrixX
+    phi = RealMatrixX::Zero(2*n_kr, n_terms),
+    Y   = RealMatrixX::Zero(2*n_kr, n_rows*n_cols);
+    
+    std::vector<Complex> f, df;
+    
+    std::map<Real, ComplexMatrixX>::const_iterator
+    it  = kr_to_gaf.begin(),
+    end = kr_to_gaf.end();
+    
+    Real
+    max_val = 0.;
+    
+    for (unsigned int i=0; it != end; it++, i++) {
+        
+        const ComplexMatrixX& mat = it->second;
+        libmesh_assert_equal_to(mat.rows(), n_rows);
+        libmesh_assert_equal_to(mat.cols(), n_cols);
+        
+        _basis(it->first, f, df);
+        
+        for (unsigned int j=0; j<n_terms; j++) {
+            phi(2*i,   j) = f[j].real();
+            phi(2*i+1, j) = f[j].imag();
+        }
+        
+        for (unsigned int c=0; c<n_cols; c++)
+            for (unsigned int r=0; r<n_rows; r++) {
+                Y(2*i,   c*n_rows+r) = mat(r,c).real();
+                Y(2*i+1, c*n_rows+r) = mat(r,c).imag();
+            }
+        
+        max_val = std::max(max_val, mat.cwiseAbs().maxCoeff());
+    }
+    
+    RealMatrixX
+    X = phi.colPivHouseholderQr().solve(Y);
+    
+    _coeffs.resize(n_terms);
+    for (unsigned int j=0; j<n_terms; j++) {
+        
+        _coeffs[j].setZero(n_rows, n_cols);
+        for (unsigned int c=0; c<n_cols; c++)
+            for (unsigned int r=0; r<n_rows; r++)
+                _coeffs[j](r,c) = X(j, c*n_rows+r);
+    }
+    
+    // the error is evaluated at the tabulated frequencies
+    ComplexMatrixX
+    mat;
+    for (it = kr_to_gaf.begin(); it != end; it++) {
+        
+        this->value(it->first, mat);
+        _fit_error = std::max(_fit_error,
+                              (mat - it->second).cwiseAbs().maxCoeff());
+    }
+    
+    if (max_val > 0.)
+        _fit_error /= max_val;
+}
+
+
+
+void
+MAST::GAFRationalFunctionApproximation::clear() {
+    
+    _lag_roots.clear();
+    _coeffs.clear();
+    _fit_error = 0.;
+}
+
+
+
+const RealMatrixX&
+MAST::GAFRationalFunctionApproximation::coefficient(const unsigned int i) const {
+    
+    libmesh_assert_less(i, _coeffs.size());
+    
+    return _coeffs[i];
+}
+
+
+
+void
+MAST::GAFRationalFunctionApproximation::value(const Real kr,
+                                              ComplexMatrixX& mat) const {
+    
+    libmesh_assert(this->initialized());
+    
+    std::vector<Complex> f, df;
+    _basis(kr, f, df);
+    
+    mat.setZero(_coeffs[0].rows(), _coeffs[0].cols());
+    for (unsigned int j=0; j<_coeffs.size(); j++)
+        mat += f[j] * _coeffs[j].cast<Complex>();
+}
+
+
+
+void
+MAST::GAFRationalFunctionApproximation::derivative(const Real kr,
+                                                   ComplexMatrixX& mat) const {
+    
+    libmesh_assert(this->initialized());
+    
+    std::vector<Complex> f, df;
+    _basis(kr, f, df);
+    
+    mat.setZero(_coeffs[0].rows(), _coeffs[0].cols());
+    for (unsigned int j=0; j<_coeffs.size(); j++)
+        mat += df[j] * _coeffs[j].cast<Complex>();
+}
+
+
+
+void
+MAST::GAFRationalFunctionApproximation::
+state_space_matrices(const RealMatrixX& m,
+                     const RealMatrixX& c,
+                     const RealMatrixX& k,
+                     const Real q_dyn,
+                     const Real V,
+                     const Real b_ref,
+                     RealMatrixX& A,
+                     RealMatrixX& B) const {
+    
+    libmesh_assert(this->initialized());
+    libmesh_assert_greater(V, 0.);
+    
+    //  with s = p b/V, the aerodynamic force is
+    //     q_dyn (A0 q + (b/V) A1 q_dot + (b/V)^2 A2 q_ddot + sum_l x_l)
+    //  where the lag states are
+    //     x_l_dot = A_{l+2} q_dot - (V/b) beta_l x_l
+    //
+    //  The equations for y = {q, q_dot, x_1, ..., x_nl} are
+    //  [ I  0         0 ]        [  0           I              0    ]
+    //  [ 0  M-q b2 A2 0 ] y_dot = [ -K+q A0    -C+q b1 A1      q I  ] y
+    //  [ 0  0         I ]        [  0           A_{l+2}  -(V/b) beta_l I]
+    //  with b1 = b/V, b2 = (b/V)^2
+    
+    const unsigned int
+    n   = (unsigned int)m.rows(),
+    n_l = (unsigned int)_lag_roots.size();
+    
+    const Real
+    b1  = b_ref/V,
+    b2  = b1*b1;
+    
+    A.setZero((2+n_l)*n, (2+n_l)*n);
+    B.setZero((2+n_l)*n, (2+n_l)*n);
+    
+    B.topLeftCorner(n, n)      = RealMatrixX::Identity(n, n);
+    B.block(n, n, n, n)        = m - q_dyn * b2 * _coeffs[2];
+    
+    A.block(0, n, n, n)        = RealMatrixX::Identity(n, n);
+    A.block(n, 0, n, n)        = -k + q_dyn * _coeffs[0];
+    A.block(n, n, n, n)        = -c + q_dyn * b1 * _coeffs[1];
+    
+    for (unsigned int l=0; l<n_l; l++) {
+        
+        const unsigned int
+        i = (2+l)*n;
+        
+        B.block(i, i, n, n)    = RealMatrixX::Identity(n, n);
+        A.block(n, i, n, n)    = q_dyn * RealMatrixX::Identity(n, n);
+        A.block(i, n, n, n)    = _coeffs[3+l];
+        A.block(i, i, n, n)    = -_lag_roots[l]/b1 * RealMatrixX::Identity(n, n);
+    }
+}
+
+
+
+void
+MAST::GAFRationalFunctionApproximation::_basis(const Real kr,
+                                               std::vector<Complex>& f,
+                                               std::vector<Complex>& df) const {
+    
+    const unsigned int
+    n_l = (unsigned int)_lag_roots.size();
+    
+    f.resize(3+n_l);
+    df.resize(3+n_l);
+    
+    const Complex
+    iota(0., 1.);
+    
+    // A0, A1 s, A2 s^2 with s = i kr
+    f[0]  = 1.;
+    f[1]  = iota * kr;
+    f[2]  = -kr*kr;
+    
+    df[0] = 0.;
+    df[1] = iota;
+    df[2] = -2.*kr;
+    
+    // lag terms s/(s + beta) = (kr^2 + i kr beta)/(kr^2 + beta^2)
+    for (unsigned int l=0; l<n_l; l++) {
+        
+        const Real
+        b   = _lag_roots[l],
+        den = kr*kr + b*b;
+        
+        f[3+l]  = Complex(kr*kr, kr*b) / den;
+        df[3+l] = Complex(2.*kr*b*b, b*(b*b - kr*kr)) / (den*den);
+    }
+}
@@ -0,0 +1,166 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__gaf_rational_function_approximation_h__
+#define __mast__gaf_rational_function_approximation_h__
+
+// C++ includes
+#include <map>
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Roger's rational function approximation of the generalized
+     *   aerodynamic force matrix as a function of the reduced frequency
+     *   \f$ k \f$. With \f$ s = i k \f$, the approximation is
+     *   \f[ A(k) = A_0 + A_1 s + A_2 s^2 +
+     *              \sum_{l=1}^{n_l} A_{l+2} \frac{s}{s + \beta_l} \f]
+     *   where \f$ \beta_l \f$ are the user-specified aerodynamic lag roots,
+     *   and the real coefficient matrices \f$ A_j \f$ are obtained from a
+     *   least-squares fit of the tabulated matrices. Once fitted, the
+     *   matrix and its derivative with respect to \f$ k \f$ are available
+     *   in closed form at any reduced frequency.
+     */
+    class GAFRationalFunctionApproximation {
+        
+    public:
+        
+        GAFRationalFunctionApproximation();
+        
+        virtual ~GAFRationalFunctionApproximation();
+        
+        /*!
+         *   fits the approximation to the matrices in \p kr_to_gaf
+         *   tabulated with respect to the reduced frequency, using the
+         *   lag roots \p lag_roots. The number of tabulated frequencies
+         *   must be sufficient to determine the 3 + n_lag coefficient
+         *   matrices from the real and imaginary parts of the data.
+         */
+        void init(const std::map<Real, ComplexMatrixX>& kr_to_gaf,
+                  const std::vector<Real>& lag_roots);
+        
+        /*!
+         *   clears the fitted data
+         */
+        void clear();
+        
+        /*!
+         *   @returns true if the approximation has been fitted
+         */
+        bool initialized() const {
+            return _coeffs.size() > 0;
+        }
+        
+        /*!
+         *   @returns the number of lag terms
+         */
+        unsigned int n_lag_terms() const {
+            return (unsigned int)_lag_roots.size();
+        }
+        
+        /*!
+         *   @returns the lag roots
+         */
+        const std::vector<Real>& lag_roots() const {
+            return _lag_roots;
+        }
+        
+        /*!
+         *   @returns the \p i th coefficient matrix. \p i = 0, 1, 2 are the
+         *   stiffness, damping and mass-like terms, and \p i = 2+l is the
+         *   coefficient of the l th lag term.
+         */
+        const RealMatrixX& coefficient(const unsigned int i) const;
+        
+        /*!
+         *   calculates the approximated matrix at reduced frequency \p kr
+         *   and returns it in \p mat
+         */
+        void value(const Real kr, ComplexMatrixX& mat) const;
+        
+        /*!
+         *   calculates the derivative of the approximated matrix with
+         *   respect to the reduced frequency at \p kr and returns it in
+         *   \p mat
+         */
+        void derivative(const Real kr, ComplexMatrixX& mat) const;
+        
+        /*!
+         *   @returns the maximum error between the tabulated matrices used
+         *   for the fit and the approximation, relative to the largest
+         *   tabulated entry.
+         */
+        Real fit_error() const {
+            return _fit_error;
+        }
+        
+        /*!
+         *   creates the first-order state-space model
+         *   \f$ B \dot{y} = A y \f$ for the structural equations
+         *   \f$ M \ddot{q} + C \dot{q} + K q = q_{dyn} A(p b/V) q \f$
+         *   with reduced-order mass \p m, damping \p c and stiffness \p k,
+         *   dynamic pressure \p q_dyn, velocity \p V, and reference length
+         *   \p b_ref. The state vector is
+         *   \f$ y = \{ q^T, \dot{q}^T, x_1^T, \dots, x_{n_l}^T \}^T \f$
+         *   where the aerodynamic lag states satisfy
+         *   \f$ \dot{x}_l = A_{l+2} \dot{q} - (V/b) \beta_l x_l \f$.
+         */
+        void state_space_matrices(const RealMatrixX& m,
+                                  const RealMatrixX& c,
+                                  const RealMatrixX& k,
+                                  const Real q_dyn,
+                                  const Real V,
+                                  const Real b_ref,
+                                  RealMatrixX& A,
+                                  RealMatrixX& B) const;
+        
+    protected:
+        
+        /*!
+         *   calculates the complex value of the basis functions at
+         *   \p kr in \p f, and of their derivatives with respect to \p kr
+         *   in \p df.
+         */
+        void _basis(const Real kr,
+                    std::vector<Complex>& f,
+                    std::vector<Complex>& df) const;
+        
+        /*!
+         *   aerodynamic lag roots
+         */
+        std::vector<Real> _lag_roots;
+        
+        /*!
+         *   coefficient matrices of the approximation
+         */
+        std::vector<RealMatrixX> _coeffs;
+        
+        /*!
+         *   error in the fit
+         */
+        Real _fit_error;
+    };
+}
+
+#endif // __mast__gaf_rational_function_approximation_h__
@@ -174,18 +174,46 @@ MAST::PKFlutterSolver::scan_for_roots() {
             }
             v_ref_vals[_n_V_divs] = _V_range.second; // to get around finite-precision arithmetic
             
+            libMesh::out
+            << " ====================================================" << std::endl
+            << "PK Solution" << std::endl
+            << "   k_red = " << std::setw(10) << current_k_red << std::endl;
+            
+            // the matrices are assembled for all velocities first, since
+            // the assembly is collective on the communicator. The
+            // eigensolutions are independent, and are computed in parallel
+            std::vector<ComplexMatrixX>
+            L(_n_V_divs+1),
+            R(_n_V_divs+1);
+            std::vector<RealMatrixX> stiff(_n_V_divs+1);
+            std::vector<MAST::LAPACK_ZGGEV> ges;
+            
+            for (unsigned int i=0; i<_n_V_divs+1; i++)
+                _initialize_matrices(current_k_red, v_ref_vals[i], L[i], R[i], stiff[i]);
+            
+            _compute_eigensolutions(L, R, ges);
+            
+            libMesh::out
+            << "Finished PK Solution" << std::endl
+            << " ====================================================" << std::endl;
+            
             MAST::FlutterSolutionBase* prev_sol = nullptr;
             
             //
-            // inner loop is on reduced frequencies
+            // inner loop is on velocities. The roots are sorted with
+            // respect to the previous velocity in the same order as the
+            // serial scan, so the results do not depend on the number of
+            // processors or threads.
             //
             for (unsigned int i=0; i<_n_V_divs+1; i++) {
                 current_v_ref = v_ref_vals[i];
-                std::auto_ptr<MAST::FlutterSolutionBase> sol =
-                _analyze(current_k_red,
-                         current_v_ref,
-                         prev_sol);
                 
+                std::auto_ptr<MAST::FlutterSolutionBase> sol =
+                _build_solution(current_k_red,
+                                current_v_ref,
+                                stiff[i],
+                                ges[i],
+                                prev_sol);
                 
                 if (_output)
                     sol->print(*_output);
@@ -423,15 +451,10 @@ MAST::PKFlutterSolver::find_next_root(const Real g_tol,
         if (!cross->root) {
             const unsigned int root_num = cross->root_num;
             std::pair<bool, MAST::FlutterSolutionBase*> sol;
-            // first try the Newton search. If that fails, then
-            // try the bisection search
-            /*sol = newton_search(*cross->crossover_solutions.second,
-             root_num,
-             g_tol,
-             n_bisection_iters);
-             if (!sol.first)*/
-            sol =   _bisection_search(cross->crossover_solutions,
-                                      root_num, g_tol, n_bisection_iters);
+            // the Newton search takes a bisection step whenever its
+            // update leaves the bracket
+            sol =   _newton_search(cross->crossover_solutions,
+                                   root_num, g_tol, n_bisection_iters);
             
             cross->root = &(sol.second->get_root(root_num));
             
@@ -476,15 +499,10 @@ MAST::PKFlutterSolver::find_critical_root(const Real g_tol,
             
             const unsigned int root_num = cross->root_num;
             std::pair<bool, MAST::FlutterSolutionBase*> sol;
-            // first try the Newton search. If that fails, then
-            // try the bisection search
-            /*sol = newton_search(*cross->crossover_solutions.second,
-             root_num,
-             g_tol,
-             n_bisection_iters);
-             if (!sol.first)*/
-            sol =   _bisection_search(cross->crossover_solutions,
-                                      root_num, g_tol, n_bisection_iters);
+            // the Newton search takes a bisection step whenever its
+            // update leaves the bracket
+            sol =   _newton_search(cross->crossover_solutions,
+                                   root_num, g_tol, n_bisection_iters);
             
             cross->root = &(sol.second->get_root(root_num));
             
@@ -507,147 +525,113 @@ MAST::PKFlutterSolver::find_critical_root(const Real g_tol,
 
 
 
-/*std::pair<bool, MAST::FlutterSolutionBase*>
-MAST::PKFlutterSolver::_newton_search(const MAST::FlutterSolutionBase& init_sol,
-                                     const unsigned int root_num,
-                                     const Real tol,
-                                     const unsigned int max_iters) {
-    
-    libmesh_error(); // to be implemented
+std::pair<bool, MAST::FlutterSolutionBase*>
+MAST::PKFlutterSolver::_newton_search(const std::pair<MAST::FlutterSolutionBase*,
+                                      MAST::FlutterSolutionBase*>& ref_sol_range,
+                                      const unsigned int root_num,
+                                      const Real g_tol,
+                                      const unsigned int max_iters) {
     
-    std::pair<bool, MAST::FlutterSolutionBase*> rval(false, nullptr);
     // assumes that the upper k_val has +ve g val and lower k_val has -ve
-    // k_val
-    Real k_red, v_ref;
+    // k_val. As in the bisection search, the reduced frequency is
+    // interpolated from the bracket for the first iterate, and is then
+    // updated from the reduced frequency of the root at each iterate.
+    Real
+    lower_k = ref_sol_range.first->get_root(root_num).kr,
+    lower_v = ref_sol_range.first->get_root(root_num).V,
+    lower_g = ref_sol_range.first->get_root(root_num).g,
+    upper_k = ref_sol_range.second->get_root(root_num).kr,
+    upper_v = ref_sol_range.second->get_root(root_num).V,
+    upper_g = ref_sol_range.second->get_root(root_num).g,
+    new_k   = lower_k + (upper_k-lower_k)/(upper_g-lower_g)*(0.-lower_g),
+    new_v   = lower_v + (upper_v-lower_v)/(upper_g-lower_g)*(0.-lower_g),
+    dg_dv   = 0.;
     unsigned int n_iters = 0;
     
-    std::auto_ptr<MAST::FlutterSolutionBase> new_sol;
-    
-    RealVectorX res, sol, dsol;
-    RealMatrixX jac, stiff;
-    ComplexMatrixX mat_A, mat_B, mat_A_sens, mat_B_sens;
-    ComplexVectorX v;
-    
-    res.resize(2); sol.resize(2); dsol.resize(2);
-    jac.resize(2,2);
-    
-    // initialize the solution to the values of init_sol
-    k_red  = init_sol.get_root(root_num).k_red_ref;
-    v_ref  = init_sol.get_root(root_num).V_ref;
-    sol(0) = k_red;
-    sol(1) = v_ref;
-    
-    const MAST::FlutterSolutionBase* prev_sol = &init_sol;
+    const unsigned int n = (unsigned int)_basis_vectors->size();
     
-    bool if_continue = true;
+    ComplexMatrixX L, R, dL_dv;
+    RealMatrixX stiff;
+    ComplexVectorX vl, vr;
+    LAPACK_ZGGEV ges;
+    std::pair<bool, MAST::FlutterSolutionBase*> rval(false, nullptr);
     
-    while (if_continue) {
+    while (n_iters < max_iters) {
         
-        // evaluate the residual and Jacobians
-        std::auto_ptr<MAST::FlutterSolutionBase> pk_sol =
-        this->analyze(k_red, v_ref, prev_sol);
+        _initialize_matrices(new_k, new_v, L, R, stiff);
+        ges.compute(L, R);
+        ges.scale_eigenvectors_to_identity_innerproduct();
         
-        pk_sol->print(_output);
+        std::auto_ptr<MAST::FlutterSolutionBase>
+        new_sol(_build_solution(new_k, new_v, stiff, ges, ref_sol_range.first));
+        
+        if (_output)
+            new_sol->print(*_output);
         
         // add the solution to this solver
-        _insert_new_solution(v_ref, pk_sol.release());
+        _insert_new_solution(new_k, new_sol.release());
         
-        // now get a pointer to the previous solution
-        // get the solution from the database for this reduced frequency
+        // get the solution from the database for this velocity
         std::map<Real, MAST::FlutterSolutionBase*>::iterator it =
-        _flutter_solutions.find(v_ref);
+        _flutter_solutions.find(new_v);
         
         libmesh_assert(it != _flutter_solutions.end());
         rval.second = it->second;
-        prev_sol = it->second;
-        
-        // solve the Newton update problem
-        const MAST::FlutterRootBase& root = prev_sol->get_root(root_num);
-        Complex eig = root.root, eig_k_red_sens = 0., den = 0., eig_V_ref_sens = 0.;
-        
-        // initialize the baseline matrices
-        initialize_matrices(k_red, v_ref, mat_A, mat_B, stiff);
-        
-        // solve the sensitivity problem
-        // first with respect to k_red
-        // next we need the sensitivity of k_red before we can calculate
-        // the sensitivity of flutter eigenvalue
-        initialize_matrix_sensitivity_for_reduced_freq(k_red,
-                                                       v_ref,
-                                                       mat_A_sens,
-                                                       mat_B_sens);
-        
-        // now calculate the quotient for sensitivity wrt k_red
-        // calculate numerator
-        mat_B_sens *= -eig;
-        mat_B_sens += mat_A_sens;
-        v = mat_B_sens*root.eig_vec_right;
-        den = root.eig_vec_left.dot(mat_B*root.eig_vec_right);
-        eig_k_red_sens = root.eig_vec_left.dot(v) / den;
+        const MAST::FlutterRootBase& root = rval.second->get_root(root_num);
         
-        //std::auto_ptr<MAST::FlutterSolutionBase> PK_dsol =
-        //this->analyze(k_red+.001, v_ref, prev_sol);
-        //eig -= PK_dsol->get_root(root_num).root;
-        //eig /= -.001;
-         
-        //std::cout << eig << std::endl;
-        //std::cout << eig_k_red_sens << std::endl;
+        // check if the new damping value
+        if (fabs(root.g) <= g_tol) {
+            rval.first = true;
+            return  rval;
+        }
         
-        // next, sensitivity wrt V_ref
-        initialize_matrix_sensitivity_for_V_ref(k_red,
-                                                v_ref,
-                                                mat_A_sens,
-                                                mat_B_sens);
+        // update the bracket
+        if (root.g < 0.) {
+            lower_v = new_v;
+            lower_g = root.g;
+        }
+        else {
+            upper_v = new_v;
+            upper_g = root.g;
+        }
         
-        // now calculate the quotient for sensitivity wrt V_ref
-        // calculate numerator
-        mat_B_sens *= -eig;
-        mat_B_sens += mat_A_sens;
-        v = mat_B_sens*root.eig_vec_right;
-        den = root.eig_vec_left.dot(mat_B*root.eig_vec_right);
-        eig_V_ref_sens = root.eig_vec_left.dot(v) / den;
+        // the roots only store the modal part of the eigenvectors, so the
+        // full eigenvectors are taken from the eigensolution whose
+        // eigenvalue matches the root
+        const ComplexVectorX
+        &alpha  = ges.alphas(),
+        &beta   = ges.betas();
+        unsigned int col = 0;
+        Real dist = std::abs(alpha(0)/beta(0) - root.root);
+        for (unsigned int i=1; i<alpha.size(); i++)
+            if (std::abs(alpha(i)/beta(i) - root.root) < dist) {
+                col  = i;
+                dist = std::abs(alpha(i)/beta(i) - root.root);
+            }
         
- //std::auto_ptr<MAST::FlutterSolutionBase> PK_dsol =
- //this->analyze(k_red, v_ref+.001, prev_sol);
- //eig -= PK_dsol->get_root(root_num).root;
- //eig /= -.001;
- 
- //std::cout << eig << std::endl;
- //std::cout << eig_V_ref_sens << std::endl;
- 
-        // residual
-        res(0) = root.root.imag();
-        res(1) = v_ref*std::sqrt(root.root.real()) - 1.;
+        vl = ges.left_eigenvectors().col(col);
+        vr = ges.right_eigenvectors().col(col);
         
-        // Jacobian
-        jac(0,0) = eig_k_red_sens.imag();
-        jac(0,1) = eig_V_ref_sens.imag();
-        jac(1,0) = 0.5*v_ref*pow(eig.real(), -0.5)*eig_k_red_sens.real();
-        jac(1,1) = std::sqrt(eig.real()) + 0.5*v_ref*pow(eig.real(), -0.5)*eig_V_ref_sens.real();
+        // only the aerodynamic term -q A(kr) in the lower left block of L
+        // depends on velocity, and scales with V^2. This block is obtained
+        // as L + K.
+        dL_dv = ComplexMatrixX::Zero(2*n, 2*n);
+        dL_dv.bottomLeftCorner(n, n) =
+        2./new_v * (L.bottomLeftCorner(n, n) + stiff.cast<Complex>());
         
-        // now calculate the updates
-        //     r0 + J *dx = 0
-        // =>  dx = - inv(J) * r0
-        // =>  x1 = x0 + dx
+        dg_dv  = (vl.dot(dL_dv*vr)/vl.dot(R*vr)).real();
         
-        dsol = -jac.inverse()*res;
-        sol += dsol;
+        new_v  = _safeguarded_newton_update(new_v, root.g, dg_dv,
+                                            lower_v, lower_g,
+                                            upper_v, upper_g);
         
-        // get the updated parameter values
-        k_red = sol(0);
-        v_ref = sol(1);
+        // use the reduced frequency of the root to get the aerodynamic
+        // matrices for the next velocity iterate. Otherwise, the iterates
+        // converge to the zero damping velocity of the interpolated
+        // reduced frequency, and not to the matched-point flutter root.
+        new_k  = root.kr;
         
-        // increment the iteration counter
         n_iters++;
-        
-        // set the flag
-        if (fabs(root.g) < tol) {
-            rval.first = true;
-            return rval;
-        }
-        
-        if (n_iters >= max_iters)
-            if_continue = false;
     }
     
     // return false, along with the latest sol
@@ -655,7 +639,6 @@ MAST::PKFlutterSolver::_newton_search(const MAST::FlutterSolutionBase& init_sol,
     
     return rval;
 }
-*/
 
 
 void
@@ -854,6 +837,27 @@ MAST::PKFlutterSolver::_analyze(const Real k_red,
     ges.compute(L, R);
     ges.scale_eigenvectors_to_identity_innerproduct();
     
+    std::auto_ptr<MAST::FlutterSolutionBase>
+    root(_build_solution(k_red, v_ref, stiff, ges, prev_sol));
+    
+    libMesh::out
+    << "Finished PK Solution" << std::endl
+    << " ====================================================" << std::endl;
+    
+    
+    return root;
+}
+
+
+
+
+std::auto_ptr<MAST::FlutterSolutionBase>
+MAST::PKFlutterSolver::_build_solution(const Real k_red,
+                                       const Real v_ref,
+                                       const RealMatrixX& stiff,
+                                       const MAST::LAPACK_ZGGEV& ges,
+                                       const MAST::FlutterSolutionBase* prev_sol) {
+    
     MAST::PKFlutterSolution* root = new MAST::PKFlutterSolution;
     root->init(*this,
                k_red, v_ref,
@@ -862,11 +866,6 @@ MAST::PKFlutterSolver::_analyze(const Real k_red,
     if (prev_sol)
         root->sort(*prev_sol);
     
-    libMesh::out
-    << "Finished PK Solution" << std::endl
-    << " ====================================================" << std::endl;
-    
-    
     return std::auto_ptr<MAST::FlutterSolutionBase> (root);
 }
 
@@ -983,6 +982,9 @@ MAST::PKFlutterSolver::_initialize_matrices(const Real k_red,
 
     
     const unsigned int n = (unsigned int)_basis_vectors->size();
+    
+    A      =  ComplexMatrixX::Zero(2*n, 2*n);
+    B      =  ComplexMatrixX::Zero(2*n, 2*n);
 
     RealMatrixX
     m      =  RealMatrixX::Zero(n, n),
@@ -1003,7 +1005,13 @@ MAST::PKFlutterSolver::_initialize_matrices(const Real k_red,
     (*_kred_param)      = k_red;
     (*_velocity_param)  = v_ref;
     
-    _assembly->assemble_reduced_order_quantity(*_basis_vectors, qty_map);
+    // the structural matrices are reused across the scan if they do not
+    // depend on the velocity or reduced frequency
+    std::vector<const MAST::FunctionBase*> scan_params(2);
+    scan_params[0] = _velocity_param;
+    scan_params[1] = _kred_param;
+    
+    _assemble_reduced_order_quantity(scan_params, qty_map);
 
     dynamic_cast<MAST::FSIGeneralizedAeroForceAssembly*>(_assembly)->
     assemble_generalized_aerodynamic_force_matrix(*_basis_vectors, a);
@@ -1013,7 +1021,7 @@ MAST::PKFlutterSolver::_initialize_matrices(const Real k_red,
     A.bottomLeftCorner  (n, n)    = -k.cast<Complex>() - _rho/2.*v_ref*v_ref*a;
     B.topLeftCorner     (n, n)    = ComplexMatrixX::Identity(n, n);
     B.bottomRightCorner (n, n)    = m.cast<Complex>();
-    
+    stiff                         = k;
 }
 
 
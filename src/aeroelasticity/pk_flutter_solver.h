@@ -150,13 +150,32 @@ namespace MAST {
         
         
         /*!
-         *    Newton method to look for cross-over point method search
+         *    Newton search for the velocity of zero damping in the bracket
+         *    \p ref_sol_range, at the reduced frequency interpolated from
+         *    the bracket. The derivative of the damping is computed from
+         *    the left and right eigenvectors of the root. An update that
+         *    leaves the bracket is replaced by a bisection step.
          */
-        /*virtual std::pair<bool, MAST::FlutterSolutionBase*>
-        newton_search(const MAST::FlutterSolutionBase& init_sol,
-                      const unsigned int root_num,
-                      const Real tol,
-                      const unsigned int max_iters);*/
+        virtual std::pair<bool, MAST::FlutterSolutionBase*>
+        _newton_search(const std::pair<MAST::FlutterSolutionBase*,
+                       MAST::FlutterSolutionBase*>& ref_sol_range,
+                       const unsigned int root_num,
+                       const Real g_tol,
+                       const unsigned int max_iters);
+        
+        
+        /*!
+         *   creates the solution at \p k_red and \p v_ref from the
+         *   eigensolution \p ges, and sorts the roots based on the provided
+         *   solution pointer. If the pointer is nullptr, then no sorting is
+         *   performed.
+         */
+        std::auto_ptr<MAST::FlutterSolutionBase>
+        _build_solution(const Real k_red,
+                        const Real v_ref,
+                        const RealMatrixX& stiff,
+                        const MAST::LAPACK_ZGGEV& ges,
+                        const MAST::FlutterSolutionBase* prev_sol);
         
         /*!
          *   performs an eigensolution at the specified reduced frequency, and
@@ -27,6 +27,7 @@
 #include "base/physics_discipline_base.h"
 #include "base/boundary_condition_base.h"
 #include "numerics/lapack_dggev_interface.h"
+#include "numerics/eigenpair_continuation.h"
 #include "base/parameter.h"
 #include "base/nonlinear_system.h"
 
@@ -165,15 +166,10 @@ MAST::TimeDomainFlutterSolver::find_next_root(const Real g_tol,
         if (!cross->root) {
             const unsigned int root_num = cross->root_num;
             std::pair<bool, MAST::FlutterSolutionBase*> sol;
-            // first try the Newton search. If that fails, then
-            // try the bisection search
-            /*sol = newton_search(*cross->crossover_solutions.second,
-                                root_num,
-                                g_tol,
-                                n_bisection_iters);
-            if (!sol.first)*/
-            sol =   _bisection_search(cross->crossover_solutions,
-                                      root_num, g_tol, n_bisection_iters);
+            // the Newton search takes a bisection step whenever its
+            // update leaves the bracket
+            sol =   _newton_search(cross->crossover_solutions,
+                                   root_num, g_tol, n_bisection_iters);
             
             cross->root = &(sol.second->get_root(root_num));
             
@@ -219,15 +215,10 @@ MAST::TimeDomainFlutterSolver::find_critical_root(const Real g_tol,
             
             const unsigned int root_num = cross->root_num;
             std::pair<bool, MAST::FlutterSolutionBase*> sol;
-            // first try the Newton search. If that fails, then
-            // try the bisection search
-            /*sol = newton_search(*cross->crossover_solutions.second,
-                                root_num,
-                                g_tol,
-                                n_bisection_iters);
-            if (!sol.first)*/
-            sol =   _bisection_search(cross->crossover_solutions,
-                                     root_num, g_tol, n_bisection_iters);
+            // the Newton search takes a bisection step whenever its
+            // update leaves the bracket
+            sol =   _newton_search(cross->crossover_solutions,
+                                   root_num, g_tol, n_bisection_iters);
             
             cross->root = &(sol.second->get_root(root_num));
             
@@ -636,6 +627,126 @@ _bisection_search(const std::pair<MAST::FlutterSolutionBase*,
 
 
 
+std::pair<bool, MAST::FlutterSolutionBase*>
+MAST::TimeDomainFlutterSolver::
+_newton_search(const std::pair<MAST::FlutterSolutionBase*,
+               MAST::FlutterSolutionBase*>& ref_sol_range,
+               const unsigned int root_num,
+               const Real g_tol,
+               const unsigned int max_iters) {
+    
+    // assumes that the upper V has +ve g val and lower V has -ve
+    // g val. The first iterate is the linear interpolation between the two.
+    Real
+    lower_V  = ref_sol_range.first->ref_val(),
+    lower_g  = ref_sol_range.first->get_root(root_num).root.real(),
+    upper_V  = ref_sol_range.second->ref_val(),
+    upper_g  = ref_sol_range.second->get_root(root_num).root.real(),
+    new_V    = lower_V +
+    (upper_V-lower_V)/(upper_g-lower_g)*(0.-lower_g),
+    dg_dV    = 0.;
+    unsigned int n_iters = 0;
+    
+    const unsigned int n = (unsigned int)_basis_vectors->size();
+    
+    // the mass matrix, which defines B, does not change with velocity
+    RealMatrixX
+    m      = RealMatrixX::Zero(n, n),
+    mat_B  = RealMatrixX::Zero(2*n, 2*n),
+    mat_A_sens,
+    mat_B_sens;
+    
+    std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
+    qty_map[MAST::MASS]       = &m;
+    
+    std::vector<const MAST::FunctionBase*> scan_params(1, _velocity_param);
+    _assemble_reduced_order_quantity(scan_params, qty_map);
+    
+    mat_B.topLeftCorner(n, n)      = RealMatrixX::Identity(n,n );
+    mat_B.bottomRightCorner(n, n)  = m;
+    
+    // the sensitivity of the steady solution with respect to velocity is
+    // not included in the derivative, which only affects the convergence
+    // rate and not the converged root
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    zero_sol_sens(_assembly->system().solution->zero_clone().release());
+    
+    libMesh::ParameterVector param_V;
+    param_V.resize(1);
+    param_V[0]  =  _velocity_param->ptr();
+    
+    Complex deig_dV = 0.;
+    
+    MAST::FlutterSolutionBase* new_sol = nullptr;
+    std::pair<bool, MAST::FlutterSolutionBase*> rval(false, nullptr);
+    
+    while (n_iters < max_iters) {
+        
+        new_sol  = _analyze(new_V, ref_sol_range.first).release();
+        
+        if (_output)
+            new_sol->print(*_output);
+        
+        // add the solution to this solver
+        bool if_success =
+        _flutter_solutions.insert(std::pair<Real, MAST::FlutterSolutionBase*>
+                                  (new_V, new_sol)).second;
+        
+        libmesh_assert(if_success);
+        
+        const MAST::FlutterRootBase& root = new_sol->get_root(root_num);
+        
+        // check if the new damping value
+        if (fabs(root.root.real()) <= g_tol) {
+            
+            rval.first = true;
+            rval.second = new_sol;
+            return  rval;
+        }
+        
+        // update the bracket
+        if (root.root.real() < 0.) {
+            
+            lower_V = new_V;
+            lower_g = root.root.real();
+        }
+        else {
+            
+            upper_V = new_V;
+            upper_g = root.root.real();
+        }
+        
+        // derivative of the eigenvalue from
+        //   dlambda/dV = [y^T (dA/dV - lambda dB/dV) x]/(y^T B x)
+        _initialize_matrix_sensitivity_for_param(param_V,
+                                                 0,
+                                                 *zero_sol_sens,
+                                                 new_V,
+                                                 mat_A_sens,
+                                                 mat_B_sens);
+        
+        deig_dV = root.eig_vec_left.dot((mat_A_sens.cast<Complex>() -
+                                         root.root*mat_B_sens.cast<Complex>())*root.eig_vec_right) /
+        root.eig_vec_left.dot(mat_B.cast<Complex>()*root.eig_vec_right);
+        dg_dV   = deig_dV.real();
+        
+        new_V   = _safeguarded_newton_update(new_V, root.root.real(), dg_dV,
+                                             lower_V, lower_g,
+                                             upper_V, upper_g);
+        
+        n_iters++;
+    }
+    
+    // return false, along with the latest sol
+    rval.first = false;
+    rval.second = new_sol;
+    
+    return rval;
+}
+
+
+
+
 std::auto_ptr<MAST::TimeDomainFlutterSolution>
 MAST::TimeDomainFlutterSolver::_analyze(const Real v_ref,
                                        const MAST::FlutterSolutionBase* prev_sol) {
@@ -653,12 +764,33 @@ MAST::TimeDomainFlutterSolver::_analyze(const Real v_ref,
     _initialize_matrices(v_ref, A, B);
     
     MAST::LAPACK_DGGEV ges;
-    ges.compute(A, B);
-    ges.scale_eigenvectors_to_identity_innerproduct();
+    
+    // follow the roots of the previous solution, if requested, so that
+    // they need not be sorted
+    MAST::EigenpairContinuation cont;
+    const bool
+    if_tracked = (_if_mode_tracking &&
+                  prev_sol &&
+                  _continue_eigensolution(A.cast<Complex>(),
+                                          B.cast<Complex>(),
+                                          *prev_sol,
+                                          cont));
+    
+    if (if_tracked)
+        ges.set_eigensolution(A, B,
+                              cont.eigenvalues(),
+                              RealVectorX::Ones(A.rows()),
+                              cont.left_eigenvectors(),
+                              cont.right_eigenvectors());
+    else {
+        
+        ges.compute(A, B);
+        ges.scale_eigenvectors_to_identity_innerproduct();
+    }
     
     MAST::TimeDomainFlutterSolution* root = new MAST::TimeDomainFlutterSolution;
     root->init(*this, v_ref, ges);
-    if (prev_sol)
+    if (prev_sol && !if_tracked)
         root->sort(*prev_sol);
     
     libMesh::out
@@ -727,8 +859,10 @@ MAST::TimeDomainFlutterSolver::_initialize_matrices(Real U_inf,
     qty_map[MAST::STIFFNESS]  = &k;
     
     
-    _assembly->assemble_reduced_order_quantity(*_basis_vectors,
-                                               qty_map);
+    // the mass matrix, and the stiffness and damping matrices without
+    // velocity dependent loads or steady solution, are computed only once
+    std::vector<const MAST::FunctionBase*> scan_params(1, _velocity_param);
+    _assemble_reduced_order_quantity(scan_params, qty_map);
     
     
     // put the matrices back in the system matrices
@@ -191,6 +191,21 @@ namespace MAST {
                           const unsigned int max_iters);
 
         
+        /*!
+         *    Newton search for the flutter velocity in the bracket
+         *    \p ref_sol_range. The derivative of the damping with respect
+         *    to velocity is computed from the left and right eigenvectors
+         *    of the root. An update that leaves the bracket is replaced by
+         *    a bisection step.
+         */
+        virtual std::pair<bool, MAST::FlutterSolutionBase*>
+        _newton_search(const std::pair<MAST::FlutterSolutionBase*,
+                       MAST::FlutterSolutionBase*>& ref_sol_range,
+                       const unsigned int root_num,
+                       const Real g_tol,
+                       const unsigned int max_iters);
+
+        
         /*!
          *    Assembles the reduced order system structural and aerodynmaic 
          *    matrices for specified flight velocity \par U_inf.
@@ -28,6 +28,7 @@
 #include "base/physics_discipline_base.h"
 #include "base/boundary_condition_base.h"
 #include "numerics/lapack_zggev_interface.h"
+#include "numerics/eigenpair_continuation.h"
 #include "base/parameter.h"
 #include "base/nonlinear_system.h"
 
@@ -174,15 +175,10 @@ MAST::UGFlutterSolver::find_next_root(const Real g_tol,
         if (!cross->root) {
             const unsigned int root_num = cross->root_num;
             std::pair<bool, MAST::FlutterSolutionBase*> sol;
-            // first try the Newton search. If that fails, then
-            // try the bisection search
-            /*sol = newton_search(*cross->crossover_solutions.second,
-             root_num,
-             g_tol,
-             n_bisection_iters);
-             if (!sol.first)*/
-            sol =   _bisection_search(cross->crossover_solutions,
-                                      root_num, g_tol, n_bisection_iters);
+            // the Newton search takes a bisection step whenever its
+            // update leaves the bracket
+            sol =   _newton_search(cross->crossover_solutions,
+                                   root_num, g_tol, n_bisection_iters);
             
             cross->root = &(sol.second->get_root(root_num));
             
@@ -227,15 +223,10 @@ MAST::UGFlutterSolver::find_critical_root(const Real g_tol,
             
             const unsigned int root_num = cross->root_num;
             std::pair<bool, MAST::FlutterSolutionBase*> sol;
-            // first try the Newton search. If that fails, then
-            // try the bisection search
-            /*sol = newton_search(*cross->crossover_solutions.second,
-             root_num,
-             g_tol,
-             n_bisection_iters);
-             if (!sol.first)*/
-            sol =   _bisection_search(cross->crossover_solutions,
-                                      root_num, g_tol, n_bisection_iters);
+            // the Newton search takes a bisection step whenever its
+            // update leaves the bracket
+            sol =   _newton_search(cross->crossover_solutions,
+                                   root_num, g_tol, n_bisection_iters);
             
             cross->root = &(sol.second->get_root(root_num));
             
@@ -275,14 +266,41 @@ MAST::UGFlutterSolver::scan_for_roots() {
         }
         k_vals[_n_kr_divs] = _kr_range.first; // to get around finite-precision arithmetic
         
+        libMesh::out
+        << " ====================================================" << std::endl
+        << "Eigensolution" << std::endl
+        << "   kr_ref = " << std::setw(10) << _kr_range.second
+        << " : " << std::setw(10) << _kr_range.first << std::endl;
+        
+        // the matrices are assembled for all reduced frequencies first,
+        // since the assembly is collective on the communicator. The
+        // eigensolutions are independent, and are computed in parallel
+        std::vector<ComplexMatrixX>
+        A(_n_kr_divs+1),
+        B(_n_kr_divs+1);
+        std::vector<MAST::LAPACK_ZGGEV> ges;
+        
+        for (unsigned int i=0; i< _n_kr_divs+1; i++)
+            _initialize_matrices(k_vals[i], A[i], B[i]);
+        
+        _compute_eigensolutions(A, B, ges);
+        
+        libMesh::out
+        << "Finished Eigensolution" << std::endl
+        << " ====================================================" << std::endl;
+        
+        // the roots are sorted in the order of the scan, so that the
+        // results do not depend on the number of processors or threads
         MAST::FlutterSolutionBase* prev_sol = nullptr;
         for (unsigned int i=0; i< _n_kr_divs+1; i++) {
             
             current_kr = k_vals[i];
-            std::auto_ptr<MAST::FlutterSolutionBase> sol =
-            _analyze(current_kr, prev_sol);
+            MAST::UGFlutterSolution* sol = new MAST::UGFlutterSolution;
+            sol->init(*this, current_kr, (*_bref_param)(), ges[i]);
+            if (prev_sol)
+                sol->sort(*prev_sol);
             
-            prev_sol = sol.get();
+            prev_sol = sol;
             
             if (_output)
                 sol->print(*_output);
@@ -290,7 +308,7 @@ MAST::UGFlutterSolver::scan_for_roots() {
             // add the solution to this solver
             bool if_success =
             _flutter_solutions.insert(std::pair<Real, MAST::FlutterSolutionBase*>
-                                      (current_kr, sol.release())).second;
+                                      (current_kr, sol)).second;
             
             libmesh_assert(if_success);
         }
@@ -482,6 +500,147 @@ _bisection_search(const std::pair<MAST::FlutterSolutionBase*,
 
 
 
+std::pair<bool, MAST::FlutterSolutionBase*>
+MAST::UGFlutterSolver::
+_newton_search(const std::pair<MAST::FlutterSolutionBase*,
+               MAST::FlutterSolutionBase*>& ref_sol_range,
+               const unsigned int root_num,
+               const Real g_tol,
+               const unsigned int max_iters) {
+    
+    // assumes that the upper kr has +ve g val and lower kr has -ve
+    // g val.
+    Real
+    lower_kr = ref_sol_range.first->get_root(root_num).kr,
+    lower_g  = ref_sol_range.first->get_root(root_num).g,
+    upper_kr = ref_sol_range.second->get_root(root_num).kr,
+    upper_g  = ref_sol_range.second->get_root(root_num).g,
+    new_kr   = 0.;
+    unsigned int n_iters = 0;
+    
+    if (ref_sol_range.first == ref_sol_range.second) {
+        
+        // there is no bracket, so start with a Newton update
+        const MAST::FlutterRootBase& root = ref_sol_range.first->get_root(root_num);
+        new_kr   = _safeguarded_newton_update(root.kr, root.g,
+                                              _damping_sensitivity_for_kr(root),
+                                              lower_kr, lower_g,
+                                              upper_kr, upper_g);
+        if (new_kr == root.kr)
+            return std::pair<bool, MAST::FlutterSolutionBase*>(false, ref_sol_range.first);
+    }
+    else
+        new_kr   = lower_kr +
+        (upper_kr-lower_kr)/(upper_g-lower_g)*(0.-lower_g); // linear interpolation
+    
+    MAST::FlutterSolutionBase* new_sol = nullptr;
+    std::pair<bool, MAST::FlutterSolutionBase*> rval(false, nullptr);
+    
+    while (n_iters < max_iters) {
+        
+        new_sol  = _analyze(new_kr, ref_sol_range.first).release();
+        
+        if (_output)
+            new_sol->print(*_output);
+        
+        // add the solution to this solver
+        bool if_success =
+        _flutter_solutions.insert(std::pair<Real, MAST::FlutterSolutionBase*>
+                                  (new_kr, new_sol)).second;
+        
+        libmesh_assert(if_success);
+        
+        const MAST::UGFlutterRoot& root =
+        dynamic_cast<const MAST::UGFlutterRoot&>(new_sol->get_root(root_num));
+        
+        // check if the new damping value
+        if (fabs(root.g) <= g_tol) {
+            
+            rval.first = true;
+            rval.second = new_sol;
+            return  rval;
+        }
+        
+        // update the bracket
+        if (root.g < 0.) {
+            
+            lower_kr = new_kr;
+            lower_g = root.g;
+        }
+        else {
+            
+            upper_kr = new_kr;
+            upper_g = root.g;
+        }
+        
+        new_kr   = _safeguarded_newton_update(new_kr, root.g,
+                                              _damping_sensitivity_for_kr(root),
+                                              lower_kr, lower_g,
+                                              upper_kr, upper_g);
+        
+        // no update is possible without a derivative or a bracket
+        if (new_kr == root.kr)
+            break;
+        
+        n_iters++;
+    }
+    
+    // return false, along with the latest sol
+    rval.first = false;
+    rval.second = new_sol;
+    
+    return rval;
+}
+
+
+
+
+Real
+MAST::UGFlutterSolver::_damping_sensitivity_for_kr(const MAST::FlutterRootBase& root) {
+    
+    // the derivative is not defined for roots with negative real part
+    if (root.if_nonphysical_root)
+        return 0.;
+    
+    const unsigned int n = (unsigned int)_basis_vectors->size();
+    
+    Complex
+    eig      = root.root,
+    deig_dkr = 0.,
+    den      = 0.;
+    
+    ComplexMatrixX
+    mat_A_sens,
+    mat_B_sens;
+    
+    // B is the stiffness matrix, which is usually retained by the base class
+    RealMatrixX
+    k      =  RealMatrixX::Zero(n, n);
+    
+    std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
+    qty_map[MAST::STIFFNESS]  = &k;
+    
+    (*_kr_param) = root.kr;
+    
+    std::vector<const MAST::FunctionBase*> scan_params(1, _kr_param);
+    _assemble_reduced_order_quantity(scan_params, qty_map);
+    
+    _initialize_matrix_sensitivity_for_kr(root.kr,
+                                          mat_A_sens,
+                                          mat_B_sens);
+    
+    den      = root.eig_vec_left.dot(k.cast<Complex>()*root.eig_vec_right);
+    deig_dkr = root.eig_vec_left.dot((mat_A_sens -
+                                      eig*mat_B_sens)*root.eig_vec_right)/den;
+    
+    // g =  im(eig)/re(eig)
+    return
+    deig_dkr.imag()/eig.real() - eig.imag()/pow(eig.real(),2) * deig_dkr.real();
+}
+
+
+
+
 std::auto_ptr<MAST::FlutterSolutionBase>
 MAST::UGFlutterSolver::_analyze(const Real kr_ref,
                                 const MAST::FlutterSolutionBase* prev_sol) {
@@ -499,12 +658,31 @@ MAST::UGFlutterSolver::_analyze(const Real kr_ref,
     _initialize_matrices(kr_ref, A, B);
     
     MAST::LAPACK_ZGGEV ges;
-    ges.compute(A, B);
-    ges.scale_eigenvectors_to_identity_innerproduct();
+    
+    // follow the roots of the previous solution, if requested, so that
+    // they need not be sorted
+    MAST::EigenpairContinuation cont;
+    const bool
+    if_tracked = (_if_mode_tracking &&
+                  prev_sol &&
+                  _continue_eigensolution(A, B, *prev_sol, cont));
+    
+    if (if_tracked)
+        ges.set_eigensolution(A, B,
+                              cont.eigenvalues(),
+                              ComplexVectorX::Ones(A.rows()),
+                              cont.left_eigenvectors(),
+                              cont.right_eigenvectors(),
+                              0);
+    else {
+        
+        ges.compute(A, B);
+        ges.scale_eigenvectors_to_identity_innerproduct();
+    }
     
     MAST::UGFlutterSolution* root = new MAST::UGFlutterSolution;
     root->init(*this, kr_ref, (*_bref_param)(), ges);
-    if (prev_sol)
+    if (prev_sol && !if_tracked)
         root->sort(*prev_sol);
     
     libMesh::out
@@ -549,7 +727,8 @@ MAST::UGFlutterSolver::_initialize_matrices(Real kr,
     // set the velocity value in the parameter that was provided
     (*_kr_param) = kr;
     
-    _assembly->assemble_reduced_order_quantity(*_basis_vectors, qty_map);
+    std::vector<const MAST::FunctionBase*> scan_params(1, _kr_param);
+    _assemble_reduced_order_quantity(scan_params, qty_map);
     
     dynamic_cast<MAST::FSIGeneralizedAeroForceAssembly*>(_assembly)->
     assemble_generalized_aerodynamic_force_matrix(*_basis_vectors, a);
@@ -649,8 +828,8 @@ _initialize_matrix_sensitivity_for_kr(Real kr,
     // set the velocity value in the parameter that was provided
     (*_kr_param) = kr;
     
-    _assembly->assemble_reduced_order_quantity(*_basis_vectors,
-                                               qty_map);
+    std::vector<const MAST::FunctionBase*> scan_params(1, _kr_param);
+    _assemble_reduced_order_quantity(scan_params, qty_map);
     
     dynamic_cast<MAST::FSIGeneralizedAeroForceAssembly*>(_assembly)->
     assemble_generalized_aerodynamic_force_matrix(*_basis_vectors, a, _kr_param);
@@ -177,6 +177,29 @@ namespace MAST {
                           const unsigned int max_iters);
         
         
+        /*!
+         *    Newton search for the flutter reduced frequency starting from
+         *    \p ref_sol_range. An update that leaves the bracket is
+         *    replaced by a bisection step. If both solutions in
+         *    \p ref_sol_range are the same, the search starts with a Newton
+         *    update from that solution.
+         */
+        virtual std::pair<bool, MAST::FlutterSolutionBase*>
+        _newton_search(const std::pair<MAST::FlutterSolutionBase*,
+                       MAST::FlutterSolutionBase*>& ref_sol_range,
+                       const unsigned int root_num,
+                       const Real g_tol,
+                       const unsigned int max_iters);
+        
+        
+        /*!
+         *    @returns the derivative of the damping of \p root with respect
+         *    to the reduced frequency, computed from the left and right
+         *    eigenvectors of the root.
+         */
+        Real _damping_sensitivity_for_kr(const MAST::FlutterRootBase& root);
+        
+        
         /*!
          *    Assembles the reduced order system structural and aerodynmaic
          *    matrices for specified reduced freq \par kr.
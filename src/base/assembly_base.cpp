@@ -17,6 +17,9 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <set>
+
 // MAST includes
 #include "base/assembly_base.h"
 #include "base/system_initialization.h"
@@ -24,18 +27,48 @@
 #include "base/elem_base.h"
 #include "base/physics_discipline_base.h"
 #include "base/nonlinear_system.h"
+#include "base/boundary_condition_base.h"
+#include "base/elem_dof_indices.h"
+#include "property_cards/element_property_card_base.h"
 
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
 #include "libmesh/dof_map.h"
 #include "libmesh/parameter_vector.h"
+#include "libmesh/boundary_info.h"
+#include "libmesh/elem.h"
+
+
+// adds to \p deps the parameters in \p param_ids that the frozen
+// function set \p set depends on
+void
+__mast_add_requested_dependencies
+(const MAST::FunctionSetBase& set,
+ const std::map<unsigned int, const MAST::FunctionBase*>& param_ids,
+ std::set<const MAST::FunctionBase*>& deps) {
+    
+    const std::vector<unsigned int>& ids = set.dependency_ids();
+    
+    std::map<unsigned int, const MAST::FunctionBase*>::const_iterator it;
+    
+    for (unsigned int i=0; i<ids.size(); i++) {
+        
+        it = param_ids.find(ids[i]);
+        if (it != param_ids.end())
+            deps.insert(it->second);
+    }
+}
+
 
 
 MAST::AssemblyBase::AssemblyBase():
 _discipline(nullptr),
 _system(nullptr),
-_sol_function(nullptr) {
+_sol_function(nullptr),
+_if_elem_cache(false),
+_elem_cache_n_dofs(0),
+_elem_cache_property_revision(0) {
     
 }
 
@@ -44,6 +77,7 @@ _sol_function(nullptr) {
 
 MAST::AssemblyBase::~AssemblyBase() {
     
+    this->clear_element_cache();
 }
 
 
@@ -112,6 +146,397 @@ MAST::AssemblyBase::_build_localized_vector(const libMesh::System& sys,
 
 
 
+void
+MAST::AssemblyBase::
+_localize_vector(const libMesh::System& sys,
+                 const libMesh::NumericVector<Real>& global,
+                 std::auto_ptr<libMesh::NumericVector<Real> >& local) {
+    
+    if (!local.get()                              ||
+        local->size()       != sys.n_dofs()       ||
+        local->local_size() != sys.n_local_dofs()) {
+        
+        local.reset(_build_localized_vector(sys, global).release());
+        return;
+    }
+    
+    global.localize(*local, sys.get_dof_map().get_send_list());
+}
+
+
+
+
+void
+MAST::AssemblyBase::set_element_cache(bool f) {
+    
+    if (f != _if_elem_cache)
+        this->clear_element_cache();
+    
+    _if_elem_cache = f;
+}
+
+
+
+void
+MAST::AssemblyBase::clear_element_cache() {
+    
+    std::map<const libMesh::Elem*, MAST::ElementBase*>::iterator
+    it  = _elem_cache.begin(),
+    end = _elem_cache.end();
+    
+    for ( ; it != end; it++)
+        delete it->second;
+    
+    _elem_cache.clear();
+    
+    std::map<const libMesh::Elem*, MAST::ElemDofIndices*>::iterator
+    d_it  = _elem_dof_cache.begin(),
+    d_end = _elem_dof_cache.end();
+    
+    for ( ; d_it != d_end; d_it++)
+        delete d_it->second;
+    
+    _elem_dof_cache.clear();
+    _elem_cache_n_dofs = 0;
+}
+
+
+
+void
+MAST::AssemblyBase::
+init_sensitivity_elem_index(const libMesh::ParameterVector& params) {
+    
+    libmesh_assert(_discipline);
+    libmesh_assert(_system);
+    
+    this->clear_sensitivity_elem_index();
+    
+    // the dependency checks below, and in the element sensitivity
+    // calculations, use the frozen dependency graphs
+    _discipline->freeze_dependencies();
+    
+    const libMesh::MeshBase& mesh = _system->system().get_mesh();
+    const libMesh::BoundaryInfo& binfo = *mesh.boundary_info;
+    
+    const MAST::VolumeBCMapType& vol_loads  = _discipline->volume_loads();
+    const MAST::SideBCMapType&   side_loads = _discipline->side_loads();
+    
+    // group the local elements by their subdomain, and by the boundary
+    // ids with side loads on their sides. This is done only once so
+    // that the cost of the parameter loop below scales with the number
+    // of subdomains and boundaries, and not with the number of elements.
+    std::map<libMesh::subdomain_id_type, std::vector<const libMesh::Elem*> >
+    subdomain_elems;
+    std::map<libMesh::boundary_id_type, std::vector<const libMesh::Elem*> >
+    boundary_elems;
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    mesh.active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    mesh.active_local_elements_end();
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        subdomain_elems[elem->subdomain_id()].push_back(elem);
+        
+        for (unsigned short int n=0; n<elem->n_sides(); n++) {
+            
+            if (!binfo.n_boundary_ids(elem, n))
+                continue;
+            
+            std::vector<libMesh::boundary_id_type> bc_ids =
+            binfo.boundary_ids(elem, n);
+            
+            for (unsigned int i=0; i<bc_ids.size(); i++)
+                if (side_loads.count(bc_ids[i]))
+                    boundary_elems[bc_ids[i]].push_back(elem);
+        }
+    }
+    
+    
+    // the requested parameters, keyed by their function id so that the
+    // parameters of a property card or load can be looked up from its
+    // frozen dependency list
+    std::map<unsigned int, const MAST::FunctionBase*> param_ids;
+    
+    // elements are keyed by their ids so that the order of assembly
+    // does not depend on the memory layout
+    std::map<const MAST::FunctionBase*,
+    std::map<libMesh::dof_id_type, const libMesh::Elem*> > dep_elems;
+    
+    for (unsigned int i=0; i<params.size(); i++) {
+        
+        const MAST::FunctionBase*
+        f = _discipline->get_parameter(&(params[i].get()));
+        
+        // shape parameters influence the element geometry, which is not
+        // identified by the dependence of properties and loads. Hence,
+        // these are left out of the index.
+        if (f->is_shape_parameter())
+            continue;
+        
+        param_ids[f->id()] = f;
+        dep_elems[f];
+    }
+    
+    // the loop is over the subdomains and boundaries, and each property
+    // card and load enumerates the requested parameters that it depends
+    // on. This keeps the cost linear in the number of elements when each
+    // element has its own property card and parameter.
+    std::set<const MAST::FunctionBase*> deps;
+    
+    // elements whose property card or volume loads depend on a parameter
+    std::map<libMesh::subdomain_id_type, std::vector<const libMesh::Elem*> >::const_iterator
+    s_it  = subdomain_elems.begin(),
+    s_end = subdomain_elems.end();
+    
+    for ( ; s_it != s_end; s_it++) {
+        
+        deps.clear();
+        
+        __mast_add_requested_dependencies
+        (_discipline->get_property_card(s_it->first), param_ids, deps);
+        
+        std::pair<MAST::VolumeBCMapType::const_iterator,
+        MAST::VolumeBCMapType::const_iterator>
+        v_it = vol_loads.equal_range(s_it->first);
+        
+        for ( ; v_it.first != v_it.second; v_it.first++)
+            __mast_add_requested_dependencies(*v_it.first->second, param_ids, deps);
+        
+        std::set<const MAST::FunctionBase*>::const_iterator
+        d_it  = deps.begin(),
+        d_end = deps.end();
+        
+        for ( ; d_it != d_end; d_it++) {
+            
+            std::map<libMesh::dof_id_type, const libMesh::Elem*>&
+            elems = dep_elems[*d_it];
+            
+            for (unsigned int j=0; j<s_it->second.size(); j++)
+                elems[s_it->second[j]->id()] = s_it->second[j];
+        }
+    }
+    
+    // elements with a side on a boundary whose loads depend on a parameter
+    std::map<libMesh::boundary_id_type, std::vector<const libMesh::Elem*> >::const_iterator
+    b_it  = boundary_elems.begin(),
+    b_end = boundary_elems.end();
+    
+    for ( ; b_it != b_end; b_it++) {
+        
+        deps.clear();
+        
+        std::pair<MAST::SideBCMapType::const_iterator,
+        MAST::SideBCMapType::const_iterator>
+        l_it = side_loads.equal_range(b_it->first);
+        
+        for ( ; l_it.first != l_it.second; l_it.first++)
+            __mast_add_requested_dependencies(*l_it.first->second, param_ids, deps);
+        
+        std::set<const MAST::FunctionBase*>::const_iterator
+        d_it  = deps.begin(),
+        d_end = deps.end();
+        
+        for ( ; d_it != d_end; d_it++) {
+            
+            std::map<libMesh::dof_id_type, const libMesh::Elem*>&
+            elems = dep_elems[*d_it];
+            
+            for (unsigned int j=0; j<b_it->second.size(); j++)
+                elems[b_it->second[j]->id()] = b_it->second[j];
+        }
+    }
+    
+    // now copy the element lists to the index
+    std::map<const MAST::FunctionBase*,
+    std::map<libMesh::dof_id_type, const libMesh::Elem*> >::const_iterator
+    p_it  = dep_elems.begin(),
+    p_end = dep_elems.end();
+    
+    for ( ; p_it != p_end; p_it++) {
+        
+        std::vector<const libMesh::Elem*>&
+        elems = _sensitivity_elem_index[p_it->first];
+        elems.clear();
+        elems.reserve(p_it->second.size());
+        
+        std::map<libMesh::dof_id_type, const libMesh::Elem*>::const_iterator
+        e_it  = p_it->second.begin(),
+        e_end = p_it->second.end();
+        
+        for ( ; e_it != e_end; e_it++)
+            elems.push_back(e_it->second);
+    }
+}
+
+
+
+void
+MAST::AssemblyBase::clear_sensitivity_elem_index() {
+    
+    _sensitivity_elem_index.clear();
+}
+
+
+
+MAST::ElemDofIndices&
+MAST::AssemblyBase::_get_elem_dofs(const libMesh::Elem& elem,
+                                   MAST::ElemDofIndices& elem_dofs) {
+    
+    const libMesh::DofMap& dof_map = _system->system().get_dof_map();
+    
+    if (!_if_elem_cache) {
+        
+        elem_dofs.reinit(dof_map, elem);
+        return elem_dofs;
+    }
+    
+    this->_validate_element_cache();
+    
+    std::map<const libMesh::Elem*, MAST::ElemDofIndices*>::iterator
+    it = _elem_dof_cache.find(&elem);
+    
+    if (it == _elem_dof_cache.end()) {
+        
+        it = _elem_dof_cache.insert
+        (std::pair<const libMesh::Elem*, MAST::ElemDofIndices*>
+         (&elem, new MAST::ElemDofIndices)).first;
+        it->second->reinit(dof_map, elem);
+    }
+    
+    return *it->second;
+}
+
+
+
+
+const std::vector<const libMesh::Elem*>&
+MAST::AssemblyBase::
+_sensitivity_elems(const MAST::FunctionBase& f,
+                   std::vector<const libMesh::Elem*>& local_elems) const {
+    
+    std::map<const MAST::FunctionBase*, std::vector<const libMesh::Elem*> >::const_iterator
+    it = _sensitivity_elem_index.find(&f);
+    
+    if (it != _sensitivity_elem_index.end())
+        return it->second;
+    
+    // parameter is not in the index, so all local elements are returned
+    return _local_elems(local_elems);
+}
+
+
+
+const std::vector<const libMesh::Elem*>&
+MAST::AssemblyBase::
+_local_elems(std::vector<const libMesh::Elem*>& local_elems) const {
+    
+    if (!local_elems.empty())
+        return local_elems;
+    
+    const libMesh::MeshBase& mesh = _system->system().get_mesh();
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    mesh.active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    mesh.active_local_elements_end();
+    
+    for ( ; el != end_el; ++el)
+        local_elems.push_back(*el);
+    
+    return local_elems;
+}
+
+
+
+void
+MAST::AssemblyBase::_validate_element_cache() {
+    
+    // a change in the number of dofs implies that the mesh has changed,
+    // and a new property revision that the elements may refer to property
+    // cards that are no longer assigned. In both cases the elements and
+    // dof indices stored so far are no longer valid.
+    const libMesh::dof_id_type n_dofs = _system->system().n_dofs();
+    const unsigned int revision = _discipline->property_revision();
+    
+    if (n_dofs != _elem_cache_n_dofs ||
+        revision != _elem_cache_property_revision) {
+        
+        this->clear_element_cache();
+        _elem_cache_n_dofs            = n_dofs;
+        _elem_cache_property_revision = revision;
+    }
+}
+
+
+
+void
+MAST::AssemblyBase::_fill_element_cache() {
+    
+    if (!_if_elem_cache)
+        return;
+    
+    this->_validate_element_cache();
+    
+    const libMesh::MeshBase& mesh = _system->system().get_mesh();
+    const libMesh::DofMap& dof_map = _system->system().get_dof_map();
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    mesh.active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    mesh.active_local_elements_end();
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        if (!_elem_dof_cache.count(elem)) {
+            
+            MAST::ElemDofIndices* dofs = new MAST::ElemDofIndices;
+            dofs->reinit(dof_map, *elem);
+            _elem_dof_cache[elem] = dofs;
+        }
+        
+        if (!_elem_cache.count(elem))
+            _elem_cache[elem] = _build_elem(*elem).release();
+    }
+}
+
+
+
+MAST::ElementBase*
+MAST::AssemblyBase::_get_elem(const libMesh::Elem& elem,
+                              std::auto_ptr<MAST::ElementBase>& elem_owner) {
+    
+    if (!_if_elem_cache) {
+        
+        elem_owner.reset(_build_elem(elem).release());
+        return elem_owner.get();
+    }
+    
+    this->_validate_element_cache();
+    
+    std::map<const libMesh::Elem*, MAST::ElementBase*>::iterator
+    it = _elem_cache.find(&elem);
+    
+    if (it == _elem_cache.end())
+        it = _elem_cache.insert
+        (std::pair<const libMesh::Elem*, MAST::ElementBase*>
+         (&elem, _build_elem(elem).release())).first;
+    
+    // the solutions and the sensitivity parameter may have been set in a
+    // previous assembly pass
+    it->second->clear_state();
+    
+    return it->second;
+}
+
+
+
+
 void
 MAST::AssemblyBase::attach_solution_function(MAST::MeshFieldFunction& f){
     
@@ -139,12 +564,11 @@ MAST::AssemblyBase::calculate_outputs(const libMesh::NumericVector<Real>& X) {
     
     // iterate over each element, initialize it and get the relevant
     // analysis quantities
-    RealVectorX vec, sol;
-    RealMatrixX mat;
+    RealVectorX sol;
     
-    std::vector<libMesh::dof_id_type> dof_indices;
-    const libMesh::DofMap& dof_map = sys.get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    MAST::ElemDofIndices elem_dofs;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     std::auto_ptr<libMesh::NumericVector<Real> > localized_solution;
     localized_solution.reset(_build_localized_vector(sys, X).release());
@@ -165,18 +589,12 @@ MAST::AssemblyBase::calculate_outputs(const libMesh::NumericVector<Real>& X) {
         
         const libMesh::Elem* elem = *el;
         
-        dof_map.dof_indices (elem, dof_indices);
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
-        vec.setZero(ndofs);
-        mat.setZero(ndofs, ndofs);
-        
-        for (unsigned int i=0; i<dof_indices.size(); i++)
-            sol(i) = (*localized_solution)(dof_indices[i]);
+        dofs.gather(*localized_solution, sol);
         
         physics_elem->set_solution(sol);
         
@@ -216,8 +634,10 @@ calculate_output_sensitivity(libMesh::ParameterVector &params,
     RealMatrixX mat;
     
     std::vector<libMesh::dof_id_type> dof_indices;
+    std::vector<const libMesh::Elem*> local_elems;
     const libMesh::DofMap& dof_map = sys.get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     std::auto_ptr<libMesh::NumericVector<Real> >
     localized_solution,
@@ -238,19 +658,26 @@ calculate_output_sensitivity(libMesh::ParameterVector &params,
             (_build_localized_vector(sys,
                                      sys.get_sensitivity_solution(i)).release());
     
-        libMesh::MeshBase::const_element_iterator       el     =
-        sys.get_mesh().active_local_elements_begin();
-        const libMesh::MeshBase::const_element_iterator end_el =
-        sys.get_mesh().active_local_elements_end();
+        const MAST::FunctionBase*
+        f = _discipline->get_parameter(&(params[i].get()));
         
+        // the solution sensitivity is nonzero on all elements, so only the
+        // partial sensitivity can be limited to the elements that depend
+        // on f. All elements are visited if none depend on f so that the
+        // outputs still record a zero sensitivity for f.
+        const std::vector<const libMesh::Elem*>*
+        elems = &_sensitivity_elems(*f, local_elems);
         
-        for ( ; el != end_el; ++el) {
+        if (if_total_sensitivity || elems->empty())
+            elems = &_local_elems(local_elems);
+        
+        for (unsigned int j=0; j<elems->size(); j++) {
             
-            const libMesh::Elem* elem = *el;
+            const libMesh::Elem* elem = (*elems)[j];
             
             dof_map.dof_indices (elem, dof_indices);
             
-            physics_elem.reset(_build_elem(*elem).release());
+            physics_elem = _get_elem(*elem, elem_owner);
             
             // get the solution
             unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -260,8 +687,7 @@ calculate_output_sensitivity(libMesh::ParameterVector &params,
             mat.setZero(ndofs, ndofs);
 
             // tell the element about the sensitivity paramete
-            physics_elem->sensitivity_param =
-            _discipline->get_parameter(&(params[i].get()));
+            physics_elem->sensitivity_param = f;
             
             // get the solution
             for (unsigned int i=0; i<dof_indices.size(); i++)
@@ -299,6 +725,19 @@ calculate_output_sensitivity(libMesh::ParameterVector &params,
 
 
 
+void
+MAST::AssemblyBase::
+calculate_output_derivative(const libMesh::NumericVector<Real>& X,
+                            MAST::OutputFunctionBase& output,
+                            libMesh::NumericVector<Real>& dq_dX) {
+    
+    // must be implemented in derived classes for the supported outputs
+    libmesh_error();
+}
+
+
+
+
 void
 MAST::AssemblyBase::
 _elem_outputs(MAST::ElementBase &elem,
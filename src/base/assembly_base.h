@@ -23,6 +23,7 @@
 // C++ includes
 #include <map>
 #include <memory>
+#include <vector>
 
 
 // MAST includes
@@ -41,6 +42,8 @@ namespace MAST {
     class OutputFunctionBase;
     class MeshFieldFunction;
     class NonlinearSystem;
+    class FunctionBase;
+    class ElemDofIndices;
     
     class AssemblyBase {
     public:
@@ -145,8 +148,136 @@ namespace MAST {
                                           const libMesh::NumericVector<Real>& X);
 
         
+        /*!
+         *   assembles the derivative of \p output with respect to the
+         *   solution about \p X in \p dq_dX, which serves as the right-hand
+         *   side of the adjoint problem. The derived classes implement this
+         *   for the outputs that they support.
+         */
+        virtual void
+        calculate_output_derivative(const libMesh::NumericVector<Real>& X,
+                                    MAST::OutputFunctionBase& output,
+                                    libMesh::NumericVector<Real>& dq_dX);
+        
+        
+        /*!
+         *   tells the assembly to retain the element objects, along with
+         *   their finite element and quadrature data, and the element dof
+         *   indices created during an assembly pass so that they can be
+         *   reused in subsequent passes. This is false by default.
+         *   Changing this flag clears the element cache. The cache is used
+         *   by the element loops of NonlinearImplicitAssembly and
+         *   TransientAssembly, and their derived classes, while the
+         *   eigenproblem and complex assemblies build their elements in
+         *   each pass. The cache is not thread-safe. The threaded assembly
+         *   fills it before the threads are started, and the threads only
+         *   read it.
+         */
+        void set_element_cache(bool f);
+        
+        
+        /*!
+         *   @returns true if the element cache is enabled
+         */
+        bool if_element_cache() const {
+            return _if_elem_cache;
+        }
+        
+        
+        /*!
+         *   deletes the cached elements and dof indices. The cache is
+         *   cleared automatically if the number of system dofs changes, or
+         *   if a property card is assigned to a subdomain of the discipline.
+         *   The user must call this if the mesh or the dof constraints are
+         *   otherwise modified after an assembly pass with the cache
+         *   enabled.
+         */
+        void clear_element_cache();
+        
+        
+        /*!
+         *   identifies the local elements whose property cards, volume
+         *   loads or side loads depend on each of the parameters in
+         *   \p params. Thereafter, the sensitivity assembly and the
+         *   partial sensitivity of outputs with respect to any of these
+         *   parameters are computed only on the dependent elements, while
+         *   all local elements are visited for other parameters. The user
+         *   must rebuild the index if the mesh, the properties or the loads
+         *   are modified.
+         */
+        void init_sensitivity_elem_index(const libMesh::ParameterVector& params);
+        
+        
+        /*!
+         *   clears the parameter to element dependency index
+         */
+        void clear_sensitivity_elem_index();
+        
+        
     protected:
         
+        /*!
+         *   clears the element cache if the mesh or the property cards
+         *   have changed since it was populated
+         */
+        void _validate_element_cache();
+        
+        
+        /*!
+         *   if the element cache is enabled, builds the element objects and
+         *   dof indices of all active local elements that are not already
+         *   in the cache. Thereafter, _get_elem() and _get_elem_dofs() only
+         *   read the cache, and can be called concurrently for different
+         *   elements during threaded assembly.
+         */
+        void _fill_element_cache();
+        
+        
+        /*!
+         *   @returns a pointer to the element object for \p elem. If the
+         *   element cache is enabled, the object is obtained from the cache,
+         *   and is built and added to the cache if not already present.
+         *   Otherwise, a new element is built and its ownership is
+         *   transferred to \p elem_owner. The cache is not thread-safe,
+         *   so concurrent calls require a cache filled with
+         *   _fill_element_cache().
+         */
+        MAST::ElementBase*
+        _get_elem(const libMesh::Elem& elem,
+                  std::auto_ptr<MAST::ElementBase>& elem_owner);
+        
+        
+        /*!
+         *   @returns a reference to the dof indices of \p elem. If the
+         *   element cache is enabled, the indices are obtained from the
+         *   cache, and are computed and added to the cache if not already
+         *   present. Otherwise, \p elem_dofs is initialized for \p elem
+         *   and returned. The same restriction on concurrent calls as for
+         *   _get_elem() applies.
+         */
+        MAST::ElemDofIndices&
+        _get_elem_dofs(const libMesh::Elem& elem,
+                       MAST::ElemDofIndices& elem_dofs);
+        
+        
+        /*!
+         *   @returns a reference to the local elements that depend on \p f
+         *   if \p f is included in the sensitivity element index. Otherwise,
+         *   all active local elements are returned through \p local_elems.
+         */
+        const std::vector<const libMesh::Elem*>&
+        _sensitivity_elems(const MAST::FunctionBase& f,
+                           std::vector<const libMesh::Elem*>& local_elems) const;
+        
+        
+        /*!
+         *   fills \p local_elems with the active local elements, if it is
+         *   empty, and returns a reference to it.
+         */
+        const std::vector<const libMesh::Elem*>&
+        _local_elems(std::vector<const libMesh::Elem*>& local_elems) const;
+        
+        
         /*!
          *   @returns a smart-pointer to a newly created element for
          *   calculation of element quantities.
@@ -164,6 +295,18 @@ namespace MAST {
                                 const libMesh::NumericVector<Real>& global);
         
         
+        /*!
+         *   localizes \p global to \p local, which is built using
+         *   _build_localized_vector() if it is null or does not match the
+         *   dof distribution of \p sys. Otherwise, the storage of
+         *   \p local is reused.
+         */
+        void
+        _localize_vector(const libMesh::System& sys,
+                         const libMesh::NumericVector<Real>& global,
+                         std::auto_ptr<libMesh::NumericVector<Real> >& local);
+        
+        
         
         /*!
          *   assembles the outputs for this element
@@ -197,6 +340,41 @@ namespace MAST {
          *   system solution that will be initialized before each solution
          */
         MAST::MeshFieldFunction* _sol_function;
+        
+        /*!
+         *   flag to retain elements across assembly passes
+         */
+        bool _if_elem_cache;
+        
+        /*!
+         *   number of system dofs when the element cache was populated.
+         *   This is used to detect changes to the mesh.
+         */
+        libMesh::dof_id_type _elem_cache_n_dofs;
+        
+        /*!
+         *   property revision of the discipline when the element cache was
+         *   populated. This is used to detect reassigned property cards.
+         */
+        unsigned int _elem_cache_property_revision;
+        
+        /*!
+         *   map of elements retained for reuse across assembly passes
+         */
+        std::map<const libMesh::Elem*, MAST::ElementBase*> _elem_cache;
+        
+        /*!
+         *   map of element dof indices retained for reuse across assembly
+         *   passes
+         */
+        std::map<const libMesh::Elem*, MAST::ElemDofIndices*> _elem_dof_cache;
+        
+        /*!
+         *   map of sensitivity parameter and the local elements that
+         *   depend on it
+         */
+        std::map<const MAST::FunctionBase*, std::vector<const libMesh::Elem*> >
+        _sensitivity_elem_index;
     };
         
 }
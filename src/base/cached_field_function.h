@@ -0,0 +1,303 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__cached_field_function__
+#define __mast__cached_field_function__
+
+// C++ includes
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <set>
+
+
+// MAST includes
+#include "base/field_function_base.h"
+#include "base/parameter.h"
+
+
+// libMesh includes
+#include "libmesh/threads.h"
+
+
+namespace MAST {
+    
+    /*!
+     *    Wraps a field function and stores its value if the function is
+     *    constant in space and time. The stored value is reused until one of
+     *    the parameters in the dependency graph of the function changes
+     *    value, at which point it is recomputed on the next call. Functions
+     *    that are not constant are evaluated by the wrapped function on
+     *    each call. Derivatives are always evaluated by the wrapped function.
+     *
+     *    The stored value is read without locking, and is validated by a
+     *    version counter that is odd while the value is being updated. A
+     *    read that overlaps an update is repeated under the lock. The
+     *    updates are serialized, and the new value is computed before the
+     *    update starts and copied into the stored value, which is not
+     *    reallocated as long as its size does not change.
+     */
+    template <typename ValType>
+    class CachedFieldFunction:
+    public MAST::FieldFunction<ValType> {
+        
+    public:
+        
+        /*!
+         *   takes ownership of \p f
+         */
+        CachedFieldFunction(std::auto_ptr<MAST::FieldFunction<ValType> > f):
+        MAST::FieldFunction<ValType>(f->name()),
+        _f(f.release()),
+        _if_constant(false),
+        _if_cached(false),
+        _version(0) {
+            
+            this->_functions.insert(_f);
+            this->_is_composite = true;
+            
+            _if_constant = (_f->is_spatially_constant() &&
+                            _f->is_temporally_constant());
+            
+            if (_if_constant) {
+                
+                std::set<const MAST::Parameter*> params;
+                _f->parameter_dependencies(params);
+                _params.assign(params.begin(), params.end());
+                _param_values.resize(_params.size(), 0.);
+            }
+        }
+        
+        
+        virtual ~CachedFieldFunction() {
+            
+            delete _f;
+        }
+        
+        
+        /*!
+         *   @returns true if the value of the wrapped function is cached
+         */
+        bool if_constant() const {
+            return _if_constant;
+        }
+        
+        
+        /*!
+         *   @returns a reference to the wrapped function
+         */
+        const MAST::FieldFunction<ValType>& function() const {
+            return *_f;
+        }
+        
+        
+        /*!
+         *   clears the stored value, so that it is recomputed on the
+         *   next call
+         */
+        void clear() {
+            
+            libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+            
+            _begin_update();
+            _if_cached.store(false, std::memory_order_relaxed);
+            _end_update();
+        }
+        
+        
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 ValType& v) const {
+            
+            if (_if_constant)
+                _cached_value(v);
+            else
+                (*_f)(p, t, v);
+        }
+        
+        
+        virtual void operator() (const std::vector<libMesh::Point>& p,
+                                 const Real t,
+                                 std::vector<ValType>& v) const {
+            
+            if (!_if_constant) {
+                
+                (*_f)(p, t, v);
+                return;
+            }
+            
+            v.resize(p.size());
+            
+            if (p.empty())
+                return;
+            
+            _cached_value(v[0]);
+            for (unsigned int i=1; i<p.size(); i++)
+                v[i] = v[0];
+        }
+        
+        
+        virtual void derivative (const MAST::FunctionBase& f,
+                                 const libMesh::Point& p,
+                                 const Real t,
+                                 ValType& v) const {
+            
+            _f->derivative(f, p, t, v);
+        }
+        
+        
+        virtual void derivative (const MAST::FunctionBase& f,
+                                 const std::vector<libMesh::Point>& p,
+                                 const Real t,
+                                 std::vector<ValType>& v) const {
+            
+            _f->derivative(f, p, t, v);
+        }
+        
+        
+    protected:
+        
+        /*!
+         *   copies the stored value into \p v after recomputing it if
+         *   any parameter value has changed since the last evaluation
+         */
+        void _cached_value(ValType& v) const {
+            
+            // the stored value is read without locking if no update is in
+            // progress, and the read is accepted only if no update started
+            // during the read. This way concurrent evaluations during
+            // threaded assembly do not wait for each other.
+            const unsigned int
+            version = _version.load(std::memory_order_acquire);
+            
+            if (!(version & 1) &&
+                _if_cached.load(std::memory_order_relaxed) &&
+                !_if_parameters_changed()) {
+                
+                v = _value;
+                
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (_version.load(std::memory_order_relaxed) == version)
+                    return;
+            }
+            
+            libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+            
+            // another thread may have updated the value in the meantime
+            if (!_if_cached.load(std::memory_order_relaxed) ||
+                _if_parameters_changed()) {
+                
+                // the new value is computed before the update starts, so
+                // that readers are invalidated only while it is copied
+                ValType val;
+                (*_f)(libMesh::Point(), 0., val);
+                
+                _begin_update();
+                
+                for (unsigned int i=0; i<_params.size(); i++)
+                    _param_values[i] = (*_params[i])();
+                _value = val;
+                _if_cached.store(true, std::memory_order_relaxed);
+                
+                _end_update();
+            }
+            
+            v = _value;
+        }
+        
+        
+        /*!
+         *   marks the start of an update of the stored data. Must be
+         *   called with the lock held.
+         */
+        void _begin_update() const {
+            
+            _version.store(_version.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        
+        
+        /*!
+         *   marks the end of an update of the stored data. Must be called
+         *   with the lock held.
+         */
+        void _end_update() const {
+            
+            _version.store(_version.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_release);
+        }
+        
+        
+        /*!
+         *   @returns true if the value of any parameter differs from its
+         *   value when \p _value was computed
+         */
+        bool _if_parameters_changed() const {
+            
+            for (unsigned int i=0; i<_params.size(); i++)
+                if ((*_params[i])() != _param_values[i])
+                    return true;
+            
+            return false;
+        }
+        
+        
+        /*!
+         *   the wrapped function
+         */
+        MAST::FieldFunction<ValType>* _f;
+        
+        /*!
+         *   true if the wrapped function is constant in space and time
+         */
+        bool _if_constant;
+        
+        /*!
+         *   true if \p _value has been computed
+         */
+        mutable std::atomic<bool> _if_cached;
+        
+        /*!
+         *   incremented at the start and end of each update of the stored
+         *   data, so that it is odd while an update is in progress
+         */
+        mutable std::atomic<unsigned int> _version;
+        
+        /*!
+         *   parameters that the wrapped function depends on, and their
+         *   values at the time \p _value was computed
+         */
+        std::vector<const MAST::Parameter*> _params;
+        mutable std::vector<Real> _param_values;
+        
+        /*!
+         *   stored value of the wrapped function
+         */
+        mutable ValType _value;
+        
+        /*!
+         *   serializes the updates of the stored value
+         */
+        mutable libMesh::Threads::spin_mutex _mutex;
+    };
+}
+
+
+#endif // __mast__cached_field_function__
@@ -106,6 +106,9 @@ clear_discipline_and_system( ) {
     
     _complex_solver->clear_assembly();
     
+    this->clear_element_cache();
+    this->clear_sensitivity_elem_index();
+    
     _if_assemble_real     = true;
     _complex_solver       = nullptr;
     _discipline           = nullptr;
@@ -641,6 +644,33 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
                                libMesh::NonlinearImplicitSystem& S,
                                MAST::Parameter* p) {
 
+    _assemble_blocked(X, R, &J, S, p);
+}
+
+
+
+
+void
+MAST::ComplexAssemblyBase::
+residual_blocked (const libMesh::NumericVector<Real>& X,
+                  libMesh::NumericVector<Real>& R,
+                  libMesh::NonlinearImplicitSystem& S,
+                  MAST::Parameter* p) {
+    
+    _assemble_blocked(X, R, nullptr, S, p);
+}
+
+
+
+
+void
+MAST::ComplexAssemblyBase::
+_assemble_blocked (const libMesh::NumericVector<Real>& X,
+                   libMesh::NumericVector<Real>& R,
+                   libMesh::SparseMatrix<Real>*  J,
+                   libMesh::NonlinearImplicitSystem& S,
+                   MAST::Parameter* p) {
+
     START_LOG("residual_and_jacobian()", "ComplexSolve");
     
     MAST::NonlinearSystem& nonlin_sys = _system->system();
@@ -650,7 +680,7 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
     libmesh_assert_equal_to(&S, &(nonlin_sys));
     
     R.zero();
-    J.zero();
+    if (J) J->zero();
     
     // iterate over each element, initialize it and get the relevant
     // analysis quantities
@@ -663,9 +693,11 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
     mat,
     dummy;
 
-    // get the petsc vector and matrix objects
+    // get the petsc matrix object, if the Jacobian was requested
     Mat
-    jac_bmat = dynamic_cast<libMesh::PetscMatrix<Real>&>(J).mat();
+    jac_bmat = nullptr;
+    if (J)
+        jac_bmat = dynamic_cast<libMesh::PetscMatrix<Real>*>(J)->mat();
     
     PetscInt ierr;
     
@@ -755,7 +787,7 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
         
         
         // perform the element level calculations
-        _elem_calculations(*physics_elem, true, vec, mat);
+        _elem_calculations(*physics_elem, J != nullptr, vec, mat);
         
         // if sensitivity was requested, then ask the element for sensitivity
         // of the residual
@@ -802,6 +834,9 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
             R.add(2*dof_indices[i],     v_R(i));
             R.add(2*dof_indices[i]+1,   v_I(i));
             
+            if (!J)
+                continue;
+            
             for (unsigned int j=0; j<dof_indices.size(); j++) {
                 vals[0] = m_R (i,j);
                 vals[1] = m_I1(i,j);
@@ -822,7 +857,7 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
     //    _sol_function->clear();
     
     R.close();
-    J.close();
+    if (J) J->close();
     
     libMesh::out << "R: " << R.l2_norm() << std::endl;
     STOP_LOG("residual_and_jacobian()", "ComplexSolve");
@@ -182,6 +182,19 @@ namespace MAST {
                                        libMesh::NonlinearImplicitSystem& S,
                                        MAST::Parameter* p = nullptr);
 
+        /*!
+         *   Assembles only the residual of the blocked complex system. This
+         *   is used when the Jacobian is already available from a previous
+         *   call to residual_and_jacobian_blocked() and only a new right-hand
+         *   side is needed, for example when the same operator is solved
+         *   for multiple excitations.
+         */
+        void
+        residual_blocked (const libMesh::NumericVector<Real>& X,
+                          libMesh::NumericVector<Real>& R,
+                          libMesh::NonlinearImplicitSystem& S,
+                          MAST::Parameter* p = nullptr);
+
         /**
          * Assembly function.  This function will be called
          * to assemble the RHS of the sensitivity equations (which is -1 times
@@ -200,6 +213,17 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   implements residual_and_jacobian_blocked() and residual_blocked().
+         *   The Jacobian is assembled only if \par J is non-null.
+         */
+        void
+        _assemble_blocked (const libMesh::NumericVector<Real>& X,
+                           libMesh::NumericVector<Real>& R,
+                           libMesh::SparseMatrix<Real>*  J,
+                           libMesh::NonlinearImplicitSystem& S,
+                           MAST::Parameter* p);
+        
         /*!
          *   performs the element calculations over \par elem, and returns
          *   the element vector and matrix quantities in \par mat and
@@ -30,6 +30,7 @@ MAST::FieldFunction<Real>(nm),
 _p(p) {
     
     _functions.insert(&p);
+    _is_composite = true;
 }
 
 
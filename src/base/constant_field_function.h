@@ -41,6 +41,10 @@ namespace MAST {
         virtual ~ConstantFieldFunction();
 
         
+        using MAST::FieldFunction<Real>::operator();
+        using MAST::FieldFunction<Real>::derivative;
+        
+        
         /*!
          *    calculates the value of the function at the specified point,
          *    \par p, and time, \par t, and returns it in \p v.
@@ -76,7 +80,6 @@ namespace MAST {
                                  Real& v) const;
 
         
-        
     protected:
 
         /*!
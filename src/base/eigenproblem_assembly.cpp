@@ -98,6 +98,9 @@ clear_discipline_and_system( ) {
         sys.reset_eigenproblem_assemble_object();
     }
     
+    this->clear_element_cache();
+    this->clear_sensitivity_elem_index();
+    
     _discipline           = nullptr;
     _system               = nullptr;
     _base_sol             = nullptr;
@@ -61,6 +61,30 @@ MAST::ElementBase::sol(bool if_sens) const {
 }
 
 
+void
+MAST::ElementBase::clear_state() {
+    
+    sensitivity_param    = nullptr;
+    _active_sol_function = nullptr;
+    
+    _sol.resize(0);
+    _sol_sens.resize(0);
+    _complex_sol.resize(0);
+    _complex_sol_sens.resize(0);
+    _delta_sol.resize(0);
+    _delta_sol_sens.resize(0);
+    _vel.resize(0);
+    _vel_sens.resize(0);
+    _delta_vel.resize(0);
+    _delta_vel_sens.resize(0);
+    _accel.resize(0);
+    _accel_sens.resize(0);
+    _delta_accel.resize(0);
+    _delta_accel_sens.resize(0);
+}
+
+
+
 void
 MAST::ElementBase::set_solution(const RealVectorX &vec,
                                 bool if_sens) {
@@ -209,6 +209,15 @@ namespace MAST {
 
     
         
+        /*!
+         *   clears the solutions, velocities, accelerations and their
+         *   perturbations and sensitivities, the sensitivity parameter and
+         *   the active solution function, so that an element retained from
+         *   a previous assembly pass has no state left from that pass.
+         */
+        virtual void clear_state();
+        
+        
         /*!
          *   Attaches the function that represents the system solution
          */
@@ -0,0 +1,184 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// MAST includes
+#include "base/elem_dof_indices.h"
+#include "numerics/utility.h"
+#include "numerics/scratch_arena.h"
+
+// libMesh includes
+#include "libmesh/petsc_vector.h"
+#include "libmesh/petsc_matrix.h"
+
+
+MAST::ElemDofIndices::ElemDofIndices():
+_if_constrained(false) {
+    
+}
+
+
+
+void
+MAST::ElemDofIndices::reinit(const libMesh::DofMap& dof_map,
+                             const libMesh::Elem& elem) {
+    
+    dof_map.dof_indices(&elem, _dof_indices);
+    
+    _petsc_indices.resize(_dof_indices.size());
+    _local_indices.clear();
+    _if_constrained = false;
+    
+    for (unsigned int i=0; i<_dof_indices.size(); i++) {
+        
+        _petsc_indices[i]  = (PetscInt)_dof_indices[i];
+        _if_constrained    = _if_constrained || dof_map.is_constrained_dof(_dof_indices[i]);
+    }
+}
+
+
+
+void
+MAST::ElemDofIndices::gather(const libMesh::NumericVector<Real>& localized,
+                             RealVectorX& v) {
+    
+    const libMesh::PetscVector<Real>*
+    p_vec = dynamic_cast<const libMesh::PetscVector<Real>*>(&localized);
+    
+    // only the ghosted PETSc vectors store the values of all element
+    // dofs in the local array
+    if (!p_vec || p_vec->type() != libMesh::GHOSTED) {
+        
+        const unsigned int n = (unsigned int)_dof_indices.size();
+        v.setZero(n);
+        
+        for (unsigned int i=0; i<n; i++)
+            v(i) = localized(_dof_indices[i]);
+        return;
+    }
+    
+    this->gather(localized, p_vec->get_array_read(), v);
+    
+    // the array is restored so that the vector can be used through its
+    // other interface functions
+    const_cast<libMesh::PetscVector<Real>*>(p_vec)->restore_array();
+}
+
+
+
+void
+MAST::ElemDofIndices::gather(const libMesh::NumericVector<Real>& localized,
+                             const PetscScalar* local_array,
+                             RealVectorX& v) {
+    
+    const libMesh::PetscVector<Real>& p_vec =
+    dynamic_cast<const libMesh::PetscVector<Real>&>(localized);
+    libmesh_assert_equal_to(p_vec.type(), libMesh::GHOSTED);
+    libmesh_assert(local_array);
+    
+    const unsigned int n = (unsigned int)_dof_indices.size();
+    v.setZero(n);
+    
+    if (_local_indices.empty()) {
+        
+        _local_indices.resize(n);
+        for (unsigned int i=0; i<n; i++)
+            _local_indices[i] = p_vec.map_global_to_local_index(_dof_indices[i]);
+    }
+    
+    for (unsigned int i=0; i<n; i++) {
+        
+        // the offsets are only valid for vectors with the same ghost
+        // layout as the vector used to compute them
+        libmesh_assert_equal_to(_local_indices[i],
+                                p_vec.map_global_to_local_index(_dof_indices[i]));
+        v(i) = local_array[_local_indices[i]];
+    }
+}
+
+
+
+void
+MAST::ElemDofIndices::add(const libMesh::DofMap& dof_map,
+                          const RealVectorX& vec,
+                          const RealMatrixX& mat,
+                          libMesh::NumericVector<Real>* R,
+                          libMesh::SparseMatrix<Real>* J) const {
+    
+    libMesh::PetscVector<Real>*
+    p_R = dynamic_cast<libMesh::PetscVector<Real>*>(R);
+    libMesh::PetscMatrix<Real>*
+    p_J = dynamic_cast<libMesh::PetscMatrix<Real>*>(J);
+    
+    if (_if_constrained || (R && !p_R) || (J && !p_J)) {
+        
+        // the constraints may add the constraining dofs to the indices
+        std::vector<libMesh::dof_id_type> dof_indices = _dof_indices;
+        
+        // copy to the libMesh matrix for further processing
+        DenseRealVector v;
+        DenseRealMatrix m;
+        if (R)
+            MAST::copy(v, vec);
+        if (J)
+            MAST::copy(m, mat);
+        
+        // constrain the quantities to account for hanging dofs,
+        // Dirichlet constraints, etc.
+        if (R && J)
+            dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
+        else if (R)
+            dof_map.constrain_element_vector(v, dof_indices);
+        else if (J)
+            dof_map.constrain_element_matrix(m, dof_indices);
+        
+        if (R) R->add_vector(v, dof_indices);
+        if (J) J->add_matrix(m, dof_indices);
+        
+        return;
+    }
+    
+    const PetscInt n = (PetscInt)_petsc_indices.size();
+    PetscErrorCode ierr;
+    
+    if (R) {
+        
+        libmesh_assert_equal_to(vec.size(), n);
+        
+        ierr = VecSetValues(p_R->vec(), n, &_petsc_indices[0],
+                            vec.data(), ADD_VALUES);
+        CHKERRABORT(R->comm().get(), ierr);
+    }
+    
+    if (J) {
+        
+        libmesh_assert_equal_to(mat.rows(), n);
+        libmesh_assert_equal_to(mat.cols(), n);
+        
+        // PETSc expects the values in row-major order, which is the
+        // column-major storage of the transpose
+        MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+        RealMatrixX& mat_t = scratch.matrix(n, n);
+        mat_t = mat.transpose();
+        
+        ierr = MatSetValues(p_J->mat(), n, &_petsc_indices[0],
+                            n, &_petsc_indices[0],
+                            mat_t.data(), ADD_VALUES);
+        CHKERRABORT(J->comm().get(), ierr);
+    }
+}
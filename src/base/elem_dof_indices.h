@@ -0,0 +1,150 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__elem_dof_indices_h__
+#define __mast__elem_dof_indices_h__
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/sparse_matrix.h"
+
+// PETSc includes
+#include <petscvec.h>
+
+
+namespace MAST {
+    
+    /*!
+     *   Stores the dof indices of an element for the gather of the element
+     *   solution and the insertion of element quantities in the global
+     *   vector and matrix. Along with the global indices, this stores the
+     *   offsets of the dofs in the local array of a ghosted PETSc vector
+     *   localized with the send list of the system, so that the element
+     *   values are read directly from this array. Elements without
+     *   constrained dofs are inserted directly in the PETSc vector and
+     *   matrix, while the others are constrained and inserted through
+     *   libMesh.
+     */
+    class ElemDofIndices {
+        
+    public:
+        
+        ElemDofIndices();
+        
+        
+        /*!
+         *   initializes the indices for \p elem from \p dof_map
+         */
+        void reinit(const libMesh::DofMap& dof_map,
+                    const libMesh::Elem& elem);
+        
+        
+        /*!
+         *   @returns the number of dofs of the element
+         */
+        unsigned int size() const {
+            return (unsigned int)_dof_indices.size();
+        }
+        
+        
+        /*!
+         *   @returns the global dof indices of the element
+         */
+        const std::vector<libMesh::dof_id_type>& dof_indices() const {
+            return _dof_indices;
+        }
+        
+        
+        /*!
+         *   @returns true if any of the element dofs is constrained
+         */
+        bool if_constrained() const {
+            return _if_constrained;
+        }
+        
+        
+        /*!
+         *   copies the values of the element dofs from \p localized to
+         *   \p v. \p localized must be localized with the send list of the
+         *   system, as done by AssemblyBase::_build_localized_vector().
+         *   The offsets in the local array are computed on the first call
+         *   and reused thereafter.
+         */
+        void gather(const libMesh::NumericVector<Real>& localized,
+                    RealVectorX& v);
+        
+        
+        /*!
+         *   copies the values of the element dofs to \p v from
+         *   \p local_array, which is the local array of the ghosted PETSc
+         *   vector \p localized obtained by the caller with
+         *   get_array_read(). The array of \p localized is not accessed,
+         *   so this can be called concurrently for different elements.
+         */
+        void gather(const libMesh::NumericVector<Real>& localized,
+                    const PetscScalar* local_array,
+                    RealVectorX& v);
+        
+        
+        /*!
+         *   adds \p vec to \p R and \p mat to \p J, either of which may be
+         *   null. The quantities are constrained using \p dof_map if the
+         *   element has constrained dofs. \p vec and \p mat are not
+         *   modified.
+         */
+        void add(const libMesh::DofMap& dof_map,
+                 const RealVectorX& vec,
+                 const RealMatrixX& mat,
+                 libMesh::NumericVector<Real>* R,
+                 libMesh::SparseMatrix<Real>* J) const;
+        
+    protected:
+        
+        /*!
+         *   global dof indices of the element
+         */
+        std::vector<libMesh::dof_id_type> _dof_indices;
+        
+        /*!
+         *   global dof indices in the integer type used by PETSc
+         */
+        std::vector<PetscInt> _petsc_indices;
+        
+        /*!
+         *   offsets of the element dofs in the local array of a ghosted
+         *   vector. This is empty until the first gather.
+         */
+        std::vector<libMesh::numeric_index_type> _local_indices;
+        
+        /*!
+         *   true if any of the element dofs is constrained
+         */
+        bool _if_constrained;
+    };
+}
+
+
+#endif // __mast__elem_dof_indices_h__
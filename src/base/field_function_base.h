@@ -23,6 +23,7 @@
 
 // C++ includes
 #include <memory>
+#include <vector>
 
 // MAST includes
 #include "base/function_base.h"
@@ -120,6 +121,62 @@ namespace MAST {
             libmesh_error(); // must be implemented in derived class
         }
         
+        
+        /*!
+         *    calculates the value of the function at each point in \p p,
+         *    and time, \par t, and returns it in \p v, which is resized to
+         *    the number of points. This is intended to be called with the
+         *    quadrature point locations of an element before the quadrature
+         *    point loop. Spatially constant functions are evaluated once
+         *    and the value is copied to all points.
+         */
+        virtual void operator() (const std::vector<libMesh::Point>& p,
+                                 const Real t,
+                                 std::vector<ValType>& v) const {
+            
+            v.resize(p.size());
+            
+            if (p.empty())
+                return;
+            
+            if (this->is_spatially_constant()) {
+                
+                (*this)(p[0], t, v[0]);
+                for (unsigned int i=1; i<p.size(); i++)
+                    v[i] = v[0];
+            }
+            else
+                for (unsigned int i=0; i<p.size(); i++)
+                    (*this)(p[i], t, v[i]);
+        }
+
+        
+        /*!
+         *    calculates the derivative of the function with respect to
+         *    \p f at each point in \p p, and time, \par t, and returns it
+         *    in \p v, which is resized to the number of points.
+         */
+        virtual void derivative (const MAST::FunctionBase& f,
+                                 const std::vector<libMesh::Point>& p,
+                                 const Real t,
+                                 std::vector<ValType>& v) const {
+            
+            v.resize(p.size());
+            
+            if (p.empty())
+                return;
+            
+            if (this->is_spatially_constant()) {
+                
+                this->derivative(f, p[0], t, v[0]);
+                for (unsigned int i=1; i<p.size(); i++)
+                    v[i] = v[0];
+            }
+            else
+                for (unsigned int i=0; i<p.size(); i++)
+                    this->derivative(f, p[i], t, v[i]);
+        }
+        
     protected:
     
     };
@@ -17,12 +17,143 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <atomic>
+
+
 // MAST includes
 #include "base/function_base.h"
+#include "base/parameter.h"
+
+
+
+bool
+MAST::FunctionBase::is_spatially_constant() const {
+    
+    // parameters do not depend on the spatial location
+    if (!_is_field_func)
+        return true;
+    
+    if (!_is_composite)
+        return false;
+    
+    std::set<const MAST::FunctionBase*>::const_iterator
+    it = _functions.begin(), end = _functions.end();
+    
+    for ( ; it != end; it++)
+        if (!(*it)->is_spatially_constant())
+            return false;
+    
+    return true;
+}
+
+
+
+bool
+MAST::FunctionBase::is_temporally_constant() const {
+    
+    if (!_is_field_func)
+        return true;
+    
+    if (!_is_composite)
+        return false;
+    
+    std::set<const MAST::FunctionBase*>::const_iterator
+    it = _functions.begin(), end = _functions.end();
+    
+    for ( ; it != end; it++)
+        if (!(*it)->is_temporally_constant())
+            return false;
+    
+    return true;
+}
+
+
+
+void
+MAST::FunctionBase::
+parameter_dependencies(std::set<const MAST::Parameter*>& params) const {
+    
+    if (_if_frozen) {
+        
+        params.insert(_parameters.begin(), _parameters.end());
+        return;
+    }
+    
+    std::set<const MAST::FunctionBase*>::const_iterator
+    it = _functions.begin(), end = _functions.end();
+    
+    for ( ; it != end; it++) {
+        
+        const MAST::Parameter* p = dynamic_cast<const MAST::Parameter*>(*it);
+        
+        if (p)
+            params.insert(p);
+        else
+            (*it)->parameter_dependencies(params);
+    }
+}
+
+
 
+void
+MAST::FunctionBase::freeze_dependencies() const {
+    
+    if (_if_frozen)
+        return;
+    
+    std::vector<bool> bits;
+    std::set<const MAST::Parameter*> params;
+    
+    std::set<const MAST::FunctionBase*>::const_iterator
+    it = _functions.begin(), end = _functions.end();
+    
+    for ( ; it != end; it++) {
+        
+        (*it)->freeze_dependencies();
+        (*it)->add_dependencies(bits);
+        
+        // this function depends on the function itself
+        if (bits.size() <= (*it)->_id)
+            bits.resize((*it)->_id+1, false);
+        bits[(*it)->_id] = true;
+        
+        const MAST::Parameter* p = dynamic_cast<const MAST::Parameter*>(*it);
+        
+        if (p)
+            params.insert(p);
+        else
+            params.insert((*it)->_parameters.begin(), (*it)->_parameters.end());
+    }
+    
+    _dependencies.swap(bits);
+    _parameters.assign(params.begin(), params.end());
+    _if_frozen = true;
+}
 
 
 
+void
+MAST::FunctionBase::add_dependencies(std::vector<bool>& bits) const {
+    
+    if (!_if_frozen)
+        this->freeze_dependencies();
+    
+    if (bits.size() < _dependencies.size())
+        bits.resize(_dependencies.size(), false);
+    
+    for (unsigned int i=0; i<_dependencies.size(); i++)
+        if (_dependencies[i])
+            bits[i] = true;
+}
 
 
 
+unsigned int
+MAST::FunctionBase::_next_id() {
+    
+    // functions may be created concurrently during threaded assembly
+    static std::atomic<unsigned int> n_functions(0);
+    
+    return n_functions++;
+}
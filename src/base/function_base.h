@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <set>
+#include <vector>
 
 
 //  MAST includes
@@ -31,6 +32,9 @@
 namespace MAST
 {
     
+    // Forward declerations
+    class Parameter;
+    
     
     class FunctionBase {
     public:
@@ -41,7 +45,10 @@ namespace MAST
         FunctionBase(const std::string& nm ,
                      const bool is_field_func):
         _name(nm),
-        _is_field_func(is_field_func)
+        _is_field_func(is_field_func),
+        _is_composite(false),
+        _id(MAST::FunctionBase::_next_id()),
+        _if_frozen(false)
         { }
 
         
@@ -50,7 +57,10 @@ namespace MAST
          */
         FunctionBase(const MAST::FunctionBase& f):
         _name(f._name),
-        _is_field_func(f._is_field_func)
+        _is_field_func(f._is_field_func),
+        _is_composite(f._is_composite),
+        _id(MAST::FunctionBase::_next_id()),
+        _if_frozen(false)
         { }
 
         
@@ -68,10 +78,24 @@ namespace MAST
         }
         
         
+        /*!
+         *   @returns the index of this function, which is unique among all
+         *   functions and is used to index the dependency bitsets
+         */
+        unsigned int id() const {
+            return _id;
+        }
+        
+        
         /*!
          *  returns true if the function depends on the provided value
          */
         virtual bool depends_on(const MAST::FunctionBase& f) const {
+            
+            // the frozen dependency graph is a single bit test
+            if (_if_frozen)
+                return (f._id < _dependencies.size() && _dependencies[f._id]);
+            
             if (_functions.count(&f))   // this function is the same
                 return true;
             
@@ -97,8 +121,71 @@ namespace MAST
             return false;
         }
         
+        
+        /*!
+         *  @returns true if the value of the function is the same at all
+         *  points in the domain. Parameters are always constant. A field
+         *  function is constant if it is a composite function and all the
+         *  functions that it depends on are constant. Other field functions
+         *  are assumed to vary in space, unless this method is reimplemented.
+         */
+        virtual bool is_spatially_constant() const;
+        
+        
+        /*!
+         *  @returns true if the value of the function does not change with
+         *  time. This uses the same dependency analysis as
+         *  is_spatially_constant().
+         */
+        virtual bool is_temporally_constant() const;
+        
+        
+        /*!
+         *  adds to \p params all parameters that this function depends on,
+         *  either directly or through the functions in its dependency graph.
+         *  For functions that are constant in space and time, the values of
+         *  these parameters uniquely define the value of the function.
+         */
+        void parameter_dependencies(std::set<const MAST::Parameter*>& params) const;
+        
+        
+        /*!
+         *  computes the transitive closure of the dependency graph of this
+         *  function and stores it as a bitset indexed by id(), together with
+         *  the list of parameters in the graph. All functions in the graph
+         *  are frozen as well. After this, depends_on() is a single bit test
+         *  and parameter_dependencies() does not walk the graph. Since the
+         *  dependencies of a function are defined in its constructor, this
+         *  can be called any time after construction. This is not thread
+         *  safe, and should be called before the assembly.
+         */
+        void freeze_dependencies() const;
+        
+        
+        /*!
+         *  @returns true if freeze_dependencies() has been called
+         */
+        bool if_frozen() const {
+            return _if_frozen;
+        }
+        
+        
+        /*!
+         *  sets the bits of \p bits for all functions that this function
+         *  depends on. The bitset is resized if needed. The dependencies of
+         *  this function are frozen by this call if they are not already
+         *  frozen.
+         */
+        void add_dependencies(std::vector<bool>& bits) const;
+        
     protected:
         
+        /*!
+         *    @returns the next available function index
+         */
+        static unsigned int _next_id();
+        
+        
         /*!
          *    name of this parameter
          */
@@ -109,10 +196,41 @@ namespace MAST
          */
         bool _is_field_func;
         
+        /*!
+         *    flag that is true if the function depends on the spatial
+         *    location and time only through the functions in
+         *    \p _functions. Derived classes that combine other functions,
+         *    for example a section stiffness computed from the material
+         *    and thickness, should set this to true, so that the dependency
+         *    graph can identify the function as constant. False by default.
+         */
+        bool _is_composite;
+        
         /*!
          *   set of functions that \p this function depends on
          */
         std::set<const MAST::FunctionBase*> _functions;
+        
+        /*!
+         *   index of this function in the dependency bitsets
+         */
+        unsigned int _id;
+        
+        /*!
+         *   true after freeze_dependencies() has been called
+         */
+        mutable bool _if_frozen;
+        
+        /*!
+         *   bitset of the functions that this function depends on,
+         *   indexed by their id()
+         */
+        mutable std::vector<bool> _dependencies;
+        
+        /*!
+         *   parameters in the frozen dependency graph
+         */
+        mutable std::vector<const MAST::Parameter*> _parameters;
     };
     
 }
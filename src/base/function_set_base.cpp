@@ -22,7 +22,8 @@
 
 
 
-MAST::FunctionSetBase::FunctionSetBase()
+MAST::FunctionSetBase::FunctionSetBase():
+_if_frozen(false)
 { }
         
 
@@ -53,12 +54,17 @@ MAST::FunctionSetBase::add(MAST::FunctionBase& f) {
     bool success = _properties.insert(std::pair<std::string, MAST::FunctionBase*>
                                       (f.name(), &f)).second;
     libmesh_assert(success);
+    
+    // the dependency graph has changed
+    _if_frozen = false;
+    _dependencies.clear();
+    _dependency_ids.clear();
 }
 
         
 
 bool
-MAST::FunctionSetBase::depends_on(const MAST::FunctionBase& f) const {
+MAST::FunctionSetBase::_depends_on(const MAST::FunctionBase& f) const {
     
     // check with all the properties to see if any one of them is
     // dependent on the provided parameter, or is the parameter itself
@@ -72,3 +78,61 @@ MAST::FunctionSetBase::depends_on(const MAST::FunctionBase& f) const {
     // if it gets here, then there is no dependency
     return false;
 }
+
+
+
+void
+MAST::FunctionSetBase::freeze_dependencies() const {
+    
+    std::vector<bool> bits;
+    
+    this->_add_dependencies(bits);
+    
+    _dependencies.swap(bits);
+    
+    _dependency_ids.clear();
+    for (unsigned int i=0; i<_dependencies.size(); i++)
+        if (_dependencies[i])
+            _dependency_ids.push_back(i);
+    
+    _if_frozen = true;
+}
+
+
+
+void
+MAST::FunctionSetBase::add_dependencies(std::vector<bool>& bits) const {
+    
+    if (!_if_frozen)
+        this->freeze_dependencies();
+    
+    if (bits.size() < _dependencies.size())
+        bits.resize(_dependencies.size(), false);
+    
+    for (unsigned int i=0; i<_dependency_ids.size(); i++)
+        bits[_dependency_ids[i]] = true;
+}
+
+
+
+void
+MAST::FunctionSetBase::_add_dependencies(std::vector<bool>& bits) const {
+    
+    std::map<std::string, MAST::FunctionBase*>::const_iterator
+    it = _properties.begin(), end = _properties.end();
+    
+    for ( ; it!=end; it++) {
+        
+        it->second->freeze_dependencies();
+        it->second->add_dependencies(bits);
+        
+        // a parameter in the set depends on itself
+        if (it->second->depends_on(*it->second)) {
+            
+            const unsigned int i = it->second->id();
+            if (bits.size() <= i)
+                bits.resize(i+1, false);
+            bits[i] = true;
+        }
+    }
+}
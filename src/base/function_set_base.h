@@ -95,15 +95,99 @@ namespace MAST {
         /*!
          *  returns true if the property card depends on the function \p f
          */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
-
+        bool depends_on(const MAST::FunctionBase& f) const {
+            
+            // the frozen dependency graph is a single bit test
+            if (_if_frozen)
+                return (f.id() < _dependencies.size() && _dependencies[f.id()]);
+            
+            return this->_depends_on(f);
+        }
+        
+        
+        /*!
+         *  freezes the dependency graphs of the functions in this set, and
+         *  of the sets that it refers to, and stores their union as a bitset
+         *  indexed by MAST::FunctionBase::id(). After this, depends_on() is
+         *  a single bit test. Adding a function to the set clears the frozen
+         *  graph. Sets that refer to this set, for example element property
+         *  cards that use a material card, need to be frozen again if this
+         *  set is changed.
+         */
+        void freeze_dependencies() const;
+        
+        
+        /*!
+         *  @returns true if freeze_dependencies() has been called since the
+         *  last change to this set
+         */
+        bool if_frozen() const {
+            return _if_frozen;
+        }
+        
+        
+        /*!
+         *  sets the bits of \p bits for all functions that this set depends
+         *  on. The set is frozen by this call if it is not already frozen.
+         */
+        void add_dependencies(std::vector<bool>& bits) const;
+        
+        
+        /*!
+         *  @returns the sorted ids, MAST::FunctionBase::id(), of all
+         *  functions that this set depends on. This allows a caller to
+         *  enumerate the parameters of a set without testing each one with
+         *  depends_on(). The set is frozen by this call if it is not
+         *  already frozen.
+         */
+        const std::vector<unsigned int>& dependency_ids() const {
+            
+            if (!_if_frozen)
+                this->freeze_dependencies();
+            
+            return _dependency_ids;
+        }
+        
         
     protected:
         
+        /*!
+         *  returns true if the set depends on \p f by checking with each
+         *  function in the set. This is used if the set is not frozen, and
+         *  should be reimplemented by sets that refer to other sets or
+         *  functions.
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
+        
+        
+        /*!
+         *  freezes the functions that this set depends on and adds them to
+         *  \p bits. Sets that reimplement _depends_on() should reimplement
+         *  this as well.
+         */
+        virtual void _add_dependencies(std::vector<bool>& bits) const;
+        
+        
         /*!
          *    map of the functions in this card
          */
         std::map<std::string, MAST::FunctionBase*> _properties;
+        
+        /*!
+         *    true if the dependency graph of this set is frozen
+         */
+        mutable bool _if_frozen;
+        
+        /*!
+         *    bitset of the functions that this set depends on, indexed by
+         *    MAST::FunctionBase::id()
+         */
+        mutable std::vector<bool> _dependencies;
+        
+        /*!
+         *    sorted ids of the set bits in \p _dependencies
+         */
+        mutable std::vector<unsigned int> _dependency_ids;
     };
     
 }
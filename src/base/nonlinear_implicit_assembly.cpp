@@ -25,6 +25,7 @@
 #include "numerics/utility.h"
 #include "base/mesh_field_function.h"
 #include "base/nonlinear_system.h"
+#include "base/elem_dof_indices.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_solver.h"
@@ -32,12 +33,114 @@
 #include "libmesh/sparse_matrix.h"
 #include "libmesh/dof_map.h"
 #include "libmesh/parameter_vector.h"
+#include "libmesh/elem_range.h"
+#include "libmesh/threads.h"
+#include "libmesh/libmesh.h"
+#include "libmesh/petsc_vector.h"
+
+
+
+namespace MAST {
+    
+    /*!
+     *   Computes the element residual and Jacobian over a range of
+     *   elements. This is used with libMesh::Threads::parallel_for
+     *   for threaded assembly. The elements and dof indices are obtained
+     *   from the element cache if it is enabled, and are otherwise created
+     *   by each thread. The element solution is read from the local
+     *   array of the ghosted solution, and only the insertion into the
+     *   global vector and matrix is serialized.
+     */
+    class NonlinearImplicitAssemblyElemThread {
+    public:
+        
+        NonlinearImplicitAssemblyElemThread(MAST::NonlinearImplicitAssembly& assembly,
+                                            const libMesh::NumericVector<Real>& sol,
+                                            const PetscScalar* sol_array,
+                                            libMesh::NumericVector<Real>* R,
+                                            libMesh::SparseMatrix<Real>*  J):
+        _assembly(assembly),
+        _sol(sol),
+        _sol_array(sol_array),
+        _R(R),
+        _J(J)
+        { }
+        
+        
+        void operator() (const libMesh::ConstElemRange& range) const {
+            
+            const libMesh::DofMap& dof_map =
+            _assembly._system->system().get_dof_map();
+            
+            RealVectorX vec, sol;
+            RealMatrixX mat;
+            
+            // the element cache was filled before the threads were
+            // started, so it is only read here
+            MAST::ElemDofIndices elem_dofs;
+            std::auto_ptr<MAST::ElementBase> elem_owner;
+            MAST::ElementBase* physics_elem = nullptr;
+            
+            libMesh::ConstElemRange::const_iterator
+            el     = range.begin(),
+            end_el = range.end();
+            
+            for ( ; el != end_el; ++el) {
+                
+                const libMesh::Elem* elem = *el;
+                
+                MAST::ElemDofIndices& dofs = _assembly._get_elem_dofs(*elem, elem_dofs);
+                
+                physics_elem = _assembly._get_elem(*elem, elem_owner);
+                
+                // get the solution
+                unsigned int ndofs = dofs.size();
+                vec.setZero(ndofs);
+                mat.setZero(ndofs, ndofs);
+                
+                dofs.gather(_sol, _sol_array, sol);
+                
+                _assembly._set_elem_solution(*physics_elem, sol);
+                
+                // perform the element level calculations
+                _assembly._elem_calculations(*physics_elem,
+                                             _J!=nullptr?true:false,
+                                             vec, mat);
+                
+                // constrain and add to the global matrices. The global
+                // data structures are not thread-safe, so only one thread
+                // adds at a time.
+                {
+                    libMesh::Threads::spin_mutex::scoped_lock
+                    lock(_assembly._thread_mutex);
+                    
+                    dofs.add(dof_map, vec, mat, _R, _J);
+                }
+            }
+        }
+        
+    protected:
+        
+        MAST::NonlinearImplicitAssembly& _assembly;
+        
+        const libMesh::NumericVector<Real>& _sol;
+        
+        const PetscScalar* _sol_array;
+        
+        libMesh::NumericVector<Real>* _R;
+        
+        libMesh::SparseMatrix<Real>*  _J;
+    };
+}
 
 
 
 MAST::NonlinearImplicitAssembly::
 NonlinearImplicitAssembly():
-MAST::AssemblyBase() {
+MAST::AssemblyBase(),
+_if_threaded_assembly(libMesh::on_command_line("--threaded_assembly")),
+_if_retain_localized_sol(false),
+_if_localized_sol_current(false) {
     
 }
 
@@ -85,6 +188,13 @@ clear_discipline_and_system( ) {
         _system->system().nonlinear_solver->residual_and_jacobian_object = nullptr;
     }
     
+    this->clear_element_cache();
+    this->clear_sensitivity_elem_index();
+    
+    _localized_sol.reset();
+    _localized_dsol.reset();
+    _if_localized_sol_current = false;
+    
     _discipline = nullptr;
     _system     = nullptr;
 }
@@ -221,14 +331,23 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     RealVectorX vec, sol;
     RealMatrixX mat;
     
-    std::vector<libMesh::dof_id_type> dof_indices;
+    MAST::ElemDofIndices elem_dofs;
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     std::auto_ptr<libMesh::NumericVector<Real> > localized_solution;
     localized_solution.reset(_build_localized_vector(nonlin_sys,
                                                      X).release());
     
+    if (_use_threaded_assembly()) {
+        
+        _threaded_residual_and_jacobian(*localized_solution, R, J);
+        
+        if (R) R->close();
+        if (J) J->close();
+        return;
+    }
     
     // if a solution function is attached, initialize it
     if (_sol_function)
@@ -245,18 +364,16 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
-        dof_map.dof_indices (elem, dof_indices);
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
+        unsigned int ndofs = dofs.size();
         vec.setZero(ndofs);
         mat.setZero(ndofs, ndofs);
         
-        for (unsigned int i=0; i<dof_indices.size(); i++)
-            sol(i) = (*localized_solution)(dof_indices[i]);
+        dofs.gather(*localized_solution, sol);
         
         physics_elem->set_solution(sol);
         
@@ -272,26 +389,9 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         
         physics_elem->detach_active_solution_function();
 
-        // copy to the libMesh matrix for further processing
-        DenseRealVector v;
-        DenseRealMatrix m;
-        if (R)
-            MAST::copy(v, vec);
-        if (J)
-            MAST::copy(m, mat);
-
         // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        if (R && J)
-            dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
-        else if (R)
-            dof_map.constrain_element_vector(v, dof_indices);
-        else
-            dof_map.constrain_element_matrix(m, dof_indices);
-        
-        // add to the global matrices
-        if (R) R->add_vector(v, dof_indices);
-        if (J) J->add_matrix(m, dof_indices);
+        // Dirichlet constraints, etc., and add to the global matrices
+        dofs.add(dof_map, vec, mat, R, J);
     }
     
 
@@ -306,6 +406,76 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
 
 
 
+bool
+MAST::NonlinearImplicitAssembly::_use_threaded_assembly() const {
+    
+    return (_if_threaded_assembly   &&
+            libMesh::n_threads() > 1 &&
+            !_sol_function);
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::
+_threaded_residual_and_jacobian(const libMesh::NumericVector<Real>& localized_solution,
+                                libMesh::NumericVector<Real>* R,
+                                libMesh::SparseMatrix<Real>*  J) {
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    
+    // the local array of a PETSc vector is obtained on first access,
+    // which is not thread-safe. It is obtained once here, and the
+    // threads read the element values directly from it.
+    const libMesh::PetscVector<Real>*
+    p_sol = dynamic_cast<const libMesh::PetscVector<Real>*>(&localized_solution);
+    
+    if (!p_sol || p_sol->type() != libMesh::GHOSTED)
+        libmesh_error_msg("Error: threaded assembly requires a ghosted PETSc vector.");
+    
+    const PetscScalar* sol_array = p_sol->get_array_read();
+    
+    // the cached elements and dof indices are created here, so that the
+    // threads do not modify the cache
+    this->_fill_element_cache();
+    
+    libMesh::ConstElemRange
+    range(nonlin_sys.get_mesh().active_local_elements_begin(),
+          nonlin_sys.get_mesh().active_local_elements_end());
+    
+    libMesh::Threads::parallel_for
+    (range,
+     MAST::NonlinearImplicitAssemblyElemThread(*this,
+                                               localized_solution,
+                                               sol_array,
+                                               R,
+                                               J));
+    
+    const_cast<libMesh::PetscVector<Real>*>(p_sol)->restore_array();
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::_set_elem_solution(MAST::ElementBase& elem,
+                                                    const RealVectorX& sol) {
+    
+    elem.set_solution(sol);
+}
+
+
+
+
+void
+MAST::NonlinearImplicitAssembly::set_retain_localized_solution(bool f) {
+    
+    _if_retain_localized_sol  = f;
+    _if_localized_sol_current = false;
+}
+
+
+
+
 void
 MAST::NonlinearImplicitAssembly::
 linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
@@ -327,18 +497,23 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
     RealVectorX vec, sol, dsol;
     RealMatrixX mat;
     
-    std::vector<libMesh::dof_id_type> dof_indices;
+    MAST::ElemDofIndices elem_dofs;
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
-    std::auto_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_perturbed_solution;
+    // the localized solution is reused if it was retained from a previous
+    // call about the same solution
+    if (!_if_localized_sol_current) {
+        
+        _localize_vector(nonlin_sys, X, _localized_sol);
+        _if_localized_sol_current = _if_retain_localized_sol;
+    }
+    _localize_vector(nonlin_sys, dX, _localized_dsol);
     
-    localized_solution.reset(_build_localized_vector(nonlin_sys,
-                                                     X).release());
-    localized_perturbed_solution.reset(_build_localized_vector(nonlin_sys,
-                                                               dX).release());
+    const libMesh::NumericVector<Real>
+    &localized_solution           = *_localized_sol,
+    &localized_perturbed_solution = *_localized_dsol;
     
     
     // if a solution function is attached, initialize it
@@ -356,21 +531,16 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
-        dof_map.dof_indices (elem, dof_indices);
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
-        dsol.setZero(ndofs);
+        unsigned int ndofs = dofs.size();
         vec.setZero(ndofs);
-        mat.setZero(ndofs, ndofs);
         
-        for (unsigned int i=0; i<dof_indices.size(); i++) {
-            sol (i) = (*localized_solution)          (dof_indices[i]);
-            dsol(i) = (*localized_perturbed_solution)(dof_indices[i]);
-        }
+        dofs.gather(localized_solution,           sol);
+        dofs.gather(localized_perturbed_solution, dsol);
         
         physics_elem->set_solution(sol);
         physics_elem->set_perturbed_solution(dsol);
@@ -386,16 +556,9 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
         
         physics_elem->detach_active_solution_function();
         
-        // copy to the libMesh matrix for further processing
-        DenseRealVector v;
-        MAST::copy(v, vec);
-        
         // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        dof_map.constrain_element_vector(v, dof_indices);
-        
-        // add to the global matrices
-        JdX.add_vector(v, dof_indices);
+        // Dirichlet constraints, etc., and add to the global vector
+        dofs.add(dof_map, vec, mat, &JdX, nullptr);
     }
     
     
@@ -434,9 +597,10 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
     RealVectorX vec, sol;
     RealMatrixX mat;
     
-    std::vector<libMesh::dof_id_type> dof_indices;
+    MAST::ElemDofIndices elem_dofs;
     const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     std::auto_ptr<libMesh::NumericVector<Real> > localized_solution;
     localized_solution.reset(_build_localized_vector(nonlin_sys,
@@ -446,29 +610,31 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
     if (_sol_function)
         _sol_function->init( *nonlin_sys.solution);
     
-    libMesh::MeshBase::const_element_iterator       el     =
-    nonlin_sys.get_mesh().active_local_elements_begin();
-    const libMesh::MeshBase::const_element_iterator end_el =
-    nonlin_sys.get_mesh().active_local_elements_end();
+    const MAST::FunctionBase*
+    f = _discipline->get_parameter(&(parameters[i].get()));
     
-    for ( ; el != end_el; ++el) {
+    // only the elements that depend on f contribute to the sensitivity
+    // of the residual
+    std::vector<const libMesh::Elem*> local_elems;
+    const std::vector<const libMesh::Elem*>&
+    elems = _sensitivity_elems(*f, local_elems);
+    
+    for (unsigned int j=0; j<elems.size(); j++) {
         
-        const libMesh::Elem* elem = *el;
+        const libMesh::Elem* elem = elems[j];
         
-        dof_map.dof_indices (elem, dof_indices);
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
+        unsigned int ndofs = dofs.size();
         vec.setZero(ndofs);
         mat.setZero(ndofs, ndofs);
         
-        for (unsigned int i=0; i<dof_indices.size(); i++)
-            sol(i) = (*localized_solution)(dof_indices[i]);
+        dofs.gather(*localized_solution, sol);
         
-        physics_elem->sensitivity_param = _discipline->get_parameter(&(parameters[i].get()));
+        physics_elem->sensitivity_param = f;
         physics_elem->set_solution(sol);
         
         if (_sol_function)
@@ -484,16 +650,9 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
         
         physics_elem->detach_active_solution_function();
         
-        // copy to the libMesh matrix for further processing
-        DenseRealVector v;
-        MAST::copy(v, vec);
-
         // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        dof_map.constrain_element_vector(v, dof_indices);
-        
-        // add to the global matrices
-        sensitivity_rhs.add_vector(v, dof_indices);
+        // Dirichlet constraints, etc., and add to the global vector
+        dofs.add(dof_map, vec, mat, &sensitivity_rhs, nullptr);
     }
     
     // if a solution function is attached, initialize it
@@ -506,3 +665,260 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
 }
 
 
+
+
+bool
+MAST::NonlinearImplicitAssembly::
+sensitivity_assemble (const libMesh::ParameterVector& parameters,
+                      std::vector<libMesh::NumericVector<Real>*>& sensitivity_rhs) {
+    
+    libmesh_assert_equal_to(sensitivity_rhs.size(), parameters.size());
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    
+    for (unsigned int i=0; i<sensitivity_rhs.size(); i++)
+        sensitivity_rhs[i]->zero();
+    
+    RealVectorX sol;
+    RealMatrixX dummy;
+    std::vector<RealVectorX> vec;
+    std::vector<const MAST::FunctionBase*> elem_params;
+    
+    MAST::ElemDofIndices elem_dofs;
+    const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
+    
+    std::auto_ptr<libMesh::NumericVector<Real> > localized_solution;
+    localized_solution.reset(_build_localized_vector(nonlin_sys,
+                                                     *nonlin_sys.solution).release());
+    
+    // if a solution function is attached, initialize it
+    if (_sol_function)
+        _sol_function->init( *nonlin_sys.solution);
+    
+    std::map<libMesh::dof_id_type,
+    std::pair<const libMesh::Elem*, std::vector<unsigned int> > > elems;
+    _sensitivity_elem_params(parameters, elems);
+    
+    std::map<libMesh::dof_id_type,
+    std::pair<const libMesh::Elem*, std::vector<unsigned int> > >::const_iterator
+    it   = elems.begin(),
+    end  = elems.end();
+    
+    for ( ; it != end; it++) {
+        
+        const libMesh::Elem* elem = it->second.first;
+        const std::vector<unsigned int>& p_index = it->second.second;
+        
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
+        
+        physics_elem = _get_elem(*elem, elem_owner);
+        
+        // get the solution
+        unsigned int ndofs = dofs.size();
+        dofs.gather(*localized_solution, sol);
+        
+        _set_elem_solution(*physics_elem, sol);
+        
+        if (_sol_function)
+            physics_elem->attach_active_solution_function(*_sol_function);
+        
+        elem_params.resize(p_index.size());
+        vec.resize(p_index.size());
+        for (unsigned int i=0; i<p_index.size(); i++) {
+            elem_params[i] = _discipline->get_parameter(&(parameters[p_index[i]].get()));
+            vec[i].setZero(ndofs);
+        }
+        
+        // perform the element level calculations
+        _elem_multiparameter_sensitivity_calculations(*physics_elem, elem_params, vec);
+        
+        physics_elem->detach_active_solution_function();
+        
+        for (unsigned int i=0; i<p_index.size(); i++) {
+            
+            // the sensitivity method provides sensitivity of the residual.
+            // Hence, this is multiplied with -1 to make it the RHS of the
+            // sensitivity equations.
+            vec[i] *= -1.;
+            
+            dofs.add(dof_map, vec[i], dummy, sensitivity_rhs[p_index[i]], nullptr);
+        }
+    }
+    
+    // if a solution function is attached, clear it
+    if (_sol_function)
+        _sol_function->clear();
+    
+    for (unsigned int i=0; i<sensitivity_rhs.size(); i++)
+        sensitivity_rhs[i]->close();
+    
+    return true;
+}
+
+
+
+
+void
+MAST::NonlinearImplicitAssembly::
+calculate_output_adjoint_sensitivity(const libMesh::ParameterVector& params,
+                                     const libMesh::NumericVector<Real>& X,
+                                     const libMesh::NumericVector<Real>& adj_sol,
+                                     std::vector<Real>& sens) {
+    
+    libmesh_assert_equal_to(sens.size(), params.size());
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    
+    RealVectorX sol, adj;
+    std::vector<RealVectorX> vec;
+    std::vector<const MAST::FunctionBase*> elem_params;
+    
+    MAST::ElemDofIndices elem_dofs;
+    std::vector<libMesh::dof_id_type> constrained_dof_indices;
+    const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
+    
+    // adjoint weighted residual sensitivity, lambda^T dR/dp, from the
+    // local elements
+    std::vector<Real> adj_dR(params.size(), 0.);
+    
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    localized_solution,
+    localized_adjoint;
+    localized_solution.reset(_build_localized_vector(nonlin_sys, X).release());
+    localized_adjoint.reset(_build_localized_vector(nonlin_sys, adj_sol).release());
+    
+    // if a solution function is attached, initialize it
+    if (_sol_function)
+        _sol_function->init(X);
+    
+    std::map<libMesh::dof_id_type,
+    std::pair<const libMesh::Elem*, std::vector<unsigned int> > > elems;
+    _sensitivity_elem_params(params, elems);
+    
+    std::map<libMesh::dof_id_type,
+    std::pair<const libMesh::Elem*, std::vector<unsigned int> > >::const_iterator
+    it   = elems.begin(),
+    end  = elems.end();
+    
+    for ( ; it != end; it++) {
+        
+        const libMesh::Elem* elem = it->second.first;
+        const std::vector<unsigned int>& p_index = it->second.second;
+        
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
+        
+        physics_elem = _get_elem(*elem, elem_owner);
+        
+        // get the solution and the adjoint
+        unsigned int ndofs = dofs.size();
+        dofs.gather(*localized_solution, sol);
+        if (!dofs.if_constrained())
+            dofs.gather(*localized_adjoint, adj);
+        
+        _set_elem_solution(*physics_elem, sol);
+        
+        if (_sol_function)
+            physics_elem->attach_active_solution_function(*_sol_function);
+        
+        elem_params.resize(p_index.size());
+        vec.resize(p_index.size());
+        for (unsigned int i=0; i<p_index.size(); i++) {
+            elem_params[i] = _discipline->get_parameter(&(params[p_index[i]].get()));
+            vec[i].setZero(ndofs);
+        }
+        
+        _elem_multiparameter_sensitivity_calculations(*physics_elem, elem_params, vec);
+        
+        physics_elem->detach_active_solution_function();
+        
+        for (unsigned int i=0; i<p_index.size(); i++) {
+            
+            if (!dofs.if_constrained()) {
+                
+                adj_dR[p_index[i]] += adj.dot(vec[i]);
+                continue;
+            }
+            
+            // the constraints may add the constraining dofs to the indices
+            DenseRealVector v;
+            MAST::copy(v, vec[i]);
+            constrained_dof_indices = dofs.dof_indices();
+            dof_map.constrain_element_vector(v, constrained_dof_indices);
+            
+            for (unsigned int k=0; k<constrained_dof_indices.size(); k++)
+                adj_dR[p_index[i]] +=
+                (*localized_adjoint)(constrained_dof_indices[k]) * v(k);
+        }
+    }
+    
+    // if a solution function is attached, clear it
+    if (_sol_function)
+        _sol_function->clear();
+    
+    nonlin_sys.comm().sum(adj_dR);
+    
+    for (unsigned int i=0; i<params.size(); i++)
+        sens[i] -= adj_dR[i];
+}
+
+
+
+
+void
+MAST::NonlinearImplicitAssembly::
+_elem_multiparameter_sensitivity_calculations
+(MAST::ElementBase& elem,
+ const std::vector<const MAST::FunctionBase*>& params,
+ std::vector<RealVectorX>& vec) {
+    
+    libmesh_assert_equal_to(params.size(), vec.size());
+    
+    RealMatrixX mat;
+    
+    for (unsigned int i=0; i<params.size(); i++) {
+        
+        mat.setZero(vec[i].size(), vec[i].size());
+        
+        elem.sensitivity_param = params[i];
+        _elem_sensitivity_calculations(elem, false, vec[i], mat);
+    }
+}
+
+
+
+
+void
+MAST::NonlinearImplicitAssembly::
+_sensitivity_elem_params
+(const libMesh::ParameterVector& params,
+ std::map<libMesh::dof_id_type,
+ std::pair<const libMesh::Elem*, std::vector<unsigned int> > >& elem_params) {
+    
+    elem_params.clear();
+    
+    std::vector<const libMesh::Elem*> local_elems;
+    
+    for (unsigned int i=0; i<params.size(); i++) {
+        
+        const MAST::FunctionBase*
+        f = _discipline->get_parameter(&(params[i].get()));
+        
+        const std::vector<const libMesh::Elem*>&
+        elems = _sensitivity_elems(*f, local_elems);
+        
+        for (unsigned int j=0; j<elems.size(); j++) {
+            
+            std::pair<const libMesh::Elem*, std::vector<unsigned int> >&
+            val = elem_params[elems[j]->id()];
+            
+            val.first = elems[j];
+            val.second.push_back(i);
+        }
+    }
+}
+
+
@@ -25,10 +25,15 @@
 
 // libMesh includes
 #include "libmesh/nonlinear_implicit_system.h"
+#include "libmesh/threads.h"
 
 
 namespace MAST {
     
+    // Forward declerations
+    class NonlinearImplicitAssemblyElemThread;
+    
+    
     class NonlinearImplicitAssembly:
     public MAST::AssemblyBase,
     public libMesh::NonlinearImplicitSystem::ComputeResidualandJacobian {
@@ -97,6 +102,28 @@ namespace MAST {
                                              libMesh::NumericVector<Real>& JdX,
                                              libMesh::NonlinearImplicitSystem& S);
         
+        
+        /*!
+         *   tells the assembly to retain the localized solution used in
+         *   linearized_jacobian_solution_product() so that subsequent
+         *   products reuse it without localizing the solution again. This
+         *   is intended for matrix-free products with several perturbations
+         *   about the same solution, and the user must call
+         *   clear_localized_solution() when the solution changes. The
+         *   localized solution is cleared when this is set to false.
+         */
+        void set_retain_localized_solution(bool f);
+        
+        
+        /*!
+         *   marks the retained localized solution as outdated, so that the
+         *   next call to linearized_jacobian_solution_product() localizes
+         *   the solution provided to it.
+         */
+        void clear_localized_solution() {
+            _if_localized_sol_current = false;
+        }
+        
         /**
          * Assembly function.  This function will be called
          * to assemble the RHS of the sensitivity equations (which is -1 times
@@ -113,8 +140,100 @@ namespace MAST {
                               const unsigned int i,
                               libMesh::NumericVector<Real>& sensitivity_rhs);
         
+        
+        /*!
+         *   assembles the RHS of the sensitivity equations for all parameters
+         *   in \p parameters in \p sensitivity_rhs[i], which must be of the
+         *   same size as \p parameters. Each element that depends on at
+         *   least one of the parameters is initialized once, and its
+         *   residual sensitivity is computed for all the parameters that
+         *   it depends on during that visit.
+         */
+        virtual bool
+        sensitivity_assemble (const libMesh::ParameterVector& parameters,
+                              std::vector<libMesh::NumericVector<Real>*>& sensitivity_rhs);
+        
+        
+        /*!
+         *   computes the adjoint contribution \f$ -\lambda^T \partial R /
+         *   \partial p_i \f$ to the total sensitivity of an output for
+         *   each parameter \f$ p_i \f$ in \p params, and adds it to
+         *   \p sens[i]. \p adj_sol is the adjoint solution of the output
+         *   obtained from NonlinearSystem::adjoint_solve(), and \p X is the
+         *   solution about which the residual is linearized. The partial
+         *   derivative of the output should be added separately using
+         *   calculate_output_sensitivity() with \p if_total_sensitivity
+         *   set to false. When the sensitivity element index has been
+         *   built, only the elements that depend on at least one
+         *   parameter are visited, and each of these is visited once,
+         *   which makes this suitable for a large number of element-wise
+         *   parameters.
+         */
+        void
+        calculate_output_adjoint_sensitivity(const libMesh::ParameterVector& params,
+                                             const libMesh::NumericVector<Real>& X,
+                                             const libMesh::NumericVector<Real>& adj_sol,
+                                             std::vector<Real>& sens);
+        
+        
+        /*!
+         *   tells the assembly to compute the element quantities in
+         *   residual_and_jacobian() concurrently over the local elements
+         *   of this processor. The number of threads is specified through
+         *   libMesh using the \p --n_threads command line option. The
+         *   insertion of element quantities in the global vector and matrix
+         *   is serialized. This is false by default, unless
+         *   \p --threaded_assembly is specified on the command line.
+         */
+        void set_threaded_assembly(bool f) {
+            _if_threaded_assembly = f;
+        }
+        
+        
+        /*!
+         *   @returns true if threaded assembly has been requested
+         */
+        bool if_threaded_assembly() const {
+            return _if_threaded_assembly;
+        }
+        
     protected:
         
+        friend class MAST::NonlinearImplicitAssemblyElemThread;
+        
+        /*!
+         *   @returns true if the threaded assembly is requested, more
+         *   than one thread is available, and no solution function is
+         *   attached. The solution function is evaluated using a
+         *   libMesh::MeshFunction, which is not thread-safe.
+         */
+        bool _use_threaded_assembly() const;
+        
+        
+        /*!
+         *   computes the residual and Jacobian using the threaded
+         *   element loop. \p localized_solution is the ghosted solution
+         *   vector. The element cache, if enabled, is filled and its local
+         *   array obtained before the threads are started, so that the
+         *   threads only read them.
+         */
+        void
+        _threaded_residual_and_jacobian(const libMesh::NumericVector<Real>& localized_solution,
+                                        libMesh::NumericVector<Real>* R,
+                                        libMesh::SparseMatrix<Real>*  J);
+        
+        
+        /*!
+         *   provides the element with the solution, \p sol, and any other
+         *   data needed before the element calculations in the threaded
+         *   assembly. This is called concurrently from multiple threads,
+         *   and the derived classes must ensure that any modification of
+         *   data shared between elements is thread-safe.
+         */
+        virtual void _set_elem_solution(MAST::ElementBase& elem,
+                                        const RealVectorX& sol);
+        
+        
         /*!
          *   performs the element calculations over \par elem, and returns
          *   the element vector and matrix quantities in \par mat and
@@ -149,6 +268,35 @@ namespace MAST {
                                                     RealMatrixX& mat) = 0;
         
         
+        /*!
+         *   performs the element residual sensitivity calculations over
+         *   \p elem for each parameter in \p params, and returns the
+         *   sensitivity with respect to \p params[i] in \p vec[i]. The
+         *   vectors are sized and zeroed by the caller. The default
+         *   implementation calls _elem_sensitivity_calculations() for each
+         *   parameter.
+         */
+        virtual void
+        _elem_multiparameter_sensitivity_calculations
+        (MAST::ElementBase& elem,
+         const std::vector<const MAST::FunctionBase*>& params,
+         std::vector<RealVectorX>& vec);
+        
+        
+        /*!
+         *   collects in \p elem_params the local elements that depend on
+         *   at least one parameter in \p params, along with the indices
+         *   of the parameters that each element depends on. The map is
+         *   keyed on the element id so that the elements are visited in
+         *   a reproducible order.
+         */
+        void
+        _sensitivity_elem_params
+        (const libMesh::ParameterVector& params,
+         std::map<libMesh::dof_id_type,
+         std::pair<const libMesh::Elem*, std::vector<unsigned int> > >& elem_params);
+        
+        
         /*!
          *    a helper function to evaluate the numerical Jacobian 
          *    and compare it with the analytical Jacobian.
@@ -156,6 +304,38 @@ namespace MAST {
         void _check_element_numerical_jacobian(MAST::ElementBase& e,
                                                RealVectorX& sol);
 
+        /*!
+         *   flag to use threaded element assembly
+         */
+        bool _if_threaded_assembly;
+        
+        /*!
+         *   flag to retain the localized solution across calls to
+         *   linearized_jacobian_solution_product()
+         */
+        bool _if_retain_localized_sol;
+        
+        /*!
+         *   true if \p _localized_sol stores the solution about which
+         *   the linearized Jacobian products are being computed
+         */
+        bool _if_localized_sol_current;
+        
+        /*!
+         *   serializes the insertion of element quantities in the global
+         *   vector and matrix, and the access to any other data shared
+         *   between elements, during threaded assembly
+         */
+        libMesh::Threads::spin_mutex _thread_mutex;
+        
+        /*!
+         *   ghosted work vectors for the solution and its perturbation in
+         *   linearized_jacobian_solution_product(). These are retained
+         *   across calls to avoid their reallocation.
+         */
+        std::auto_ptr<libMesh::NumericVector<Real> >
+        _localized_sol,
+        _localized_dsol;
     };
 }
 
@@ -692,18 +692,28 @@ MAST::NonlinearSystem::assemble_residual_derivatives
     dynamic_cast<MAST::NonlinearImplicitAssembly&>
     (*this->nonlinear_solver->residual_and_jacobian_object);
     
-    assembly.sensitivity_assemble(parameters, 0, this->add_sensitivity_rhs());
+    // the residual sensitivity for all parameters is computed in a single
+    // pass over the elements
+    std::vector<libMesh::NumericVector<Real>*> rhs(parameters.size());
+    for (unsigned int i=0; i<parameters.size(); i++)
+        rhs[i] = &this->add_sensitivity_rhs(i);
+    
+    assembly.sensitivity_assemble(parameters, rhs);
 }
 
 
 
 void
-MAST::NonlinearSystem::adjoint_solve(MAST::OutputAssemblyBase &output) {
+MAST::NonlinearSystem::adjoint_solve(MAST::OutputFunctionBase& output) {
     
     libmesh_assert(!_output);
     
     _output = &output;
     
+    // libMesh solves for the adjoint of each QoI in the system
+    if (this->qoi.size() != 1)
+        this->qoi.resize(1);
+    
     libMesh::NonlinearImplicitSystem::adjoint_solve();
     
     _output = nullptr;
@@ -720,6 +730,14 @@ assemble_qoi_derivative (const libMesh::QoISet & qoi_indices,
     // make sure the output object has been set
     libmesh_assert(_output);
     
+    MAST::NonlinearImplicitAssembly& assembly =
+    dynamic_cast<MAST::NonlinearImplicitAssembly&>
+    (*this->nonlinear_solver->residual_and_jacobian_object);
+    
+    libMesh::NumericVector<Real>& rhs = this->add_adjoint_rhs(0);
+    rhs.zero();
     
+    // the constraints are applied to the element vectors by the assembly
+    assembly.calculate_output_derivative(*this->solution, *_output, rhs);
 }
 
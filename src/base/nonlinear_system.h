@@ -40,7 +40,7 @@ namespace MAST {
     class SlepcEigenSolver;
     class EigenSystemAssembly;
     class PhysicsDisciplineBase;
-    class OutputAssemblyBase;
+    class OutputFunctionBase;
     
     
     /*!
@@ -90,10 +90,9 @@ namespace MAST {
         
         
         /**
-         *   calculates and stores the sensitivity RHS in System::add_sensitivity_rhs(0).
-         *   This assumes that \p parameters is of size 1. For solving sensitivity
-         *   wrt multiple parameters, the user should call this method multiple 
-         *   times with the parameter vector modified.
+         *   calculates and stores the sensitivity RHS for the i^th parameter
+         *   in \p parameters in System::add_sensitivity_rhs(i). The RHS for
+         *   all parameters is assembled in a single pass over the elements.
          *   The RHS is \f$ - \frac{\partial R(U,p)}{\partial p}\f$
          */
         virtual void
@@ -113,7 +112,7 @@ namespace MAST {
         /*!
          *   solves the adjoint problem for the provided output function
          */
-        void adjoint_solve(MAST::OutputAssemblyBase& output);
+        void adjoint_solve(MAST::OutputFunctionBase& output);
         
         
         /**
@@ -335,10 +334,10 @@ namespace MAST {
         MAST::EigenSystemAssembly *        _eigenproblem_assemble_system_object;
 
         /*!
-         *    OutputAssemblyBase object for which the adjoint calculation
+         *    output function for which the adjoint calculation
          *    is being solved
          */
-        MAST::OutputAssemblyBase*       _output;
+        MAST::OutputFunctionBase*       _output;
         
         /**
          * Vector storing the local dof indices that will not be condensed.
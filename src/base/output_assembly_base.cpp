@@ -47,6 +47,9 @@ clear_discipline_and_system() {
         
     }
     
+    this->clear_element_cache();
+    this->clear_sensitivity_elem_index();
+    
     _discipline = nullptr;
     _system     = nullptr;
 }
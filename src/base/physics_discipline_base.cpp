@@ -153,6 +153,7 @@ set_property_for_subdomain(const libMesh::subdomain_id_type sid,
     libmesh_assert(elem_p_it == _element_property.end());
     
     _element_property[sid] = &prop;
+    _property_revision++;
 }
 
 
@@ -228,6 +229,34 @@ MAST::PhysicsDisciplineBase::get_parameter(const Real* par) const {
 
 
 
+
+void
+MAST::PhysicsDisciplineBase::freeze_dependencies() const {
+    
+    MAST::PropertyCardMapType::const_iterator
+    p_it  = _element_property.begin(),
+    p_end = _element_property.end();
+    
+    for ( ; p_it != p_end; p_it++)
+        p_it->second->freeze_dependencies();
+    
+    MAST::VolumeBCMapType::const_iterator
+    v_it  = _vol_bc_map.begin(),
+    v_end = _vol_bc_map.end();
+    
+    for ( ; v_it != v_end; v_it++)
+        v_it->second->freeze_dependencies();
+    
+    MAST::SideBCMapType::const_iterator
+    s_it  = _side_bc_map.begin(),
+    s_end = _side_bc_map.end();
+    
+    for ( ; s_it != s_end; s_it++)
+        s_it->second->freeze_dependencies();
+}
+
+
+
 void
 MAST::PhysicsDisciplineBase::
 init_system_dirichlet_bc(libMesh::System& sys) const {
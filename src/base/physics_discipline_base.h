@@ -61,7 +61,8 @@ namespace MAST {
         
         // Constructor
         PhysicsDisciplineBase(libMesh::EquationSystems& eq_sys):
-        _eq_systems(eq_sys)
+        _eq_systems(eq_sys),
+        _property_revision(0)
         { }
         
         /*!
@@ -231,11 +232,22 @@ namespace MAST {
                                           std::set<unsigned int>& dof_ids) const;
         
         /*!
-         *    sets the same property for all elements in the specified subdomain
+         *    sets the same property for all elements in the specified
+         *    subdomain. A property can be set only once for a subdomain.
          */
         void set_property_for_subdomain(const libMesh::subdomain_id_type sid,
                                         const MAST::ElementPropertyCardBase& prop);
         
+        /*!
+         *    @returns a counter that is incremented each time a property
+         *    card is assigned to a subdomain. Objects that retain data
+         *    built from the property cards compare this with the value at
+         *    the time the data was built.
+         */
+        unsigned int property_revision() const {
+            return _property_revision;
+        }
+        
         /*!
          *    get property card for the specified element
          */
@@ -263,6 +275,15 @@ namespace MAST {
         const MAST::FunctionBase* get_parameter(const Real* par) const;
         
         
+        /*!
+         *   freezes the dependency graphs of the element property cards and
+         *   the volume and side loads, so that their depends_on() methods
+         *   are a single bit test. This should be called again if any of
+         *   these are changed.
+         */
+        void freeze_dependencies() const;
+        
+        
     protected:
         
         /*!
@@ -275,6 +296,11 @@ namespace MAST {
          */
         MAST::PropertyCardMapType _element_property;
         
+        /*!
+         *   number of property card assignments
+         */
+        unsigned int _property_revision;
+        
         /*!
          *   map of sensitivity parameters and the corresponding functions that
          *   are directly dependent on these parameters
@@ -26,6 +26,7 @@
 #include "numerics/utility.h"
 #include "base/mesh_field_function.h"
 #include "base/nonlinear_system.h"
+#include "base/elem_dof_indices.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_solver.h"
@@ -95,6 +96,9 @@ clear_discipline_and_system( ) {
     // clear the association of this assembly object to the solver
     _transient_solver->clear_assembly();
     
+    this->clear_element_cache();
+    this->clear_sensitivity_elem_index();
+    
     _discipline       = nullptr;
     _transient_solver = nullptr;
     _system           = nullptr;
@@ -123,9 +127,10 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     RealVectorX vec;
     RealMatrixX mat;
     
-    std::vector<libMesh::dof_id_type> dof_indices;
+    MAST::ElemDofIndices elem_dofs;
     const libMesh::DofMap& dof_map = transient_sys.get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     
     // stores the localized solution, velocity, acceleration, etc. vectors.
@@ -149,12 +154,13 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
-        dof_map.dof_indices (elem, dof_indices);
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
+        const std::vector<libMesh::dof_id_type>& dof_indices = dofs.dof_indices();
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
+        unsigned int ndofs = dofs.size();
         vec.setZero(ndofs);
         mat.setZero(ndofs, ndofs);
         
@@ -171,26 +177,9 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
                                               J!=nullptr?true:false,
                                               vec, mat);
         
-        // copy to the libMesh matrix for further processing
-        DenseRealVector v;
-        DenseRealMatrix m;
-        if (R)
-            MAST::copy(v, vec);
-        if (J)
-            MAST::copy(m, mat);
-        
         // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        if (R && J)
-            dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
-        else if (R)
-            dof_map.constrain_element_vector(v, dof_indices);
-        else
-            dof_map.constrain_element_matrix(m, dof_indices);
-        
-        // add to the global matrices
-        if (R) R->add_vector(v, dof_indices);
-        if (J) J->add_matrix(m, dof_indices);
+        // Dirichlet constraints, etc., and add to the global matrices
+        dofs.add(dof_map, vec, mat, R, J);
     }
     
     // delete pointers to the local solutions
@@ -226,10 +215,12 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
     // iterate over each element, initialize it and get the relevant
     // analysis quantities
     RealVectorX vec;
+    RealMatrixX mat;
     
-    std::vector<libMesh::dof_id_type> dof_indices;
+    MAST::ElemDofIndices elem_dofs;
     const libMesh::DofMap& dof_map = transient_sys.get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     // stores the localized solution, velocity, acceleration, etc. vectors.
     // These pointers will have to be deleted
@@ -254,12 +245,13 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
-        dof_map.dof_indices (elem, dof_indices);
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
+        const std::vector<libMesh::dof_id_type>& dof_indices = dofs.dof_indices();
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
+        unsigned int ndofs = dofs.size();
         vec.setZero(ndofs);
 
         
@@ -278,16 +270,9 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
                                                                       dof_indices,
                                                                       vec);
         
-        // copy to the libMesh matrix for further processing
-        DenseRealVector v;
-        MAST::copy(v, vec);
-
         // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        dof_map.constrain_element_vector(v, dof_indices);
-        
-        // add to the global matrices
-        JdX.add_vector(v, dof_indices);
+        // Dirichlet constraints, etc., and add to the global vector
+        dofs.add(dof_map, vec, mat, &JdX, nullptr);
     }
     
     // delete pointers to the local solutions
@@ -321,9 +306,10 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
     RealVectorX vec, sol, vel;
     RealMatrixX mat;
     
-    std::vector<libMesh::dof_id_type> dof_indices;
+    MAST::ElemDofIndices elem_dofs;
     const libMesh::DofMap& dof_map = transient_sys.get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     // localize the solution and velocity for element assembly
     std::auto_ptr<libMesh::NumericVector<Real> >
@@ -351,21 +337,18 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
         
         const libMesh::Elem* elem = *el;
         
-        dof_map.dof_indices (elem, dof_indices);
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
+        const std::vector<libMesh::dof_id_type>& dof_indices = dofs.dof_indices();
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
-        vel.setZero(ndofs);
+        unsigned int ndofs = dofs.size();
         vec.setZero(ndofs);
         mat.setZero(ndofs, ndofs);
         
-        for (unsigned int i=0; i<dof_indices.size(); i++) {
-            sol(i) = solution(dof_indices[i]);
-            vel(i) = velocity(dof_indices[i]);
-        }
+        dofs.gather(solution, sol);
+        dofs.gather(velocity, vel);
         
         physics_elem->set_solution(sol);
         physics_elem->set_velocity(vel);
@@ -379,15 +362,9 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
         // perform the element level calculations
         _transient_solver->_elem_sensitivity_calculations(*physics_elem, dof_indices, vec);
         
-        DenseRealVector v;
-        MAST::copy(v, vec);
-        
         // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        dof_map.constrain_element_vector(v, dof_indices);
-        
-        // add to the global matrices
-        sensitivity_rhs.add_vector(v, dof_indices);
+        // Dirichlet constraints, etc., and add to the global vector
+        dofs.add(dof_map, vec, mat, &sensitivity_rhs, nullptr);
     }
     
     
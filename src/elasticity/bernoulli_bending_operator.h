@@ -24,6 +24,7 @@
 // MAST includes
 #include "elasticity/bending_operator.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/scratch_arena.h"
 
 // libMesh includes
 #include "libmesh/point.h"
@@ -120,7 +121,9 @@ initialize_bending_strain_operator_for_yz (const libMesh::FEBase& fe,
     // N3 = (1.0/4.0) * (0.0 -  1.0        - 2.0*xi  +         3.0*pow(xi,2));  // needs a -1.0 factor for theta_y
     // N4 = (1.0/4.0) * (0.0 -  1.0        + 2.0*xi  +         3.0*pow(xi,2));  // needs a -1.0 factor for theta_y
     
-    RealVectorX N = RealVectorX::Zero(2);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &N = scratch.vector(2);
     
     // second order shape function derivative
     N(0) = (0.5/_length) * (  0.0     +  12.0/_length*xi);
@@ -22,6 +22,7 @@
 
 // MAST includes
 #include "elasticity/bending_operator.h"
+#include "numerics/scratch_arena.h"
 
 
 // libMesh includes
@@ -187,15 +188,17 @@ initialize_bending_strain_operator_for_z (const libMesh::FEBase& fe,
     const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = _fe->get_dphi();
     const unsigned int n_phi = (unsigned int)dphi.size();
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealVectorX
-    phi       = RealVectorX::Zero(n_phi),
-    dbetaxdx  = RealVectorX::Zero(9),
-    dbetaxdy  = RealVectorX::Zero(9),
-    dbetaydx  = RealVectorX::Zero(9),
-    dbetaydy  = RealVectorX::Zero(9),
-    w         = RealVectorX::Zero(3),
-    thetax    = RealVectorX::Zero(3),
-    thetay    = RealVectorX::Zero(3);
+    &phi       = scratch.vector(n_phi),
+    &dbetaxdx  = scratch.vector(9),
+    &dbetaxdy  = scratch.vector(9),
+    &dbetaydx  = scratch.vector(9),
+    &dbetaydy  = scratch.vector(9),
+    &w         = scratch.vector(3),
+    &thetax    = scratch.vector(3),
+    &thetay    = scratch.vector(3);
 
     
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
@@ -103,6 +103,165 @@ MAST::FSIGeneralizedAeroForceAssembly::clear_discipline_and_system() {
 
 
 
+namespace MAST {
+    
+    class FSIGeneralizedAeroForceAssembly::ModeRHSUpdate:
+    public MAST::ComplexSolverBase::RHSUpdate {
+        
+    public:
+        
+        ModeRHSUpdate(MAST::FSIGeneralizedAeroForceAssembly& assembly,
+                      std::vector<libMesh::NumericVector<Real>*>& localized_basis,
+                      libMesh::NumericVector<Real>& localized_zero,
+                      libMesh::NumericVector<Real>* localized_solution,
+                      ComplexMatrixX& mat,
+                      MAST::Parameter* p):
+        _assembly           (assembly),
+        _localized_basis    (localized_basis),
+        _localized_zero     (localized_zero),
+        _mat                (mat),
+        _p                  (p) {
+            
+            // the element dofs, base solution and the restriction of the
+            // basis to each element are the same for all modes. So these
+            // are extracted once here instead of for each mode.
+            const unsigned int
+            n_basis = (unsigned int)localized_basis.size();
+            
+            MAST::NonlinearSystem& sys = _assembly._system->system();
+            const libMesh::DofMap& dof_map = sys.get_dof_map();
+            
+            libMesh::MeshBase::const_element_iterator       el     =
+            sys.get_mesh().active_local_elements_begin();
+            const libMesh::MeshBase::const_element_iterator end_el =
+            sys.get_mesh().active_local_elements_end();
+            
+            for ( ; el != end_el; ++el)
+                _elems.push_back(*el);
+            
+            _dof_indices.resize(_elems.size());
+            _sol.resize(_elems.size());
+            _basis_mat.resize(_elems.size());
+            
+            for (unsigned int e=0; e<_elems.size(); e++) {
+                
+                std::vector<libMesh::dof_id_type>& dofs = _dof_indices[e];
+                dof_map.dof_indices (_elems[e], dofs);
+                
+                unsigned int ndofs = (unsigned int)dofs.size();
+                _sol[e].setZero(ndofs);
+                _basis_mat[e].setZero(ndofs, n_basis);
+                
+                for (unsigned int i=0; i<ndofs; i++) {
+                    
+                    if (localized_solution)
+                        _sol[e](i) = (*localized_solution)(dofs[i]);
+                    
+                    for (unsigned int j=0; j<n_basis; j++)
+                        _basis_mat[e](i,j) = (*localized_basis[j])(dofs[i]);
+                }
+            }
+        }
+        
+        
+        virtual ~ModeRHSUpdate() { }
+        
+        
+        virtual void init_rhs(unsigned int i) {
+            
+            // set up the fluid flexible-surface boundary condition for this mode
+            _assembly._complex_displ->clear();
+            _assembly._complex_displ->init(*_localized_basis[i], _localized_zero);
+        }
+        
+        
+        virtual void process_solution(unsigned int i) {
+            
+            MAST::ComplexSolverBase& solver = *_assembly._fluid_complex_solver;
+            
+            // use this solution to initialize the structural boundary conditions
+            _assembly._pressure_function->init(solver.get_assembly().base_sol());
+            
+            // use this solution to initialize the structural boundary conditions
+            _assembly._freq_domain_pressure_function->init
+            (solver.get_assembly().base_sol(),
+             solver.real_solution(_p != nullptr),
+             solver.imag_solution(_p != nullptr));
+            
+            const libMesh::DofMap&
+            dof_map = _assembly._system->system().get_dof_map();
+            
+            RealVectorX    zero;
+            ComplexVectorX vec;
+            DenseRealVector v1;
+            RealVectorX     v2;
+            std::auto_ptr<MAST::ElementBase> elem_owner;
+            
+            // assemble the complex small-disturbance force vector
+            for (unsigned int e=0; e<_elems.size(); e++) {
+                
+                const std::vector<libMesh::dof_id_type>& dofs = _dof_indices[e];
+                
+                MAST::ElementBase&
+                physics_elem = *_assembly._get_elem(*_elems[e], elem_owner);
+                
+                unsigned int ndofs = (unsigned int)dofs.size();
+                zero.setZero(ndofs);
+                vec.setZero(ndofs);
+                
+                physics_elem.set_solution(_sol[e]);
+                physics_elem.set_velocity(zero);     // set to zero value
+                physics_elem.set_acceleration(zero); // set to zero value
+                
+                if (_assembly._sol_function)
+                    physics_elem.attach_active_solution_function(*_assembly._sol_function);
+                
+                _assembly._elem_aerodynamic_force_calculations(physics_elem, vec);
+                
+                // constrain and set the real component
+                MAST::copy(v1, vec.real());
+                dof_map.constrain_element_vector(v1, dofs);
+                MAST::copy(v2, v1);
+                vec.real() =  v2;
+                
+                // constrain and set the imag component
+                MAST::copy(v1, vec.imag());
+                dof_map.constrain_element_vector(v1, dofs);
+                MAST::copy(v2, v1);
+                vec.imag() =  v2;
+                
+                // project the force vector on all the structural modes for the
+                // i^th column of the generalized aerodynamic force matrix
+                _mat.col(i) += _basis_mat[e].transpose() * vec;
+                
+                physics_elem.detach_active_solution_function();
+            }
+        }
+        
+    protected:
+        
+        MAST::FSIGeneralizedAeroForceAssembly&       _assembly;
+        
+        std::vector<libMesh::NumericVector<Real>*>&  _localized_basis;
+        
+        libMesh::NumericVector<Real>&                _localized_zero;
+        
+        ComplexMatrixX&                              _mat;
+        
+        MAST::Parameter*                             _p;
+        
+        std::vector<const libMesh::Elem*>                  _elems;
+        
+        std::vector<std::vector<libMesh::dof_id_type> >    _dof_indices;
+        
+        std::vector<RealVectorX>                           _sol;
+        
+        std::vector<RealMatrixX>                           _basis_mat;
+    };
+}
+
+
+
 void
 MAST::FSIGeneralizedAeroForceAssembly::
 assemble_generalized_aerodynamic_force_matrix
@@ -118,18 +277,8 @@ assemble_generalized_aerodynamic_force_matrix
     unsigned int
     n_basis = (unsigned int)basis.size();
     
-
-    // iterate over each element, initialize it and get the relevant
-    // analysis quantities
-    RealVectorX    sol;
-    ComplexVectorX vec;
-    RealMatrixX    basis_mat;
-
     mat.setZero(n_basis, n_basis);
 
-    std::vector<libMesh::dof_id_type> dof_indices;
-    std::auto_ptr<MAST::ElementBase> physics_elem;
-    
     std::auto_ptr<libMesh::NumericVector<Real> >
     localized_solution,
     localized_zero;
@@ -151,95 +300,19 @@ assemble_generalized_aerodynamic_force_matrix
         _sol_function->init( *_base_sol);
     
     
-    // iterate over each structural mode to calculate the
-    // fluid small-disturbance solution
-    for (unsigned int i=0; i<n_basis; i++) {
-        
-        // set up the fluid flexible-surface boundary condition for this mode
-        _complex_displ->clear();
-        _complex_displ->init(*localized_basis[i], *localized_zero);
-        
-        
-        // solve the complex smamll-disturbance fluid-equations
-        _fluid_complex_solver->solve_block_matrix(p);
-        
-        // use this solution to initialize the structural boundary conditions
-        _pressure_function->init(_fluid_complex_solver->get_assembly().base_sol());
-        
-        // use this solution to initialize the structural boundary conditions
-        _freq_domain_pressure_function->init
-        (_fluid_complex_solver->get_assembly().base_sol(),
-         _fluid_complex_solver->real_solution(p != nullptr),
-         _fluid_complex_solver->imag_solution(p != nullptr));
-
-        
-        const libMesh::DofMap& dof_map = _system->system().get_dof_map();
-        
-        // assemble the complex small-disturbance force vector force vector
-        libMesh::MeshBase::const_element_iterator       el     =
-        _system->system().get_mesh().active_local_elements_begin();
-        const libMesh::MeshBase::const_element_iterator end_el =
-        _system->system().get_mesh().active_local_elements_end();
-        
-        
-        for ( ; el != end_el; ++el) {
-            
-            const libMesh::Elem* elem = *el;
-            
-            dof_map.dof_indices (elem, dof_indices);
-            
-            physics_elem.reset(_build_elem(*elem).release());
-            
-            // get the solution
-            unsigned int ndofs = (unsigned int)dof_indices.size();
-            sol.setZero(ndofs);
-            vec.setZero(ndofs);
-            basis_mat.setZero(ndofs, n_basis);
-            
-            for (unsigned int i=0; i<dof_indices.size(); i++) {
-                
-                if (_base_sol)
-                    sol(i) = (*localized_solution)(dof_indices[i]);
-                
-                for (unsigned int j=0; j<n_basis; j++)
-                    basis_mat(i,j) = (*localized_basis[j])(dof_indices[i]);
-            }
-            
-            
-            physics_elem->set_solution(sol);
-            sol.setZero();
-            physics_elem->set_velocity(sol);     // set to zero value
-            physics_elem->set_acceleration(sol); // set to zero value
-            
-            
-            if (_sol_function)
-                physics_elem->attach_active_solution_function(*_sol_function);
-            
-            _elem_aerodynamic_force_calculations(*physics_elem, vec);
-            
-            DenseRealVector v1;
-            RealVectorX     v2;
-            
-            // constrain and set the real component
-            MAST::copy(v1, vec.real());
-            dof_map.constrain_element_vector(v1, dof_indices);
-            MAST::copy(v2, v1);
-            vec.real() =  v2;
-            
-            // constrain and set the imag component
-            MAST::copy(v1, vec.imag());
-            dof_map.constrain_element_vector(v1, dof_indices);
-            MAST::copy(v2, v1);
-            vec.imag() =  v2;
-            
-            // project the force vector on all the structural modes for the
-            // i^th column of the generalized aerodynamic force matrix
-            mat.col(i) += basis_mat.transpose() * vec;
-            
-            physics_elem->detach_active_solution_function();
-        }
-    }
+    // the fluid small-disturbance operator does not depend on the mode
+    // shape, so all modes are solved with a single assembly and
+    // factorization of the operator. Each fluid solution is projected on
+    // the structural modes as soon as it is available.
+    MAST::FSIGeneralizedAeroForceAssembly::ModeRHSUpdate
+    rhs(*this,
+        localized_basis,
+        *localized_zero,
+        localized_solution.get(),
+        mat,
+        p);
     
+    _fluid_complex_solver->solve_block_matrix_multiple_rhs(rhs, n_basis, p);
     
     
     // if a solution function is attached, clear it
@@ -255,4 +328,3 @@ assemble_generalized_aerodynamic_force_matrix
     // this assumes that the structural comm is a subset of fluid comm
     MAST::parallel_sum(_system->system().comm(), mat);
 }
-
@@ -89,6 +89,13 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   sets up the fluid excitation for each structural mode and
+         *   projects the resulting pressure on the structural modes to
+         *   obtain the corresponding column of the GAF matrix
+         */
+        class ModeRHSUpdate;
+        
         /*!
          *   complex solver
          */
@@ -20,10 +20,15 @@
 #ifndef mast_mindlin_bending_operator_h
 #define mast_mindlin_bending_operator_h
 
+// C++ includes
+#include <map>
+
+
 // MAST includes
 #include "elasticity/bending_operator.h"
 #include "property_cards/element_property_card_base.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/scratch_arena.h"
 #include "mesh/local_elem_base.h"
 #include "base/nonlinear_system.h"
 
@@ -35,6 +40,84 @@
 namespace MAST {
     
     
+    /*!
+     *   stores the reduced-integration FE and quadrature objects used for
+     *   transverse shear, for each combination of element type, FE type
+     *   and quadrature order. The objects are reinitialized for each
+     *   element that uses them, and are shared by all Mindlin operators
+     *   on a thread so that they are not constructed for each element.
+     */
+    class MindlinShearFECache {
+        
+    public:
+        
+        MindlinShearFECache() { }
+        
+        ~MindlinShearFECache() {
+            
+            std::map<key_type, std::pair<libMesh::FEBase*, libMesh::QBase*> >::iterator
+            it  = _fe_map.begin(),
+            end = _fe_map.end();
+            
+            for ( ; it != end; it++) {
+                delete it->second.first;
+                delete it->second.second;
+            }
+        }
+        
+        
+        /*!
+         *   @returns the FE object for reduced integration on \par e with
+         *   a quadrature rule of order \par order, reinitialized on \par e.
+         */
+        libMesh::FEBase& reinit(const libMesh::Elem& e,
+                                const libMesh::FEType& fe_type,
+                                const int order) {
+            
+            key_type key(std::make_pair((int)e.type(), fe_type), order);
+            
+            std::map<key_type, std::pair<libMesh::FEBase*, libMesh::QBase*> >::iterator
+            it = _fe_map.find(key);
+            
+            if (it == _fe_map.end()) {
+                
+                libMesh::FEBase* fe = libMesh::FEBase::build(e.dim(), fe_type).release();
+                libMesh::QBase*  qrule =
+                fe_type.default_quadrature_rule(e.dim(), order).release();
+                
+                fe->attach_quadrature_rule(qrule);
+                fe->get_phi();
+                fe->get_JxW();
+                fe->get_xyz();
+                fe->get_dphi();
+                
+                it = _fe_map.insert(std::make_pair(key, std::make_pair(fe, qrule))).first;
+            }
+            
+            it->second.first->reinit(&e);
+            
+            return *it->second.first;
+        }
+        
+        
+        /*!
+         *   @returns the cache for the calling thread
+         */
+        static MAST::MindlinShearFECache& thread_cache() {
+            
+            static thread_local MAST::MindlinShearFECache cache;
+            return cache;
+        }
+        
+    protected:
+        
+        typedef std::pair<std::pair<int, libMesh::FEType>, int> key_type;
+        
+        std::map<key_type, std::pair<libMesh::FEBase*, libMesh::QBase*> > _fe_map;
+    };
+    
+    
+    
     class MindlinBendingOperator:
     public MAST::BendingOperator2D {
         
@@ -42,7 +125,8 @@ namespace MAST {
         
         MindlinBendingOperator(MAST::StructuralElementBase& elem):
         MAST::BendingOperator2D(elem),
-        _shear_quadrature_reduction(2)
+        _shear_quadrature_reduction(2),
+        _shear_quadrature_order(-1)
         { }
         
         virtual ~MindlinBendingOperator() { }
@@ -85,10 +169,40 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   initializes the reduced-integration shape function data for
+         *   transverse shear, if this has not already been done for the
+         *   current quadrature order.
+         */
+        void _init_shear_quadrature_data();
+        
         /*!
          *   reduction in quadrature for shear energy
          */
         unsigned int _shear_quadrature_reduction;
+        
+        /*!
+         *   quadrature order for which the transverse shear data below
+         *   was computed. This is -1 if the data has not been computed.
+         */
+        int _shear_quadrature_order;
+        
+        /*!
+         *   shape functions and their x- and y-derivatives at the
+         *   reduced-integration points. Each column stores the values at
+         *   one quadrature point.
+         */
+        RealMatrixX _shear_phi, _shear_dphi_dx, _shear_dphi_dy;
+        
+        /*!
+         *   quadrature weights times Jacobian at the reduced-integration points
+         */
+        std::vector<Real> _shear_JxW;
+        
+        /*!
+         *   locations of the reduced-integration points
+         */
+        std::vector<libMesh::Point> _shear_xyz;
     };
 }
 
@@ -118,7 +232,9 @@ initialize_bending_strain_operator_for_z(const libMesh::FEBase& fe,
     
     const unsigned int n_phi = (unsigned int)phi.size();
     
-    RealVectorX phi_vec = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec = scratch.vector(n_phi);
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
         phi_vec(i_nd) = dphi[i_nd][qp](0);  // dphi/dx
     
@@ -141,6 +257,51 @@ initialize_bending_strain_operator_for_z(const libMesh::FEBase& fe,
 
 
 
+inline void
+MAST::MindlinBendingOperator::_init_shear_quadrature_data() {
+    
+    const MAST::ElementPropertyCardBase& property = _structural_elem.elem_property();
+    const libMesh::FEType fe_type = _structural_elem.fe().get_fe_type();
+    
+    const int
+    order = (int)property.extra_quadrature_order(_elem, fe_type)
+    - (int)_shear_quadrature_reduction;
+    
+    // the element geometry does not change, so the data is recomputed
+    // only if the quadrature order changes
+    if (order == _shear_quadrature_order)
+        return;
+    
+    libMesh::FEBase&
+    fe = MAST::MindlinShearFECache::thread_cache().reinit(_elem, fe_type, order);
+    
+    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
+    const std::vector<std::vector<Real> >& phi = fe.get_phi();
+    
+    const unsigned int
+    n_phi = (unsigned int)phi.size(),
+    n_qp  = (unsigned int)fe.get_JxW().size();
+    
+    _shear_phi.setZero(n_phi, n_qp);
+    _shear_dphi_dx.setZero(n_phi, n_qp);
+    _shear_dphi_dy.setZero(n_phi, n_qp);
+    
+    for (unsigned int qp=0; qp<n_qp; qp++)
+        for (unsigned int i_nd=0; i_nd<n_phi; i_nd++) {
+            
+            _shear_phi(i_nd, qp)     = phi[i_nd][qp];
+            _shear_dphi_dx(i_nd, qp) = dphi[i_nd][qp](0);
+            _shear_dphi_dy(i_nd, qp) = dphi[i_nd][qp](1);
+        }
+    
+    _shear_JxW = fe.get_JxW();
+    _shear_xyz = fe.get_xyz();
+    
+    _shear_quadrature_order = order;
+}
+
+
+
 void
 MAST::MindlinBendingOperator::
 calculate_transverse_shear_residual(bool request_jacobian,
@@ -150,51 +311,35 @@ calculate_transverse_shear_residual(bool request_jacobian,
 {
     const MAST::ElementPropertyCardBase& property = _structural_elem.elem_property();
     
-    // make an fe and quadrature object for the requested order for integrating
-    // transverse shear
-    
-    std::auto_ptr<libMesh::FEBase> fe;
-    std::auto_ptr<libMesh::QBase> qrule;
-    libMesh::FEType fe_type = _structural_elem.fe().get_fe_type();
-    
-    fe.reset(libMesh::FEBase::build(_elem.dim(), fe_type).release());
-    qrule.reset(fe_type.default_quadrature_rule
-                (_elem.dim(),
-                 property.extra_quadrature_order(_elem, fe->get_fe_type())
-                 - _shear_quadrature_reduction).release());
-    fe->attach_quadrature_rule(qrule.get());
-    fe->get_phi();
-    fe->get_JxW();
-    fe->get_xyz();
-    fe->get_dphi();
+    // get the reduced-integration data for integrating transverse shear
+    _init_shear_quadrature_data();
     
-    fe->reinit(&_elem);
-    
-    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe->get_dphi();
-    const std::vector<std::vector<Real> >& phi = fe->get_phi();
-    const std::vector<Real>& JxW = fe->get_JxW();
-    const std::vector<libMesh::Point>& xyz = fe->get_xyz();
+    const std::vector<Real>& JxW = _shear_JxW;
+    const std::vector<libMesh::Point>& xyz = _shear_xyz;
     
     const unsigned int
-    n_phi = (unsigned int)phi.size(),
+    n_phi = (unsigned int)_shear_phi.rows(),
     n2    = 6*n_phi;
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealVectorX
-    phi_vec   = RealVectorX::Zero(n_phi),
-    vec3_n2   = RealVectorX::Zero(n2),
-    vec4_2    = RealVectorX::Zero(2),
-    vec5_2    = RealVectorX::Zero(2);
+    &phi_vec   = scratch.vector(n_phi),
+    &vec3_n2   = scratch.vector(n2),
+    &vec4_2    = scratch.vector(2),
+    &vec5_2    = scratch.vector(2);
     RealMatrixX
-    material_trans_shear_mat,
-    mat2_n2n2    = RealMatrixX::Zero(n2,n2),
-    mat4_2n2     = RealMatrixX::Zero(2,n2);
+    &material_trans_shear_mat = scratch.matrix(2,2),
+    &mat2_n2n2    = scratch.matrix(n2,n2),
+    &mat4_2n2     = scratch.matrix(2,n2);
     
     
-    FEMOperatorMatrix Bmat_trans;
+    FEMOperatorMatrix &Bmat_trans = scratch.operator_matrix();
     Bmat_trans.reinit(2, 6, n_phi); // only two shear stresses
     
-    std::auto_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff = property.transverse_shear_stiffness_matrix(_structural_elem);
+    const MAST::FieldFunction<RealMatrixX>
+    &mat_stiff = property.property_matrix(MAST::TRANSVERSE_SHEAR_STIFFNESS_MATRIX,
+                                          _structural_elem);
     
     libMesh::Point p;
     
@@ -203,29 +348,23 @@ calculate_transverse_shear_residual(bool request_jacobian,
         _structural_elem.local_elem().global_coordinates_location(xyz[qp], p);
         
         if (!sens_param)
-            (*mat_stiff)(p,
-                         _structural_elem.system().time,
-                         material_trans_shear_mat);
+            mat_stiff(p,
+                      _structural_elem.system().time,
+                      material_trans_shear_mat);
         else
-            mat_stiff->derivative(  *sens_param,
-                                  p,
-                                  _structural_elem.system().time,
-                                  material_trans_shear_mat);
+            mat_stiff.derivative(*sens_param,
+                                 p,
+                                 _structural_elem.system().time,
+                                 material_trans_shear_mat);
         
         // initialize the strain operator
-        for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
-            phi_vec(i_nd) = dphi[i_nd][qp](0);  // dphi/dx
-        
+        phi_vec = _shear_dphi_dx.col(qp);  // dphi/dx
         Bmat_trans.set_shape_function(0, 2, phi_vec); // gamma-xz:  w
         
-        for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
-            phi_vec(i_nd) = dphi[i_nd][qp](1);  // dphi/dy
-        
+        phi_vec = _shear_dphi_dy.col(qp);  // dphi/dy
         Bmat_trans.set_shape_function(1, 2, phi_vec); // gamma-yz : w
         
-        for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
-            phi_vec(i_nd) = phi[i_nd][qp];  // phi
-        
+        phi_vec = _shear_phi.col(qp);  // phi
         Bmat_trans.set_shape_function(0, 4, phi_vec); // gamma-xz:  thetay
         phi_vec  *= -1.0;
         Bmat_trans.set_shape_function(1, 3, phi_vec); // gamma-yz : thetax
@@ -233,7 +372,7 @@ calculate_transverse_shear_residual(bool request_jacobian,
         
         // now add the transverse shear component
         Bmat_trans.vector_mult(vec4_2, _structural_elem.local_solution());
-        vec5_2 = material_trans_shear_mat * vec4_2;
+        vec5_2.noalias() = material_trans_shear_mat * vec4_2;
         Bmat_trans.vector_mult_transpose(vec3_n2, vec5_2);
         local_f += JxW[qp] * vec3_n2;
         
@@ -20,6 +20,7 @@
 // MAST includes
 #include "elasticity/solid_element_3d.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/scratch_arena.h"
 #include "mesh/local_elem_base.h"
 #include "property_cards/element_property_card_base.h"
 #include "base/boundary_condition_base.h"
@@ -32,11 +33,28 @@ MAST::StructuralElement3D::
 StructuralElement3D(MAST::SystemInitialization& sys,
                     const libMesh::Elem& elem,
                     const MAST::ElementPropertyCardBase& p):
-MAST::StructuralElementBase(sys, elem, p) {
+MAST::StructuralElementBase(sys, elem, p),
+_n_phi_fixed_kernel(0) {
     
     // now initialize the finite element data structures
     _init_fe_and_qrule(get_elem_for_quadrature(), &_fe, &_qrule);
     
+    // select the fixed-size internal residual kernel, if one is
+    // available for this element type and interpolation
+    switch (_elem.type()) {
+            
+        case libMesh::TET4:
+        case libMesh::TET10:
+        case libMesh::HEX8:
+        case libMesh::HEX20:
+        case libMesh::HEX27:
+            if (_fe->n_shape_functions() == _elem.n_nodes())
+                _n_phi_fixed_kernel = _elem.n_nodes();
+            break;
+            
+        default:
+            break;
+    }
 }
 
 
@@ -132,45 +150,115 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
                                              RealVectorX& f,
                                              RealMatrixX& jac) {
     
+    switch (_n_phi_fixed_kernel) {
+            
+        case 4:
+            return _internal_residual<4>(request_jacobian, f, jac);
+            
+        case 8:
+            return _internal_residual<8>(request_jacobian, f, jac);
+            
+        case 10:
+            return _internal_residual<10>(request_jacobian, f, jac);
+            
+        case 20:
+            return _internal_residual<20>(request_jacobian, f, jac);
+            
+        case 27:
+            return _internal_residual<27>(request_jacobian, f, jac);
+            
+        default:
+            return _internal_residual<Eigen::Dynamic>(request_jacobian, f, jac);
+    }
+}
+
+
+
+
+template <int NPhi>
+bool
+MAST::StructuralElement3D::_internal_residual(bool request_jacobian,
+                                              RealVectorX& f,
+                                              RealMatrixX& jac) {
+    
+    // number of dofs, and the number of incompatible modes
+    const int
+    N2 = (NPhi == Eigen::Dynamic)? Eigen::Dynamic : 3*NPhi,
+    N3 = 30;
+    
+    typedef Eigen::Matrix<Real, 6, 6>   Matrix66;
+    typedef Eigen::Matrix<Real, 6, 3>   Matrix63;
+    typedef Eigen::Matrix<Real, 3, 3>   Matrix33;
+    typedef Eigen::Matrix<Real, 6, N3>  Matrix6N3;
+    typedef Eigen::Matrix<Real, 3, N3>  Matrix3N3;
+    typedef Eigen::Matrix<Real, N3, N3> MatrixN3N3;
+    typedef Eigen::Matrix<Real, 6, N2>  Matrix6N2;
+    typedef Eigen::Matrix<Real, 3, N2>  Matrix3N2;
+    typedef Eigen::Matrix<Real, N2, N2> MatrixN2N2;
+    typedef Eigen::Matrix<Real, N2, N3> MatrixN2N3;
+    typedef Eigen::Matrix<Real, 6, 1>   Vector6;
+    typedef Eigen::Matrix<Real, 3, 1>   Vector3;
+    typedef Eigen::Matrix<Real, N3, 1>  VectorN3;
+    typedef Eigen::Matrix<Real, N2, 1>  VectorN2;
+    
     const std::vector<Real>& JxW            = _fe->get_JxW();
     const std::vector<libMesh::Point>& xyz  = _fe->get_xyz();
     const unsigned int
     n_phi              = (unsigned int)_fe->n_shape_functions(),
     n1                 =6,
     n2                 =3*n_phi,
-    n3                 =30;
+    n3                 =N3;
+    
+    libmesh_assert(NPhi == Eigen::Dynamic || NPhi == (int)n_phi);
     
+    // the material matrix is evaluated by the property card function,
+    // which uses dynamic storage, and is copied to the fixed size matrix
+    // at each qp. The strain operators are initialized in place.
     RealMatrixX
-    material_mat,
-    mat_x        = RealMatrixX::Zero(6,3),
-    mat_y        = RealMatrixX::Zero(6,3),
-    mat_z        = RealMatrixX::Zero(6,3),
-    mat1_n1n2    = RealMatrixX::Zero(n1, n2),
-    mat2_n2n2    = RealMatrixX::Zero(n2, n2),
-    mat3_3n2     = RealMatrixX::Zero(3, n2),
-    mat4_33      = RealMatrixX::Zero(3, 3),
-    mat5_n1n3    = RealMatrixX::Zero(n1, n3),
-    mat6_n2n3    = RealMatrixX::Zero(n2, n3),
-    mat7_3n3     = RealMatrixX::Zero(3, n3),
-    Gmat         = RealMatrixX::Zero(6, n3),
-    K_alphaalpha = RealMatrixX::Zero(n3, n3),
-    K_ualpha     = RealMatrixX::Zero(n2, n3),
-    K_corr       = RealMatrixX::Zero(n2, n2);
+    material_mat;
     RealVectorX
-    strain    = RealVectorX::Zero(6),
-    stress    = RealVectorX::Zero(6),
-    vec1_n1   = RealVectorX::Zero(n1),
-    vec2_n2   = RealVectorX::Zero(n2),
-    vec3_3    = RealVectorX::Zero(3),
-    local_disp= RealVectorX::Zero(n2),
-    f_alpha   = RealVectorX::Zero(n3),
-    &alpha    = *_incompatible_sol;
+    local_disp   = RealVectorX::Zero(n2);
+    
+    Matrix66
+    C;
+    Matrix63
+    mat_x        = Matrix63::Zero(),
+    mat_y        = Matrix63::Zero(),
+    mat_z        = Matrix63::Zero();
+    Matrix33
+    mat4_33      = Matrix33::Zero();
+    Matrix6N3
+    mat5_n1n3,
+    Gmat         = Matrix6N3::Zero();
+    Matrix3N3
+    mat7_3n3;
+    MatrixN3N3
+    K_alphaalpha = MatrixN3N3::Zero(n3, n3);
+    Matrix6N2
+    mat1_n1n2    = Matrix6N2::Zero(n1, n2);
+    Matrix3N2
+    mat3_3n2     = Matrix3N2::Zero(3, n2);
+    MatrixN2N2
+    mat2_n2n2    = MatrixN2N2::Zero(n2, n2);
+    MatrixN2N3
+    mat6_n2n3    = MatrixN2N3::Zero(n2, n3),
+    K_ualpha     = MatrixN2N3::Zero(n2, n3);
+    Vector6
+    strain       = Vector6::Zero(),
+    stress;
+    Vector3
+    vec3_3;
+    VectorN2
+    vec2_n2      = VectorN2::Zero(n2);
+    VectorN3
+    f_alpha      = VectorN3::Zero(n3),
+    alpha        = *_incompatible_sol;
     
     // copy the values from the global to the local element
     local_disp.topRows(n2) = _local_sol.topRows(n2);
     
-    std::auto_ptr<MAST::FieldFunction<RealMatrixX> > mat_stiff =
-    _property.stiffness_A_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>& mat_stiff =
+    _property.property_matrix(MAST::STIFFNESS_A_MATRIX, *this);
     
     libMesh::Point p;
     MAST::FEMOperatorMatrix
@@ -202,13 +290,16 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
         _local_elem->global_coordinates_location(xyz[qp], p);
         
         // get the material matrix
-        (*mat_stiff)(p, _time, material_mat);
+        mat_stiff(p, _time, material_mat);
+        C = material_mat;
         
         this->initialize_green_lagrange_strain_operator(qp,
                                                         *_fe,
                                                         local_disp,
                                                         strain,
-                                                        mat_x, mat_y, mat_z,
+                                                        mat_x,
+                                                        mat_y,
+                                                        mat_z,
                                                         Bmat_lin,
                                                         Bmat_nl_x,
                                                         Bmat_nl_y,
@@ -220,8 +311,8 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
         
         // calculate the incompatible mode matrices
         // incompatible mode diagonal stiffness matrix
-        mat5_n1n3    =  material_mat * Gmat;
-        K_alphaalpha += JxW[qp] * ( Gmat.transpose() * mat5_n1n3);
+        mat5_n1n3.noalias()    =  C * Gmat;
+        K_alphaalpha.noalias() += JxW[qp] * ( Gmat.transpose() * mat5_n1n3);
         
         // off-diagonal coupling matrix
         // linear strain term
@@ -230,28 +321,27 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
         
         // nonlinear component
         // along x
-        mat7_3n3  = mat_x.transpose() * mat5_n1n3;
+        mat7_3n3.noalias()  = mat_x.transpose() * mat5_n1n3;
         Bmat_nl_x.right_multiply_transpose(mat6_n2n3, mat7_3n3);
         K_ualpha  += JxW[qp] * mat6_n2n3;
         
         // along y
-        mat7_3n3  = mat_y.transpose() * mat5_n1n3;
+        mat7_3n3.noalias()  = mat_y.transpose() * mat5_n1n3;
         Bmat_nl_y.right_multiply_transpose(mat6_n2n3, mat7_3n3);
         K_ualpha  += JxW[qp] * mat6_n2n3;
         
         // along z
-        mat7_3n3  = mat_z.transpose() * mat5_n1n3;
+        mat7_3n3.noalias()  = mat_z.transpose() * mat5_n1n3;
         Bmat_nl_z.right_multiply_transpose(mat6_n2n3, mat7_3n3);
         K_ualpha  += JxW[qp] * mat6_n2n3;
     }
     
     
     // incompatible mode corrections
-    K_alphaalpha = K_alphaalpha.inverse();
-    K_corr = K_ualpha * K_alphaalpha * K_ualpha.transpose();
+    K_alphaalpha = K_alphaalpha.inverse().eval();
     
     if (request_jacobian)
-        jac.topLeftCorner(n2, n2) -= K_corr;
+        jac.topLeftCorner(n2, n2) -= K_ualpha * K_alphaalpha * K_ualpha.transpose();
 
     
     ///////////////////////////////////////////////////////////////////////
@@ -261,13 +351,16 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
         _local_elem->global_coordinates_location(xyz[qp], p);
         
         // get the material matrix
-        (*mat_stiff)(p, _time, material_mat);
+        mat_stiff(p, _time, material_mat);
+        C = material_mat;
         
         this->initialize_green_lagrange_strain_operator(qp,
                                                         *_fe,
                                                         local_disp,
                                                         strain,
-                                                        mat_x, mat_y, mat_z,
+                                                        mat_x,
+                                                        mat_y,
+                                                        mat_z,
                                                         Bmat_lin,
                                                         Bmat_nl_x,
                                                         Bmat_nl_y,
@@ -278,10 +371,10 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
         this->initialize_incompatible_strain_operator(qp, *_fe, Bmat_inc, Gmat);
         
         // calculate the stress
-        stress = material_mat * (strain + Gmat * alpha);
+        stress.noalias() = C * (strain + Gmat * alpha);
         
         // residual from incompatible modes
-        f_alpha += JxW[qp] * Gmat.transpose() * stress;
+        f_alpha.noalias() += JxW[qp] * Gmat.transpose() * stress;
         
         // calculate contribution to the residual
         // linear strain operator
@@ -290,17 +383,17 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
         
         // nonlinear strain operator
         // x
-        vec3_3 = mat_x.transpose() * stress;
+        vec3_3.noalias() = mat_x.transpose() * stress;
         Bmat_nl_x.vector_mult_transpose(vec2_n2, vec3_3);
         f.topRows(n2) += JxW[qp] * vec2_n2;
 
         // y
-        vec3_3 = mat_y.transpose() * stress;
+        vec3_3.noalias() = mat_y.transpose() * stress;
         Bmat_nl_y.vector_mult_transpose(vec2_n2, vec3_3);
         f.topRows(n2) += JxW[qp] * vec2_n2;
 
         // z
-        vec3_3 = mat_z.transpose() * stress;
+        vec3_3.noalias() = mat_z.transpose() * stress;
         Bmat_nl_z.vector_mult_transpose(vec2_n2, vec3_3);
         f.topRows(n2) += JxW[qp] * vec2_n2;
 
@@ -314,22 +407,22 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
             
             ////////////////////////////////////////////////////////
             // B_lin^T C B_lin
-            Bmat_lin.left_multiply(mat1_n1n2, material_mat);
+            Bmat_lin.left_multiply(mat1_n1n2, C);
             Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
             jac.topLeftCorner(n2, n2) += JxW[qp] * mat2_n2n2;
             
             // B_x^T mat_x^T C B_lin
-            mat3_3n2 = mat_x.transpose() * mat1_n1n2;
+            mat3_3n2.noalias() = mat_x.transpose() * mat1_n1n2;
             Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat3_3n2);
             jac.topLeftCorner(n2, n2) += JxW[qp] * mat2_n2n2;
             
             // B_y^T mat_y^T C B_lin
-            mat3_3n2 = mat_y.transpose() * mat1_n1n2;
+            mat3_3n2.noalias() = mat_y.transpose() * mat1_n1n2;
             Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat3_3n2);
             jac.topLeftCorner(n2, n2) += JxW[qp] * mat2_n2n2;
-
+            
             // B_z^T mat_z^T C B_lin
-            mat3_3n2 = mat_z.transpose() * mat1_n1n2;
+            mat3_3n2.noalias() = mat_z.transpose() * mat1_n1n2;
             Bmat_nl_z.right_multiply_transpose(mat2_n2n2, mat3_3n2);
             jac.topLeftCorner(n2, n2) += JxW[qp] * mat2_n2n2;
 
@@ -350,22 +443,22 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
                 }
                 
                 // B_lin^T C mat_x_i B_x_i
-                mat1_n1n2 =  material_mat * mat1_n1n2;
+                mat1_n1n2 =  C * mat1_n1n2;
                 Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 jac.topLeftCorner(n2, n2) += JxW[qp] * mat2_n2n2;
                 
                 // B_x^T mat_x^T C mat_x B_x
-                mat3_3n2 = mat_x.transpose() * mat1_n1n2;
+                mat3_3n2.noalias() = mat_x.transpose() * mat1_n1n2;
                 Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat3_3n2);
                 jac.topLeftCorner(n2, n2) += JxW[qp] * mat2_n2n2;
 
                 // B_y^T mat_y^T C mat_x B_x
-                mat3_3n2 = mat_y.transpose() * mat1_n1n2;
+                mat3_3n2.noalias() = mat_y.transpose() * mat1_n1n2;
                 Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat3_3n2);
                 jac.topLeftCorner(n2, n2) += JxW[qp] * mat2_n2n2;
                 
                 // B_z^T mat_z^T C mat_x B_x
-                mat3_3n2 = mat_z.transpose() * mat1_n1n2;
+                mat3_3n2.noalias() = mat_z.transpose() * mat1_n1n2;
                 Bmat_nl_z.right_multiply_transpose(mat2_n2n2, mat3_3n2);
                 jac.topLeftCorner(n2, n2) += JxW[qp] * mat2_n2n2;
                 
@@ -615,15 +708,19 @@ surface_pressure_residual(bool request_jacobian,
     bc.get<MAST::FieldFunction<Real> >("pressure");
     
     
-    FEMOperatorMatrix Bmat;
     Real press;
     libMesh::Point pt;
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealVectorX
-    phi_vec     = RealVectorX::Zero(n_phi),
-    force       = RealVectorX::Zero(2*n1),
-    local_f     = RealVectorX::Zero(n2),
-    vec_n2      = RealVectorX::Zero(n2);
+    &phi_vec     = scratch.vector(n_phi),
+    &force       = scratch.vector(2*n1),
+    &local_f     = scratch.vector(n2),
+    &vec_n2      = scratch.vector(n2);
+    
+    MAST::FEMOperatorMatrix
+    &Bmat = scratch.operator_matrix();
     
     for (unsigned int qp=0; qp<qpoint.size(); qp++) {
         
@@ -1118,15 +1215,16 @@ MAST::StructuralElement3D::initialize_strain_operator (const unsigned int qp,
 
 
 
+template <typename VecType, typename MatType>
 void
 MAST::StructuralElement3D::
 initialize_green_lagrange_strain_operator(const unsigned int qp,
                                           const libMesh::FEBase& fe,
                                           const RealVectorX& local_disp,
-                                          RealVectorX& epsilon,
-                                          RealMatrixX& mat_x,
-                                          RealMatrixX& mat_y,
-                                          RealMatrixX& mat_z,
+                                          VecType& epsilon,
+                                          MatType& mat_x,
+                                          MatType& mat_y,
+                                          MatType& mat_z,
                                           MAST::FEMOperatorMatrix& Bmat_lin,
                                           MAST::FEMOperatorMatrix& Bmat_nl_x,
                                           MAST::FEMOperatorMatrix& Bmat_nl_y,
@@ -1218,19 +1316,19 @@ initialize_green_lagrange_strain_operator(const unsigned int qp,
 
     
     // calculate the displacement gradient to create the
-    RealVectorX
-    ddisp_dx = RealVectorX::Zero(3),
-    ddisp_dy = RealVectorX::Zero(3),
-    ddisp_dz = RealVectorX::Zero(3);
+    RealVector3
+    ddisp_dx = RealVector3::Zero(),
+    ddisp_dy = RealVector3::Zero(),
+    ddisp_dz = RealVector3::Zero();
     
     Bmat_nl_x.vector_mult(ddisp_dx, local_disp);  // {du/dx, dv/dx, dw/dx}
     Bmat_nl_y.vector_mult(ddisp_dy, local_disp);  // {du/dy, dv/dy, dw/dy}
     Bmat_nl_z.vector_mult(ddisp_dz, local_disp);  // {du/dz, dv/dz, dw/dz}
 
     // prepare the deformation gradient matrix
-    RealMatrixX
-    F = RealMatrixX::Zero(3,3),
-    E = RealMatrixX::Zero(3,3);
+    RealMatrix3
+    F = RealMatrix3::Zero(),
+    E = RealMatrix3::Zero();
     F.col(0) = ddisp_dx;
     F.col(1) = ddisp_dy;
     F.col(2) = ddisp_dz;
@@ -1266,12 +1364,13 @@ initialize_green_lagrange_strain_operator(const unsigned int qp,
 
 
 
+template <typename MatType>
 void
 MAST::StructuralElement3D::
 initialize_incompatible_strain_operator(const unsigned int qp,
                                         const libMesh::FEBase& fe,
                                         FEMOperatorMatrix& Bmat,
-                                        RealMatrixX& G_mat) {
+                                        MatType& G_mat) {
     
     RealVectorX phi_vec = RealVectorX::Zero(1);
     
@@ -1308,8 +1407,8 @@ initialize_incompatible_strain_operator(const unsigned int qp,
     // elemnts only.
     libmesh_assert_equal_to(dshapedxi.size(), n_nodes);
 
-    RealMatrixX
-    jac = RealMatrixX::Zero(3,3);
+    RealMatrix3
+    jac = RealMatrix3::Zero();
     
     // first derivatives wrt xi
     for (unsigned int i_node=0; i_node<n_nodes; i_node++)
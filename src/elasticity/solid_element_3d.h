@@ -120,6 +120,17 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *    implements internal_residual() with the number of shape
+         *    functions fixed at compile time to \p NPhi, so that the
+         *    element matrices use fixed-size storage. Eigen::Dynamic may be
+         *    used for element types without a fixed-size kernel.
+         */
+        template <int NPhi>
+        bool _internal_residual(bool request_jacobian,
+                                RealVectorX& f,
+                                RealMatrixX& jac);
+        
         /*!
          *    Calculates the force vector and Jacobian due to surface pressure.
          */
@@ -272,15 +283,18 @@ namespace MAST {
         
         /*!
          *    initialize the strain operator matrices for the 
-         *    Green-Lagrange strain matrices
+         *    Green-Lagrange strain matrices. The strain vector and the
+         *    6x3 matrices may have fixed or dynamic size, so that the
+         *    fixed-size kernels are initialized without copies.
          */
+        template <typename VecType, typename MatType>
         void initialize_green_lagrange_strain_operator(const unsigned int qp,
                                                        const libMesh::FEBase& fe,
                                                        const RealVectorX& local_disp,
-                                                       RealVectorX& epsilon,
-                                                       RealMatrixX& mat_x,
-                                                       RealMatrixX& mat_y,
-                                                       RealMatrixX& mat_z,
+                                                       VecType& epsilon,
+                                                       MatType& mat_x,
+                                                       MatType& mat_y,
+                                                       MatType& mat_z,
                                                        MAST::FEMOperatorMatrix& Bmat_lin,
                                                        MAST::FEMOperatorMatrix& Bmat_nl_x,
                                                        MAST::FEMOperatorMatrix& Bmat_nl_y,
@@ -290,12 +304,14 @@ namespace MAST {
                                                        MAST::FEMOperatorMatrix& Bmat_nl_w);
         
         /*!
-         *   initialize incompatible strain operator
+         *   initialize incompatible strain operator. \p G_mat may have
+         *   fixed or dynamic size.
          */
+        template <typename MatType>
         void initialize_incompatible_strain_operator(const unsigned int qp,
                                                      const libMesh::FEBase& fe,
                                                      FEMOperatorMatrix& Bmat,
-                                                     RealMatrixX& G_mat);
+                                                     MatType& G_mat);
 
         /*!
          *   initialize the Jacobian needed for incompatible modes
@@ -307,6 +323,14 @@ namespace MAST {
          *   Jacobian matrix at element center needed for incompatible modes
          */
         RealMatrixX _T0_inv_tr;
+        
+        /*!
+         *   number of shape functions for which the fixed-size
+         *   internal_residual() kernel is used. This is selected at
+         *   construction based on the element type, and is zero if
+         *   the dynamic kernel is used.
+         */
+        unsigned int _n_phi_fixed_kernel;
 
     };
 }
@@ -20,6 +20,7 @@
 // MAST includes
 #include "elasticity/structural_element_1d.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/scratch_arena.h"
 #include "mesh/local_elem_base.h"
 #include "property_cards/element_property_card_1D.h"
 #include "property_cards/material_property_card_base.h"
@@ -36,10 +37,25 @@
 MAST::StructuralElement1D::StructuralElement1D(MAST::SystemInitialization& sys,
                                                const libMesh::Elem& elem,
                                                const MAST::ElementPropertyCardBase& p):
-MAST::BendingStructuralElem(sys, elem, p) {
+MAST::BendingStructuralElem(sys, elem, p),
+_n_phi_fixed_kernel(0) {
     
     // now initialize the finite element data structures
     _init_fe_operators(get_elem_for_quadrature(), &_fe, &_qrule, &_bending_operator);
+    
+    // select the fixed-size internal residual kernel, if one is
+    // available for this element type and interpolation
+    switch (_elem.type()) {
+            
+        case libMesh::EDGE2:
+        case libMesh::EDGE3:
+            if (_fe->n_shape_functions() == _elem.n_nodes())
+                _n_phi_fixed_kernel = _elem.n_nodes();
+            break;
+            
+        default:
+            break;
+    }
 }
 
 
@@ -56,7 +72,10 @@ initialize_direct_strain_operator(const unsigned int qp,
     const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
     
     unsigned int n_phi = (unsigned int)dphi.size();
-    RealVectorX phi   = RealVectorX::Zero(n_phi);
+    
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi  = scratch.vector(n_phi);
     
     libmesh_assert_equal_to(Bmat.m(), 2);
     libmesh_assert_equal_to(Bmat.n(), 6*n_phi);
@@ -71,13 +90,14 @@ initialize_direct_strain_operator(const unsigned int qp,
 
 
 
+template <typename VecType, typename MatType>
 void
 MAST::StructuralElement1D::
 initialize_von_karman_strain_operator(const unsigned int qp,
                                       const libMesh::FEBase& fe,
-                                      RealVectorX& vk_strain,
-                                      RealMatrixX& vk_dvdxi_mat,
-                                      RealMatrixX& vk_dwdxi_mat,
+                                      VecType& vk_strain,
+                                      MatType& vk_dvdxi_mat,
+                                      MatType& vk_dwdxi_mat,
                                       MAST::FEMOperatorMatrix& Bmat_v_vk,
                                       MAST::FEMOperatorMatrix& Bmat_w_vk) {
     
@@ -99,7 +119,9 @@ initialize_von_karman_strain_operator(const unsigned int qp,
     vk_dvdxi_mat.setZero();
     vk_dwdxi_mat.setZero();
     
-    RealVectorX phi_vec   = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec  = scratch.vector(n_phi);
     
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ ) {
         phi_vec(i_nd) = dphi[i_nd][qp](0);                // dphi/dx
@@ -533,8 +555,19 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
                                               RealVectorX& f,
                                               RealMatrixX& jac)
 {
-    MAST::FEMOperatorMatrix Bmat_mem, Bmat_bend, Bmat_v_vk, Bmat_w_vk;
+    switch (_n_phi_fixed_kernel) {
+            
+        case 2:
+            return _internal_residual<2>(request_jacobian, f, jac);
+            
+        case 3:
+            return _internal_residual<3>(request_jacobian, f, jac);
+            
+        default:
+            break;
+    }
     
+    // the remaining element types use dynamic storage
     const std::vector<Real>& JxW           = _fe->get_JxW();
     const std::vector<libMesh::Point>& xyz = _fe->get_xyz();
     const unsigned int
@@ -543,30 +576,38 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
     n2       = 6*n_phi,
     n3       = this->n_von_karman_strain_components();
     
+    // the workspace is drawn from the per-thread arena, which retains the
+    // storage across elements
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    material_A_mat,
-    material_B_mat,
-    material_D_mat,
-    mat1_n1n2    = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2    = RealMatrixX::Zero(n2,n2),
-    mat3,
-    mat4_n3n2    = RealMatrixX::Zero(n3,2),
-    vk_dvdxi_mat = RealMatrixX::Zero(n1,n3),
-    vk_dwdxi_mat = RealMatrixX::Zero(n1,n3),
-    stress       = RealMatrixX::Zero(2,2),
-    stress_l     = RealMatrixX::Zero(2,2),
-    local_jac    = RealMatrixX::Zero(n2,n2);
+    &mat_work     = scratch.matrix(n2,n2),
+    &material_A_mat = scratch.matrix(n1,n1),
+    &material_B_mat = scratch.matrix(n1,n1),
+    &material_D_mat = scratch.matrix(n1,n1),
+    &mat1_n1n2    = scratch.matrix(n1,n2),
+    &mat2_n2n2    = scratch.matrix(n2,n2),
+    &mat3         = scratch.matrix(n1,n2),
+    &mat4_n3n2    = scratch.matrix(n3,2),
+    &vk_dvdxi_mat = scratch.matrix(n1,n3),
+    &vk_dwdxi_mat = scratch.matrix(n1,n3),
+    &stress       = scratch.matrix(2,2),
+    &stress_l     = scratch.matrix(2,2),
+    &local_jac    = scratch.matrix(n2,n2);
     
     RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
-    vec3_n2    = RealVectorX::Zero(n2),
-    vec4_n3    = RealVectorX::Zero(n3),
-    vec5_n3    = RealVectorX::Zero(n3),
-    local_f    = RealVectorX::Zero(n2);
+    &vec1_n1    = scratch.vector(n1),
+    &vec2_n1    = scratch.vector(n1),
+    &vec3_n2    = scratch.vector(n2),
+    &vec4_n3    = scratch.vector(n3),
+    &vec5_n3    = scratch.vector(n3),
+    &local_f    = scratch.vector(n2);
     
-    local_f.setZero();
-    local_jac.setZero();
+    MAST::FEMOperatorMatrix
+    &Bmat_mem   = scratch.operator_matrix(),
+    &Bmat_bend  = scratch.operator_matrix(),
+    &Bmat_v_vk  = scratch.operator_matrix(),
+    &Bmat_w_vk  = scratch.operator_matrix();
     
     Bmat_mem.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
     Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
@@ -576,10 +617,10 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
     bool if_vk = (_property.strain_type() == MAST::VON_KARMAN_STRAIN),
     if_bending = (_property.bending_model(_elem, _fe->get_fe_type()) != MAST::NO_BENDING);
     
-    std::auto_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff_A  = _property.stiffness_A_matrix(*this),
-    mat_stiff_B  = _property.stiffness_B_matrix(*this),
-    mat_stiff_D  = _property.stiffness_D_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    &mat_stiff_A = _property.property_matrix(MAST::STIFFNESS_A_MATRIX, *this),
+    &mat_stiff_B = _property.property_matrix(MAST::STIFFNESS_B_MATRIX, *this),
+    &mat_stiff_D = _property.property_matrix(MAST::STIFFNESS_D_MATRIX, *this);
     
     
     libMesh::Point p;
@@ -589,24 +630,25 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
         this->local_elem().global_coordinates_location(xyz[qp], p);
         
         // get the material matrix
-        (*mat_stiff_A)(p, _time, material_A_mat);
+        mat_stiff_A(p, _time, material_A_mat);
         
         if (if_bending) {
-            (*mat_stiff_B)(p, _time, material_B_mat);
-            (*mat_stiff_D)(p, _time, material_D_mat);
+            mat_stiff_B(p, _time, material_B_mat);
+            mat_stiff_D(p, _time, material_D_mat);
         }
         
         // now calculte the quantity for these matrices
-        _internal_residual_operation(if_bending, if_vk, n2, qp, *_fe, JxW,
-                                     request_jacobian, 
-                                     local_f, local_jac,
-                                     Bmat_mem, Bmat_bend, Bmat_v_vk, Bmat_w_vk,
-                                     stress, stress_l, vk_dvdxi_mat, vk_dwdxi_mat,
-                                     material_A_mat,
-                                     material_B_mat, material_D_mat, vec1_n1,
-                                     vec2_n1, vec3_n2, vec4_n3,
-                                     vec5_n3, mat1_n1n2, mat2_n2n2,
-                                     mat3, mat4_n3n2);
+        _internal_residual_operation<Eigen::Dynamic>
+        (if_bending, if_vk, n2, qp, *_fe, JxW,
+         request_jacobian, 
+         local_f, local_jac,
+         Bmat_mem, Bmat_bend, Bmat_v_vk, Bmat_w_vk,
+         stress, stress_l, vk_dvdxi_mat, vk_dwdxi_mat,
+         material_A_mat,
+         material_B_mat, material_D_mat, vec1_n1,
+         vec2_n1, vec3_n2, vec4_n3,
+         vec5_n3, mat1_n1n2, mat2_n2n2,
+         mat3, mat4_n3n2);
         
     }
     
@@ -625,7 +667,7 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
     f += vec3_n2;
 
     if (request_jacobian) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac += mat2_n2n2;
     }
     
@@ -636,6 +678,142 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
 
 
 
+template <int NPhi>
+bool
+MAST::StructuralElement1D::_internal_residual(bool request_jacobian,
+                                              RealVectorX& f,
+                                              RealMatrixX& jac) {
+    
+    typedef KernelTypes<NPhi> Types;
+    
+    const std::vector<Real>& JxW           = _fe->get_JxW();
+    const std::vector<libMesh::Point>& xyz = _fe->get_xyz();
+    const unsigned int
+    n_phi    = (unsigned int)_fe->get_phi().size(),
+    n1       = this->n_direct_strain_components(),
+    n2       = 6*n_phi,
+    n3       = this->n_von_karman_strain_components();
+    
+    libmesh_assert_equal_to(NPhi, (int)n_phi);
+    
+    // the local residual and Jacobian are also updated by the bending
+    // operator, and are drawn from the arena along with the workspace of
+    // the transformation to the global system. All other work matrices
+    // have fixed size.
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealMatrixX
+    &mat_work       = scratch.matrix(n2,n2),
+    &material_mat   = scratch.matrix(n1,n1),
+    &global_jac     = scratch.matrix(n2,n2),
+    &local_jac      = scratch.matrix(n2,n2);
+    RealVectorX
+    &global_f       = scratch.vector(n2),
+    &local_f        = scratch.vector(n2);
+    
+    typename Types::MatrixN1N1
+    material_A_mat  = Types::MatrixN1N1::Zero(),
+    material_B_mat  = Types::MatrixN1N1::Zero(),
+    material_D_mat  = Types::MatrixN1N1::Zero();
+    typename Types::MatrixN1N2
+    mat1_n1n2       = Types::MatrixN1N2::Zero(),
+    mat3            = Types::MatrixN1N2::Zero();
+    typename Types::MatrixN3N2
+    mat4_n3n2       = Types::MatrixN3N2::Zero();
+    typename Types::MatrixN2N2
+    mat2_n2n2       = Types::MatrixN2N2::Zero();
+    typename Types::MatrixN1N3
+    vk_dvdxi_mat    = Types::MatrixN1N3::Zero(),
+    vk_dwdxi_mat    = Types::MatrixN1N3::Zero();
+    typename Types::Matrix22
+    stress          = Types::Matrix22::Zero(),
+    stress_l        = Types::Matrix22::Zero();
+    typename Types::VectorN1
+    vec1_n1         = Types::VectorN1::Zero(),
+    vec2_n1         = Types::VectorN1::Zero();
+    typename Types::VectorN2
+    vec3_n2         = Types::VectorN2::Zero();
+    typename Types::VectorN3
+    vec4_n3         = Types::VectorN3::Zero(),
+    vec5_n3         = Types::VectorN3::Zero();
+    
+    MAST::FEMOperatorMatrix
+    &Bmat_mem   = scratch.operator_matrix(),
+    &Bmat_bend  = scratch.operator_matrix(),
+    &Bmat_v_vk  = scratch.operator_matrix(),
+    &Bmat_w_vk  = scratch.operator_matrix();
+    
+    Bmat_mem.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
+    Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
+    Bmat_v_vk.reinit(n3, _system.n_vars(), n_phi); // only dv/dx and dv/dy
+    Bmat_w_vk.reinit(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
+    
+    bool if_vk = (_property.strain_type() == MAST::VON_KARMAN_STRAIN),
+    if_bending = (_property.bending_model(_elem, _fe->get_fe_type()) != MAST::NO_BENDING);
+    
+    const MAST::FieldFunction<RealMatrixX>
+    &mat_stiff_A = _property.property_matrix(MAST::STIFFNESS_A_MATRIX, *this),
+    &mat_stiff_B = _property.property_matrix(MAST::STIFFNESS_B_MATRIX, *this),
+    &mat_stiff_D = _property.property_matrix(MAST::STIFFNESS_D_MATRIX, *this);
+    
+    
+    libMesh::Point p;
+    
+    for (unsigned int qp=0; qp<JxW.size(); qp++) {
+        
+        this->local_elem().global_coordinates_location(xyz[qp], p);
+        
+        // the property card functions return dynamic matrices, which are
+        // copied to the fixed-size matrices
+        mat_stiff_A(p, _time, material_mat);
+        material_A_mat = material_mat;
+        
+        if (if_bending) {
+            mat_stiff_B(p, _time, material_mat);
+            material_B_mat = material_mat;
+            mat_stiff_D(p, _time, material_mat);
+            material_D_mat = material_mat;
+        }
+        
+        _internal_residual_operation<NPhi>
+        (if_bending, if_vk, n2, qp, *_fe, JxW,
+         request_jacobian,
+         local_f, local_jac,
+         Bmat_mem, Bmat_bend, Bmat_v_vk, Bmat_w_vk,
+         stress, stress_l, vk_dvdxi_mat, vk_dwdxi_mat,
+         material_A_mat,
+         material_B_mat, material_D_mat, vec1_n1,
+         vec2_n1, vec3_n2, vec4_n3,
+         vec5_n3, mat1_n1n2, mat2_n2n2,
+         mat3, mat4_n3n2);
+    }
+    
+    
+    // now calculate the transverse shear contribution if appropriate for the
+    // element
+    if (if_bending && _bending_operator->include_transverse_shear_energy())
+        _bending_operator->calculate_transverse_shear_residual(request_jacobian,
+                                                               local_f,
+                                                               local_jac,
+                                                               nullptr);
+    
+    
+    // now transform to the global coorodinate system
+    transform_vector_to_global_system(local_f, global_f);
+    f += global_f;
+    
+    if (request_jacobian) {
+        transform_matrix_to_global_system(local_jac, global_jac, mat_work);
+        jac += global_jac;
+    }
+    
+    return request_jacobian;
+}
+
+
+
+
+
 bool
 MAST::StructuralElement1D::internal_residual_sensitivity (bool request_jacobian,
                                                           RealVectorX& f,
@@ -667,6 +845,7 @@ MAST::StructuralElement1D::internal_residual_sensitivity (bool request_jacobian,
     n3    = this->n_von_karman_strain_components();
     
     RealMatrixX
+    mat_work,
     material_A_mat,
     material_B_mat,
     material_D_mat,
@@ -725,16 +904,17 @@ MAST::StructuralElement1D::internal_residual_sensitivity (bool request_jacobian,
         }
         
         // now calculte the quantity for these matrices
-        _internal_residual_operation(if_bending, if_vk, n2, qp, *_fe, JxW,
-                                     request_jacobian,
-                                     local_f, local_jac,
-                                     Bmat_mem, Bmat_bend, Bmat_v_vk, Bmat_w_vk,
-                                     stress, stress_l, vk_dvdxi_mat, vk_dwdxi_mat,
-                                     material_A_mat,
-                                     material_B_mat, material_D_mat, vec1_n1,
-                                     vec2_n1, vec3_n2, vec4_n3,
-                                     vec5_n3, mat1_n1n2, mat2_n2n2,
-                                     mat3, mat4_n3n2);
+        _internal_residual_operation<Eigen::Dynamic>
+        (if_bending, if_vk, n2, qp, *_fe, JxW,
+         request_jacobian,
+         local_f, local_jac,
+         Bmat_mem, Bmat_bend, Bmat_v_vk, Bmat_w_vk,
+         stress, stress_l, vk_dvdxi_mat, vk_dwdxi_mat,
+         material_A_mat,
+         material_B_mat, material_D_mat, vec1_n1,
+         vec2_n1, vec3_n2, vec4_n3,
+         vec5_n3, mat1_n1n2, mat2_n2n2,
+         mat3, mat4_n3n2);
         
         // this accounts for the sensitivity of the linear stress as a result of
         // static solution. This is needed only for cases that require linearized
@@ -767,7 +947,7 @@ MAST::StructuralElement1D::internal_residual_sensitivity (bool request_jacobian,
     f += vec3_n2;
     
     if (request_jacobian) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac += mat2_n2n2;
     }
     
@@ -792,6 +972,7 @@ internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
     n3    = this->n_von_karman_strain_components();
     
     RealMatrixX
+    mat_work,
     material_A_mat,
     material_B_mat,
     material_D_mat,
@@ -1006,7 +1187,7 @@ internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
         local_jac += JxW[qp] * mat2_n2n2;
     }
     
-    transform_matrix_to_global_system(local_jac, mat2_n2n2);
+    transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
     jac += mat2_n2n2;
     
     return true;
@@ -1015,6 +1196,7 @@ internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
 
 
 
+template <int NPhi>
 void
 MAST::StructuralElement1D::
 _internal_residual_operation(bool if_bending,
@@ -1030,28 +1212,28 @@ _internal_residual_operation(bool if_bending,
                              MAST::FEMOperatorMatrix& Bmat_bend,
                              MAST::FEMOperatorMatrix& Bmat_v_vk,
                              MAST::FEMOperatorMatrix& Bmat_w_vk,
-                             RealMatrixX& stress,
-                             RealMatrixX& stress_l,
-                             RealMatrixX& vk_dvdxi_mat,
-                             RealMatrixX& vk_dwdxi_mat,
-                             RealMatrixX& material_A_mat,
-                             RealMatrixX& material_B_mat,
-                             RealMatrixX& material_D_mat,
-                             RealVectorX& vec1_n1,
-                             RealVectorX& vec2_n1,
-                             RealVectorX& vec3_n2,
-                             RealVectorX& vec4_2,
-                             RealVectorX& vec5_2,
-                             RealMatrixX& mat1_n1n2,
-                             RealMatrixX& mat2_n2n2,
-                             RealMatrixX& mat3,
-                             RealMatrixX& mat4_2n2)
+                             typename KernelTypes<NPhi>::Matrix22& stress,
+                             typename KernelTypes<NPhi>::Matrix22& stress_l,
+                             typename KernelTypes<NPhi>::MatrixN1N3& vk_dvdxi_mat,
+                             typename KernelTypes<NPhi>::MatrixN1N3& vk_dwdxi_mat,
+                             const typename KernelTypes<NPhi>::MatrixN1N1& material_A_mat,
+                             const typename KernelTypes<NPhi>::MatrixN1N1& material_B_mat,
+                             const typename KernelTypes<NPhi>::MatrixN1N1& material_D_mat,
+                             typename KernelTypes<NPhi>::VectorN1& vec1_n1,
+                             typename KernelTypes<NPhi>::VectorN1& vec2_n1,
+                             typename KernelTypes<NPhi>::VectorN2& vec3_n2,
+                             typename KernelTypes<NPhi>::VectorN3& vec4_2,
+                             typename KernelTypes<NPhi>::VectorN3& vec5_2,
+                             typename KernelTypes<NPhi>::MatrixN1N2& mat1_n1n2,
+                             typename KernelTypes<NPhi>::MatrixN2N2& mat2_n2n2,
+                             typename KernelTypes<NPhi>::MatrixN1N2& mat3,
+                             typename KernelTypes<NPhi>::MatrixN3N2& mat4_2n2)
 {
     this->initialize_direct_strain_operator(qp, fe, Bmat_mem);
     
     // first handle constant throught the thickness stresses: membrane and vonKarman
     Bmat_mem.vector_mult(vec1_n1, _local_sol);
-    vec2_n1 = material_A_mat * vec1_n1; // linear direct stress
+    vec2_n1.noalias() = material_A_mat * vec1_n1; // linear direct stress
     
     // copy the stress values to a matrix
     stress_l(0,0) = vec2_n1(0); // sigma_xx
@@ -1069,7 +1251,7 @@ _internal_residual_operation(bool if_bending,
         Bmat_bend.vector_mult(vec2_n1, _local_sol);
         // vec2_n1(0) is the longitudinal force due to v-bending
         // vec2_n1(1) is the longitudinal force due to w-bending
-        vec1_n1 = material_B_mat * vec2_n1;
+        vec1_n1.noalias() = material_B_mat * vec2_n1;
         stress_l(0,0) += vec1_n1(0);
         stress(0,0)   += vec1_n1(0);
         
@@ -1082,7 +1264,7 @@ _internal_residual_operation(bool if_bending,
                                                         vk_dwdxi_mat,
                                                         Bmat_v_vk,
                                                         Bmat_w_vk);
-            vec1_n1 = material_A_mat * vec2_n1;
+            vec1_n1.noalias() = material_A_mat * vec2_n1;
             stress(0,0) += vec1_n1(0); // total strain that multiplies with the membrane strain
             stress(1,1) += vec2_n1(0); // add the two strains to get the direct strain
         }
@@ -1102,12 +1284,12 @@ _internal_residual_operation(bool if_bending,
     if (if_bending) {
         if (if_vk) {
             // von Karman strain: direct stress
-            vec4_2 = vk_dvdxi_mat.transpose() * vec1_n1;
+            vec4_2.noalias() = vk_dvdxi_mat.transpose() * vec1_n1;
             Bmat_v_vk.vector_mult_transpose(vec3_n2, vec4_2);
             local_f += JxW[qp] * vec3_n2;
             
             // von Karman strain: direct stress
-            vec4_2 = vk_dwdxi_mat.transpose() * vec1_n1;
+            vec4_2.noalias() = vk_dwdxi_mat.transpose() * vec1_n1;
             Bmat_w_vk.vector_mult_transpose(vec3_n2, vec4_2);
             local_f += JxW[qp] * vec3_n2;
         }
@@ -1117,13 +1299,13 @@ _internal_residual_operation(bool if_bending,
         stress(1,1) = 0.;
         // now coupling with the bending strain
         // B_bend^T [B] B_mem
-        vec1_n1 = material_B_mat.transpose() * vec2_n1;
+        vec1_n1.noalias() = material_B_mat.transpose() * vec2_n1;
         Bmat_bend.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
         
         // now bending stress
         Bmat_bend.vector_mult(vec2_n1, _local_sol);
-        vec1_n1 = material_D_mat * vec2_n1;
+        vec1_n1.noalias() = material_D_mat * vec2_n1;
         Bmat_bend.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
     }
@@ -1137,28 +1319,28 @@ _internal_residual_operation(bool if_bending,
         if (if_bending) {
             if (if_vk) {
                 // membrane - vk: v-displacement
-                mat3 = RealMatrixX::Zero(vk_dvdxi_mat.rows(), n2);
+                mat3.setZero(vk_dvdxi_mat.rows(), n2);
                 Bmat_v_vk.left_multiply(mat3, vk_dvdxi_mat);
-                mat3 = material_A_mat * mat3;
-                Bmat_mem.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2.noalias() = material_A_mat * mat3;
+                Bmat_mem.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // membrane - vk: w-displacement
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
+                mat3.setZero(vk_dwdxi_mat.rows(), n2);
                 Bmat_w_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = material_A_mat * mat3;
-                Bmat_mem.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2.noalias() = material_A_mat * mat3;
+                Bmat_mem.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - membrane: v-displacement
                 Bmat_mem.left_multiply(mat1_n1n2, material_A_mat);
-                mat3 = vk_dvdxi_mat.transpose() * mat1_n1n2;
+                mat3.noalias() = vk_dvdxi_mat.transpose() * mat1_n1n2;
                 Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - membrane: w-displacement
                 Bmat_mem.left_multiply(mat1_n1n2, material_A_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                mat3.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
                 Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
@@ -1168,87 +1350,90 @@ _internal_residual_operation(bool if_bending,
                 // is included. Otherwise, all terms are included
                 /*if (if_ignore_ho_jac) {
                     // vk - vk: v-displacement: first order term
-                    mat3 = RealMatrixX::Zero(2, n2);
+                    mat3.setZero(2, n2);
                     Bmat_v_vk.left_multiply(mat3, stress_l);
                     Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
                     // vk - vk: v-displacement: first order term
-                    mat3 = RealMatrixX::Zero(2, n2);
+                    mat3.setZero(2, n2);
                     Bmat_w_vk.left_multiply(mat3, stress_l);
                     Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
                     local_jac += JxW[qp] * mat2_n2n2;
                 }
                 else*/ {
                     // vk - vk: v-displacement
-                    mat3 = RealMatrixX::Zero(2, n2);
+                    mat3.setZero(2, n2);
                     Bmat_v_vk.left_multiply(mat3, stress);
                     Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
-                    mat3 = RealMatrixX::Zero(vk_dvdxi_mat.rows(), n2);
+                    mat3.setZero(vk_dvdxi_mat.rows(), n2);
                     Bmat_v_vk.left_multiply(mat3, vk_dvdxi_mat);
-                    mat3 = vk_dvdxi_mat.transpose() * material_A_mat * mat3;
+                    mat1_n1n2.noalias() = material_A_mat * mat3;
+                    mat3.noalias() = vk_dvdxi_mat.transpose() * mat1_n1n2;
                     Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
                     // vk - vk: w-displacement
-                    mat3 = RealMatrixX::Zero(2, n2);
+                    mat3.setZero(2, n2);
                     Bmat_w_vk.left_multiply(mat3, stress);
                     Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
-                    mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
+                    mat3.setZero(vk_dwdxi_mat.rows(), n2);
                     Bmat_w_vk.left_multiply(mat3, vk_dwdxi_mat);
-                    mat3 = vk_dwdxi_mat.transpose() * material_A_mat * mat3;
+                    mat1_n1n2.noalias() = material_A_mat * mat3;
+                    mat3.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
                     Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
                     // coupling of v, w-displacements
-                    mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
+                    mat3.setZero(vk_dwdxi_mat.rows(), n2);
                     Bmat_w_vk.left_multiply(mat3, vk_dwdxi_mat);
-                    mat3 = vk_dvdxi_mat.transpose() * material_A_mat * mat3;
+                    mat1_n1n2.noalias() = material_A_mat * mat3;
+                    mat3.noalias() = vk_dvdxi_mat.transpose() * mat1_n1n2;
                     Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
-                    mat3 = RealMatrixX::Zero(vk_dvdxi_mat.rows(), n2);
+                    mat3.setZero(vk_dvdxi_mat.rows(), n2);
                     Bmat_v_vk.left_multiply(mat3, vk_dvdxi_mat);
-                    mat3 = vk_dwdxi_mat.transpose() * material_A_mat * mat3;
+                    mat1_n1n2.noalias() = material_A_mat * mat3;
+                    mat3.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
                     Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
                 }
                 
                 // bending - vk: v-displacement
-                mat3 = RealMatrixX::Zero(vk_dvdxi_mat.rows(), n2);
+                mat3.setZero(vk_dvdxi_mat.rows(), n2);
                 Bmat_v_vk.left_multiply(mat3, vk_dvdxi_mat);
-                mat3 = material_B_mat.transpose() * mat3;
-                Bmat_bend.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2.noalias() = material_B_mat.transpose() * mat3;
+                Bmat_bend.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // bending - vk: w-displacement
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
+                mat3.setZero(vk_dwdxi_mat.rows(), n2);
                 Bmat_w_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = material_B_mat.transpose() * mat3;
-                Bmat_bend.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2.noalias() = material_B_mat.transpose() * mat3;
+                Bmat_bend.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - bending: v-displacement
                 Bmat_bend.left_multiply(mat1_n1n2, material_B_mat);
-                mat3 = vk_dvdxi_mat.transpose() * mat1_n1n2;
+                mat3.noalias() = vk_dvdxi_mat.transpose() * mat1_n1n2;
                 Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - bending: w-displacement
                 Bmat_bend.left_multiply(mat1_n1n2, material_B_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                mat3.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
                 Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
                 local_jac += JxW[qp] * mat2_n2n2;
             }
             
             // bending - membrane
-            mat3 = material_B_mat.transpose();
-            Bmat_mem.left_multiply(mat1_n1n2, mat3);
+            Bmat_mem.left_multiply(mat1_n1n2, material_B_mat.transpose());
             Bmat_bend.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
@@ -1427,6 +1612,7 @@ MAST::StructuralElement1D::prestress_residual (bool request_jacobian,
     n3    = this->n_von_karman_strain_components();
     
     RealMatrixX
+    mat_work,
     mat2_n2n2     = RealMatrixX::Zero(n2, n2),
     mat3,
     vk_dvdxi_mat  = RealMatrixX::Zero(n1, n3),
@@ -1532,7 +1718,7 @@ MAST::StructuralElement1D::prestress_residual (bool request_jacobian,
     transform_vector_to_global_system(local_f, vec3_n2);
     f += vec3_n2;
     if (request_jacobian && if_vk) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac += mat2_n2n2;
     }
     
@@ -1563,6 +1749,7 @@ MAST::StructuralElement1D::prestress_residual_sensitivity (bool request_jacobian
     n3    = this->n_von_karman_strain_components();
 
     RealMatrixX
+    mat_work,
     mat2_n2n2     = RealMatrixX::Zero(n2,n2),
     mat3,
     vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
@@ -1670,7 +1857,7 @@ MAST::StructuralElement1D::prestress_residual_sensitivity (bool request_jacobian
     transform_vector_to_global_system(local_f, vec3_n2);
     f += vec3_n2;
     if (request_jacobian && if_vk) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac += mat2_n2n2;
     }
     
@@ -1719,17 +1906,21 @@ surface_pressure_residual(bool request_jacobian,
     const MAST::FieldFunction<Real>& A_func =
     dynamic_cast<const MAST::ElementPropertyCard1D&>(_property).A();
     
-    FEMOperatorMatrix Bmat;
     Real
     press   = 0.,
     A_val   = 0.;
     libMesh::Point pt;
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealVectorX
-    phi_vec     = RealVectorX::Zero(n_phi),
-    force       = RealVectorX::Zero(2*n1),
-    local_f     = RealVectorX::Zero(n2),
-    vec_n2      = RealVectorX::Zero(n2);
+    &phi_vec     = scratch.vector(n_phi),
+    &force       = scratch.vector(2*n1),
+    &local_f     = scratch.vector(n2),
+    &vec_n2      = scratch.vector(n2);
+    
+    MAST::FEMOperatorMatrix
+    &Bmat = scratch.operator_matrix();
     
     for (unsigned int qp=0; qp<qpoint.size(); qp++) {
         
@@ -1876,8 +2067,6 @@ MAST::StructuralElement1D::thermal_residual (bool request_jacobian,
                                              RealMatrixX& jac,
                                              MAST::BoundaryConditionBase& bc)
 {
-    MAST::FEMOperatorMatrix Bmat_mem, Bmat_bend, Bmat_v_vk, Bmat_w_vk;
-    
     const std::vector<Real>& JxW           = _fe->get_JxW();
     const std::vector<libMesh::Point>& xyz = _fe->get_xyz();
     const unsigned int
@@ -1886,29 +2075,32 @@ MAST::StructuralElement1D::thermal_residual (bool request_jacobian,
     n2    = 6*n_phi,
     n3    = this->n_von_karman_strain_components();
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    material_exp_A_mat,
-    material_exp_B_mat,
-    mat1_n1n2    = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2    = RealMatrixX::Zero(n2,n2),
-    mat3,
-    mat4_n3n2    = RealMatrixX::Zero(n3,n2),
-    vk_dvdxi_mat = RealMatrixX::Zero(n1,n3),
-    vk_dwdxi_mat = RealMatrixX::Zero(n1,n3),
-    stress       = RealMatrixX::Zero(2,2),
-    local_jac    = RealMatrixX::Zero(n2, n2);
+    &mat_work           = scratch.matrix(n2,n2),
+    &material_exp_A_mat = scratch.matrix(n1,1),
+    &material_exp_B_mat = scratch.matrix(n1,1),
+    &mat2_n2n2    = scratch.matrix(n2,n2),
+    &mat3         = scratch.matrix(2,n2),
+    &vk_dvdxi_mat = scratch.matrix(n1,n3),
+    &vk_dwdxi_mat = scratch.matrix(n1,n3),
+    &stress       = scratch.matrix(2,2),
+    &local_jac    = scratch.matrix(n2,n2);
     RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
-    vec3_n2    = RealVectorX::Zero(n2),
-    vec4_2     = RealVectorX::Zero(2),
-    vec5_n3    = RealVectorX::Zero(n3),
-    local_f    = RealVectorX::Zero(n2),
-    delta_t    = RealVectorX::Zero(1);
+    &vec1_n1    = scratch.vector(n1),
+    &vec2_n1    = scratch.vector(n1),
+    &vec3_n2    = scratch.vector(n2),
+    &vec4_2     = scratch.vector(2),
+    &local_f    = scratch.vector(n2),
+    &delta_t    = scratch.vector(1);
+    
+    MAST::FEMOperatorMatrix
+    &Bmat_mem   = scratch.operator_matrix(),
+    &Bmat_bend  = scratch.operator_matrix(),
+    &Bmat_v_vk  = scratch.operator_matrix(),
+    &Bmat_w_vk  = scratch.operator_matrix();
     
-    local_f.setZero();
-    local_jac.setZero();
-
     Bmat_mem.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
     Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
     Bmat_v_vk.reinit(n3, _system.n_vars(), n_phi); // only dv/dx and dv/dy
@@ -1917,9 +2109,9 @@ MAST::StructuralElement1D::thermal_residual (bool request_jacobian,
     bool if_vk = (_property.strain_type() == MAST::VON_KARMAN_STRAIN),
     if_bending = (_property.bending_model(_elem, _fe->get_fe_type()) != MAST::NO_BENDING);
     
-    std::auto_ptr<MAST::FieldFunction<RealMatrixX > >
-    expansion_A = _property.thermal_expansion_A_matrix(*this),
-    expansion_B = _property.thermal_expansion_B_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    &expansion_A = _property.property_matrix(MAST::THERMAL_EXPANSION_A_MATRIX, *this),
+    &expansion_B = _property.property_matrix(MAST::THERMAL_EXPANSION_B_MATRIX, *this);
     
     // temperature function
     const MAST::FieldFunction<Real>
@@ -1934,17 +2126,17 @@ MAST::StructuralElement1D::thermal_residual (bool request_jacobian,
         this->local_elem().global_coordinates_location(xyz[qp], pt);
         
         // get the material property
-        (*expansion_A)(pt, _time, material_exp_A_mat);
-        (*expansion_B)(pt, _time, material_exp_B_mat);
+        expansion_A(pt, _time, material_exp_A_mat);
+        expansion_B(pt, _time, material_exp_B_mat);
         
         // get the temperature function
         temp_func    (pt, _time, t);
         ref_temp_func(pt, _time, t0);
         delta_t(0) = t-t0;
         
-        vec1_n1 = material_exp_A_mat * delta_t; // [C]{alpha (T - T0)} (with membrane strain)
+        vec1_n1.noalias() = material_exp_A_mat * delta_t; // [C]{alpha (T - T0)} (with membrane strain)
         stress(0,0) = vec1_n1(0); // sigma_xx
-        vec2_n1 = material_exp_B_mat * delta_t; // [C]{alpha (T - T0)} (with bending strain)
+        vec2_n1.noalias() = material_exp_B_mat * delta_t; // [C]{alpha (T - T0)} (with bending strain)
         
         this->initialize_direct_strain_operator(qp, *_fe, Bmat_mem);
         
@@ -1969,12 +2161,12 @@ MAST::StructuralElement1D::thermal_residual (bool request_jacobian,
                                                             Bmat_v_vk,
                                                             Bmat_w_vk);
                 // von Karman strain: v-displacement
-                vec4_2 = vk_dvdxi_mat.transpose() * vec1_n1;
+                vec4_2.noalias() = vk_dvdxi_mat.transpose() * vec1_n1;
                 Bmat_v_vk.vector_mult_transpose(vec3_n2, vec4_2);
                 local_f += JxW[qp] * vec3_n2;
                 
                 // von Karman strain: w-displacement
-                vec4_2 = vk_dwdxi_mat.transpose() * vec1_n1;
+                vec4_2.noalias() = vk_dwdxi_mat.transpose() * vec1_n1;
                 Bmat_w_vk.vector_mult_transpose(vec3_n2, vec4_2);
                 local_f += JxW[qp] * vec3_n2;
             }
@@ -1982,13 +2174,11 @@ MAST::StructuralElement1D::thermal_residual (bool request_jacobian,
             if (request_jacobian && if_vk) { // Jacobian only for vk strain
                 
                 // vk - vk: v-displacement
-                mat3 = RealMatrixX::Zero(2, n2);
                 Bmat_v_vk.left_multiply(mat3, stress);
                 Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - vk: w-displacement
-                mat3 = RealMatrixX::Zero(2, n2);
                 Bmat_w_vk.left_multiply(mat3, stress);
                 Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
                 local_jac += JxW[qp] * mat2_n2n2;
@@ -2001,7 +2191,7 @@ MAST::StructuralElement1D::thermal_residual (bool request_jacobian,
     transform_vector_to_global_system(local_f, vec3_n2);
     f -= vec3_n2;
     if (request_jacobian && if_vk) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac -= mat2_n2n2;
     }
     
@@ -2029,6 +2219,7 @@ MAST::StructuralElement1D::thermal_residual_sensitivity (bool request_jacobian,
     n3    = this->n_von_karman_strain_components();
     
     RealMatrixX
+    mat_work,
     material_exp_A_mat,
     material_exp_B_mat,
     material_exp_A_mat_sens,
@@ -2157,7 +2348,7 @@ MAST::StructuralElement1D::thermal_residual_sensitivity (bool request_jacobian,
     transform_vector_to_global_system(local_f, vec3_n2);
     f -= vec3_n2;
     if (request_jacobian && if_vk) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac -= mat2_n2n2;
     }
     
@@ -2240,6 +2431,7 @@ piston_theory_residual(bool request_jacobian,
     
     
     RealMatrixX
+    mat_work,
     dvdx             = RealMatrixX::Zero(2,2),
     dwdx             = RealMatrixX::Zero(2,2),
     local_jac        = RealMatrixX::Zero(n2,n2),
@@ -2344,10 +2536,10 @@ piston_theory_residual(bool request_jacobian,
     // if the Jacobian was requested, then transform it and add to the
     // global Jacobian
     if (request_jacobian) {
-        transform_matrix_to_global_system(local_jac_xdot, mat_n2n2);
+        transform_matrix_to_global_system(local_jac_xdot, mat_n2n2, mat_work);
         jac_xdot -= mat_n2n2;
 
-        transform_matrix_to_global_system(local_jac, mat_n2n2);
+        transform_matrix_to_global_system(local_jac, mat_n2n2, mat_work);
         jac      -= mat_n2n2;
     }
     
@@ -2433,6 +2625,7 @@ piston_theory_residual_sensitivity(bool request_jacobian,
     
     
     RealMatrixX
+    mat_work,
     dvdx             = RealMatrixX::Zero(2,2),
     dwdx             = RealMatrixX::Zero(2,2),
     local_jac        = RealMatrixX::Zero(n2,n2),
@@ -2556,10 +2749,10 @@ piston_theory_residual_sensitivity(bool request_jacobian,
     // if the Jacobian was requested, then transform it and add to the
     // global Jacobian
     if (request_jacobian) {
-        transform_matrix_to_global_system(local_jac_xdot, mat_n2n2);
+        transform_matrix_to_global_system(local_jac_xdot, mat_n2n2, mat_work);
         jac_xdot -= mat_n2n2;
         
-        transform_matrix_to_global_system(local_jac, mat_n2n2);
+        transform_matrix_to_global_system(local_jac, mat_n2n2, mat_work);
         jac      -= mat_n2n2;
     }
     
@@ -22,6 +22,7 @@
 
 // MAST includes
 #include "elasticity/bending_structural_element.h"
+#include "elasticity/structural_kernel_types.h"
 
 
 
@@ -105,6 +106,22 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *    matrix and vector types of the internal residual kernels for
+         *    \p NPhi shape functions
+         */
+        template <int NPhi>
+        using KernelTypes = MAST::StructuralKernelTypes<2, 2, NPhi>;
+        
+        /*!
+         *    implements internal_residual() with the number of shape
+         *    functions fixed at compile time to \p NPhi, so that the
+         *    element matrices use fixed-size storage.
+         */
+        template <int NPhi>
+        bool _internal_residual(bool request_jacobian,
+                                RealVectorX& f,
+                                RealMatrixX& jac);
         
         /*!
          *    Calculates the force vector and Jacobian due to surface pressure.
@@ -265,13 +282,16 @@ namespace MAST {
          *   matrices needed for Jacobian calculation.
          *   vk_strain = [dw/dx 0; 0 dw/dy; dw/dy dw/dx]
          *   Bmat_vk   = [dw/dx; dw/dy]
+         *   The strain vector and matrices may have fixed or dynamic size,
+         *   so that the fixed-size kernels are initialized without copies.
          */
-        virtual void
+        template <typename VecType, typename MatType>
+        void
         initialize_von_karman_strain_operator(const unsigned int qp,
                                               const libMesh::FEBase& fe,
-                                              RealVectorX& vk_strain,
-                                              RealMatrixX& vk_dvdxi_mat,
-                                              RealMatrixX& vk_dwdxi_mat,
+                                              VecType& vk_strain,
+                                              MatType& vk_dvdxi_mat,
+                                              MatType& vk_dwdxi_mat,
                                               MAST::FEMOperatorMatrix& Bmat_v_vk,
                                               MAST::FEMOperatorMatrix& Bmat_w_vk);
         
@@ -291,37 +311,40 @@ namespace MAST {
         /*!
          *   performs integration at the quadrature point for the provided
          *   matrices. The temperature vector and matrix entities are provided for
-         *   integration
+         *   integration. The work matrices have fixed size for \p NPhi
+         *   shape functions, or dynamic size if \p NPhi is Eigen::Dynamic.
          */
-        virtual void _internal_residual_operation(bool if_bending,
-                                                  bool if_vk,
-                                                  const unsigned int n2,
-                                                  const unsigned int qp,
-                                                  const libMesh::FEBase& fe,
-                                                  const std::vector<Real>& JxW,
-                                                  bool request_jacobian,
-                                                  RealVectorX& local_f,
-                                                  RealMatrixX& local_jac,
-                                                  MAST::FEMOperatorMatrix& Bmat_mem,
-                                                  MAST::FEMOperatorMatrix& Bmat_bend,
-                                                  MAST::FEMOperatorMatrix& Bmat_v_vk,
-                                                  MAST::FEMOperatorMatrix& Bmat_w_vk,
-                                                  RealMatrixX& stress,
-                                                  RealMatrixX& stress_l,
-                                                  RealMatrixX& vk_dvdxi_mat,
-                                                  RealMatrixX& vk_dwdxi_mat,
-                                                  RealMatrixX& material_A_mat,
-                                                  RealMatrixX& material_B_mat,
-                                                  RealMatrixX& material_D_mat,
-                                                  RealVectorX& vec1_n1,
-                                                  RealVectorX& vec2_n1,
-                                                  RealVectorX& vec3_n2,
-                                                  RealVectorX& vec4_2,
-                                                  RealVectorX& vec5_2,
-                                                  RealMatrixX& mat1_n1n2,
-                                                  RealMatrixX& mat2_n2n2,
-                                                  RealMatrixX& mat3,
-                                                  RealMatrixX& mat4_2n2);
+        template <int NPhi>
+        void
+        _internal_residual_operation(bool if_bending,
+                                     bool if_vk,
+                                     const unsigned int n2,
+                                     const unsigned int qp,
+                                     const libMesh::FEBase& fe,
+                                     const std::vector<Real>& JxW,
+                                     bool request_jacobian,
+                                     RealVectorX& local_f,
+                                     RealMatrixX& local_jac,
+                                     MAST::FEMOperatorMatrix& Bmat_mem,
+                                     MAST::FEMOperatorMatrix& Bmat_bend,
+                                     MAST::FEMOperatorMatrix& Bmat_v_vk,
+                                     MAST::FEMOperatorMatrix& Bmat_w_vk,
+                                     typename KernelTypes<NPhi>::Matrix22& stress,
+                                     typename KernelTypes<NPhi>::Matrix22& stress_l,
+                                     typename KernelTypes<NPhi>::MatrixN1N3& vk_dvdxi_mat,
+                                     typename KernelTypes<NPhi>::MatrixN1N3& vk_dwdxi_mat,
+                                     const typename KernelTypes<NPhi>::MatrixN1N1& material_A_mat,
+                                     const typename KernelTypes<NPhi>::MatrixN1N1& material_B_mat,
+                                     const typename KernelTypes<NPhi>::MatrixN1N1& material_D_mat,
+                                     typename KernelTypes<NPhi>::VectorN1& vec1_n1,
+                                     typename KernelTypes<NPhi>::VectorN1& vec2_n1,
+                                     typename KernelTypes<NPhi>::VectorN2& vec3_n2,
+                                     typename KernelTypes<NPhi>::VectorN3& vec4_2,
+                                     typename KernelTypes<NPhi>::VectorN3& vec5_2,
+                                     typename KernelTypes<NPhi>::MatrixN1N2& mat1_n1n2,
+                                     typename KernelTypes<NPhi>::MatrixN2N2& mat2_n2n2,
+                                     typename KernelTypes<NPhi>::MatrixN1N2& mat3,
+                                     typename KernelTypes<NPhi>::MatrixN3N2& mat4_2n2);
         
         
         /*!
@@ -360,7 +383,14 @@ namespace MAST {
          */
         void _convert_prestress_B_mat_to_vector(const RealMatrixX& mat,
                                                 RealVectorX& vec) const;
-
+        
+        /*!
+         *   number of shape functions for which the fixed-size
+         *   internal_residual() kernel is used. This is selected at
+         *   construction based on the element type, and is zero if
+         *   the dynamic kernel is used.
+         */
+        unsigned int _n_phi_fixed_kernel;
     };
 }
 
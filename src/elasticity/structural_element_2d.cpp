@@ -21,6 +21,7 @@
 #include "elasticity/structural_element_2d.h"
 #include "property_cards/element_property_card_2D.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/scratch_arena.h"
 #include "mesh/local_elem_base.h"
 #include "elasticity/piston_theory_boundary_condition.h"
 #include "elasticity/stress_output_base.h"
@@ -37,13 +38,31 @@ MAST::StructuralElement2D::
 StructuralElement2D(MAST::SystemInitialization& sys,
                     const libMesh::Elem& elem,
                     const MAST::ElementPropertyCardBase& p):
-MAST::BendingStructuralElem(sys, elem, p) {
+MAST::BendingStructuralElem(sys, elem, p),
+_n_phi_fixed_kernel(0) {
 
     // now initialize the finite element data structures
     _init_fe_operators(get_elem_for_quadrature(),
                        &_fe,
                        &_qrule,
                        &_bending_operator);
+    
+    // select the fixed-size internal residual kernel, if one is
+    // available for this element type and interpolation
+    switch (_elem.type()) {
+            
+        case libMesh::TRI3:
+        case libMesh::TRI6:
+        case libMesh::QUAD4:
+        case libMesh::QUAD8:
+        case libMesh::QUAD9:
+            if (_fe->n_shape_functions() == _elem.n_nodes())
+                _n_phi_fixed_kernel = _elem.n_nodes();
+            break;
+            
+        default:
+            break;
+    }
 }
 
 
@@ -61,7 +80,9 @@ initialize_direct_strain_operator(const unsigned int qp,
     
     unsigned int n_phi = (unsigned int)dphi.size();
     
-    RealVectorX phi   = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi  = scratch.vector(n_phi);
     
     libmesh_assert_equal_to(Bmat.m(), 3);
     libmesh_assert_equal_to(Bmat.n(), 6*n_phi);
@@ -82,12 +103,13 @@ initialize_direct_strain_operator(const unsigned int qp,
 
 
 
+template <typename VecType, typename MatType>
 void
 MAST::StructuralElement2D::
 initialize_von_karman_strain_operator(const unsigned int qp,
                                       const libMesh::FEBase& fe,
-                                      RealVectorX& vk_strain,
-                                      RealMatrixX& vk_dwdxi_mat,
+                                      VecType& vk_strain,
+                                      MatType& vk_dwdxi_mat,
                                       MAST::FEMOperatorMatrix& Bmat_vk) {
     
     const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
@@ -103,7 +125,9 @@ initialize_von_karman_strain_operator(const unsigned int qp,
     vk_strain.setZero();
     vk_dwdxi_mat.setZero();
     
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec = scratch.vector(n_phi);
     
     dw = 0.;
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ ) {
@@ -538,6 +562,28 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
                                               RealVectorX& f,
                                               RealMatrixX& jac)
 {
+    switch (_n_phi_fixed_kernel) {
+            
+        case 3:
+            return _internal_residual<3>(request_jacobian, f, jac);
+            
+        case 4:
+            return _internal_residual<4>(request_jacobian, f, jac);
+            
+        case 6:
+            return _internal_residual<6>(request_jacobian, f, jac);
+            
+        case 8:
+            return _internal_residual<8>(request_jacobian, f, jac);
+            
+        case 9:
+            return _internal_residual<9>(request_jacobian, f, jac);
+            
+        default:
+            break;
+    }
+    
+    // the remaining element types use dynamic storage
     const std::vector<Real>& JxW           = _fe->get_JxW();
     const std::vector<libMesh::Point>& xyz = _fe->get_xyz();
     
@@ -547,31 +593,33 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
     n2       =6*n_phi,
     n3       = this->n_von_karman_strain_components();
     
+    // the workspace is drawn from the per-thread arena, which retains the
+    // storage across elements
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    material_A_mat,
-    material_B_mat,
-    material_D_mat,
-    mat1_n1n2     = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
-    mat4_n3n2     = RealMatrixX::Zero(n3,n2),
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    stress        = RealMatrixX::Zero(2,2),
-    stress_l      = RealMatrixX::Zero(2,2),
-    local_jac     = RealMatrixX::Zero(n2,n2);
+    &mat_work       = scratch.matrix(n2,n2),
+    &mat1_n1n2      = scratch.matrix(n1,n2),
+    &mat2_n2n2      = scratch.matrix(n2,n2),
+    &mat3           = scratch.matrix(n1,n2),
+    &mat4_n3n2      = scratch.matrix(n3,n2),
+    &vk_dwdxi_mat   = scratch.matrix(n1,n3),
+    &stress         = scratch.matrix(2,2),
+    &stress_l       = scratch.matrix(2,2),
+    &local_jac      = scratch.matrix(n2,n2);
 
     RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
-    vec3_n2    = RealVectorX::Zero(n2),
-    vec4_n3    = RealVectorX::Zero(n3),
-    vec5_n3    = RealVectorX::Zero(n3),
-    local_f    = RealVectorX::Zero(n2);
+    &vec1_n1    = scratch.vector(n1),
+    &vec2_n1    = scratch.vector(n1),
+    &vec3_n2    = scratch.vector(n2),
+    &vec4_n3    = scratch.vector(n3),
+    &vec5_n3    = scratch.vector(n3),
+    &local_f    = scratch.vector(n2);
     
-    local_f.setZero();
-    local_jac.setZero();
-    
-    FEMOperatorMatrix Bmat_mem, Bmat_bend, Bmat_vk;
+    FEMOperatorMatrix
+    &Bmat_mem   = scratch.operator_matrix(),
+    &Bmat_bend  = scratch.operator_matrix(),
+    &Bmat_vk    = scratch.operator_matrix();
     
     Bmat_mem.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
     Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
@@ -580,36 +628,43 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
     bool if_vk = (_property.strain_type() == MAST::VON_KARMAN_STRAIN),
     if_bending = (_property.bending_model(_elem, _fe->get_fe_type()) != MAST::NO_BENDING);
     
-    std::auto_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff_A  = _property.stiffness_A_matrix(*this),
-    mat_stiff_B  = _property.stiffness_B_matrix(*this),
-    mat_stiff_D  = _property.stiffness_D_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    &mat_stiff_A = _property.property_matrix(MAST::STIFFNESS_A_MATRIX, *this),
+    &mat_stiff_B = _property.property_matrix(MAST::STIFFNESS_B_MATRIX, *this),
+    &mat_stiff_D = _property.property_matrix(MAST::STIFFNESS_D_MATRIX, *this);
     
     
-    libMesh::Point p;
+    // the material matrices are evaluated for all quadrature points
+    // before the quadrature loop, which requires a single evaluation
+    // for sections with constant properties
+    _qp_xyz.resize(xyz.size());
+    for (unsigned int qp=0; qp<xyz.size(); qp++)
+        this->local_elem().global_coordinates_location(xyz[qp], _qp_xyz[qp]);
+    
+    mat_stiff_A(_qp_xyz, _time, _material_A_qp);
+    
+    if (if_bending) {
+        mat_stiff_B(_qp_xyz, _time, _material_B_qp);
+        mat_stiff_D(_qp_xyz, _time, _material_D_qp);
+    }
+    else {
+        _material_B_qp.resize(xyz.size());
+        _material_D_qp.resize(xyz.size());
+    }
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
-                
-        this->local_elem().global_coordinates_location(xyz[qp], p);
-        
-        // get the material matrix
-        (*mat_stiff_A)(p, _time, material_A_mat);
-        
-        if (if_bending) {
-            (*mat_stiff_B)(p, _time, material_B_mat);
-            (*mat_stiff_D)(p, _time, material_D_mat);
-        }
         
         // now calculte the quantity for these matrices
-        _internal_residual_operation(if_bending, if_vk, n2, qp, *_fe, JxW,
-                                     request_jacobian,
-                                     local_f, local_jac,
-                                     Bmat_mem, Bmat_bend, Bmat_vk,
-                                     stress, stress_l, vk_dwdxi_mat, material_A_mat,
-                                     material_B_mat, material_D_mat, vec1_n1,
-                                     vec2_n1, vec3_n2, vec4_n3,
-                                     vec5_n3, mat1_n1n2, mat2_n2n2,
-                                     mat3, mat4_n3n2);
+        _internal_residual_operation<Eigen::Dynamic>
+        (if_bending, if_vk, n2, qp, *_fe, JxW,
+         request_jacobian,
+         local_f, local_jac,
+         Bmat_mem, Bmat_bend, Bmat_vk,
+         stress, stress_l, vk_dwdxi_mat, _material_A_qp[qp],
+         _material_B_qp[qp], _material_D_qp[qp], vec1_n1,
+         vec2_n1, vec3_n2, vec4_n3,
+         vec5_n3, mat1_n1n2, mat2_n2n2,
+         mat3, mat4_n3n2);
         
     }
     
@@ -635,7 +690,7 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
             for (unsigned int i=0; i<n_phi; i++)
                 local_jac(5*n_phi+i, 5*n_phi+i) = 1.0e-8;
         }
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac += mat2_n2n2;
     }
     
@@ -646,6 +701,146 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
 
 
 
+template <int NPhi>
+bool
+MAST::StructuralElement2D::_internal_residual(bool request_jacobian,
+                                              RealVectorX& f,
+                                              RealMatrixX& jac) {
+    
+    typedef KernelTypes<NPhi> Types;
+    
+    const std::vector<Real>& JxW           = _fe->get_JxW();
+    const std::vector<libMesh::Point>& xyz = _fe->get_xyz();
+    
+    const unsigned int
+    n_phi    = (unsigned int)_fe->get_phi().size(),
+    n1       = this->n_direct_strain_components(),
+    n2       =6*n_phi,
+    n3       = this->n_von_karman_strain_components();
+    
+    libmesh_assert_equal_to(NPhi, (int)n_phi);
+    
+    // the local residual and Jacobian are also updated by the bending
+    // operator, and are drawn from the arena along with the workspace of
+    // the transformation to the global system. All other work matrices
+    // have fixed size.
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealMatrixX
+    &mat_work       = scratch.matrix(n2,n2),
+    &global_jac     = scratch.matrix(n2,n2),
+    &local_jac      = scratch.matrix(n2,n2);
+    RealVectorX
+    &global_f       = scratch.vector(n2),
+    &local_f        = scratch.vector(n2);
+    
+    typename Types::MatrixN1N1
+    material_A_mat  = Types::MatrixN1N1::Zero(),
+    material_B_mat  = Types::MatrixN1N1::Zero(),
+    material_D_mat  = Types::MatrixN1N1::Zero();
+    typename Types::MatrixN1N2
+    mat1_n1n2       = Types::MatrixN1N2::Zero(),
+    mat3            = Types::MatrixN1N2::Zero();
+    typename Types::MatrixN3N2
+    mat4_n3n2       = Types::MatrixN3N2::Zero();
+    typename Types::MatrixN2N2
+    mat2_n2n2       = Types::MatrixN2N2::Zero();
+    typename Types::MatrixN1N3
+    vk_dwdxi_mat    = Types::MatrixN1N3::Zero();
+    typename Types::Matrix22
+    stress          = Types::Matrix22::Zero(),
+    stress_l        = Types::Matrix22::Zero();
+    typename Types::VectorN1
+    vec1_n1         = Types::VectorN1::Zero(),
+    vec2_n1         = Types::VectorN1::Zero();
+    typename Types::VectorN2
+    vec3_n2         = Types::VectorN2::Zero();
+    typename Types::VectorN3
+    vec4_n3         = Types::VectorN3::Zero(),
+    vec5_n3         = Types::VectorN3::Zero();
+    
+    FEMOperatorMatrix
+    &Bmat_mem   = scratch.operator_matrix(),
+    &Bmat_bend  = scratch.operator_matrix(),
+    &Bmat_vk    = scratch.operator_matrix();
+    
+    Bmat_mem.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
+    Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
+    Bmat_vk.reinit(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
+    
+    bool if_vk = (_property.strain_type() == MAST::VON_KARMAN_STRAIN),
+    if_bending = (_property.bending_model(_elem, _fe->get_fe_type()) != MAST::NO_BENDING);
+    
+    const MAST::FieldFunction<RealMatrixX>
+    &mat_stiff_A = _property.property_matrix(MAST::STIFFNESS_A_MATRIX, *this),
+    &mat_stiff_B = _property.property_matrix(MAST::STIFFNESS_B_MATRIX, *this),
+    &mat_stiff_D = _property.property_matrix(MAST::STIFFNESS_D_MATRIX, *this);
+    
+    _qp_xyz.resize(xyz.size());
+    for (unsigned int qp=0; qp<xyz.size(); qp++)
+        this->local_elem().global_coordinates_location(xyz[qp], _qp_xyz[qp]);
+    
+    mat_stiff_A(_qp_xyz, _time, _material_A_qp);
+    
+    if (if_bending) {
+        mat_stiff_B(_qp_xyz, _time, _material_B_qp);
+        mat_stiff_D(_qp_xyz, _time, _material_D_qp);
+    }
+    
+    for (unsigned int qp=0; qp<JxW.size(); qp++) {
+        
+        // the property card functions return dynamic matrices, which are
+        // copied to the fixed-size matrices
+        material_A_mat = _material_A_qp[qp];
+        
+        if (if_bending) {
+            material_B_mat = _material_B_qp[qp];
+            material_D_mat = _material_D_qp[qp];
+        }
+        
+        _internal_residual_operation<NPhi>
+        (if_bending, if_vk, n2, qp, *_fe, JxW,
+         request_jacobian,
+         local_f, local_jac,
+         Bmat_mem, Bmat_bend, Bmat_vk,
+         stress, stress_l, vk_dwdxi_mat, material_A_mat,
+         material_B_mat, material_D_mat, vec1_n1,
+         vec2_n1, vec3_n2, vec4_n3,
+         vec5_n3, mat1_n1n2, mat2_n2n2,
+         mat3, mat4_n3n2);
+    }
+    
+    
+    // now calculate the transverse shear contribution if appropriate for the
+    // element
+    if (if_bending &&
+        _bending_operator->include_transverse_shear_energy())
+        _bending_operator->calculate_transverse_shear_residual(request_jacobian,
+                                                               local_f,
+                                                               local_jac,
+                                                               nullptr);
+    
+    
+    // now transform to the global coorodinate system
+    transform_vector_to_global_system(local_f, global_f);
+    f += global_f;
+    
+    if (request_jacobian) {
+        // add small values to the diagonal of the theta_z dofs
+        for (unsigned int i=0; i<n_phi; i++)
+            local_jac(5*n_phi+i, 5*n_phi+i) = 1.0e-8;
+        
+        transform_matrix_to_global_system(local_jac, global_jac, mat_work);
+        jac += global_jac;
+    }
+    
+    return request_jacobian;
+}
+
+
+
+
+
 bool
 MAST::StructuralElement2D::internal_residual_sensitivity (bool request_jacobian,
                                                           RealVectorX& f,
@@ -675,28 +870,33 @@ MAST::StructuralElement2D::internal_residual_sensitivity (bool request_jacobian,
     n2       =6*n_phi,
     n3       = this->n_von_karman_strain_components();
 
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    material_A_mat,
-    material_B_mat,
-    material_D_mat,
-    material_trans_shear_mat,
-    mat1_n1n2     = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
-    mat4_n3n2     = RealMatrixX::Zero(n3,n2),
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    stress        = RealMatrixX::Zero(2,2),
-    stress_l      = RealMatrixX::Zero(2,2),
-    local_jac     = RealMatrixX::Zero(n2,n2);
+    &mat_work       = scratch.matrix(n2,n2),
+    &material_A_mat = scratch.matrix(n1,n1),
+    &material_B_mat = scratch.matrix(n1,n1),
+    &material_D_mat = scratch.matrix(n1,n1),
+    &mat1_n1n2      = scratch.matrix(n1,n2),
+    &mat2_n2n2      = scratch.matrix(n2,n2),
+    &mat3           = scratch.matrix(n1,n2),
+    &mat4_n3n2      = scratch.matrix(n3,n2),
+    &vk_dwdxi_mat   = scratch.matrix(n1,n3),
+    &stress         = scratch.matrix(2,2),
+    &stress_l       = scratch.matrix(2,2),
+    &local_jac      = scratch.matrix(n2,n2);
     RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
-    vec3_n2    = RealVectorX::Zero(n2),
-    vec4_n3    = RealVectorX::Zero(n3),
-    vec5_n3    = RealVectorX::Zero(n3),
-    local_f    = RealVectorX::Zero(n2);
+    &vec1_n1    = scratch.vector(n1),
+    &vec2_n1    = scratch.vector(n1),
+    &vec3_n2    = scratch.vector(n2),
+    &vec4_n3    = scratch.vector(n3),
+    &vec5_n3    = scratch.vector(n3),
+    &local_f    = scratch.vector(n2);
     
-    FEMOperatorMatrix Bmat_mem, Bmat_bend, Bmat_vk;
+    FEMOperatorMatrix
+    &Bmat_mem   = scratch.operator_matrix(),
+    &Bmat_bend  = scratch.operator_matrix(),
+    &Bmat_vk    = scratch.operator_matrix();
     
     Bmat_mem.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
     Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
@@ -738,15 +938,16 @@ MAST::StructuralElement2D::internal_residual_sensitivity (bool request_jacobian,
         
         // now calculte the quantity for these matrices
         // this accounts for the sensitivity of the material property matrices
-        _internal_residual_operation(if_bending, if_vk, n2, qp, *_fe, JxW,
-                                     request_jacobian,
-                                     local_f, local_jac,
-                                     Bmat_mem, Bmat_bend, Bmat_vk,
-                                     stress, stress_l, vk_dwdxi_mat, material_A_mat,
-                                     material_B_mat, material_D_mat, vec1_n1,
-                                     vec2_n1, vec3_n2, vec4_n3,
-                                     vec5_n3, mat1_n1n2, mat2_n2n2,
-                                     mat3, mat4_n3n2);
+        _internal_residual_operation<Eigen::Dynamic>
+        (if_bending, if_vk, n2, qp, *_fe, JxW,
+         request_jacobian,
+         local_f, local_jac,
+         Bmat_mem, Bmat_bend, Bmat_vk,
+         stress, stress_l, vk_dwdxi_mat, material_A_mat,
+         material_B_mat, material_D_mat, vec1_n1,
+         vec2_n1, vec3_n2, vec4_n3,
+         vec5_n3, mat1_n1n2, mat2_n2n2,
+         mat3, mat4_n3n2);
         
         // this accounts for the sensitivity of the linear stress as a result of
         // static solution. This is needed only for cases that require linearized
@@ -776,7 +977,7 @@ MAST::StructuralElement2D::internal_residual_sensitivity (bool request_jacobian,
     f += vec3_n2;
     
     if (request_jacobian) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac += mat2_n2n2;
     }
     
@@ -787,6 +988,161 @@ MAST::StructuralElement2D::internal_residual_sensitivity (bool request_jacobian,
 
 
 
+void
+MAST::StructuralElement2D::
+internal_residual_multiparameter_sensitivity
+(const std::vector<const MAST::FunctionBase*>& params,
+ std::vector<RealVectorX>& f)
+{
+    libmesh_assert_equal_to(params.size(), f.size());
+    
+    // only the parameters that the section property depends on contribute
+    // to the internal residual
+    std::vector<unsigned int> dep_params;
+    for (unsigned int i=0; i<params.size(); i++) {
+        
+        libmesh_assert(!params[i]->is_shape_parameter()); // this is not implemented for now
+        
+        if (_property.depends_on(*params[i]))
+            dep_params.push_back(i);
+    }
+    
+    if (dep_params.empty())
+        return;
+    
+    const std::vector<Real>& JxW = _fe->get_JxW();
+    const std::vector<libMesh::Point>& xyz = _fe->get_xyz();
+    
+    const unsigned int
+    n_phi    = (unsigned int)_fe->get_phi().size(),
+    n1       = this->n_direct_strain_components(),
+    n2       =6*n_phi,
+    n3       = this->n_von_karman_strain_components(),
+    n_params = (unsigned int)dep_params.size();
+    
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealMatrixX
+    &material_A_mat = scratch.matrix(n1,n1),
+    &material_B_mat = scratch.matrix(n1,n1),
+    &material_D_mat = scratch.matrix(n1,n1),
+    &vk_dwdxi_mat   = scratch.matrix(n1,n3),
+    &local_jac      = scratch.matrix(n2,n2),
+    &local_f        = scratch.matrix(n2,n_params); // one column per parameter
+    RealVectorX
+    &strain     = scratch.vector(n1),
+    &kappa      = scratch.vector(n1),
+    &vk_strain  = scratch.vector(n1),
+    &force      = scratch.vector(n1),
+    &moment     = scratch.vector(n1),
+    &vec3_n2    = scratch.vector(n2),
+    &vec4_n3    = scratch.vector(n3),
+    &vec5_n2    = scratch.vector(n2);
+    
+    FEMOperatorMatrix
+    &Bmat_mem   = scratch.operator_matrix(),
+    &Bmat_bend  = scratch.operator_matrix(),
+    &Bmat_vk    = scratch.operator_matrix();
+    
+    Bmat_mem.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
+    Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
+    Bmat_vk.reinit(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
+    
+    bool if_vk = (_property.strain_type() == MAST::VON_KARMAN_STRAIN),
+    if_bending = (_property.bending_model(_elem, _fe->get_fe_type()) != MAST::NO_BENDING);
+    
+    const MAST::FieldFunction<RealMatrixX>
+    &mat_stiff_A = _property.property_matrix(MAST::STIFFNESS_A_MATRIX, *this),
+    &mat_stiff_B = _property.property_matrix(MAST::STIFFNESS_B_MATRIX, *this),
+    &mat_stiff_D = _property.property_matrix(MAST::STIFFNESS_D_MATRIX, *this);
+    
+    libMesh::Point p;
+    
+    for (unsigned int qp=0; qp<JxW.size(); qp++) {
+        
+        this->local_elem().global_coordinates_location(xyz[qp], p);
+        
+        // the strains depend only on the solution and are shared by all
+        // parameters. The von Karman strain, if applicable, is included
+        // in the membrane strain.
+        this->initialize_direct_strain_operator(qp, *_fe, Bmat_mem);
+        Bmat_mem.vector_mult(strain, _local_sol);
+        
+        if (if_bending) {
+            
+            _bending_operator->initialize_bending_strain_operator(*_fe, qp, Bmat_bend);
+            Bmat_bend.vector_mult(kappa, _local_sol);
+            
+            if (if_vk) {
+                
+                vk_strain.setZero();
+                this->initialize_von_karman_strain_operator(qp,
+                                                            *_fe,
+                                                            vk_strain,
+                                                            vk_dwdxi_mat,
+                                                            Bmat_vk);
+                strain += vk_strain;
+            }
+        }
+        
+        for (unsigned int i=0; i<n_params; i++) {
+            
+            const MAST::FunctionBase& f_param = *params[dep_params[i]];
+            
+            // sensitivity of the membrane force and bending moment
+            mat_stiff_A.derivative(f_param, p, _time, material_A_mat);
+            force.noalias() = material_A_mat * strain;
+            
+            if (if_bending) {
+                
+                mat_stiff_B.derivative(f_param, p, _time, material_B_mat);
+                mat_stiff_D.derivative(f_param, p, _time, material_D_mat);
+                
+                force.noalias()  += material_B_mat * kappa;
+                moment.noalias()  = material_B_mat.transpose() * strain;
+                moment.noalias() += material_D_mat * kappa;
+            }
+            
+            Bmat_mem.vector_mult_transpose(vec3_n2, force);
+            
+            if (if_bending) {
+                
+                Bmat_bend.vector_mult_transpose(vec5_n2, moment);
+                vec3_n2 += vec5_n2;
+                
+                if (if_vk) {
+                    
+                    vec4_n3.noalias() = vk_dwdxi_mat.transpose() * force;
+                    Bmat_vk.vector_mult_transpose(vec5_n2, vec4_n3);
+                    vec3_n2 += vec5_n2;
+                }
+            }
+            
+            local_f.col(i) += JxW[qp] * vec3_n2;
+        }
+    }
+    
+    for (unsigned int i=0; i<n_params; i++) {
+        
+        vec5_n2 = local_f.col(i);
+        
+        // now calculate the transverse shear contribution if appropriate
+        // for the element
+        if (if_bending && _bending_operator->include_transverse_shear_energy())
+            _bending_operator->calculate_transverse_shear_residual(false,
+                                                                   vec5_n2,
+                                                                   local_jac,
+                                                                   params[dep_params[i]]);
+        
+        // now transform to the global coorodinate system
+        transform_vector_to_global_system(vec5_n2, vec3_n2);
+        f[dep_params[i]] += vec3_n2;
+    }
+}
+
+
+
+
 bool
 MAST::StructuralElement2D::
 internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
@@ -800,6 +1156,7 @@ internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
     n3    = this->n_von_karman_strain_components();
     
     RealMatrixX
+    mat_work,
     material_A_mat,
     material_B_mat,
     material_D_mat,
@@ -941,7 +1298,7 @@ internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
         local_jac += JxW[qp] * mat2_n2n2;
     }
     
-    transform_matrix_to_global_system(local_jac, mat2_n2n2);
+    transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
     jac += mat2_n2n2;
     
     return true;
@@ -950,6 +1307,7 @@ internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
 
 
 
+template <int NPhi>
 void
 MAST::StructuralElement2D::_internal_residual_operation
 (bool if_bending,
@@ -964,27 +1322,27 @@ MAST::StructuralElement2D::_internal_residual_operation
  FEMOperatorMatrix& Bmat_mem,
  FEMOperatorMatrix& Bmat_bend,
  FEMOperatorMatrix& Bmat_vk,
- RealMatrixX& stress,
- RealMatrixX& stress_l,
- RealMatrixX& vk_dwdxi_mat,
- RealMatrixX& material_A_mat,
- RealMatrixX& material_B_mat,
- RealMatrixX& material_D_mat,
- RealVectorX& vec1_n1,
- RealVectorX& vec2_n1,
- RealVectorX& vec3_n2,
- RealVectorX& vec4_2,
- RealVectorX& vec5_2,
- RealMatrixX& mat1_n1n2,
- RealMatrixX& mat2_n2n2,
- RealMatrixX& mat3,
- RealMatrixX& mat4_2n2)
+ typename KernelTypes<NPhi>::Matrix22& stress,
+ typename KernelTypes<NPhi>::Matrix22& stress_l,
+ typename KernelTypes<NPhi>::MatrixN1N3& vk_dwdxi_mat,
+ const typename KernelTypes<NPhi>::MatrixN1N1& material_A_mat,
+ const typename KernelTypes<NPhi>::MatrixN1N1& material_B_mat,
+ const typename KernelTypes<NPhi>::MatrixN1N1& material_D_mat,
+ typename KernelTypes<NPhi>::VectorN1& vec1_n1,
+ typename KernelTypes<NPhi>::VectorN1& vec2_n1,
+ typename KernelTypes<NPhi>::VectorN2& vec3_n2,
+ typename KernelTypes<NPhi>::VectorN3& vec4_2,
+ typename KernelTypes<NPhi>::VectorN3& vec5_2,
+ typename KernelTypes<NPhi>::MatrixN1N2& mat1_n1n2,
+ typename KernelTypes<NPhi>::MatrixN2N2& mat2_n2n2,
+ typename KernelTypes<NPhi>::MatrixN1N2& mat3,
+ typename KernelTypes<NPhi>::MatrixN3N2& mat4_2n2)
 {
     this->initialize_direct_strain_operator(qp, fe, Bmat_mem);
     
     // first handle constant throught the thickness stresses: membrane and vonKarman
     Bmat_mem.vector_mult(vec1_n1, _local_sol);
-    vec2_n1 = material_A_mat * vec1_n1; // linear direct stress
+    vec2_n1.noalias() = material_A_mat * vec1_n1; // linear direct stress
     
     // copy the stress values to a matrix
     stress_l(0,0) = vec2_n1(0); // sigma_xx
@@ -1000,7 +1358,7 @@ MAST::StructuralElement2D::_internal_residual_operation
         _bending_operator->initialize_bending_strain_operator(fe, qp, Bmat_bend);
         
         Bmat_bend.vector_mult(vec2_n1, _local_sol);
-        vec1_n1 = material_B_mat * vec2_n1;
+        vec1_n1.noalias() = material_B_mat * vec2_n1;
         stress_l(0,0) += vec1_n1(0); // sigma_xx
         stress_l(0,1) += vec1_n1(2); // sigma_xy
         stress_l(1,0) += vec1_n1(2); // sigma_yx
@@ -1021,7 +1379,7 @@ MAST::StructuralElement2D::_internal_residual_operation
                                                         vk_dwdxi_mat,
                                                         Bmat_vk);
             
-            vec1_n1 = material_A_mat * vec2_n1; // stress
+            vec1_n1.noalias() = material_A_mat * vec2_n1; // stress
             stress(0,0) += vec1_n1(0); // sigma_xx
             stress(0,1) += vec1_n1(2); // sigma_xy
             stress(1,0) += vec1_n1(2); // sigma_yx
@@ -1048,20 +1406,20 @@ MAST::StructuralElement2D::_internal_residual_operation
     if (if_bending) {
         if (if_vk) {
             // von Karman strain
-            vec4_2 = vk_dwdxi_mat.transpose() * vec1_n1;
+            vec4_2.noalias() = vk_dwdxi_mat.transpose() * vec1_n1;
             Bmat_vk.vector_mult_transpose(vec3_n2, vec4_2);
             local_f += JxW[qp] * vec3_n2;
         }
         
         // now coupling with the bending strain
         // B_bend^T [B] B_mem
-        vec1_n1 = material_B_mat.transpose() * vec2_n1;
+        vec1_n1.noalias() = material_B_mat.transpose() * vec2_n1;
         Bmat_bend.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
         
         // now bending stress
         Bmat_bend.vector_mult(vec2_n1, _local_sol);
-        vec1_n1 = material_D_mat * vec2_n1;
+        vec1_n1.noalias() = material_D_mat * vec2_n1;
         Bmat_bend.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
     }
@@ -1075,16 +1433,19 @@ MAST::StructuralElement2D::_internal_residual_operation
         if (if_bending) {
             if (if_vk) {
                 // membrane - vk
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
+                // mat3 and mat4_2n2 keep their sizes of n1 x n2 and
+                // 2 x n2, so that they are not reallocated between the
+                // terms, and the products are not evaluated in place.
+                mat3.setZero(vk_dwdxi_mat.rows(), n2);
                 Bmat_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = material_A_mat * mat3;
-                Bmat_mem.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2.noalias() = material_A_mat * mat3;
+                Bmat_mem.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - membrane
                 Bmat_mem.left_multiply(mat1_n1n2, material_A_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat4_2n2.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat4_2n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // if only the first order term of the Jacobian is needed, for
@@ -1100,35 +1461,32 @@ MAST::StructuralElement2D::_internal_residual_operation
                 }
                 else*/ {
                     // vk - vk
-                    mat3 = RealMatrixX::Zero(2, n2);
-                    Bmat_vk.left_multiply(mat3, stress);
-                    Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                    Bmat_vk.left_multiply(mat4_2n2, stress);
+                    Bmat_vk.right_multiply_transpose(mat2_n2n2, mat4_2n2);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
-                    mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
                     Bmat_vk.left_multiply(mat3, vk_dwdxi_mat);
-                    mat3 = vk_dwdxi_mat.transpose() * material_A_mat * mat3;
-                    Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                    mat1_n1n2.noalias() = material_A_mat * mat3;
+                    mat4_2n2.noalias()  = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                    Bmat_vk.right_multiply_transpose(mat2_n2n2, mat4_2n2);
                     local_jac += JxW[qp] * mat2_n2n2;
                 }
                 
                 // bending - vk
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
                 Bmat_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = material_B_mat.transpose() * mat3;
-                Bmat_bend.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2.noalias() = material_B_mat.transpose() * mat3;
+                Bmat_bend.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - bending
                 Bmat_bend.left_multiply(mat1_n1n2, material_B_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat4_2n2.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat4_2n2);
                 local_jac += JxW[qp] * mat2_n2n2;
             }
             
             // bending - membrane
-            mat3 = material_B_mat.transpose();
-            Bmat_mem.left_multiply(mat1_n1n2, mat3);
+            Bmat_mem.left_multiply(mat1_n1n2, material_B_mat.transpose());
             Bmat_bend.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
@@ -1277,6 +1635,7 @@ MAST::StructuralElement2D::prestress_residual (bool request_jacobian,
     n3     = this->n_von_karman_strain_components();
     
     RealMatrixX
+    mat_work,
     mat2_n2n2     = RealMatrixX::Zero(n2,n2),
     mat3,
     vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
@@ -1366,7 +1725,7 @@ MAST::StructuralElement2D::prestress_residual (bool request_jacobian,
     transform_vector_to_global_system(local_f, vec3_n2);
     f += vec3_n2;
     if (request_jacobian && if_vk) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac += mat2_n2n2;
     }
     
@@ -1397,6 +1756,7 @@ MAST::StructuralElement2D::prestress_residual_sensitivity (bool request_jacobian
     n3    = this->n_von_karman_strain_components();
     
     RealMatrixX
+    mat_work,
     mat2_n2n2     = RealMatrixX::Zero(n2,n2),
     mat3,
     vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
@@ -1492,7 +1852,7 @@ MAST::StructuralElement2D::prestress_residual_sensitivity (bool request_jacobian
     transform_vector_to_global_system(local_f, vec3_n2);
     f += vec3_n2;
     if (request_jacobian && if_vk) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac += mat2_n2n2;
     }
     
@@ -1543,17 +1903,21 @@ surface_pressure_residual(bool request_jacobian,
     const MAST::FieldFunction<Real>& t_func =
     _property.get<MAST::FieldFunction<Real> >("h");
     
-    FEMOperatorMatrix Bmat;
     Real
     press   = 0.,
     t_val   = 0.;
     libMesh::Point pt;
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealVectorX
-    phi_vec     = RealVectorX::Zero(n_phi),
-    force       = RealVectorX::Zero(2*n1),
-    local_f     = RealVectorX::Zero(n2),
-    vec_n2      = RealVectorX::Zero(n2);
+    &phi_vec     = scratch.vector(n_phi),
+    &force       = scratch.vector(2*n1),
+    &local_f     = scratch.vector(n2),
+    &vec_n2      = scratch.vector(n2);
+    
+    MAST::FEMOperatorMatrix
+    &Bmat = scratch.operator_matrix();
     
     for (unsigned int qp=0; qp<qpoint.size(); qp++) {
         
@@ -1693,35 +2057,36 @@ MAST::StructuralElement2D::thermal_residual (bool request_jacobian,
                                              RealMatrixX& jac,
                                              MAST::BoundaryConditionBase& bc)
 {
-    FEMOperatorMatrix Bmat_mem, Bmat_bend, Bmat_vk;
-    
     const std::vector<Real>& JxW = _fe->get_JxW();
     const std::vector<libMesh::Point>& xyz = _fe->get_xyz();
     const unsigned int n_phi = (unsigned int)_fe->get_phi().size();
     const unsigned int n1= this->n_direct_strain_components(), n2=6*n_phi,
     n3 = this->n_von_karman_strain_components();
+    
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    material_exp_A_mat,
-    material_exp_B_mat,
-    mat1_n1n2     = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
-    mat4_n3n2     = RealMatrixX::Zero(n3,n2),
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    stress        = RealMatrixX::Zero(2,2),
-    local_jac     = RealMatrixX::Zero(n2,n2);
+    &mat_work           = scratch.matrix(n2,n2),
+    &material_exp_A_mat = scratch.matrix(n1,1),
+    &material_exp_B_mat = scratch.matrix(n1,1),
+    &mat2_n2n2          = scratch.matrix(n2,n2),
+    &mat4_n3n2          = scratch.matrix(n3,n2),
+    &vk_dwdxi_mat       = scratch.matrix(n1,n3),
+    &stress             = scratch.matrix(2,2),
+    &local_jac          = scratch.matrix(n2,n2);
     RealVectorX
-    vec1_n1     = RealVectorX::Zero(n1),
-    vec2_n1     = RealVectorX::Zero(n1),
-    vec3_n2     = RealVectorX::Zero(n2),
-    vec4_2      = RealVectorX::Zero(2),
-    vec5_n3     = RealVectorX::Zero(n3),
-    local_f     = RealVectorX::Zero(n2),
-    delta_t     = RealVectorX::Zero(1);
+    &vec1_n1     = scratch.vector(n1),
+    &vec2_n1     = scratch.vector(n1),
+    &vec3_n2     = scratch.vector(n2),
+    &vec4_2      = scratch.vector(2),
+    &local_f     = scratch.vector(n2),
+    &delta_t     = scratch.vector(1);
+    
+    FEMOperatorMatrix
+    &Bmat_mem    = scratch.operator_matrix(),
+    &Bmat_bend   = scratch.operator_matrix(),
+    &Bmat_vk     = scratch.operator_matrix();
     
-    local_f.setZero();
-    local_jac.setZero();
-
     Bmat_mem.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
     Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
     Bmat_vk.reinit(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
@@ -1729,9 +2094,9 @@ MAST::StructuralElement2D::thermal_residual (bool request_jacobian,
     bool if_vk = (_property.strain_type() == MAST::VON_KARMAN_STRAIN),
     if_bending = (_property.bending_model(_elem, _fe->get_fe_type()) != MAST::NO_BENDING);
     
-    std::auto_ptr<MAST::FieldFunction<RealMatrixX > >
-    expansion_A = _property.thermal_expansion_A_matrix(*this),
-    expansion_B = _property.thermal_expansion_B_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    &expansion_A = _property.property_matrix(MAST::THERMAL_EXPANSION_A_MATRIX, *this),
+    &expansion_B = _property.property_matrix(MAST::THERMAL_EXPANSION_B_MATRIX, *this);
     
     const MAST::FieldFunction<Real>
     &temp_func     = bc.get<MAST::FieldFunction<Real> >("temperature"),
@@ -1745,16 +2110,16 @@ MAST::StructuralElement2D::thermal_residual (bool request_jacobian,
         this->local_elem().global_coordinates_location(xyz[qp], pt);
         
         // this is moved inside the domain since
-        (*expansion_A)(pt, _time, material_exp_A_mat);
-        (*expansion_B)(pt, _time, material_exp_B_mat);
+        expansion_A(pt, _time, material_exp_A_mat);
+        expansion_B(pt, _time, material_exp_B_mat);
         
         // get the temperature function
         temp_func(pt, _time, t);
         ref_temp_func(pt, _time, t0);
         delta_t(0) = t-t0;
         
-        vec1_n1 = material_exp_A_mat * delta_t; // [C]{alpha (T - T0)} (with membrane strain)
-        vec2_n1 = material_exp_B_mat * delta_t; // [C]{alpha (T - T0)} (with bending strain)
+        vec1_n1.noalias() = material_exp_A_mat * delta_t; // [C]{alpha (T - T0)} (with membrane strain)
+        vec2_n1.noalias() = material_exp_B_mat * delta_t; // [C]{alpha (T - T0)} (with bending strain)
         stress(0,0) = vec1_n1(0); // sigma_xx
         stress(0,1) = vec1_n1(2); // sigma_xy
         stress(1,0) = vec1_n1(2); // sigma_yx
@@ -1781,16 +2146,15 @@ MAST::StructuralElement2D::thermal_residual (bool request_jacobian,
                                                             vk_dwdxi_mat,
                                                             Bmat_vk);
                 // von Karman strain
-                vec4_2 = vk_dwdxi_mat.transpose() * vec1_n1;
+                vec4_2.noalias() = vk_dwdxi_mat.transpose() * vec1_n1;
                 Bmat_vk.vector_mult_transpose(vec3_n2, vec4_2);
                 local_f += JxW[qp] * vec3_n2;
             }
             
             if (request_jacobian && if_vk) { // Jacobian only for vk strain
                                              // vk - vk
-                mat3 = RealMatrixX::Zero(2, n2);
-                Bmat_vk.left_multiply(mat3, stress);
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_vk.left_multiply(mat4_n3n2, stress);
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat4_n3n2);
                 local_jac += JxW[qp] * mat2_n2n2;
             }
         }
@@ -1800,7 +2164,7 @@ MAST::StructuralElement2D::thermal_residual (bool request_jacobian,
     transform_vector_to_global_system(local_f, vec3_n2);
     f -= vec3_n2;
     if (request_jacobian && if_vk) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac -= mat2_n2n2;
     }
     
@@ -1826,6 +2190,7 @@ thermal_residual_sensitivity (bool request_jacobian,
     const unsigned int n1= this->n_direct_strain_components(), n2=6*n_phi,
     n3 = this->n_von_karman_strain_components();
     RealMatrixX
+    mat_work,
     material_exp_A_mat,
     material_exp_B_mat,
     material_exp_A_mat_sens,
@@ -1953,7 +2318,7 @@ thermal_residual_sensitivity (bool request_jacobian,
     transform_vector_to_global_system(local_f, vec3_n2);
     f -= vec3_n2;
     if (request_jacobian && if_vk) {
-        transform_matrix_to_global_system(local_jac, mat2_n2n2);
+        transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
         jac -= mat2_n2n2;
     }
     
@@ -2066,6 +2431,7 @@ piston_theory_residual(bool request_jacobian,
     dummy    = RealVectorX::Zero(3);
 
     RealMatrixX
+    mat_work,
     dwdx            = RealMatrixX::Zero(3,2),
     local_jac_xdot  = RealMatrixX::Zero(n2,n2),
     local_jac       = RealMatrixX::Zero(n2,n2),
@@ -2166,10 +2532,10 @@ piston_theory_residual(bool request_jacobian,
     // if the Jacobian was requested, then transform it and add to the
     // global Jacobian
     if (request_jacobian) {
-        transform_matrix_to_global_system(local_jac_xdot, mat_n2n2);
+        transform_matrix_to_global_system(local_jac_xdot, mat_n2n2, mat_work);
         jac_xdot -= mat_n2n2;
         
-        transform_matrix_to_global_system(local_jac, mat_n2n2);
+        transform_matrix_to_global_system(local_jac, mat_n2n2, mat_work);
         jac      -= mat_n2n2;
     }
     
@@ -2246,6 +2612,7 @@ piston_theory_residual_sensitivity(bool request_jacobian,
     dummy    = RealVectorX::Zero(3);
     
     RealMatrixX
+    mat_work,
     dwdx            = RealMatrixX::Zero(3,2),
     local_jac_xdot  = RealMatrixX::Zero(n2,n2),
     local_jac       = RealMatrixX::Zero(n2,n2),
@@ -2355,10 +2722,10 @@ piston_theory_residual_sensitivity(bool request_jacobian,
     // if the Jacobian was requested, then transform it and add to the
     // global Jacobian
     if (request_jacobian) {
-        transform_matrix_to_global_system(local_jac_xdot, mat_n2n2);
+        transform_matrix_to_global_system(local_jac_xdot, mat_n2n2, mat_work);
         jac_xdot -= mat_n2n2;
         
-        transform_matrix_to_global_system(local_jac, mat_n2n2);
+        transform_matrix_to_global_system(local_jac, mat_n2n2, mat_work);
         jac      -= mat_n2n2;
     }
     
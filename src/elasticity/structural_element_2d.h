@@ -22,10 +22,12 @@
 
 // C++ includes
 #include <memory>
+#include <vector>
 
 
 // MAST includes
 #include "elasticity/bending_structural_element.h"
+#include "elasticity/structural_kernel_types.h"
 
 
 
@@ -77,6 +79,18 @@ namespace MAST {
         virtual bool internal_residual_sensitivity(bool request_jacobian,
                                                    RealVectorX& f,
                                                    RealMatrixX& jac);
+        
+        /*!
+         *    Calculates the sensitivity of the internal residual vector with
+         *    respect to each parameter in \p params. The strain operators and
+         *    the strains are computed once per quadrature point, and only the
+         *    section matrix derivatives are evaluated for each parameter.
+         */
+        virtual void
+        internal_residual_multiparameter_sensitivity
+        (const std::vector<const MAST::FunctionBase*>& params,
+         std::vector<RealVectorX>& f);
+        
         /*!
          *   calculates d[J]/d{x} . d{x}/dp
          */
@@ -110,6 +124,22 @@ namespace MAST {
 
     protected:
         
+        /*!
+         *    matrix and vector types of the internal residual kernels for
+         *    \p NPhi shape functions
+         */
+        template <int NPhi>
+        using KernelTypes = MAST::StructuralKernelTypes<3, 2, NPhi>;
+        
+        /*!
+         *    implements internal_residual() with the number of shape
+         *    functions fixed at compile time to \p NPhi, so that the
+         *    element matrices use fixed-size storage.
+         */
+        template <int NPhi>
+        bool _internal_residual(bool request_jacobian,
+                                RealVectorX& f,
+                                RealMatrixX& jac);
         
         /*!
          *    Calculates the force vector and Jacobian due to surface pressure.
@@ -267,12 +297,16 @@ namespace MAST {
          *   matrices needed for Jacobian calculation.
          *   vk_strain = [dw/dx 0; 0 dw/dy; dw/dy dw/dx]
          *   Bmat_vk   = [dw/dx; dw/dy]
+         *   \par vk_strain and \par vk_dwdxi_mat may have fixed or dynamic
+         *   size, so that the fixed-size kernels are initialized without
+         *   copies.
          */
-        virtual void
+        template <typename VecType, typename MatType>
+        void
         initialize_von_karman_strain_operator(const unsigned int qp,
                                               const libMesh::FEBase& fe,
-                                              RealVectorX& vk_strain,
-                                              RealMatrixX& vk_dwdxi_mat,
+                                              VecType& vk_strain,
+                                              MatType& vk_dwdxi_mat,
                                               MAST::FEMOperatorMatrix& Bmat_vk);
         
         /*!
@@ -288,9 +322,11 @@ namespace MAST {
         /*!
          *   performs integration at the quadrature point for the provided
          *   matrices. The temperature vector and matrix entities are provided for
-         *   integration
+         *   integration. The work matrices have fixed size for \p NPhi
+         *   shape functions, or dynamic size if \p NPhi is Eigen::Dynamic.
          */
-        virtual void
+        template <int NPhi>
+        void
         _internal_residual_operation(bool if_bending,
                                      bool if_vk,
                                      const unsigned int n2,
@@ -303,21 +339,21 @@ namespace MAST {
                                      MAST::FEMOperatorMatrix& Bmat_mem,
                                      MAST::FEMOperatorMatrix& Bmat_bend,
                                      MAST::FEMOperatorMatrix& Bmat_vk,
-                                     RealMatrixX& stress,
-                                     RealMatrixX& stress_l,
-                                     RealMatrixX& vk_dwdxi_mat,
-                                     RealMatrixX& material_A_mat,
-                                     RealMatrixX& material_B_mat,
-                                     RealMatrixX& material_D_mat,
-                                     RealVectorX& vec1_n1,
-                                     RealVectorX& vec2_n1,
-                                     RealVectorX& vec3_n2,
-                                     RealVectorX& vec4_2,
-                                     RealVectorX& vec5_2,
-                                     RealMatrixX& mat1_n1n2,
-                                     RealMatrixX& mat2_n2n2,
-                                     RealMatrixX& mat3,
-                                     RealMatrixX& mat4_2n2);
+                                     typename KernelTypes<NPhi>::Matrix22& stress,
+                                     typename KernelTypes<NPhi>::Matrix22& stress_l,
+                                     typename KernelTypes<NPhi>::MatrixN1N3& vk_dwdxi_mat,
+                                     const typename KernelTypes<NPhi>::MatrixN1N1& material_A_mat,
+                                     const typename KernelTypes<NPhi>::MatrixN1N1& material_B_mat,
+                                     const typename KernelTypes<NPhi>::MatrixN1N1& material_D_mat,
+                                     typename KernelTypes<NPhi>::VectorN1& vec1_n1,
+                                     typename KernelTypes<NPhi>::VectorN1& vec2_n1,
+                                     typename KernelTypes<NPhi>::VectorN2& vec3_n2,
+                                     typename KernelTypes<NPhi>::VectorN3& vec4_2,
+                                     typename KernelTypes<NPhi>::VectorN3& vec5_2,
+                                     typename KernelTypes<NPhi>::MatrixN1N2& mat1_n1n2,
+                                     typename KernelTypes<NPhi>::MatrixN2N2& mat2_n2n2,
+                                     typename KernelTypes<NPhi>::MatrixN1N2& mat3,
+                                     typename KernelTypes<NPhi>::MatrixN3N2& mat4_2n2);
         
         /*!
          *   sensitivity of linear part of the geometric stiffness matrix
@@ -355,6 +391,25 @@ namespace MAST {
         void _convert_prestress_B_mat_to_vector(const RealMatrixX& mat,
                                                 RealVectorX& vec) const;
 
+        /*!
+         *   quadrature point locations in the global coordinate system,
+         *   used for the batch evaluation of the section properties
+         */
+        std::vector<libMesh::Point> _qp_xyz;
+        
+        /*!
+         *   section stiffness matrices at the quadrature points. These are
+         *   retained across calls so that their storage is reused.
+         */
+        std::vector<RealMatrixX> _material_A_qp, _material_B_qp, _material_D_qp;
+        
+        /*!
+         *   number of shape functions for which the fixed-size
+         *   internal_residual() kernel is used. This is selected at
+         *   construction based on the element type, and is zero if
+         *   the dynamic kernel is used.
+         */
+        unsigned int _n_phi_fixed_kernel;
     };
 }
 
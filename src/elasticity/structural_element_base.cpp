@@ -30,6 +30,8 @@
 #include "mesh/local_2d_elem.h"
 #include "mesh/local_3d_elem.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/nodal_transformation.h"
+#include "numerics/scratch_arena.h"
 #include "numerics/utility.h"
 #include "elasticity/stress_output_base.h"
 #include "base/nonlinear_system.h"
@@ -80,6 +82,29 @@ MAST::StructuralElementBase::~StructuralElementBase() {
 
 
 
+void
+MAST::StructuralElementBase::clear_state() {
+    
+    MAST::ElementBase::clear_state();
+    
+    _local_sol.resize(0);
+    _local_delta_sol.resize(0);
+    _local_sol_sens.resize(0);
+    _local_delta_sol_sens.resize(0);
+    _local_vel.resize(0);
+    _local_delta_vel.resize(0);
+    _local_vel_sens.resize(0);
+    _local_delta_vel_sens.resize(0);
+    _local_accel.resize(0);
+    _local_delta_accel.resize(0);
+    _local_accel_sens.resize(0);
+    _local_delta_accel_sens.resize(0);
+    
+    _incompatible_sol = nullptr;
+}
+
+
+
 void
 MAST::StructuralElementBase::set_solution(const RealVectorX& vec,
                                           bool if_sens) {
@@ -299,29 +324,33 @@ MAST::StructuralElementBase::inertial_residual (bool request_jacobian,
     n1       =6,
     n2       =6*n_phi;
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    material_mat,
-    mat1_n1n2     = RealMatrixX::Zero(n1, n2),
-    mat2_n2n2     = RealMatrixX::Zero(n2, n2),
-    local_jac     = RealMatrixX::Zero(n2, n2);
+    &mat_work      = scratch.matrix(n2, n2),
+    &material_mat  = scratch.matrix(n1, n1),
+    &mat1_n1n2     = scratch.matrix(n1, n2),
+    &mat2_n2n2     = scratch.matrix(n2, n2),
+    &local_jac     = scratch.matrix(n2, n2);
     RealVectorX
-    phi_vec    = RealVectorX::Zero(n_phi),
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n2    = RealVectorX::Zero(n2),
-    local_f    = RealVectorX::Zero(n2);
+    &phi_vec    = scratch.vector(n_phi),
+    &vec1_n1    = scratch.vector(n1),
+    &vec2_n2    = scratch.vector(n2),
+    &local_f    = scratch.vector(n2);
     
-    std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
-    mat_inertia  = _property.inertia_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    &mat_inertia = _property.property_matrix(MAST::INERTIA_MATRIX, *this);
     
     libMesh::Point p;
-    MAST::FEMOperatorMatrix Bmat;
+    MAST::FEMOperatorMatrix
+    &Bmat = scratch.operator_matrix();
     
     if (_property.if_diagonal_mass_matrix()) {
         
         // as an approximation, get matrix at the first quadrature point
         _local_elem->global_coordinates_location(xyz[0], p);
         
-        (*mat_inertia)(p, _time, material_mat);
+        mat_inertia(p, _time, material_mat);
         
         Real vol = 0.;
         const unsigned int nshp = _fe->n_shape_functions();
@@ -333,16 +362,15 @@ MAST::StructuralElementBase::inertial_residual (bool request_jacobian,
                 local_jac(i_var*nshp+i, i_var*nshp+i) =
                 vol*material_mat(i_var, i_var);
         
-        local_f =  local_jac * _local_accel;
+        local_f.noalias() =  local_jac * _local_accel;
     }
     else {
-        libMesh::Point p;
         
         for (unsigned int qp=0; qp<JxW.size(); qp++) {
             
             _local_elem->global_coordinates_location(xyz[0], p);
             
-            (*mat_inertia)(p, _time, material_mat);
+            mat_inertia(p, _time, material_mat);
             
             // now set the shape function values
             for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
@@ -352,7 +380,7 @@ MAST::StructuralElementBase::inertial_residual (bool request_jacobian,
             
             Bmat.left_multiply(mat1_n1n2, material_mat);
             
-            vec1_n1 = mat1_n1n2 * _local_accel;
+            vec1_n1.noalias() = mat1_n1n2 * _local_accel;
             Bmat.vector_mult_transpose(vec2_n2, vec1_n1);
             
             local_f += JxW[qp] * vec2_n2;
@@ -372,7 +400,7 @@ MAST::StructuralElementBase::inertial_residual (bool request_jacobian,
         f += vec2_n2;
         
         if (request_jacobian) {
-            transform_matrix_to_global_system(local_jac, mat2_n2n2);
+            transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
             jac_xddot += mat2_n2n2;
         }
     }
@@ -435,6 +463,29 @@ linearized_inertial_residual (bool request_jacobian,
 
 
 
+void
+MAST::StructuralElementBase::
+internal_residual_multiparameter_sensitivity
+(const std::vector<const MAST::FunctionBase*>& params,
+ std::vector<RealVectorX>& f) {
+    
+    libmesh_assert_equal_to(params.size(), f.size());
+    
+    const MAST::FunctionBase* p = this->sensitivity_param;
+    RealMatrixX dummy;
+    
+    for (unsigned int i=0; i<params.size(); i++) {
+        
+        this->sensitivity_param = params[i];
+        this->internal_residual_sensitivity(false, f[i], dummy);
+    }
+    
+    this->sensitivity_param = p;
+}
+
+
+
+
 bool
 MAST::StructuralElementBase::inertial_residual_sensitivity (bool request_jacobian,
                                                             RealVectorX& f,
@@ -453,6 +504,7 @@ MAST::StructuralElementBase::inertial_residual_sensitivity (bool request_jacobia
     n2       =6*n_phi;
     
     RealMatrixX
+    mat_work,
     material_mat,
     mat1_n1n2     = RealMatrixX::Zero(n1, n2),
     mat2_n2n2     = RealMatrixX::Zero(n2, n2),
@@ -527,7 +579,7 @@ MAST::StructuralElementBase::inertial_residual_sensitivity (bool request_jacobia
         f += vec2_n2;
         
         if (request_jacobian) {
-            transform_matrix_to_global_system(local_jac, mat2_n2n2);
+            transform_matrix_to_global_system(local_jac, mat2_n2n2, mat_work);
             jac_xddot += mat2_n2n2;
         }
     }
@@ -1131,14 +1183,18 @@ surface_pressure_residual(bool request_jacobian,
     bc.get<MAST::FieldFunction<Real> >("pressure");
     
     Real press;
-    FEMOperatorMatrix Bmat;
     libMesh::Point pt;
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealVectorX
-    phi_vec  = RealVectorX::Zero(n_phi),
-    force    = RealVectorX::Zero(2*n1),
-    local_f  = RealVectorX::Zero(n2),
-    vec_n2   = RealVectorX::Zero(n2);
+    &phi_vec     = scratch.vector(n_phi),
+    &force       = scratch.vector(2*n1),
+    &local_f     = scratch.vector(n2),
+    &vec_n2      = scratch.vector(n2);
+    
+    MAST::FEMOperatorMatrix
+    &Bmat = scratch.operator_matrix();
     
     
     for (unsigned int qp=0; qp<qpoint.size(); qp++)
@@ -1425,7 +1481,8 @@ template <typename ValType>
 void
 MAST::StructuralElementBase::
 transform_matrix_to_global_system(const ValType& local_mat,
-                                  ValType& global_mat) const {
+                                  ValType& global_mat,
+                                  ValType& work) const {
     
     libmesh_assert_equal_to( local_mat.rows(),  local_mat.cols());
     libmesh_assert_equal_to(global_mat.rows(), global_mat.cols());
@@ -1433,22 +1490,12 @@ transform_matrix_to_global_system(const ValType& local_mat,
     
     const unsigned int n_dofs = _fe->n_shape_functions();
 
-    ValType mat(6*n_dofs, 6*n_dofs);
-    
-    mat.setZero();
-    global_mat.setZero();
-    
-    const RealMatrixX& Tmat = this->local_elem().T_matrix();
-    // now initialize the global T matrix
-    for (unsigned int i=0; i<n_dofs; i++)
-        for (unsigned int j=0; j<3; j++)
-            for (unsigned int k=0; k<3; k++) {
-                mat(j*n_dofs+i, k*n_dofs+i) = Tmat(j,k); // for u,v,w
-                mat((j+3)*n_dofs+i, (k+3)*n_dofs+i) = Tmat(j,k); // for tx,ty,tz
-            }
-    
     // right multiply with T^tr, and left multiply with T.
-    global_mat = mat * local_mat * mat.transpose();
+    MAST::transform_nodal_matrix_to_global(this->local_elem().T_matrix(),
+                                           n_dofs,
+                                           local_mat,
+                                           global_mat,
+                                           work);
 }
 
 
@@ -1462,21 +1509,12 @@ transform_vector_to_local_system(const ValType& global_vec,
     libmesh_assert_equal_to( local_vec.size(),  global_vec.size());
     
     const unsigned int n_dofs = _fe->n_shape_functions();
-    RealMatrixX mat  = RealMatrixX::Zero(6*n_dofs, 6*n_dofs);
-    
-    local_vec.setZero();
-
-    const RealMatrixX& Tmat = this->local_elem().T_matrix();
-    // now initialize the global T matrix
-    for (unsigned int i=0; i<n_dofs; i++)
-        for (unsigned int j=0; j<3; j++)
-            for (unsigned int k=0; k<3; k++) {
-                mat(j*n_dofs+i, k*n_dofs+i) = Tmat(j,k); // for u,v,w
-                mat((j+3)*n_dofs+i, (k+3)*n_dofs+i) = Tmat(j,k); // for tx,ty,tz
-            }
     
     // left multiply with T^tr
-    local_vec = mat.transpose() * global_vec;
+    MAST::transform_nodal_vector_to_local(this->local_elem().T_matrix(),
+                                          n_dofs,
+                                          global_vec,
+                                          local_vec);
 }
 
 
@@ -1491,21 +1529,11 @@ transform_vector_to_global_system(const ValType& local_vec,
     
     const unsigned int n_dofs = _fe->n_shape_functions();
 
-    RealMatrixX mat  = RealMatrixX::Zero(6*n_dofs, 6*n_dofs);
-
-    global_vec.setZero();
-    
-    const RealMatrixX& Tmat = this->local_elem().T_matrix();
-    // now initialize the global T matrix
-    for (unsigned int i=0; i<n_dofs; i++)
-        for (unsigned int j=0; j<3; j++)
-            for (unsigned int k=0; k<3; k++) {
-                mat(j*n_dofs+i, k*n_dofs+i) = Tmat(j,k); // for u,v,w
-                mat((j+3)*n_dofs+i, (k+3)*n_dofs+i) = Tmat(j,k); // for tx,ty,tz
-            }
-    
     // left multiply with T
-    global_vec = mat* local_vec;
+    MAST::transform_nodal_vector_to_global(this->local_elem().T_matrix(),
+                                           n_dofs,
+                                           local_vec,
+                                           global_vec);
 }
 
 
@@ -1609,7 +1637,8 @@ template
 void
 MAST::StructuralElementBase::transform_matrix_to_global_system<RealMatrixX>
 (const RealMatrixX& local_mat,
- RealMatrixX& global_mat) const;
+ RealMatrixX& global_mat,
+ RealMatrixX& work) const;
 
 
 template
@@ -1630,7 +1659,8 @@ template
 void
 MAST::StructuralElementBase::transform_matrix_to_global_system<ComplexMatrixX>
 (const ComplexMatrixX& local_mat,
- ComplexMatrixX& global_mat) const;
+ ComplexMatrixX& global_mat,
+ ComplexMatrixX& work) const;
 
 
 template
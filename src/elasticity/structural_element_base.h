@@ -23,6 +23,7 @@
 // C++ includes
 #include <memory>
 #include <map>
+#include <vector>
 
 // MAST includes
 #include "base/elem_base.h"
@@ -97,6 +98,13 @@ namespace MAST {
          */
         virtual void set_perturbed_acceleration(const RealVectorX& vec,
                                                 bool if_sens = false);
+        
+        
+        /*!
+         *   clears the local solutions in addition to the solutions of the
+         *   base class, and the pointer to the incompatible mode solution.
+         */
+        virtual void clear_state();
 
         
         /*!
@@ -296,6 +304,20 @@ namespace MAST {
                                                     RealVectorX& f,
                                                     RealMatrixX& jac) = 0;
 
+        /*!
+         *   sensitivity of the internal force contribution to system residual
+         *   with respect to each parameter in \p params. The sensitivity
+         *   with respect to \p params[i] is added to \p f[i]. The default
+         *   implementation calls internal_residual_sensitivity() for each
+         *   parameter, and the derived classes may override this to share
+         *   the strain operators and solution interpolation between the
+         *   parameters. The value of \p sensitivity_param is not changed.
+         */
+        virtual void
+        internal_residual_multiparameter_sensitivity
+        (const std::vector<const MAST::FunctionBase*>& params,
+         std::vector<RealVectorX>& f);
+
         /*!
          *   sensitivity of the damping force contribution to system residual
          */
@@ -385,9 +407,16 @@ namespace MAST {
         bool follower_forces;
         
 
+        /*!
+         *    transforms \par local_mat from the element local coordinate
+         *    system to the global system in \par global_mat. \par work is
+         *    used as workspace, and retains its storage if the same matrix
+         *    is passed to repeated calls.
+         */
         template <typename ValType>
         void transform_matrix_to_global_system(const ValType& local_mat,
-                                               ValType& global_mat) const;
+                                               ValType& global_mat,
+                                               ValType& work) const;
         
         template <typename ValType>
         void transform_vector_to_local_system(const ValType& global_vec,
@@ -160,7 +160,8 @@ assemble_reduced_order_quantity
     
     std::vector<libMesh::dof_id_type> dof_indices;
     const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     std::auto_ptr<libMesh::NumericVector<Real> > localized_solution;
     if (_base_sol)
@@ -190,7 +191,7 @@ assemble_reduced_order_quantity
         
         dof_map.dof_indices (elem, dof_indices);
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -292,7 +293,8 @@ assemble_reduced_order_quantity_sensitivity
     
     std::vector<libMesh::dof_id_type> dof_indices;
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     std::auto_ptr<libMesh::NumericVector<Real> >
     localized_solution,
@@ -332,7 +334,7 @@ assemble_reduced_order_quantity_sensitivity
         
         dof_map.dof_indices (elem, dof_indices);
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -0,0 +1,63 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef __mast__structural_kernel_types_h__
+#define __mast__structural_kernel_types_h__
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Matrix and vector types used by the internal residual kernels of
+     *   the 1D and 2D structural elements, for \p N1 direct strain
+     *   components, \p N3 von Karman strain components and \p NPhi shape
+     *   functions per variable. The elements have six variables. If
+     *   \p NPhi is Eigen::Dynamic all types are the dynamic RealMatrixX and
+     *   RealVectorX, which is used by the kernels for element types
+     *   without a fixed-size instantiation.
+     */
+    template <int N1, int N3, int NPhi>
+    struct StructuralKernelTypes {
+        
+        static const int
+        n1 = (NPhi == Eigen::Dynamic)? Eigen::Dynamic : N1,
+        n2 = (NPhi == Eigen::Dynamic)? Eigen::Dynamic : 6*NPhi,
+        n3 = (NPhi == Eigen::Dynamic)? Eigen::Dynamic : N3,
+        n4 = (NPhi == Eigen::Dynamic)? Eigen::Dynamic : 2;
+        
+        typedef Eigen::Matrix<Real, n1, 1>  VectorN1;
+        typedef Eigen::Matrix<Real, n2, 1>  VectorN2;
+        typedef Eigen::Matrix<Real, n3, 1>  VectorN3;
+        typedef Eigen::Matrix<Real, n1, n1> MatrixN1N1;
+        typedef Eigen::Matrix<Real, n1, n2> MatrixN1N2;
+        typedef Eigen::Matrix<Real, n1, n3> MatrixN1N3;
+        typedef Eigen::Matrix<Real, n3, n2> MatrixN3N2;
+        typedef Eigen::Matrix<Real, n2, n2> MatrixN2N2;
+        
+        /*!
+         *   2x2 stress resultant tensor
+         */
+        typedef Eigen::Matrix<Real, n4, n4> Matrix22;
+    };
+}
+
+
+#endif // __mast__structural_kernel_types_h__
@@ -29,6 +29,7 @@
 #include "numerics/utility.h"
 #include "base/real_output_function.h"
 #include "base/nonlinear_system.h"
+#include "base/elem_dof_indices.h"
 
 
 // libMesh includes
@@ -38,6 +39,7 @@
 #include "libmesh/petsc_nonlinear_solver.h"
 #include "libmesh/petsc_vector.h"
 #include "libmesh/parameter_vector.h"
+#include "libmesh/threads.h"
 
 
 
@@ -77,14 +79,23 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     RealVectorX vec, sol;
     RealMatrixX mat;
     
-    std::vector<libMesh::dof_id_type> dof_indices;
+    MAST::ElemDofIndices elem_dofs;
     const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     std::auto_ptr<libMesh::NumericVector<Real> > localized_solution;
     localized_solution.reset(_build_localized_vector(nonlin_sys,
                                                      X).release());
     
+    if (_use_threaded_assembly()) {
+        
+        _threaded_residual_and_jacobian(*localized_solution, R, J);
+        
+        if (R) R->close();
+        if (J) J->close();
+        return;
+    }
     
     // if a solution function is attached, initialize it
     if (_sol_function)
@@ -101,22 +112,20 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
-        dof_map.dof_indices (elem, dof_indices);
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
 
         MAST::StructuralElementBase& p_elem =
         dynamic_cast<MAST::StructuralElementBase&>(*physics_elem);
 
         
         // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
+        unsigned int ndofs = dofs.size();
         vec.setZero(ndofs);
         mat.setZero(ndofs, ndofs);
         
-        for (unsigned int i=0; i<dof_indices.size(); i++)
-            sol(i) = (*localized_solution)(dof_indices[i]);
+        dofs.gather(*localized_solution, sol);
         
         physics_elem->set_solution    (sol);
         physics_elem->set_velocity    (vec); // set to zero vector for a quasi-steady analysis
@@ -144,26 +153,9 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         
         physics_elem->detach_active_solution_function();
         
-        // copy to the libMesh matrix for further processing
-        DenseRealVector v;
-        DenseRealMatrix m;
-        if (R)
-            MAST::copy(v, vec);
-        if (J)
-            MAST::copy(m, mat);
-        
         // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        if (R && J)
-            dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
-        else if (R)
-            dof_map.constrain_element_vector(v, dof_indices);
-        else
-            dof_map.constrain_element_matrix(m, dof_indices);
-        
-        // add to the global matrices
-        if (R) R->add_vector(v, dof_indices);
-        if (J) J->add_matrix(m, dof_indices);
+        // Dirichlet constraints, etc., and add to the global matrices
+        dofs.add(dof_map, vec, mat, R, J);
     }
     
     
@@ -194,9 +186,10 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
     RealVectorX vec, sol;
     RealMatrixX mat;
     
-    std::vector<libMesh::dof_id_type> dof_indices;
+    MAST::ElemDofIndices elem_dofs;
     const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     std::auto_ptr<libMesh::NumericVector<Real> > localized_solution;
     localized_solution.reset(_build_localized_vector(nonlin_sys,
@@ -206,32 +199,33 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
     if (_sol_function)
         _sol_function->init( *nonlin_sys.solution);
     
-    libMesh::MeshBase::const_element_iterator       el     =
-    nonlin_sys.get_mesh().active_local_elements_begin();
-    const libMesh::MeshBase::const_element_iterator end_el =
-    nonlin_sys.get_mesh().active_local_elements_end();
+    const MAST::FunctionBase*
+    f = _discipline->get_parameter(&(parameters[i].get()));
     
-    for ( ; el != end_el; ++el) {
+    // elements that do not depend on f are skipped if an index is available
+    std::vector<const libMesh::Elem*> local_elems;
+    const std::vector<const libMesh::Elem*>&
+    elems = _sensitivity_elems(*f, local_elems);
+    
+    for (unsigned int j=0; j<elems.size(); j++) {
         
-        const libMesh::Elem* elem = *el;
+        const libMesh::Elem* elem = elems[j];
         
-        dof_map.dof_indices (elem, dof_indices);
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         MAST::StructuralElementBase& p_elem =
         dynamic_cast<MAST::StructuralElementBase&>(*physics_elem);
 
         // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
+        unsigned int ndofs = dofs.size();
         vec.setZero(ndofs);
         mat.setZero(ndofs, ndofs);
         
-        for (unsigned int i=0; i<dof_indices.size(); i++)
-            sol(i) = (*localized_solution)(dof_indices[i]);
+        dofs.gather(*localized_solution, sol);
         
-        physics_elem->sensitivity_param = _discipline->get_parameter(&(parameters[i].get()));
+        physics_elem->sensitivity_param = f;
         physics_elem->set_solution    (sol);
         physics_elem->set_velocity    (vec); // set to zero vector for a quasi-steady analysis
         physics_elem->set_acceleration(vec); // set to zero vector for a quasi-steady analysis
@@ -258,16 +252,9 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
         
         physics_elem->detach_active_solution_function();
         
-        // copy to the libMesh matrix for further processing
-        DenseRealVector v;
-        MAST::copy(v, vec);
-        
         // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        dof_map.constrain_element_vector(v, dof_indices);
-        
-        // add to the global matrices
-        sensitivity_rhs.add_vector(v, dof_indices);
+        // Dirichlet constraints, etc., and add to the global vector
+        dofs.add(dof_map, vec, mat, &sensitivity_rhs, nullptr);
     }
     
     // if a solution function is attached, initialize it
@@ -301,7 +288,8 @@ update_incompatible_solution(libMesh::NumericVector<Real>& X,
     
     std::vector<libMesh::dof_id_type> dof_indices;
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
     std::auto_ptr<libMesh::NumericVector<Real> >
     localized_solution(_build_localized_vector(nonlin_sys,
@@ -325,7 +313,7 @@ update_incompatible_solution(libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
         
         MAST::StructuralElementBase& p_elem =
         dynamic_cast<MAST::StructuralElementBase&>(*physics_elem);
@@ -377,18 +365,36 @@ calculate_outputs(const libMesh::NumericVector<Real>& X) {
     it    = _discipline->volume_output().begin(),
     end   = _discipline->volume_output().end();
     
+    MAST::NonlinearSystem& sys = _system->system();
+    
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    localized_solution;
+    
+    std::vector<const libMesh::Elem*> local_elems;
     
     for ( ; it != end; it++)
         if (it->second->type() == MAST::STRUCTURAL_COMPLIANCE) {
             
-            MAST::NonlinearSystem& sys = _system->system();
-            
             MAST::RealOutputFunction& output =
             dynamic_cast<MAST::RealOutputFunction&>(*it->second);
             
-            _calculate_compliance(X, sys, output);
+            if (!localized_solution.get()) {
+                
+                localized_solution.reset(_build_localized_vector(sys, X).release());
+                
+                if (_sol_function)
+                    _sol_function->init(X);
+            }
+            
+            _calculate_compliance(*localized_solution,
+                                  _local_elems(local_elems),
+                                  output);
         }
     
+    // if a solution function is attached, clear it
+    if (localized_solution.get() && _sol_function)
+        _sol_function->clear();
+    
     // now call the parent's method for calculation of the other outputs
     MAST::NonlinearImplicitAssembly::calculate_outputs(X);
     
@@ -412,36 +418,56 @@ calculate_output_sensitivity(libMesh::ParameterVector& params,
     it    = _discipline->volume_output().begin(),
     end   = _discipline->volume_output().end();
     
+    MAST::NonlinearSystem& sys = _system->system();
+    
+    // the solution is localized once for all parameters, and the partial
+    // sensitivity with respect to each parameter is computed only on the
+    // elements that depend on it
     std::auto_ptr<libMesh::NumericVector<Real> >
+    localized_solution,
     localized_solution_sensitivity;
     
+    std::vector<const libMesh::Elem*> local_elems;
+    
     for ( ; it != end; it++)
         if (it->second->type() == MAST::STRUCTURAL_COMPLIANCE) {
             
-            MAST::NonlinearSystem& sys = _system->system();
-            
             MAST::RealOutputFunction& output =
             dynamic_cast<MAST::RealOutputFunction&>(*it->second);
             
+            if (!localized_solution.get()) {
+                
+                localized_solution.reset(_build_localized_vector(sys, X).release());
+                
+                if (_sol_function)
+                    _sol_function->init(X);
+            }
+            
             for ( unsigned int i=0; i<params.size(); i++) {
                 
                 const MAST::FunctionBase* f =
                 _discipline->get_parameter(&(params[i].get()));
                 
-                if (!if_total_sensitivity)
-                    _calculate_compliance(X,
-                                          sys,
+                if (!if_total_sensitivity) {
+                    
+                    // the sensitivity is recorded for f even if none of
+                    // the local elements depend on it
+                    output.add_sensitivity(f, 0.);
+                    
+                    _calculate_compliance(*localized_solution,
+                                          _sensitivity_elems(*f, local_elems),
                                           output,
                                           f);
+                }
                 else {
                     
+                    // the solution sensitivity is nonzero on all elements
                     localized_solution_sensitivity.reset
                     (_build_localized_vector(sys,
                                              sys.get_sensitivity_solution(i)).release());
                     
-                    
-                    _calculate_compliance(X,
-                                          sys,
+                    _calculate_compliance(*localized_solution,
+                                          _local_elems(local_elems),
                                           output,
                                           f,
                                           localized_solution_sensitivity.get());
@@ -449,6 +475,10 @@ calculate_output_sensitivity(libMesh::ParameterVector& params,
             }
         }
     
+    // if a solution function is attached, clear it
+    if (localized_solution.get() && _sol_function)
+        _sol_function->clear();
+    
     // now call the parent's method for calculation of the other outputs
     MAST::NonlinearImplicitAssembly::
     calculate_output_sensitivity(params,
@@ -464,78 +494,129 @@ calculate_output_sensitivity(libMesh::ParameterVector& params,
 
 void
 MAST::StructuralNonlinearAssembly::
-_calculate_compliance (const libMesh::NumericVector<Real>& X,
-                       libMesh::NonlinearImplicitSystem& S,
-                       MAST::RealOutputFunction& output,
-                       const MAST::FunctionBase* f,
-                       const libMesh::NumericVector<Real>* dX) {
-
-
+calculate_output_derivative(const libMesh::NumericVector<Real>& X,
+                            MAST::OutputFunctionBase& output,
+                            libMesh::NumericVector<Real>& dq_dX) {
+    
+    // only the compliance is currently supported
+    libmesh_assert_equal_to(output.type(), MAST::STRUCTURAL_COMPLIANCE);
+    
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
-    // make sure that the system for which this object was created,
-    // and the system passed through the function call are the same
-    libmesh_assert_equal_to(&S, &(nonlin_sys));
+    dq_dX.zero();
     
-    // iterate over each element, initialize it and get the relevant
-    // analysis quantities
-    RealVectorX vec, sol, dsol;
+    RealVectorX vec, sol;
     RealMatrixX mat;
-    Real        val;
     
     std::vector<libMesh::dof_id_type> dof_indices;
-    const libMesh::DofMap& dof_map = _system->system().get_dof_map();
-    std::auto_ptr<MAST::ElementBase> physics_elem;
+    const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
     
-    std::auto_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_solution_sens;
-    localized_solution.reset(_build_localized_vector(nonlin_sys,
-                                                     X).release());
-    if (f)
-        localized_solution_sens.reset(_build_localized_vector(nonlin_sys,
-                                                              *dX).release());
-
+    std::auto_ptr<libMesh::NumericVector<Real> > localized_solution;
+    localized_solution.reset(_build_localized_vector(nonlin_sys, X).release());
     
     // if a solution function is attached, initialize it
     if (_sol_function)
-        _sol_function->init( X);
-    
+        _sol_function->init(X);
     
     libMesh::MeshBase::const_element_iterator       el     =
     nonlin_sys.get_mesh().active_local_elements_begin();
     const libMesh::MeshBase::const_element_iterator end_el =
     nonlin_sys.get_mesh().active_local_elements_end();
     
-    
     for ( ; el != end_el; ++el) {
         
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
         
-        physics_elem.reset(_build_elem(*elem).release());
+        physics_elem = _get_elem(*elem, elem_owner);
+        
+        // get the solution
+        unsigned int ndofs = (unsigned int)dof_indices.size();
+        sol.setZero(ndofs);
+        vec.setZero(ndofs);
+        mat.setZero(ndofs, ndofs);
+        
+        for (unsigned int i=0; i<dof_indices.size(); i++)
+            sol(i) = (*localized_solution)(dof_indices[i]);
+        
+        _set_elem_solution(*physics_elem, sol);
+        
+        if (_sol_function)
+            physics_elem->attach_active_solution_function(*_sol_function);
+        
+        _elem_calculations(*physics_elem, true, vec, mat);
+        
+        physics_elem->detach_active_solution_function();
+        
+        // derivative of the element compliance X^T J X, with the
+        // Jacobian held constant
+        vec = (mat + mat.transpose()) * sol;
+        
+        DenseRealVector v;
+        MAST::copy(v, vec);
+        dof_map.constrain_element_vector(v, dof_indices);
+        
+        dq_dX.add_vector(v, dof_indices);
+    }
+    
+    // if a solution function is attached, clear it
+    if (_sol_function)
+        _sol_function->clear();
+    
+    dq_dX.close();
+}
+
+
+
+
+void
+MAST::StructuralNonlinearAssembly::
+_calculate_compliance (const libMesh::NumericVector<Real>& localized_X,
+                       const std::vector<const libMesh::Elem*>& elems,
+                       MAST::RealOutputFunction& output,
+                       const MAST::FunctionBase* f,
+                       const libMesh::NumericVector<Real>* localized_dX) {
+
+
+    // iterate over each element, initialize it and get the relevant
+    // analysis quantities
+    RealVectorX vec, sol, dsol;
+    RealMatrixX mat;
+    Real        val;
+    
+    MAST::ElemDofIndices elem_dofs;
+    std::auto_ptr<MAST::ElementBase> elem_owner;
+    MAST::ElementBase* physics_elem = nullptr;
+    
+    for (unsigned int j=0; j<elems.size(); j++) {
+        
+        const libMesh::Elem* elem = elems[j];
+        
+        MAST::ElemDofIndices& dofs = _get_elem_dofs(*elem, elem_dofs);
+        
+        physics_elem = _get_elem(*elem, elem_owner);
         
         MAST::StructuralElementBase& p_elem =
         dynamic_cast<MAST::StructuralElementBase&>(*physics_elem);
         
         
         // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero (ndofs);
+        unsigned int ndofs = dofs.size();
         dsol.setZero(ndofs);
         vec.setZero (ndofs);
         mat.setZero (ndofs, ndofs);
         
-        for (unsigned int i=0; i<dof_indices.size(); i++)
-            sol(i) = (*localized_solution)(dof_indices[i]);
+        dofs.gather(localized_X, sol);
 
         physics_elem->set_solution(sol, false);  // primal solution
 
         if (f) {
             
-            for (unsigned int i=0; i<dof_indices.size(); i++)
-                dsol(i) = (*localized_solution_sens)(dof_indices[i]);
+            if (localized_dX)
+                dofs.gather(*localized_dX, dsol);
             
             physics_elem->set_solution(dsol, true);  // sensitivity solution
             physics_elem->sensitivity_param = f;
@@ -571,8 +652,10 @@ _calculate_compliance (const libMesh::NumericVector<Real>& X,
             _elem_calculations(*physics_elem,
                                true,
                                vec, mat);
-            val = sol.dot(mat * dsol) + dsol.dot(mat *  sol);
-            output.add_sensitivity(f, val);
+            if (localized_dX) {
+                val = sol.dot(mat * dsol) + dsol.dot(mat *  sol);
+                output.add_sensitivity(f, val);
+            }
             
             _elem_sensitivity_calculations(*physics_elem, true, vec, mat);
             output.add_sensitivity(f, sol.dot(mat * sol));
@@ -581,11 +664,6 @@ _calculate_compliance (const libMesh::NumericVector<Real>& X,
         physics_elem->detach_active_solution_function();
         
     }
-    
-    
-    // if a solution function is attached, clear it
-    if (_sol_function)
-        _sol_function->clear();
 }
 
 
@@ -697,6 +775,77 @@ _elem_sensitivity_calculations(MAST::ElementBase& elem,
 
 
 
+void
+MAST::StructuralNonlinearAssembly::
+_elem_multiparameter_sensitivity_calculations
+(MAST::ElementBase& elem,
+ const std::vector<const MAST::FunctionBase*>& params,
+ std::vector<RealVectorX>& vec) {
+    
+    libmesh_assert_equal_to(params.size(), vec.size());
+    
+    MAST::StructuralElementBase& e =
+    dynamic_cast<MAST::StructuralElementBase&>(elem);
+    
+    e.internal_residual_multiparameter_sensitivity(params, vec);
+    
+    RealMatrixX dummy;
+    
+    for (unsigned int i=0; i<params.size(); i++) {
+        
+        dummy.setZero(vec[i].size(), vec[i].size());
+        
+        e.sensitivity_param = params[i];
+        e.side_external_residual_sensitivity(false,
+                                             vec[i],
+                                             dummy,
+                                             dummy,
+                                             _discipline->side_loads());
+        e.volume_external_residual_sensitivity(false,
+                                               vec[i],
+                                               dummy,
+                                               dummy,
+                                               _discipline->volume_loads());
+    }
+}
+
+
+
+
+void
+MAST::StructuralNonlinearAssembly::
+_set_elem_solution(MAST::ElementBase& elem,
+                   const RealVectorX& sol) {
+    
+    MAST::StructuralElementBase& p_elem =
+    dynamic_cast<MAST::StructuralElementBase&>(elem);
+    
+    RealVectorX zero = RealVectorX::Zero(sol.size());
+    
+    p_elem.set_solution    (sol);
+    p_elem.set_velocity    (zero); // set to zero vector for a quasi-steady analysis
+    p_elem.set_acceleration(zero); // set to zero vector for a quasi-steady analysis
+    
+    // set the incompatible mode solution if required by the
+    // element. The map is shared between threads, so access to it
+    // is serialized.
+    if (p_elem.if_incompatible_modes()) {
+        
+        libMesh::Threads::spin_mutex::scoped_lock
+        lock(_thread_mutex);
+        
+        const libMesh::Elem* e = &p_elem.elem();
+        
+        // check if the vector exists in the map
+        if (!_incompatible_sol.count(e))
+            _incompatible_sol[e] = RealVectorX::Zero(p_elem.incompatible_mode_size());
+        p_elem.set_incompatible_mode_solution(_incompatible_sol[e]);
+    }
+}
+
+
+
+
 void
 MAST::StructuralNonlinearAssembly::
 attach_discipline_and_system(MAST::PhysicsDisciplineBase& discipline,
@@ -90,6 +90,8 @@ namespace MAST {
                               const unsigned int i,
                               libMesh::NumericVector<Real>& sensitivity_rhs);
         
+        using MAST::NonlinearImplicitAssembly::sensitivity_assemble;
+        
         
         /*!
          *   asks the system to update the nonlinear incompatible mode solution
@@ -113,24 +115,37 @@ namespace MAST {
         void calculate_output_sensitivity(libMesh::ParameterVector& params,
                                           const bool if_total_sensitivity,
                                           const libMesh::NumericVector<Real>& X);
+        
+        
+        /*!
+         *   assembles the derivative of the structural compliance output
+         *   with respect to the solution \p X in \p dq_dX. Other output
+         *   types are not currently supported.
+         */
+        virtual void
+        calculate_output_derivative(const libMesh::NumericVector<Real>& X,
+                                    MAST::OutputFunctionBase& output,
+                                    libMesh::NumericVector<Real>& dq_dX);
 
         
     protected:
         
         /*!
-         *  calculates the elastic compliance of the system \p S about the
-         *  solution defined by \p X. If sensitivity of the quantity is
-         *  desired with respect to a parameter, then the parameter can
-         *  be specified. If \p dX is provided, then the total sensitivity
-         *  is evaluated with respect to the parameter, otherwise the partial
-         *  derivative of the output quantity is evaluated.
+         *  adds the elastic compliance of the elements \p elems about the
+         *  localized solution \p localized_X to \p output. If sensitivity
+         *  of the quantity is desired with respect to a parameter, then the
+         *  parameter can be specified. If \p localized_dX is provided, then
+         *  the total sensitivity is evaluated with respect to the parameter,
+         *  otherwise the partial derivative of the output quantity is
+         *  evaluated. The solution function, if attached, must be
+         *  initialized by the caller.
          */
         virtual void
-        _calculate_compliance (const libMesh::NumericVector<Real>& X,
-                               libMesh::NonlinearImplicitSystem& S,
+        _calculate_compliance (const libMesh::NumericVector<Real>& localized_X,
+                               const std::vector<const libMesh::Elem*>& elems,
                                MAST::RealOutputFunction& output,
                                const MAST::FunctionBase* f = nullptr,
-                               const libMesh::NumericVector<Real>* dX = nullptr);
+                               const libMesh::NumericVector<Real>* localized_dX = nullptr);
         
         
 
@@ -172,6 +187,25 @@ namespace MAST {
                                                     RealVectorX& vec,
                                                     RealMatrixX& mat);
         
+        /*!
+         *   computes the element residual sensitivity for all parameters in
+         *   \p params. The internal residual sensitivity is computed by the
+         *   element for all parameters together, while the external load
+         *   sensitivities are computed for each parameter.
+         */
+        virtual void
+        _elem_multiparameter_sensitivity_calculations
+        (MAST::ElementBase& elem,
+         const std::vector<const MAST::FunctionBase*>& params,
+         std::vector<RealVectorX>& vec);
+        
+        /*!
+         *   sets the solution, zero velocity and acceleration, and the
+         *   incompatible mode solution for the element in threaded assembly.
+         */
+        virtual void _set_elem_solution(MAST::ElementBase& elem,
+                                        const RealVectorX& sol);
+        
         /*!
          *   map of local incompatible mode solution per 3D elements
          */
@@ -24,6 +24,7 @@
 #include "elasticity/bending_operator.h"
 #include "property_cards/element_property_card_base.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/scratch_arena.h"
 #include "mesh/local_elem_base.h"
 #include "base/nonlinear_system.h"
 
@@ -123,7 +124,9 @@ initialize_bending_strain_operator_for_yz(const libMesh::FEBase& fe,
     
     const unsigned int n_phi = (unsigned int)phi.size();
     
-    RealVectorX phi_vec = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec = scratch.vector(n_phi);
     
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
         phi_vec(i_nd) = dphi[i_nd][qp](0);  // dphi/dx
@@ -173,23 +176,26 @@ calculate_transverse_shear_residual(bool request_jacobian,
     const std::vector<libMesh::Point>& xyz = fe->get_xyz();
     
     const unsigned int n_phi = (unsigned int)phi.size(), n2 = 6*n_phi;
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
+    
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
     
     RealVectorX
-    vec3_n2   = RealVectorX::Zero(n2),
-    vec4_2    = RealVectorX::Zero(2),
-    vec5_2    = RealVectorX::Zero(2);
+    &phi_vec   = scratch.vector(n_phi),
+    &vec3_n2   = scratch.vector(n2),
+    &vec4_2    = scratch.vector(2),
+    &vec5_2    = scratch.vector(2);
     RealMatrixX
-    material_trans_shear_mat,
-    mat2_n2n2  = RealMatrixX::Zero(n2,n2),
-    mat4_2n2   = RealMatrixX::Zero(2,n2);
+    &material_trans_shear_mat = scratch.matrix(2,2),
+    &mat2_n2n2  = scratch.matrix(n2,n2),
+    &mat4_2n2   = scratch.matrix(2,n2);
     
 
-    FEMOperatorMatrix Bmat_trans;
+    FEMOperatorMatrix &Bmat_trans = scratch.operator_matrix();
     Bmat_trans.reinit(2, 6, n_phi); // only two shear stresses
     
-    std::auto_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff = property.transverse_shear_stiffness_matrix(_structural_elem);
+    const MAST::FieldFunction<RealMatrixX>
+    &mat_stiff = property.property_matrix(MAST::TRANSVERSE_SHEAR_STIFFNESS_MATRIX,
+                                          _structural_elem);
     
     libMesh::Point p;
     
@@ -198,14 +204,14 @@ calculate_transverse_shear_residual(bool request_jacobian,
         _structural_elem.local_elem().global_coordinates_location(xyz[qp], p);
         
         if (!sens_param)
-            (*mat_stiff)(p,
-                         _structural_elem.system().time,
-                         material_trans_shear_mat);
+            mat_stiff(p,
+                      _structural_elem.system().time,
+                      material_trans_shear_mat);
         else
-            mat_stiff->derivative(  *sens_param,
-                                  p,
-                                  _structural_elem.system().time,
-                                  material_trans_shear_mat);
+            mat_stiff.derivative(*sens_param,
+                                 p,
+                                 _structural_elem.system().time,
+                                 material_trans_shear_mat);
         
         // initialize the strain operator
         for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
@@ -222,7 +228,7 @@ calculate_transverse_shear_residual(bool request_jacobian,
         
         // now add the transverse shear component
         Bmat_trans.vector_mult(vec4_2, _structural_elem.local_solution());
-        vec5_2 = material_trans_shear_mat * vec4_2;
+        vec5_2.noalias() = material_trans_shear_mat * vec4_2;
         Bmat_trans.vector_mult_transpose(vec3_n2, vec5_2);
         local_f += JxW[qp] * vec3_n2;
         
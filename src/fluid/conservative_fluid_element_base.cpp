@@ -24,6 +24,7 @@
 #include "fluid/flight_condition.h"
 #include "base/boundary_condition_base.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/scratch_arena.h"
 #include "base/system_initialization.h"
 #include "elasticity/normal_rotation_function_base.h"
 #include "fluid/surface_integrated_pressure_output.h"
@@ -35,10 +36,28 @@ ConservativeFluidElementBase(MAST::SystemInitialization& sys,
                              const libMesh::Elem& elem,
                              const MAST::FlightCondition& f):
 MAST::FluidElemBase(elem.dim(), f),
-MAST::ElementBase(sys, elem) {
+MAST::ElementBase(sys, elem),
+_fixed_kernel_elem_type(libMesh::INVALID_ELEM) {
     
     // initialize the finite element data structures
     _init_fe_and_qrule(elem, &_fe, &_qrule);
+    
+    // select the fixed-size internal residual kernel, if one is
+    // available for this element type and interpolation
+    switch (elem.type()) {
+            
+        case libMesh::EDGE2:
+        case libMesh::TRI3:
+        case libMesh::QUAD4:
+        case libMesh::TET4:
+        case libMesh::HEX8:
+            if (_fe->n_shape_functions() == elem.n_nodes())
+                _fixed_kernel_elem_type = elem.type();
+            break;
+            
+        default:
+            break;
+    }
 }
 
 
@@ -54,6 +73,29 @@ bool
 MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
                                                        RealVectorX& f,
                                                        RealMatrixX& jac) {
+    
+    switch (_fixed_kernel_elem_type) {
+            
+        case libMesh::EDGE2:
+            return _internal_residual<1, 2>(request_jacobian, f, jac);
+            
+        case libMesh::TRI3:
+            return _internal_residual<2, 3>(request_jacobian, f, jac);
+            
+        case libMesh::QUAD4:
+            return _internal_residual<2, 4>(request_jacobian, f, jac);
+            
+        case libMesh::TET4:
+            return _internal_residual<3, 4>(request_jacobian, f, jac);
+            
+        case libMesh::HEX8:
+            return _internal_residual<3, 8>(request_jacobian, f, jac);
+            
+        default:
+            break;
+    }
+    
+    // the remaining element types use dynamic storage
     const std::vector<Real>& JxW                  = _fe->get_JxW();
     const std::vector<std::vector<Real> >& phi    = _fe->get_phi();
     const unsigned int
@@ -62,33 +104,36 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
     n2     = _fe->n_shape_functions()*n1,
     nphi   = _fe->n_shape_functions();
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    mat1_n1n1       = RealMatrixX::Zero(   n1,    n1),
-    mat2_n1n1       = RealMatrixX::Zero(   n1,    n1),
-    mat3_n1n2       = RealMatrixX::Zero(   n1,    n2),
-    mat4_n2n2       = RealMatrixX::Zero(   n2,    n2),
-    AiBi_adv        = RealMatrixX::Zero(   n1,    n2),
-    A_sens          = RealMatrixX::Zero(   n1,    n2),
-    LS              = RealMatrixX::Zero(   n1,    n2),
-    LS_sens         = RealMatrixX::Zero(   n2,    n2),
-    stress          = RealMatrixX::Zero(  dim,   dim),
-    dprim_dcons     = RealMatrixX::Zero(   n1,    n1),
-    dcons_dprim     = RealMatrixX::Zero(   n1,    n1);
+    &mat1_n1n1       = scratch.matrix(   n1,    n1),
+    &mat3_n1n2       = scratch.matrix(   n1,    n2),
+    &mat4_n2n2       = scratch.matrix(   n2,    n2),
+    &AiBi_adv        = scratch.matrix(   n1,    n2),
+    &A_sens          = scratch.matrix(   n1,    n2),
+    &LS              = scratch.matrix(   n1,    n2),
+    &LS_sens         = scratch.matrix(   n2,    n2),
+    &stress          = scratch.matrix(  dim,   dim),
+    &dprim_dcons     = scratch.matrix(   n1,    n1),
+    &dcons_dprim     = scratch.matrix(   n1,    n1);
     
     RealVectorX
-    vec1_n1   = RealVectorX::Zero(n1),
-    vec2_n1   = RealVectorX::Zero(n1),
-    vec3_n2   = RealVectorX::Zero(n2),
-    dc        = RealVectorX::Zero(dim),
-    temp_grad = RealVectorX::Zero(dim);
+    &vec1_n1   = scratch.vector(n1),
+    &vec2_n1   = scratch.vector(n1),
+    &vec3_n2   = scratch.vector(n2),
+    &dc        = scratch.vector(dim),
+    &temp_grad = scratch.vector(dim);
 
     
     std::vector<RealMatrixX>
-    Ai_adv  (dim);
+    &Ai_adv  = _Ai_adv;
     
     std::vector<std::vector<RealMatrixX> >
-    Ai_sens  (dim);
+    &Ai_sens = _Ai_sens;
     
+    Ai_adv.resize(dim);
+    Ai_sens.resize(dim);
     
     for (unsigned int i=0; i<dim; i++) {
         Ai_sens [i].resize(n1);
@@ -98,9 +143,13 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
     }
     
     
-    std::vector<MAST::FEMOperatorMatrix> dBmat(dim);
-    MAST::FEMOperatorMatrix Bmat;
-    MAST::PrimitiveSolution      primitive_sol;
+    _dBmat.resize(dim);
+    std::vector<MAST::FEMOperatorMatrix>
+    &dBmat = _dBmat;
+    MAST::FEMOperatorMatrix
+    &Bmat  = scratch.operator_matrix();
+    MAST::PrimitiveSolution
+    &primitive_sol = _primitive_sol;
     
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
@@ -194,7 +243,8 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
         }
         
         // stabilization term
-        f += JxW[qp] * LS.transpose() * (AiBi_adv * _sol);
+        vec1_n1.noalias() = AiBi_adv * _sol;
+        f.noalias() += JxW[qp] * LS.transpose() * vec1_n1;
         
         
         if (request_jacobian) {
@@ -212,7 +262,7 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
                 dBmat[i_dim].vector_mult(vec1_n1, _sol);
                 for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++) {
                     
-                    vec2_n1 = Ai_sens[i_dim][i_cvar] * vec1_n1;
+                    vec2_n1.noalias() = Ai_sens[i_dim][i_cvar] * vec1_n1;
                     for (unsigned int i_phi=0; i_phi<nphi; i_phi++)
                         A_sens.col(nphi*i_cvar+i_phi) += phi[i_phi][qp] *vec2_n1; // assuming that all variables have same n_phi
                 }
@@ -239,10 +289,10 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
             }
             
             // stabilization term
-            jac  += JxW[qp] * LS.transpose() * AiBi_adv;                          // A_i dB_i
+            jac.noalias()  += JxW[qp] * LS.transpose() * AiBi_adv;                          // A_i dB_i
 
             // linearization of the Jacobian terms
-            jac += JxW[qp] * LS.transpose() * A_sens; // LS^T tau d^2F^adv_i / dx dU  (Ai sensitivity)
+            jac.noalias() += JxW[qp] * LS.transpose() * A_sens; // LS^T tau d^2F^adv_i / dx dU  (Ai sensitivity)
                                           // linearization of the LS terms
             jac += JxW[qp] * LS_sens;
             
@@ -255,6 +305,247 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
 
 
 
+template <int Dim, int NPhi>
+bool
+MAST::ConservativeFluidElementBase::_internal_residual (bool request_jacobian,
+                                                        RealVectorX& f,
+                                                        RealMatrixX& jac) {
+    
+    // number of conservative variables, and number of element dofs
+    const int
+    N1 = Dim+2,
+    N2 = N1*NPhi;
+    
+    typedef Eigen::Matrix<Real, N1,  1> VectorN1;
+    typedef Eigen::Matrix<Real, N2,  1> VectorN2;
+    typedef Eigen::Matrix<Real, N1, N2> MatrixN1N2;
+    typedef Eigen::Matrix<Real, N2, N2> MatrixN2N2;
+    
+    const std::vector<Real>& JxW                  = _fe->get_JxW();
+    const std::vector<std::vector<Real> >& phi    = _fe->get_phi();
+    const unsigned int
+    dim    = Dim,
+    n1     = N1,
+    n2     = N2,
+    nphi   = NPhi;
+    
+    libmesh_assert_equal_to(dim,  _elem.dim());
+    libmesh_assert_equal_to(nphi, _fe->n_shape_functions());
+    
+    // the flux Jacobians and the stabilization and discontinuity capturing
+    // operators are calculated by the FluidElemBase routines in dynamic
+    // storage, which is drawn from the arena. The element-sized products
+    // use fixed-size storage.
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealMatrixX
+    &mat1_n1n1       = scratch.matrix(   n1,    n1),
+    &AiBi_adv        = scratch.matrix(   n1,    n2),
+    &LS              = scratch.matrix(   n1,    n2),
+    &LS_sens         = scratch.matrix(   n2,    n2),
+    &stress          = scratch.matrix(  dim,   dim),
+    &dprim_dcons     = scratch.matrix(   n1,    n1),
+    &dcons_dprim     = scratch.matrix(   n1,    n1);
+    
+    RealVectorX
+    &vec1_n1   = scratch.vector(n1),
+    &dc        = scratch.vector(dim),
+    &temp_grad = scratch.vector(dim);
+    
+    MatrixN1N2
+    mat3_n1n2        = MatrixN1N2::Zero(),
+    AiBi             = MatrixN1N2::Zero(),
+    LS_fixed         = MatrixN1N2::Zero(),
+    A_sens           = MatrixN1N2::Zero();
+    MatrixN2N2
+    mat4_n2n2        = MatrixN2N2::Zero();
+    VectorN1
+    vec2_n1          = VectorN1::Zero();
+    VectorN2
+    vec3_n2          = VectorN2::Zero(),
+    sol              = _sol;
+    
+    
+    std::vector<RealMatrixX>
+    &Ai_adv  = _Ai_adv;
+    
+    std::vector<std::vector<RealMatrixX> >
+    &Ai_sens = _Ai_sens;
+    
+    Ai_adv.resize(dim);
+    Ai_sens.resize(dim);
+    
+    for (unsigned int i=0; i<dim; i++) {
+        Ai_sens [i].resize(n1);
+        Ai_adv  [i].setZero(n1, n1);
+        for (unsigned int j=0; j<n1; j++)
+            Ai_sens[i][j].setZero(n1, n1);
+    }
+    
+    
+    _dBmat.resize(dim);
+    std::vector<MAST::FEMOperatorMatrix>
+    &dBmat = _dBmat;
+    MAST::FEMOperatorMatrix
+    &Bmat  = scratch.operator_matrix();
+    MAST::PrimitiveSolution
+    &primitive_sol = _primitive_sol;
+    
+    
+    for (unsigned int qp=0; qp<JxW.size(); qp++) {
+        
+        // initialize the Bmat operator for this term
+        _initialize_fem_interpolation_operator(qp, dim, *_fe, Bmat);
+        
+        // calculate the local element solution
+        Bmat.right_multiply(vec1_n1, _sol);
+        
+        primitive_sol.zero();
+        primitive_sol.init(dim,
+                           vec1_n1,
+                           flight_condition->gas_property.cp,
+                           flight_condition->gas_property.cv,
+                           if_viscous());
+        
+        // initialize the FEM derivative operator
+        _initialize_fem_gradient_operator(qp, dim, *_fe, dBmat);
+        
+        if (if_viscous()) {
+            
+            calculate_conservative_variable_jacobian(primitive_sol,
+                                                     dcons_dprim,
+                                                     dprim_dcons);
+            calculate_diffusion_tensors(_sol,
+                                        dBmat,
+                                        dprim_dcons,
+                                        primitive_sol,
+                                        stress,
+                                        temp_grad);
+        }
+        
+        AiBi.setZero();
+        for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
+            calculate_advection_flux_jacobian(i_dim, primitive_sol, Ai_adv[i_dim]);
+            calculate_advection_flux_jacobian_sensitivity_for_conservative_variable
+            (i_dim, primitive_sol, Ai_sens[i_dim]);
+            
+            dBmat[i_dim].left_multiply(mat3_n1n2, Ai_adv[i_dim]);
+            AiBi += mat3_n1n2;
+        }
+        AiBi_adv = AiBi;
+        
+        // intrinsic time operator for this quadrature point
+        calculate_differential_operator_matrix(qp,
+                                               *_fe,
+                                               _sol,
+                                               primitive_sol,
+                                               Bmat,
+                                               dBmat,
+                                               Ai_adv,
+                                               AiBi_adv,
+                                               Ai_sens,
+                                               LS,
+                                               LS_sens);
+        LS_fixed = LS;
+        
+        // discontinuity capturing operator for this quadrature point
+        calculate_aliabadi_discontinuity_operator(qp,
+                                                  *_fe,
+                                                  primitive_sol,
+                                                  _sol,
+                                                  dBmat,
+                                                  AiBi_adv,
+                                                  dc);
+        
+        // assemble the residual due to flux operator
+        for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
+            
+            // first the flux
+            calculate_advection_flux(i_dim, primitive_sol, vec1_n1);
+            dBmat[i_dim].vector_mult_transpose(vec3_n2, vec1_n1);
+            f -= JxW[qp] * vec3_n2;
+            
+            // diffusive flux
+            if (if_viscous()) {
+                
+                calculate_diffusion_flux(i_dim,
+                                         primitive_sol,
+                                         stress,
+                                         temp_grad,
+                                         vec1_n1);
+                dBmat[i_dim].vector_mult_transpose(vec3_n2, vec1_n1);
+                f += JxW[qp] * vec3_n2;
+            }
+            
+            // solution derivative in i^th direction
+            // use this to calculate the discontinuity capturing term
+            dBmat[i_dim].vector_mult(vec2_n1, sol);
+            dBmat[i_dim].vector_mult_transpose(vec3_n2, vec2_n1);
+            f += JxW[qp] * dc(i_dim) * vec3_n2;
+        }
+        
+        // stabilization term
+        vec2_n1.noalias() = AiBi * sol;
+        f.noalias() += JxW[qp] * LS_fixed.transpose() * vec2_n1;
+        
+        
+        if (request_jacobian) {
+            
+            A_sens.setZero();
+            
+            // contribution from flux Jacobian
+            for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
+                // flux term
+                Bmat.left_multiply(mat3_n1n2, Ai_adv[i_dim]);                        // A_i B
+                dBmat[i_dim].right_multiply_transpose(mat4_n2n2, mat3_n1n2);          // dB_i^T A_i B
+                jac -= JxW[qp]*mat4_n2n2;
+                
+                // sensitivity of Ai_Bi with respect to U:   [dAi/dUj.Bi.U  ...  dAi/dUn.Bi.U]
+                dBmat[i_dim].vector_mult(vec1_n1, sol);
+                for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++) {
+                    
+                    vec2_n1.noalias() = Ai_sens[i_dim][i_cvar] * vec1_n1;
+                    for (unsigned int i_phi=0; i_phi<nphi; i_phi++)
+                        A_sens.col(nphi*i_cvar+i_phi) += phi[i_phi][qp] *vec2_n1; // assuming that all variables have same n_phi
+                }
+                
+                // viscous flux Jacobian
+                if (if_viscous()) {
+                    
+                    for (unsigned int j_dim=0; j_dim<dim; j_dim++) {
+                        
+                        calculate_diffusion_flux_jacobian(i_dim,
+                                                          j_dim,
+                                                          primitive_sol,
+                                                          mat1_n1n1);
+                        
+                        dBmat[j_dim].left_multiply(mat3_n1n2, mat1_n1n1);                     // Kij dB_j
+                        dBmat[i_dim].right_multiply_transpose(mat4_n2n2, mat3_n1n2);          // dB_i^T Kij dB_j
+                        jac += JxW[qp]*mat4_n2n2;
+                    }
+                }
+                
+                // discontinuity capturing term
+                dBmat[i_dim].right_multiply_transpose(mat4_n2n2, dBmat[i_dim]);   // dB_i^T dc dB_i
+                jac += JxW[qp] * dc(i_dim) * mat4_n2n2;
+            }
+            
+            // stabilization term
+            jac.noalias()  += JxW[qp] * LS_fixed.transpose() * AiBi;                        // A_i dB_i
+            
+            // linearization of the Jacobian terms
+            jac.noalias() += JxW[qp] * LS_fixed.transpose() * A_sens; // LS^T tau d^2F^adv_i / dx dU  (Ai sensitivity)
+            // linearization of the LS terms
+            jac += JxW[qp] * LS_sens;
+        }
+    }
+    
+    return request_jacobian;
+}
+
+
+
+
 bool
 MAST::ConservativeFluidElementBase::
 linearized_internal_residual (bool request_jacobian,
@@ -270,12 +561,13 @@ linearized_internal_residual (bool request_jacobian,
     n1     = dim+2,
     n2     = _fe->n_shape_functions()*n1;
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    f_jac_x         = RealMatrixX::Zero(   n2,    n2),
-    fm_jac_xdot     = RealMatrixX::Zero(   n2,    n2);
+    &f_jac_x    = scratch.matrix(n2, n2);
     
     RealVectorX
-    local_f    = RealVectorX::Zero(n2);
+    &local_f    = scratch.vector(n2);
     
     // df/dx. We always need the Jacobian, since it is used to calculate
     // the residual
@@ -284,7 +576,7 @@ linearized_internal_residual (bool request_jacobian,
     if (request_jacobian)
         jac      +=  f_jac_x;
     
-    f        +=  f_jac_x * _delta_sol;
+    f.noalias() +=  f_jac_x * _delta_sol;
     
     return request_jacobian;
 }
@@ -302,31 +594,35 @@ MAST::ConservativeFluidElementBase::velocity_residual (bool request_jacobian,
     n1     = dim+2,
     n2     = _fe->n_shape_functions()*n1;
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    tau              = RealMatrixX::Zero(n1, n1),
-    mat1_n1n1        = RealMatrixX::Zero(n1, n1),
-    mat2_n1n2        = RealMatrixX::Zero(n1, n2),
-    mat3_n2n2        = RealMatrixX::Zero(n2, n2),
-    mat4_n2n1        = RealMatrixX::Zero(n2, n1),
-    AiBi_adv         = RealMatrixX::Zero(n1, n2),
-    A_sens           = RealMatrixX::Zero(n1, n2),
-    LS               = RealMatrixX::Zero(n1, n2),
-    LS_sens          = RealMatrixX::Zero(n2, n2);
+    &mat2_n1n2        = scratch.matrix(n1, n2),
+    &mat3_n2n2        = scratch.matrix(n2, n2),
+    &mat4_n2n1        = scratch.matrix(n2, n1),
+    &AiBi_adv         = scratch.matrix(n1, n2),
+    &LS               = scratch.matrix(n1, n2),
+    &LS_sens          = scratch.matrix(n2, n2);
     RealVectorX
-    vec1_n1          = RealVectorX::Zero(n1),
-    vec2_n1          = RealVectorX::Zero(n1),
-    vec3_n2          = RealVectorX::Zero(n2);
+    &vec1_n1          = scratch.vector(n1),
+    &vec3_n2          = scratch.vector(n2);
     
-    std::vector<MAST::FEMOperatorMatrix> dBmat(dim);
-    MAST::FEMOperatorMatrix      Bmat;
-    MAST::PrimitiveSolution      primitive_sol;
+    _dBmat.resize(dim);
+    std::vector<MAST::FEMOperatorMatrix>
+    &dBmat = _dBmat;
+    MAST::FEMOperatorMatrix
+    &Bmat  = scratch.operator_matrix();
+    MAST::PrimitiveSolution
+    &primitive_sol = _primitive_sol;
     
     std::vector<RealMatrixX>
-    Ai_adv  (dim);
+    &Ai_adv  = _Ai_adv;
     
     std::vector<std::vector<RealMatrixX> >
-    Ai_sens  (dim);
+    &Ai_sens = _Ai_sens;
     
+    Ai_adv.resize(dim);
+    Ai_sens.resize(dim);
     
     for (unsigned int i=0; i<dim; i++) {
         Ai_sens [i].resize(n1);
@@ -380,7 +676,7 @@ MAST::ConservativeFluidElementBase::velocity_residual (bool request_jacobian,
         f += JxW[qp] * vec3_n2;
         
         // next, evaluate the contribution from the stabilization term
-        f += JxW[qp] * LS.transpose() * vec1_n1;
+        f.noalias() += JxW[qp] * LS.transpose() * vec1_n1;
         
         if (request_jacobian) {
             
@@ -1746,7 +2042,9 @@ _initialize_fem_interpolation_operator(const unsigned int qp,
     
     const unsigned int n_phi = (unsigned int)phi_fe.size();
     
-    RealVectorX phi = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi = scratch.vector(n_phi);
     
     // shape function values
     // N
@@ -1771,7 +2069,9 @@ _initialize_fem_gradient_operator(const unsigned int qp,
     const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
     
     const unsigned int n_phi = (unsigned int)dphi.size();
-    RealVectorX phi = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi = scratch.vector(n_phi);
     
     // now set the shape function values
     for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
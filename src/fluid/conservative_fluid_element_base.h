@@ -24,6 +24,7 @@
 // MAST includes
 #include "base/elem_base.h"
 #include "fluid/fluid_elem_base.h"
+#include "fluid/primitive_fluid_solution.h"
 
 
 namespace MAST {
@@ -159,6 +160,16 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *    implements internal_residual() with the spatial dimension and
+         *    the number of shape functions fixed at compile time to \p Dim
+         *    and \p NPhi, so that the element-sized matrices use fixed-size
+         *    storage.
+         */
+        template <int Dim, int NPhi>
+        bool _internal_residual(bool request_jacobian,
+                                RealVectorX& f,
+                                RealMatrixX& jac);
         
         
         /*!
@@ -269,6 +280,27 @@ namespace MAST {
                                                const libMesh::FEBase& fe,
                                                std::vector<MAST::FEMOperatorMatrix>& dBmat);
         
+        
+        /*!
+         *   workspace used by the internal and velocity residuals. These
+         *   containers are retained by the element so that their matrices
+         *   and operators are not reallocated on each call. The
+         *   element-size workspace is drawn from MAST::ScratchArena.
+         */
+        MAST::PrimitiveSolution                      _primitive_sol;
+        
+        std::vector<RealMatrixX>                     _Ai_adv;
+        
+        std::vector<std::vector<RealMatrixX> >       _Ai_sens;
+        
+        std::vector<MAST::FEMOperatorMatrix>         _dBmat;
+        
+        /*!
+         *   element type for which the fixed-size internal_residual()
+         *   kernel is used. This is selected at construction, and is
+         *   libMesh::INVALID_ELEM if the dynamic kernel is used.
+         */
+        libMesh::ElemType                            _fixed_kernel_elem_type;
     };
 }
 
@@ -25,6 +25,7 @@
 #include "fluid/primitive_fluid_solution.h"
 #include "fluid/small_disturbance_primitive_fluid_solution.h"
 #include "fluid/flight_condition.h"
+#include "numerics/scratch_arena.h"
 
 // Basic include files
 #include "libmesh/mesh.h"
@@ -226,12 +227,8 @@ MAST::FluidElemBase::calculate_diffusion_flux(const unsigned int calculate_dim,
     
     const unsigned int n1 = 2 + dim;
     
-    RealVectorX
-    uvec               = RealVectorX::Zero(3);
-
-    uvec(0) = sol.u1;
-    uvec(1) = sol.u2;
-    uvec(2) = sol.u3;
+    const Real
+    uvec[3]            = {sol.u1, sol.u2, sol.u3};
     
     flux.setZero();
     
@@ -240,7 +237,7 @@ MAST::FluidElemBase::calculate_diffusion_flux(const unsigned int calculate_dim,
         
         flux(1+i_dim) = stress_tensor(calculate_dim, i_dim); // tau_ij
         
-        flux(n1-1) += uvec(i_dim) * stress_tensor(calculate_dim, i_dim); // u_j tau_ij
+        flux(n1-1) += uvec[i_dim] * stress_tensor(calculate_dim, i_dim); // u_j tau_ij
     }
 
     flux(n1-1) += sol.k_thermal * temp_gradient(calculate_dim);
@@ -260,9 +257,11 @@ calculate_diffusion_tensors(const RealVectorX& elem_sol,
     
     const unsigned int n1 = dim+2;
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealVectorX
-    dprim_dx               = RealVectorX::Zero(n1),
-    dcons_dx               = RealVectorX::Zero(n1);
+    &dprim_dx              = scratch.vector(n1),
+    &dcons_dx              = scratch.vector(n1);
     
     stress_tensor.setZero();
     temp_gradient.setZero();
@@ -270,7 +269,7 @@ calculate_diffusion_tensors(const RealVectorX& elem_sol,
     for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
         
         dB_mat[i_dim].vector_mult(dcons_dx, elem_sol); // dUcons/dx_i
-        dprim_dx = dprim_dcons * dcons_dx; // dUprim/dx_i
+        dprim_dx.noalias() = dprim_dcons * dcons_dx; // dUprim/dx_i
         
         for (unsigned int j_dim=0; j_dim<dim; j_dim++) {
             
@@ -747,9 +746,11 @@ calculate_advection_flux_jacobian_sensitivity_for_conservative_variable
     
     const unsigned int n1 = 2 + dim;
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    dprim_dcons      = RealMatrixX::Zero(n1, n1),
-    mat              = RealMatrixX::Zero(n1, n1);
+    &dprim_dcons     = scratch.matrix(n1, n1),
+    &mat             = scratch.matrix(n1, n1);
     
     for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
         jac[i_cvar].setZero();
@@ -1650,13 +1651,16 @@ calculate_barth_tau_matrix (const unsigned int qp,
     const unsigned int n1 = 2 + dim;
     
     libMesh::Point nvec;
+    
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealVectorX
-    eig_val               = RealVectorX::Zero(n1);
+    &eig_val              = scratch.vector(n1);
     
     RealMatrixX
-    l_eig_vec             = RealMatrixX::Zero(n1, n1),
-    l_eig_vec_inv_tr      = RealMatrixX::Zero(n1, n1),
-    tmp1                  = RealMatrixX::Zero(n1, n1);
+    &l_eig_vec            = scratch.matrix(n1, n1),
+    &l_eig_vec_inv_tr     = scratch.matrix(n1, n1),
+    &tmp1                 = scratch.matrix(n1, n1);
     
     Real nval = 0.;
     
@@ -1676,25 +1680,18 @@ calculate_barth_tau_matrix (const unsigned int qp,
             for (unsigned int i_var=0; i_var<n1; i_var++)
                 l_eig_vec_inv_tr.col(i_var) *= fabs(eig_val(i_var)); // L^-T [omaga]
             
-            l_eig_vec_inv_tr *= l_eig_vec.transpose(); // A = L^-T [omaga] L^T
-            
-            tmp1 += nval * l_eig_vec_inv_tr;  // sum_inode  | A_i |
+            // A = L^-T [omaga] L^T, and sum_inode  | A_i |
+            tmp1.noalias() += nval * l_eig_vec_inv_tr * l_eig_vec.transpose();
         }
     }
     
     
     // now invert the tmp matrix to get the tau matrix
-    RealVectorX
-    x    =   RealVectorX::Zero(n1),
-    b    =   RealVectorX::Zero(n1);
-
-    for (unsigned int i_var=0; i_var<n1; i_var++) {
-        
+    _tau_lu.compute(tmp1);
+    tau = _tau_lu.inverse();
+    
+    for (unsigned int i_var=0; i_var<n1; i_var++)
         tau_sens[i_var].setZero(); // zero the sensitivity matrix for now
-        b.setZero(); b(i_var) = 1.;
-        x = tmp1.lu().solve(b);
-        tau.col(i_var) = x;
-    }
     
     return false;
 }
@@ -2000,19 +1997,20 @@ calculate_aliabadi_discontinuity_operator(const unsigned int qp,
     discontinuity_val.setZero();
     const unsigned int n1 = 2 + dim;
     
-    std::vector<RealVectorX >
-    diff_vec(3);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX*
+    diff_vec[3];
     RealMatrixX
-    A_inv_entropy      = RealMatrixX::Zero(dim+2, dim+2),
-    A_entropy          = RealMatrixX::Zero(dim+2, dim+2),
-    dxi_dX             = RealMatrixX::Zero(dim, dim),
-    dX_dxi             = RealMatrixX::Zero(dim, dim),
-    tmpmat1_n1n1       = RealMatrixX::Zero(n1, n1);
+    &A_inv_entropy     = scratch.matrix(dim+2, dim+2),
+    &A_entropy         = scratch.matrix(dim+2, dim+2),
+    &dxi_dX            = scratch.matrix(dim, dim),
+    &dX_dxi            = scratch.matrix(dim, dim);
     RealVectorX
-    vec1               = RealVectorX::Zero(n1),
-    vec2               = RealVectorX::Zero(n1);
+    &vec1              = scratch.vector(n1),
+    &vec2              = scratch.vector(n1);
 
-    for (unsigned int i=0; i<dim; i++) diff_vec[i].setZero(n1);
+    for (unsigned int i=0; i<dim; i++) diff_vec[i] = &scratch.vector(n1);
     
     Real dval;
     
@@ -2021,15 +2019,15 @@ calculate_aliabadi_discontinuity_operator(const unsigned int qp,
     
     
     for (unsigned int i=0; i<dim; i++)
-        dB_mat[i].vector_mult(diff_vec[i], elem_solution); // dU/dxi
-    vec1 = Ai_Bi_advection * elem_solution; // Ai dU/dxi
+        dB_mat[i].vector_mult(*diff_vec[i], elem_solution); // dU/dxi
+    vec1.noalias() = Ai_Bi_advection * elem_solution; // Ai dU/dxi
     
     // TODO: divergence of diffusive flux
     
     // add the velocity and calculate the numerator of the discontinuity
     // capturing term coefficient
     //vec2 += c.elem_solution; // add velocity TODO: how to get the
-    vec2 = A_inv_entropy * vec1;
+    vec2.noalias() = A_inv_entropy * vec1;
     dval = vec1.dot(vec2);  // this is the numerator term
     
     // now evaluate the dissipation factor for the discontinuity capturing term
@@ -2041,10 +2039,10 @@ calculate_aliabadi_discontinuity_operator(const unsigned int qp,
         vec1.setZero();
         
         for (unsigned int j=0; j<dim; j++)
-            vec1 += dxi_dX(i, j) * diff_vec[j];
+            vec1 += dxi_dX(i, j) * *diff_vec[j];
         
         // calculate the value of denominator
-        vec2 = A_inv_entropy * vec1;
+        vec2.noalias() = A_inv_entropy * vec1;
         val1 += vec1.dot(vec2);
     }
     
@@ -2086,12 +2084,12 @@ calculate_aliabadi_discontinuity_operator(const unsigned int qp,
     if (_include_pressure_switch) {
         // also add a pressure switch q
         RealMatrixX
-        dpdc      = RealMatrixX::Zero(n1, n1),
-        dcdp      = RealMatrixX::Zero(n1, n1);
+        &dpdc     = scratch.matrix(n1, n1),
+        &dcdp     = scratch.matrix(n1, n1);
         
         RealVectorX
-        dpress_dp          = RealVectorX::Zero(n1, n1),
-        dp                 = RealVectorX::Zero(dim);
+        &dpress_dp         = scratch.vector(n1),
+        &dp                = scratch.vector(dim);
 
         Real p_sensor = 0., hk = 0.;
         calculate_conservative_variable_jacobian(sol, dcdp, dpdc);
@@ -2099,7 +2097,7 @@ calculate_aliabadi_discontinuity_operator(const unsigned int qp,
         dpress_dp(n1-1) = (sol.cp - sol.cv)*sol.rho; // R rho
         for (unsigned int i=0; i<dim; i++) {
             dB_mat[i].vector_mult(vec1, elem_solution);
-            vec2 = dpdc * vec1;
+            vec2.noalias() = dpdc * vec1;
             dp(i) = vec2.dot(dpress_dp);
             for (unsigned int j=0; j<dim; j++)
                 hk = fmax(hk, fabs(dX_dxi(i, j)));
@@ -2238,21 +2236,24 @@ calculate_differential_operator_matrix (const unsigned int qp,
     
     const unsigned int n1 = 2 + dim, n2 = B_mat.n();
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    mat                = RealMatrixX::Zero(n1, n2),
-    mat2               = RealMatrixX::Zero(n1, n2),
-    tau                = RealMatrixX::Zero(n1, n1);
+    &mat               = scratch.matrix(n1, n1),
+    &mat2              = scratch.matrix(n1, n2),
+    &tau               = scratch.matrix(n1, n1);
     RealVectorX
-    vec1               = RealVectorX::Zero(n1),
-    vec2               = RealVectorX::Zero(n1),
-    vec3               = RealVectorX::Zero(n1),
-    vec4_n2            = RealVectorX::Zero(n2);
+    &vec1              = scratch.vector(n1),
+    &vec2              = scratch.vector(n1),
+    &vec3              = scratch.vector(n1),
+    &vec4_n2           = scratch.vector(n2);
 
     
     const std::vector<std::vector<Real> >& phi =
     fe.get_phi(); // assuming that all variables have the same interpolation
     const unsigned int n_phi = phi.size();
-    std::vector<RealMatrixX > tau_sens(n1);
+    std::vector<RealMatrixX >& tau_sens = _tau_sens;
+    tau_sens.resize(n1);
     for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
         tau_sens[i_cvar].setZero(n1, n1);
     
@@ -2263,7 +2264,7 @@ calculate_differential_operator_matrix (const unsigned int qp,
     bool if_diagonal_tau = false;
     
     vec2.setZero();
-    vec2 = Ai_Bi_advection * elem_solution; // sum A_i dU/dx_i
+    vec2.noalias() = Ai_Bi_advection * elem_solution; // sum A_i dU/dx_i
     
     //if_diagonal_tau = this->calculate_aliabadi_tau_matrix
     //(qp, c, sol, tau, tau_sens);
@@ -2280,10 +2281,10 @@ calculate_differential_operator_matrix (const unsigned int qp,
         
         // sensitivity of the LS operator times strong form of residual
         // Bi^T dAi/dalpha tau
-        vec1 = tau * vec2;
+        vec1.noalias() = tau * vec2;
         for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
         {
-            vec3 = Ai_sens[i][i_cvar] * vec1;
+            vec3.noalias() = Ai_sens[i][i_cvar] * vec1;
             dB_mat[i].vector_mult_transpose(vec4_n2, vec3);
             for (unsigned int i_phi=0; i_phi<n_phi; i_phi++)
                 LS_sens.col((n_phi*i_cvar)+i_phi) += phi[i_phi][qp] * vec4_n2;
@@ -2292,8 +2293,8 @@ calculate_differential_operator_matrix (const unsigned int qp,
         // Bi^T Ai dtau/dalpha
         for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
         {
-            vec1 = tau_sens[i_cvar] * vec2;
-            vec3 = Ai_advection[i] * vec1;
+            vec1.noalias() = tau_sens[i_cvar] * vec2;
+            vec3.noalias() = Ai_advection[i] * vec1;
             dB_mat[i].vector_mult_transpose(vec4_n2, vec3);
             for (unsigned int i_phi=0; i_phi<n_phi; i_phi++)
                 LS_sens.col((n_phi*i_cvar)+i_phi) += phi[i_phi][qp] * vec4_n2;
@@ -2306,8 +2307,11 @@ calculate_differential_operator_matrix (const unsigned int qp,
         for (unsigned int i=0; i<n1; i++)
             LS_operator.row(i) *= tau(i,i);
     }
-    else
-        LS_operator = tau.transpose() * LS_operator;
+    else {
+        
+        mat2.noalias() = tau.transpose() * LS_operator;
+        LS_operator = mat2;
+    }
 }
 
 
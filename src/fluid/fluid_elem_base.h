@@ -23,6 +23,7 @@
 // C++ includes
 #include <ostream>
 #include <map>
+#include <vector>
 
 // MAST includes
 #include "base/mast_data_types.h"
@@ -425,6 +426,20 @@ namespace MAST {
         bool _include_pressure_switch;
         
         Real _dissipation_scaling;
+        
+        /*!
+         *   sensitivity of the intrinsic time scale matrix, retained across
+         *   calls so that the matrices are not reallocated at every
+         *   quadrature point
+         */
+        std::vector<RealMatrixX> _tau_sens;
+        
+        /*!
+         *   factorization used to invert the intrinsic time scale matrix.
+         *   The factorization reuses its storage when the matrix size does
+         *   not change.
+         */
+        Eigen::PartialPivLU<RealMatrixX> _tau_lu;
     };
     
     
@@ -20,6 +20,7 @@
 // MAST includes
 #include "heat_conduction/heat_conduction_elem_base.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/scratch_arena.h"
 #include "base/system_initialization.h"
 #include "base/field_function_base.h"
 #include "base/parameter.h"
@@ -91,21 +92,26 @@ MAST::HeatConductionElementBase::internal_residual (bool request_jacobian,
     n_phi  = _fe->n_shape_functions(),
     dim    = _elem.dim();
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    material_mat   = RealMatrixX::Zero(dim, dim),
-    dmaterial_mat  = RealMatrixX::Zero(dim, dim), // for calculation of Jac when k is temp. dep.
-    mat_n2n2       = RealMatrixX::Zero(n_phi, n_phi);
+    &material_mat  = scratch.matrix(dim, dim),
+    &dmaterial_mat = scratch.matrix(dim, dim), // for calculation of Jac when k is temp. dep.
+    &mat_n2n2      = scratch.matrix(n_phi, n_phi);
     RealVectorX
-    vec1     = RealVectorX::Zero(1),
-    vec2_n2  = RealVectorX::Zero(n_phi),
-    flux     = RealVectorX::Zero(dim);
+    &vec1    = scratch.vector(1),
+    &vec2_n2 = scratch.vector(n_phi),
+    &flux    = scratch.vector(dim);
     
-    std::auto_ptr<MAST::FieldFunction<RealMatrixX> > conductance =
-    _property.thermal_conductance_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    &conductance = _property.property_matrix(MAST::THERMAL_CONDUCTANCE_MATRIX, *this);
     
     libMesh::Point p;
-    std::vector<MAST::FEMOperatorMatrix> dBmat(dim);
-    MAST::FEMOperatorMatrix Bmat; // for calculation of Jac when k is temp. dep.
+    _dBmat.resize(dim);
+    std::vector<MAST::FEMOperatorMatrix>
+    &dBmat = _dBmat;
+    MAST::FEMOperatorMatrix
+    &Bmat  = scratch.operator_matrix(); // for calculation of Jac when k is temp. dep.
 
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
@@ -120,7 +126,7 @@ MAST::HeatConductionElementBase::internal_residual (bool request_jacobian,
 
         _local_elem->global_coordinates_location(xyz[qp], p);
         
-        (*conductance)(p, _time, material_mat);
+        conductance(p, _time, material_mat);
 
         _initialize_fem_gradient_operator(qp, dim, *_fe, dBmat);
         
@@ -155,7 +161,7 @@ MAST::HeatConductionElementBase::internal_residual (bool request_jacobian,
             // Jacobian contribution from int_omega dB_dxi dT_dxj dk_ij/dT B
             if (_active_sol_function) {
                 // get derivative of the conductance matrix wrt temperature
-                conductance->derivative(        *_active_sol_function,
+                conductance.derivative(         *_active_sol_function,
                                         p,
                                         _time, dmaterial_mat);
                 
@@ -190,8 +196,6 @@ MAST::HeatConductionElementBase::velocity_residual (bool request_jacobian,
                                                     RealVectorX& f,
                                                     RealMatrixX& jac_xdot,
                                                     RealMatrixX& jac) {
-    MAST::FEMOperatorMatrix Bmat;
-    
     const std::vector<Real>& JxW                 = _fe->get_JxW();
     const std::vector<libMesh::Point>& xyz       = _fe->get_xyz();
     
@@ -199,15 +203,20 @@ MAST::HeatConductionElementBase::velocity_residual (bool request_jacobian,
     n_phi      = _fe->n_shape_functions(),
     dim        = _elem.dim();
     
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
     RealMatrixX
-    material_mat    = RealMatrixX::Zero(dim, dim),
-    mat_n2n2        = RealMatrixX::Zero(n_phi, n_phi);
+    &material_mat   = scratch.matrix(dim, dim),
+    &mat_n2n2       = scratch.matrix(n_phi, n_phi);
     RealVectorX
-    vec1    = RealVectorX::Zero(1),
-    vec2_n2 = RealVectorX::Zero(n_phi);
+    &vec1    = scratch.vector(1),
+    &vec2_n2 = scratch.vector(n_phi);
+    
+    MAST::FEMOperatorMatrix
+    &Bmat    = scratch.operator_matrix();
     
-    std::auto_ptr<MAST::FieldFunction<RealMatrixX> > capacitance =
-    _property.thermal_capacitance_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    &capacitance = _property.property_matrix(MAST::THERMAL_CAPACITANCE_MATRIX, *this);
     
     libMesh::Point p;
     
@@ -222,7 +231,7 @@ MAST::HeatConductionElementBase::velocity_residual (bool request_jacobian,
 
         _local_elem->global_coordinates_location(xyz[qp], p);
         
-        (*capacitance)(p, _time, material_mat);
+        capacitance(p, _time, material_mat);
         
         Bmat.right_multiply(vec1, _vel);               //  B * T_dot
         Bmat.vector_mult_transpose(vec2_n2, vec1);     //  B^T * B * T_dot
@@ -237,7 +246,7 @@ MAST::HeatConductionElementBase::velocity_residual (bool request_jacobian,
             // Jacobian contribution from int_omega B T d(rho*cp)/dT B
             if (_active_sol_function) {
                 // get derivative of the conductance matrix wrt temperature
-                capacitance->derivative(        *_active_sol_function,
+                capacitance.derivative(         *_active_sol_function,
                                         p,
                                         _time, material_mat);
                 
@@ -588,7 +597,9 @@ surface_flux_residual(bool request_jacobian,
     const std::vector<std::vector<Real> >& phi   = fe->get_phi();
     const unsigned int n_phi                     = (unsigned int)phi.size();
     
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec = scratch.vector(n_phi);
     libMesh::Point pt;
     Real  flux;
     
@@ -631,7 +642,9 @@ surface_flux_residual(bool request_jacobian,
     const std::vector<std::vector<Real> >& phi   = _fe->get_phi();
     const unsigned int n_phi                     = (unsigned int)phi.size();
     
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec = scratch.vector(n_phi);
     libMesh::Point pt;
     Real  flux;
     
@@ -709,11 +722,13 @@ surface_convection_residual(bool request_jacobian,
     const unsigned int n_phi                   = (unsigned int)phi.size();
     
     
-    RealVectorX  phi_vec  = RealVectorX::Zero(n_phi);
-    RealMatrixX  mat      = RealMatrixX::Zero(n_phi, n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec = scratch.vector(n_phi);
+    RealMatrixX &mat     = scratch.matrix(n_phi, n_phi);
     Real temp, amb_temp, h_coeff;
     libMesh::Point pt;
-    MAST::FEMOperatorMatrix Bmat;
+    MAST::FEMOperatorMatrix &Bmat = scratch.operator_matrix();
     
     
     for (unsigned int qp=0; qp<qpoint.size(); qp++) {
@@ -767,11 +782,13 @@ surface_convection_residual(bool request_jacobian,
     const unsigned int n_phi                   = (unsigned int)phi.size();
     
     
-    RealVectorX  phi_vec  = RealVectorX::Zero(n_phi);
-    RealMatrixX  mat      = RealMatrixX::Zero(n_phi, n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec = scratch.vector(n_phi);
+    RealMatrixX &mat     = scratch.matrix(n_phi, n_phi);
     Real temp, amb_temp, h_coeff;
     libMesh::Point pt;
-    MAST::FEMOperatorMatrix Bmat;
+    MAST::FEMOperatorMatrix &Bmat = scratch.operator_matrix();
     
     
     for (unsigned int qp=0; qp<qpoint.size(); qp++) {
@@ -865,15 +882,17 @@ surface_radiation_residual(bool request_jacobian,
     const std::vector<std::vector<Real> >& phi = fe->get_phi();
     const unsigned int n_phi                   = (unsigned int)phi.size();
     
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
-    RealMatrixX mat      = RealMatrixX::Zero(n_phi, n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec = scratch.vector(n_phi);
+    RealMatrixX &mat     = scratch.matrix(n_phi, n_phi);
     const Real
     sbc      = sb_const(),
     amb_temp = T_amb(),
     zero_ref = T_ref_zero();
     Real temp, emiss;
     libMesh::Point pt;
-    MAST::FEMOperatorMatrix Bmat;
+    MAST::FEMOperatorMatrix &Bmat = scratch.operator_matrix();
     
     for (unsigned int qp=0; qp<qpoint.size(); qp++) {
         
@@ -927,15 +946,17 @@ surface_radiation_residual(bool request_jacobian,
     const std::vector<std::vector<Real> >& phi = _fe->get_phi();
     const unsigned int n_phi                   = (unsigned int)phi.size();
     
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
-    RealMatrixX mat      = RealMatrixX::Zero(n_phi, n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec = scratch.vector(n_phi);
+    RealMatrixX &mat     = scratch.matrix(n_phi, n_phi);
     const Real
     sbc      = sb_const(),
     amb_temp = T_amb(),
     zero_ref = T_ref_zero();
     Real temp, emiss;
     libMesh::Point pt;
-    MAST::FEMOperatorMatrix Bmat;
+    MAST::FEMOperatorMatrix &Bmat = scratch.operator_matrix();
     
     for (unsigned int qp=0; qp<qpoint.size(); qp++) {
         
@@ -1015,7 +1036,9 @@ volume_heat_source_residual(bool request_jacobian,
     const std::vector<std::vector<Real> >& phi   = _fe->get_phi();
     const unsigned int n_phi                     = (unsigned int)phi.size();
     
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi_vec = scratch.vector(n_phi);
     libMesh::Point pt;
     Real  source;
     
@@ -1092,7 +1115,9 @@ _initialize_mass_fem_operator(const unsigned int qp,
     
     const unsigned int n_phi = (unsigned int)phi_fe.size();
     
-    RealVectorX phi = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi = scratch.vector(n_phi);
     
     // shape function values
     // N
@@ -1117,7 +1142,9 @@ _initialize_fem_gradient_operator(const unsigned int qp,
     const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
     
     const unsigned int n_phi = (unsigned int)dphi.size();
-    RealVectorX phi = RealVectorX::Zero(n_phi);
+    MAST::ScratchArena::Scope scratch(MAST::ScratchArena::thread_arena());
+    
+    RealVectorX &phi = scratch.vector(n_phi);
     
     // now set the shape function values
     for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
@@ -23,6 +23,7 @@
 
 // MAST includes
 #include "base/elem_base.h"
+#include "numerics/fem_operator_matrix.h"
 
 namespace MAST {
     
@@ -351,6 +352,13 @@ namespace MAST {
          */
         const MAST::ElementPropertyCardBase& _property;
         
+        
+        /*!
+         *   gradient operators used by the internal residual, retained by
+         *   the element so that they are not reallocated on each call
+         */
+        std::vector<MAST::FEMOperatorMatrix> _dBmat;
+        
     };
     
 }
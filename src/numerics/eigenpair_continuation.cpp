@@ -0,0 +1,311 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "numerics/eigenpair_continuation.h"
+
+
+
+// LU factorization with partial pivoting of an upper Hessenberg matrix.
+// Since each column has a single entry below the diagonal, the pivot is
+// chosen between adjacent rows, and both the factorization and the solves
+// need O(n^2) operations.
+class __mast_hessenberg_lu {
+    
+public:
+    
+    void compute(const ComplexMatrixX& H) {
+        
+        const unsigned int n = (unsigned int)H.rows();
+        
+        _U = H;
+        _l.setZero(n);
+        _swap.assign(n, false);
+        
+        for (unsigned int k=0; k+1<n; k++) {
+            
+            if (std::abs(_U(k+1,k)) > std::abs(_U(k,k))) {
+                
+                _U.row(k).tail(n-k).swap(_U.row(k+1).tail(n-k));
+                _swap[k] = true;
+            }
+            
+            _l(k)      = _U(k+1,k)/_U(k,k);
+            _U.row(k+1).tail(n-k-1) -= _l(k) * _U.row(k).tail(n-k-1);
+            _U(k+1,k)  = 0.;
+        }
+    }
+    
+    
+    // solves H x = b, with x overwriting b
+    void solve(ComplexVectorX& b) const {
+        
+        const unsigned int n = (unsigned int)_U.rows();
+        
+        for (unsigned int k=0; k+1<n; k++) {
+            
+            if (_swap[k])
+                std::swap(b(k), b(k+1));
+            b(k+1) -= _l(k) * b(k);
+        }
+        
+        _U.triangularView<Eigen::Upper>().solveInPlace(b);
+    }
+    
+    
+    // solves H^* y = c, with y overwriting c
+    void solve_adjoint(ComplexVectorX& c) const {
+        
+        const unsigned int n = (unsigned int)_U.rows();
+        
+        _U.adjoint().triangularView<Eigen::Lower>().solveInPlace(c);
+        
+        for (unsigned int k=n-1; k>0; k--) {
+            
+            c(k-1) -= std::conj(_l(k-1)) * c(k);
+            if (_swap[k-1])
+                std::swap(c(k-1), c(k));
+        }
+    }
+    
+protected:
+    
+    ComplexMatrixX    _U;
+    
+    ComplexVectorX    _l;
+    
+    std::vector<bool> _swap;
+};
+
+
+
+// reduces the pencil (A, B) to the Hessenberg-triangular form
+// A = Q S Z, B = Q T Z, with S upper Hessenberg, T upper triangular and
+// Q, Z unitary. This is the first step of the QZ algorithm.
+void
+__mast_hessenberg_triangular(const ComplexMatrixX& A,
+                             const ComplexMatrixX& B,
+                             ComplexMatrixX& S,
+                             ComplexMatrixX& T,
+                             ComplexMatrixX& Q,
+                             ComplexMatrixX& Z) {
+    
+    const int n = (int)A.rows();
+    
+    Eigen::HouseholderQR<ComplexMatrixX> qr(B);
+    T = qr.matrixQR();
+    T.triangularView<Eigen::StrictlyLower>().setZero();
+    Q = qr.householderQ();
+    S = Q.adjoint() * A;
+    Z = ComplexMatrixX::Identity(n, n);
+    
+    Eigen::JacobiRotation<Complex> G;
+    
+    for (int j=0; j<=n-3; j++)
+        for (int i=n-1; i>=j+2; i--) {
+            
+            // zero S(i,j) with a rotation of rows i-1 and i
+            if (S(i,j) != Complex(0.)) {
+                
+                G.makeGivens(S(i-1,j), S(i,j), &S(i-1,j));
+                S(i,j) = 0.;
+                S.rightCols(n-j-1).applyOnTheLeft(i-1, i, G.adjoint());
+                T.rightCols(n-i+1).applyOnTheLeft(i-1, i, G.adjoint());
+                Q.applyOnTheRight(i-1, i, G);
+            }
+            
+            // zero the fill-in T(i,i-1) with a rotation of columns i-1
+            // and i. makeGivens() defines G so that G^* [a; b] = [r; 0],
+            // so the rotation [a b] G_c = [r 0] of the row is its conjugate.
+            if (T(i,i-1) != Complex(0.)) {
+                
+                G.makeGivens(T(i,i), T(i,i-1), &T(i,i));
+                G = G.adjoint().transpose();
+                T(i,i-1) = 0.;
+                S.applyOnTheRight(i, i-1, G);
+                T.topRows(i).applyOnTheRight(i, i-1, G);
+                Z.applyOnTheLeft(i, i-1, G.adjoint());
+            }
+        }
+}
+
+
+MAST::EigenpairContinuation::EigenpairContinuation():
+_residual_tol(1.e-10),
+_mac_tol(0.9),
+_max_iters(10) {
+    
+}
+
+
+
+void
+MAST::EigenpairContinuation::set_tolerances(const Real residual_tol,
+                                            const Real mac_tol,
+                                            const unsigned int max_iters) {
+    
+    libmesh_assert_greater(residual_tol, 0.);
+    libmesh_assert_greater(max_iters, 0);
+    
+    _residual_tol = residual_tol;
+    _mac_tol      = mac_tol;
+    _max_iters    = max_iters;
+}
+
+
+
+Real
+MAST::EigenpairContinuation::mac(const ComplexVectorX& x,
+                                 const ComplexVectorX& y) {
+    
+    const Real
+    den = x.squaredNorm() * y.squaredNorm();
+    
+    if (den == 0.)
+        return 0.;
+    
+    return std::norm(x.dot(y))/den;
+}
+
+
+
+bool
+MAST::EigenpairContinuation::compute(const ComplexMatrixX& A,
+                                     const ComplexMatrixX& B,
+                                     const ComplexVectorX& lambda0,
+                                     const ComplexMatrixX& VR0,
+                                     const ComplexMatrixX& VL0) {
+    
+    libmesh_assert_equal_to(A.rows(), A.cols());
+    libmesh_assert_equal_to(B.rows(), A.rows());
+    libmesh_assert_equal_to(VR0.rows(), A.rows());
+    libmesh_assert_equal_to(VL0.rows(), A.rows());
+    libmesh_assert_equal_to(VR0.cols(), lambda0.size());
+    libmesh_assert_equal_to(VL0.cols(), lambda0.size());
+    
+    const unsigned int
+    n      = (unsigned int)A.rows(),
+    n_eig  = (unsigned int)lambda0.size();
+    
+    const Real
+    A_norm = A.norm(),
+    B_norm = B.norm();
+    
+    _lambda.setZero(n_eig);
+    _VR.setZero(n, n_eig);
+    _VL.setZero(n, n_eig);
+    
+    ComplexVectorX
+    x,
+    y,
+    Bx,
+    r;
+    
+    Complex
+    sigma  = 0.,
+    lambda = 0.,
+    den    = 0.;
+    
+    // A - sigma B = Q (S - sigma T) Z, where S - sigma T is upper
+    // Hessenberg for all shifts. Hence, the pencil is reduced once, and
+    // the factorization and solves for each eigenpair are O(n^2).
+    ComplexMatrixX
+    S,
+    T,
+    Q,
+    Z;
+    __mast_hessenberg_triangular(A, B, S, T, Q, Z);
+    
+    __mast_hessenberg_lu lu;
+    
+    for (unsigned int i=0; i<n_eig; i++) {
+        
+        sigma  = lambda0(i);
+        lambda = sigma;
+        x      = VR0.col(i).normalized();
+        y      = VL0.col(i).normalized();
+        
+        lu.compute(S - sigma * T);
+        
+        bool if_converged = false;
+        
+        for (unsigned int j=0; j<_max_iters; j++) {
+            
+            // x = (A - sigma B)^{-1} B x = Z^* (S - sigma T)^{-1} Q^* B x
+            r = Q.adjoint() * (B * x);
+            lu.solve(r);
+            x = Z.adjoint() * r;
+            
+            // y = (A - sigma B)^{-*} B^* y = Q (S - sigma T)^{-*} Z B^* y
+            r = Z * (B.adjoint() * y);
+            lu.solve_adjoint(r);
+            y = Q * r;
+            
+            if (!x.allFinite() || !y.allFinite())
+                return false;
+            
+            x.normalize();
+            y.normalize();
+            
+            // two-sided Rayleigh quotient
+            Bx  = B * x;
+            den = y.dot(Bx);
+            if (std::abs(den) == 0.)
+                return false;
+            
+            lambda = y.dot(A * x)/den;
+            
+            r = A * x - lambda * Bx;
+            if (r.norm() <= _residual_tol * (A_norm + std::abs(lambda) * B_norm)) {
+                if_converged = true;
+                break;
+            }
+        }
+        
+        if (!if_converged ||
+            mac(VR0.col(i), x) < _mac_tol)
+            return false;
+        
+        // the eigenvalue should remain closer to its previous value than
+        // to the previous value of any other eigenpair
+        for (unsigned int j=0; j<n_eig; j++)
+            if (j != i &&
+                std::abs(lambda0(j)-lambda) < std::abs(sigma-lambda))
+                return false;
+        
+        // scale for unit inner product with respect to B
+        _lambda(i)  = lambda;
+        _VR.col(i)  = x / y.dot(B * x);
+        _VL.col(i)  = y;
+    }
+    
+    // two eigenpairs that converged to the same mode indicate that the
+    // continuation jumped between branches
+    for (unsigned int i=0; i<n_eig; i++)
+        for (unsigned int j=i+1; j<n_eig; j++)
+            if (std::abs(_lambda(i)-_lambda(j)) <=
+                sqrt(_residual_tol) * (std::abs(_lambda(i)) + std::abs(_lambda(j))) &&
+                mac(_VR.col(i), _VR.col(j)) >= _mac_tol)
+                return false;
+    
+    return true;
+}
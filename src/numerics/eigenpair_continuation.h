@@ -0,0 +1,130 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__eigenpair_continuation_h__
+#define __mast__eigenpair_continuation_h__
+
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Computes the eigenpairs of A x = \lambda B x by continuation from
+     *   the eigenpairs of a neighboring problem, for example from the
+     *   previous point of a flutter scan. Each eigenpair is refined by
+     *   inverse iteration on the left and right eigenvectors, with the
+     *   previous eigenvalue as the shift and a two-sided Rayleigh quotient
+     *   for the eigenvalue. The pencil is reduced once to
+     *   Hessenberg-triangular form, which is O(n^3). Since A - \sigma B
+     *   is then Hessenberg for every shift, the factorization and the
+     *   iterations for each eigenpair are O(n^2).
+     *
+     *   An eigenpair is accepted only if its residual converges and the
+     *   modal assurance criterion (MAC) between the new and previous
+     *   right eigenvectors is above a threshold. The eigenpairs are
+     *   returned in the order of the previous eigenpairs, so that modes
+     *   are followed without sorting.
+     */
+    class EigenpairContinuation {
+        
+    public:
+        
+        EigenpairContinuation();
+        
+        /*!
+         *   sets the relative residual tolerance, the MAC threshold and
+         *   the maximum number of iterations per eigenpair.
+         */
+        void set_tolerances(const Real residual_tol,
+                            const Real mac_tol,
+                            const unsigned int max_iters);
+        
+        /*!
+         *   computes the eigenpairs of A x = \lambda B x that continue the
+         *   eigenvalues \p lambda0, and the right and left eigenvectors in
+         *   the columns of \p VR0 and \p VL0. @returns false if any
+         *   eigenpair fails to converge, fails the MAC check, moves closer
+         *   to the previous eigenvalue of another eigenpair, or converges
+         *   to the same eigenpair as another one. The caller should then
+         *   compute the full eigensolution.
+         */
+        bool compute(const ComplexMatrixX& A,
+                     const ComplexMatrixX& B,
+                     const ComplexVectorX& lambda0,
+                     const ComplexMatrixX& VR0,
+                     const ComplexMatrixX& VL0);
+        
+        /*!
+         *   @returns the eigenvalues
+         */
+        const ComplexVectorX& eigenvalues() const {
+            return _lambda;
+        }
+        
+        /*!
+         *   @returns the right eigenvectors, scaled so that
+         *   VL^H B VR has a unit diagonal.
+         */
+        const ComplexMatrixX& right_eigenvectors() const {
+            return _VR;
+        }
+        
+        /*!
+         *   @returns the left eigenvectors
+         */
+        const ComplexMatrixX& left_eigenvectors() const {
+            return _VL;
+        }
+        
+        /*!
+         *   @returns the MAC between the vectors \p x and \p y
+         */
+        static Real mac(const ComplexVectorX& x,
+                        const ComplexVectorX& y);
+        
+    protected:
+        
+        /*!
+         *   relative residual tolerance for convergence
+         */
+        Real _residual_tol;
+        
+        /*!
+         *   minimum MAC between the previous and new right eigenvectors
+         */
+        Real _mac_tol;
+        
+        /*!
+         *   maximum number of inverse iterations per eigenpair
+         */
+        unsigned int _max_iters;
+        
+        ComplexVectorX _lambda;
+        
+        ComplexMatrixX _VR;
+        
+        ComplexMatrixX _VL;
+    };
+}
+
+
+#endif // __mast__eigenpair_continuation_h__
@@ -24,12 +24,47 @@
 MAST::FEMOperatorMatrix::FEMOperatorMatrix():
 _n_interpolated_vars(0),
 _n_discrete_vars(0),
-_n_dofs_per_var(0)
+_n_dofs_per_var(0),
+_if_shared_shape_function(false),
+_shape_functions(nullptr, 0, 0)
 {
     
 }
 
 
+
+MAST::FEMOperatorMatrix::FEMOperatorMatrix(const MAST::FEMOperatorMatrix& m):
+_n_interpolated_vars(0),
+_n_discrete_vars(0),
+_n_dofs_per_var(0),
+_if_shared_shape_function(false),
+_shape_functions(nullptr, 0, 0)
+{
+    *this = m;
+}
+
+
+
+MAST::FEMOperatorMatrix&
+MAST::FEMOperatorMatrix::operator= (const MAST::FEMOperatorMatrix& m) {
+    
+    if (this == &m)
+        return *this;
+    
+    _n_interpolated_vars      = m._n_interpolated_vars;
+    _n_discrete_vars          = m._n_discrete_vars;
+    _n_dofs_per_var           = m._n_dofs_per_var;
+    _if_shared_shape_function = m._if_shared_shape_function;
+    _nonzero_blocks           = m._nonzero_blocks;
+    
+    // the map of this operator must view its own storage
+    this->_init_shape_functions();
+    _shape_functions          = m._shape_functions;
+    
+    return *this;
+}
+
+
 MAST::FEMOperatorMatrix::~FEMOperatorMatrix()
 {
     this->clear();
@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <vector>
+#include <new>
 
 
 // MAST includes
@@ -38,9 +39,16 @@ namespace MAST {
         FEMOperatorMatrix();
         
         
+        FEMOperatorMatrix(const MAST::FEMOperatorMatrix& m);
+        
+        
         virtual ~FEMOperatorMatrix();
         
         
+        MAST::FEMOperatorMatrix&
+        operator= (const MAST::FEMOperatorMatrix& m);
+        
+        
         /*!
          *   clears the data structures
          */
@@ -84,29 +92,29 @@ namespace MAST {
         /*!
          *   res = [this] * v
          */
-        template <typename T>
-        void vector_mult(T& res, const T& v) const;
+        template <typename T1, typename T2>
+        void vector_mult(T1& res, const T2& v) const;
         
         
         /*!
          *   res = v^T * [this]
          */
-        template <typename T>
-        void vector_mult_transpose(T& res, const T& v) const;
+        template <typename T1, typename T2>
+        void vector_mult_transpose(T1& res, const T2& v) const;
         
         
         /*!
          *   [R] = [this] * [M]
          */
-        template <typename T>
-        void right_multiply(T& r, const T& m) const;
+        template <typename T1, typename T2>
+        void right_multiply(T1& r, const T2& m) const;
         
         
         /*!
          *   [R] = [this]^T * [M]
          */
-        template <typename T>
-        void right_multiply_transpose(T& r, const T& m) const;
+        template <typename T1, typename T2>
+        void right_multiply_transpose(T1& r, const T2& m) const;
         
         
         /*!
@@ -119,19 +127,29 @@ namespace MAST {
         /*!
          *   [R] = [M] * [this]
          */
-        template <typename T>
-        void left_multiply(T& r, const T& m) const;
+        template <typename T1, typename T2>
+        void left_multiply(T1& r, const T2& m) const;
         
         
         /*!
          *   [R] = [M] * [this]^T
          */
-        template <typename T>
-        void left_multiply_transpose(T& r, const T& m) const;
+        template <typename T1, typename T2>
+        void left_multiply_transpose(T1& r, const T2& m) const;
         
         
     protected:
         
+        /*!
+         *    @returns the index of the block coupling \par interpolated_var
+         *    and \par discrete_var in the block storage.
+         */
+        unsigned int _block_index(unsigned int interpolated_var,
+                                  unsigned int discrete_var) const {
+            return discrete_var*_n_interpolated_vars+interpolated_var;
+        }
+        
+        
         /*!
          *    number of rows of the operator
          */
@@ -147,13 +165,40 @@ namespace MAST {
          */
         unsigned int _n_dofs_per_var;
         
+        /*!
+         *    true if the operator was initialized with the same shape
+         *    function for all variables on the block diagonal, which
+         *    allows the products to be computed as dense operations on the
+         *    single shape function vector.
+         */
+        bool _if_shared_shape_function;
+        
+        /*!
+         *    resizes the shape function storage for the current
+         *    dimensions and zeroes it.
+         */
+        void _init_shape_functions();
+        
+        /*!
+         *    storage for the shape function values. This only grows, so
+         *    that reinit() does not reallocate for operators that are
+         *    not larger than those it has been initialized with before.
+         */
+        RealVectorX                _storage;
+        
         /*!
          *    stores the shape function values that defines the coupling
-         *    of i_th interpolated var and j_th discrete var. Stored in
-         *    column major format. nullptr, if values are zero, otherwise the
-         *    value is set in the vector.
+         *    of i_th interpolated var and j_th discrete var in the column
+         *    _block_index(i, j), as a view of \p _storage. Columns of
+         *    blocks that are not set are zero.
          */
-        std::vector<RealVectorX*>  _var_shape_functions;
+        Eigen::Map<RealMatrixX>    _shape_functions;
+        
+        /*!
+         *    true for blocks whose shape functions have been set, in the same
+         *    order as the columns of _shape_functions.
+         */
+        std::vector<bool>          _nonzero_blocks;
     };
     
 }
@@ -164,19 +209,35 @@ inline
 void
 MAST::FEMOperatorMatrix::clear() {
     
-    _n_interpolated_vars = 0;
-    _n_discrete_vars     = 0;
-    _n_dofs_per_var      = 0;
+    _n_interpolated_vars      = 0;
+    _n_discrete_vars          = 0;
+    _n_dofs_per_var           = 0;
+    _if_shared_shape_function = false;
     
-    // iterate over the shape function entries and delete the non-nullptr values
-    std::vector<RealVectorX*>::iterator it = _var_shape_functions.begin(),
-    end = _var_shape_functions.end();
+    _storage.resize(0);
+    new (&_shape_functions) Eigen::Map<RealMatrixX>(nullptr, 0, 0);
+    _nonzero_blocks.clear();
+}
+
+
+
+inline
+void
+MAST::FEMOperatorMatrix::_init_shape_functions() {
+    
+    const unsigned int
+    n_rows = _n_dofs_per_var,
+    n_cols = _n_interpolated_vars*_n_discrete_vars;
     
-    for ( ; it!=end; it++)
-        if ( *it != nullptr)
-            delete *it;
+    if (_storage.size() < n_rows*n_cols)
+        _storage.resize(n_rows*n_cols);
     
-    _var_shape_functions.clear();
+    // the map is reconstructed in place to view the storage with the
+    // current dimensions
+    new (&_shape_functions) Eigen::Map<RealMatrixX>(_storage.data(),
+                                                    n_rows,
+                                                    n_cols);
+    _shape_functions.setZero();
 }
 
 
@@ -189,13 +250,15 @@ reinit(unsigned int n_interpolated_vars,
        unsigned int n_discrete_vars,
        unsigned int n_discrete_dofs_per_var) {
     
-    this->clear();
-    _n_interpolated_vars = n_interpolated_vars;
-    _n_discrete_vars = n_discrete_vars;
-    _n_dofs_per_var = n_discrete_dofs_per_var;
-    _var_shape_functions.resize(_n_interpolated_vars*_n_discrete_vars);
-    for (unsigned int i=0; i<_var_shape_functions.size(); i++)
-        _var_shape_functions[i] = nullptr;
+    _n_interpolated_vars      = n_interpolated_vars;
+    _n_discrete_vars          = n_discrete_vars;
+    _n_dofs_per_var           = n_discrete_dofs_per_var;
+    _if_shared_shape_function = false;
+    
+    // this does not reallocate unless the operator is larger than any
+    // previous one
+    this->_init_shape_functions();
+    _nonzero_blocks.assign(_n_interpolated_vars*_n_discrete_vars, false);
 }
 
 
@@ -208,22 +271,19 @@ set_shape_function(unsigned int interpolated_var,
                    const RealVectorX& shape_func) {
     
     // make sure that reinit has been called.
-    libmesh_assert(_var_shape_functions.size());
+    libmesh_assert(_nonzero_blocks.size());
     
     // also make sure that the specified indices are within bounds
     libmesh_assert(interpolated_var < _n_interpolated_vars);
     libmesh_assert(discrete_var < _n_discrete_vars);
+    libmesh_assert_equal_to(shape_func.size(), _n_dofs_per_var);
     
-    RealVectorX* vec =
-    _var_shape_functions[discrete_var*_n_interpolated_vars+interpolated_var];
-    
-    if (!vec)
-    {
-        vec = new RealVectorX;
-        _var_shape_functions[discrete_var*_n_interpolated_vars+interpolated_var] = vec;
-    }
+    const unsigned int
+    b = _block_index(interpolated_var, discrete_var);
     
-    *vec = shape_func;
+    _shape_functions.col(b) = shape_func;
+    _nonzero_blocks[b]      = true;
+    _if_shared_shape_function = false;
 }
 
 
@@ -234,120 +294,145 @@ MAST::FEMOperatorMatrix::
 reinit(unsigned int n_vars,
        const RealVectorX& shape_func) {
     
-    this->clear();
+    this->reinit(n_vars, n_vars, (unsigned int)shape_func.size());
     
-    _n_interpolated_vars = n_vars;
-    _n_discrete_vars = n_vars;
-    _n_dofs_per_var = (unsigned int)shape_func.size();
-    _var_shape_functions.resize(n_vars*n_vars);
-    
-    for (unsigned int i=0; i<n_vars; i++)
-    {
-        RealVectorX*  vec = new RealVectorX;
-        *vec = shape_func;
-        _var_shape_functions[i*n_vars+i] = vec;
+    for (unsigned int i=0; i<n_vars; i++) {
+        
+        _shape_functions.col(_block_index(i, i)) = shape_func;
+        _nonzero_blocks[_block_index(i, i)]      = true;
     }
+    
+    _if_shared_shape_function = true;
 }
 
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-vector_mult(T& res, const T& v) const {
+vector_mult(T1& res, const T2& v) const {
     
     libmesh_assert_equal_to(res.size(), _n_interpolated_vars);
     libmesh_assert_equal_to(v.size(), n());
     
+    typedef typename T1::Scalar                                 ScalarType;
+    typedef Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic> MatrixType;
+    
+    if (_if_shared_shape_function) {
+        
+        // v stores the dofs of each variable contiguously, so it can be
+        // viewed as a matrix with one column per variable
+        Eigen::Map<const MatrixType>
+        v_mat(v.data(), _n_dofs_per_var, _n_discrete_vars);
+        
+        res.noalias() = v_mat.transpose() *
+        _shape_functions.col(0).template cast<ScalarType>();
+        return;
+    }
+    
     res.setZero();
-    unsigned int index = 0;
-    
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column
-            index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) // check if this is non-nullptr
-                for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                    res(i) +=
-                    (*_var_shape_functions[index])(k) * v(j*_n_dofs_per_var+k);
+    
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
+            
+            const unsigned int b = _block_index(i, j);
+            
+            if (_nonzero_blocks[b])
+                res(i) += _shape_functions.col(b).template cast<ScalarType>().dot
+                (v.segment(j*_n_dofs_per_var, _n_dofs_per_var));
         }
 }
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-vector_mult_transpose(T& res, const T& v) const {
+vector_mult_transpose(T1& res, const T2& v) const {
     
     libmesh_assert_equal_to(res.size(), n());
     libmesh_assert_equal_to(v.size(), _n_interpolated_vars);
     
+    typedef typename T1::Scalar                                 ScalarType;
+    typedef Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic> MatrixType;
+    
+    if (_if_shared_shape_function) {
+        
+        Eigen::Map<MatrixType>
+        res_mat(res.data(), _n_dofs_per_var, _n_discrete_vars);
+        
+        res_mat.noalias() =
+        _shape_functions.col(0).template cast<ScalarType>() * v.transpose();
+        return;
+    }
+    
     res.setZero(res.size());
-    unsigned int index = 0;
-    
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column
-            index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) // check if this is non-nullptr
-                for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                    res(j*_n_dofs_per_var+k) +=
-                    (*_var_shape_functions[index])(k) * v(i);
+    
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
+            
+            const unsigned int b = _block_index(i, j);
+            
+            if (_nonzero_blocks[b])
+                res.segment(j*_n_dofs_per_var, _n_dofs_per_var) +=
+                _shape_functions.col(b).template cast<ScalarType>() * v(i);
         }
 }
 
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-right_multiply(T& r, const T& m) const {
+right_multiply(T1& r, const T2& m) const {
     
     libmesh_assert_equal_to(r.rows(), _n_interpolated_vars);
     libmesh_assert_equal_to(r.cols(), m.cols());
     libmesh_assert_equal_to(m.rows(), n());
     
+    typedef typename T1::Scalar ScalarType;
+    
     r.setZero();
-    unsigned int index = 0;
-    
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
-            index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
-                for (unsigned int l=0; l<m.cols(); l++) // column of matrix
-                    for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                        r(i,l) +=
-                        (*_var_shape_functions[index])(k) * m(j*_n_dofs_per_var+k,l);
-            }
+    
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column of operator
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
+            
+            const unsigned int b = _block_index(i, j);
+            
+            if (_nonzero_blocks[b])
+                r.row(i).noalias() +=
+                _shape_functions.col(b).template cast<ScalarType>().transpose() *
+                m.middleRows(j*_n_dofs_per_var, _n_dofs_per_var);
         }
 }
 
 
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-right_multiply_transpose(T& r, const T& m) const {
+right_multiply_transpose(T1& r, const T2& m) const {
     
     libmesh_assert_equal_to(r.rows(), n());
     libmesh_assert_equal_to(r.cols(), m.cols());
     libmesh_assert_equal_to(m.rows(), _n_interpolated_vars);
     
+    typedef typename T1::Scalar ScalarType;
+    
     r.setZero(r.rows(), r.cols());
-    unsigned int index = 0;
-    
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
-            index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
-                for (unsigned int l=0; l<m.cols(); l++) // column of matrix
-                    for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                        r(j*_n_dofs_per_var+k,l) +=
-                        (*_var_shape_functions[index])(k) * m(i,l);
-            }
+    
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column of operator
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
+            
+            const unsigned int b = _block_index(i, j);
+            
+            if (_nonzero_blocks[b])
+                r.middleRows(j*_n_dofs_per_var, _n_dofs_per_var).noalias() +=
+                _shape_functions.col(b).template cast<ScalarType>() * m.row(i);
         }
 }
 
@@ -363,78 +448,110 @@ right_multiply_transpose(T& r, const MAST::FEMOperatorMatrix& m) const {
     libmesh_assert_equal_to(r.cols(), m.n());
     libmesh_assert_equal_to(_n_interpolated_vars, m._n_interpolated_vars);
     
+    typedef typename T::Scalar ScalarType;
+    
     r.setZero();
-    unsigned int index_i, index_j = 0;
+    
+    if (_if_shared_shape_function && m._if_shared_shape_function) {
+        
+        // both operators are block diagonal with a single shape function,
+        // so the product is block diagonal with the same outer product in
+        // each block. The products are written directly into the blocks
+        // so that no temporary is created.
+        for (unsigned int i=0; i<_n_discrete_vars; i++)
+            r.block(i*_n_dofs_per_var,
+                    i*m._n_dofs_per_var,
+                    _n_dofs_per_var,
+                    m._n_dofs_per_var).noalias() =
+            _shape_functions.col(0).template cast<ScalarType>() *
+            m._shape_functions.col(0).transpose().template cast<ScalarType>();
+        return;
+    }
+    
+    
+    // the columns of the shape function storage for discrete var i are
+    // contiguous over the interpolated vars, so each block of the product
+    // is a single matrix-matrix product over the interpolated vars.
+    // The columns of the blocks that are not set are zero.
+    bool if_nonzero = false;
     
     for (unsigned int i=0; i<_n_discrete_vars; i++) // row of result
-        for (unsigned int j=0; j<m._n_discrete_vars; j++) // column of result
-            for (unsigned int k=0; k<_n_interpolated_vars; k++) {
-                index_i = i*_n_interpolated_vars+k;
-                index_j = j*m._n_interpolated_vars+k;
-                if (_var_shape_functions[index_i] &&
-                    m._var_shape_functions[index_j]) { // if shape function exists for both
-                    const RealVectorX &n1 = *_var_shape_functions[index_i],
-                    &n2 = *m._var_shape_functions[index_j];
-                    for (unsigned int i_n1=0; i_n1<n1.size(); i_n1++)
-                        for (unsigned int i_n2=0; i_n2<n2.size(); i_n2++)
-                            r (i*_n_dofs_per_var+i_n1,
-                               j*m._n_dofs_per_var+i_n2) += n1(i_n1) * n2(i_n2);
+        for (unsigned int j=0; j<m._n_discrete_vars; j++) { // column of result
+            
+            if_nonzero = false;
+            for (unsigned int k=0; k<_n_interpolated_vars; k++)
+                if (_nonzero_blocks[_block_index(k, i)] &&
+                    m._nonzero_blocks[m._block_index(k, j)]) {
+                    if_nonzero = true;
+                    break;
                 }
-            }
+            
+            if (if_nonzero)
+                r.block(i*_n_dofs_per_var,
+                        j*m._n_dofs_per_var,
+                        _n_dofs_per_var,
+                        m._n_dofs_per_var).noalias() =
+                _shape_functions.middleCols(i*_n_interpolated_vars,
+                                            _n_interpolated_vars).template cast<ScalarType>() *
+                m._shape_functions.middleCols(j*m._n_interpolated_vars,
+                                              m._n_interpolated_vars).transpose().template cast<ScalarType>();
+        }
 }
 
 
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-left_multiply(T& r, const T& m) const {
+left_multiply(T1& r, const T2& m) const {
     
     libmesh_assert_equal_to(r.rows(), m.rows());
     libmesh_assert_equal_to(r.cols(), n());
     libmesh_assert_equal_to(m.cols(), _n_interpolated_vars);
     
+    typedef typename T1::Scalar ScalarType;
+    
     r.setZero(r.rows(), r.cols());
-    unsigned int index = 0;
-    
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
-            index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
-                for (unsigned int l=0; l<m.rows(); l++) // rows of matrix
-                    for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                        r(l,j*_n_dofs_per_var+k) +=
-                        (*_var_shape_functions[index])(k) * m(l,i);
-            }
+    
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column of operator
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
+            
+            const unsigned int b = _block_index(i, j);
+            
+            if (_nonzero_blocks[b])
+                r.middleCols(j*_n_dofs_per_var, _n_dofs_per_var).noalias() +=
+                m.col(i) *
+                _shape_functions.col(b).template cast<ScalarType>().transpose();
         }
 }
 
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-left_multiply_transpose(T& r, const T& m) const {
+left_multiply_transpose(T1& r, const T2& m) const {
     
     libmesh_assert_equal_to(r.rows(), m.rows());
     libmesh_assert_equal_to(r.cols(), _n_interpolated_vars);
     libmesh_assert_equal_to(m.cols(), n());
     
+    typedef typename T1::Scalar ScalarType;
+    
     r.setZero();
-    unsigned int index = 0;
-    
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
-            index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
-                for (unsigned int l=0; l<m.rows(); l++) // column of matrix
-                    for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                        r(l,i) +=
-                        (*_var_shape_functions[index])(k) * m(l,j*_n_dofs_per_var+k);
-            }
+    
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column of operator
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
+            
+            const unsigned int b = _block_index(i, j);
+            
+            if (_nonzero_blocks[b])
+                r.col(i).noalias() +=
+                m.middleCols(j*_n_dofs_per_var, _n_dofs_per_var) *
+                _shape_functions.col(b).template cast<ScalarType>();
         }
 }
 
@@ -442,4 +559,3 @@ left_multiply_transpose(T& r, const T& m) const {
 
 
 #endif // __mast__fem_operator_matrix__
-
@@ -227,6 +227,26 @@ namespace MAST {
             return this->VR;
         }
         
+        /*!
+         *    sets the eigensolution of A x = \lambda B x that was computed
+         *    by another method, for example by continuation of the
+         *    eigenpairs of a neighboring problem.
+         */
+        void set_eigensolution(const RealMatrixX&    A,
+                               const RealMatrixX&    B,
+                               const ComplexVectorX& alpha_vals,
+                               const RealVectorX&    beta_vals,
+                               const ComplexMatrixX& VL_mat,
+                               const ComplexMatrixX& VR_mat) {
+            _A       = A;
+            _B       = B;
+            alpha    = alpha_vals;
+            beta     = beta_vals;
+            VL       = VL_mat;
+            VR       = VR_mat;
+            info_val = 0;
+        }
+        
         /*!
          *    Scales the right eigenvector so that the inner product with respect
          *    to the B matrix is equal to an Identity matrix, i.e.
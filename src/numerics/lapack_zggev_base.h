@@ -76,7 +76,35 @@ namespace MAST {
             libmesh_assert(info_val == 0);
             return this->VR;
         }
-        
+
+        /*!
+         *    @returns the info value returned by LAPACK. This is zero for
+         *    a successful solution.
+         */
+        int info() const {
+            return info_val;
+        }
+
+        /*!
+         *    sets the eigensolution of A x = \lambda B x that was computed
+         *    by another object, for example on a different processor.
+         */
+        void set_eigensolution(const ComplexMatrixX& A,
+                               const ComplexMatrixX& B,
+                               const ComplexVectorX& alpha_vals,
+                               const ComplexVectorX& beta_vals,
+                               const ComplexMatrixX& VL_mat,
+                               const ComplexMatrixX& VR_mat,
+                               int info) {
+            _A       = A;
+            _B       = B;
+            alpha    = alpha_vals;
+            beta     = beta_vals;
+            VL       = VL_mat;
+            VR       = VR_mat;
+            info_val = info;
+        }
+
         /*!
          *    Scales the right eigenvector so that the inner product with respect
          *    to the B matrix is equal to an Identity matrix, i.e.
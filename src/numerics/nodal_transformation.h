@@ -0,0 +1,140 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__nodal_transformation_h__
+#define __mast__nodal_transformation_h__
+
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+namespace MAST {
+    
+    /*
+     *   The methods below apply the transformation between the element
+     *   local and global coordinate systems to structural element vectors
+     *   and matrices. The element dofs are ordered by variable, with
+     *   \par n_nodes dofs each for the three translations followed by the
+     *   three rotations. The transformation is
+     *
+     *      T = diag(R (x) I, R (x) I)
+     *
+     *   where R is the 3x3 rotation matrix of the element and I is the
+     *   identity of size \par n_nodes. The methods apply R to the
+     *   variable blocks of size \par n_nodes, which needs O(n^2) operations
+     *   for a matrix of size n, instead of forming the n x n matrix T and
+     *   computing the O(n^3) dense products.
+     */
+    
+    
+    /*!
+     *   \par global_vec = T \par local_vec
+     */
+    template <typename ValType>
+    inline void
+    transform_nodal_vector_to_global(const RealMatrixX& R,
+                                     const unsigned int n_nodes,
+                                     const ValType& local_vec,
+                                     ValType& global_vec) {
+        
+        libmesh_assert_equal_to(R.rows(), 3);
+        libmesh_assert_equal_to(R.cols(), 3);
+        libmesh_assert_equal_to(local_vec.size(), 6*n_nodes);
+        
+        global_vec.setZero(6*n_nodes);
+        
+        for (unsigned int g=0; g<2; g++)
+            for (unsigned int j=0; j<3; j++)
+                for (unsigned int k=0; k<3; k++)
+                    if (R(j,k) != 0.)
+                        global_vec.segment((3*g+j)*n_nodes, n_nodes) +=
+                        R(j,k) * local_vec.segment((3*g+k)*n_nodes, n_nodes);
+    }
+    
+    
+    
+    /*!
+     *   \par local_vec = T^T \par global_vec
+     */
+    template <typename ValType>
+    inline void
+    transform_nodal_vector_to_local(const RealMatrixX& R,
+                                    const unsigned int n_nodes,
+                                    const ValType& global_vec,
+                                    ValType& local_vec) {
+        
+        libmesh_assert_equal_to(R.rows(), 3);
+        libmesh_assert_equal_to(R.cols(), 3);
+        libmesh_assert_equal_to(global_vec.size(), 6*n_nodes);
+        
+        local_vec.setZero(6*n_nodes);
+        
+        for (unsigned int g=0; g<2; g++)
+            for (unsigned int j=0; j<3; j++)
+                for (unsigned int k=0; k<3; k++)
+                    if (R(k,j) != 0.)
+                        local_vec.segment((3*g+j)*n_nodes, n_nodes) +=
+                        R(k,j) * global_vec.segment((3*g+k)*n_nodes, n_nodes);
+    }
+    
+    
+    
+    /*!
+     *   \par global_mat = T \par local_mat T^T. \par work is used as
+     *   workspace, and is resized to the size of \par local_mat.
+     */
+    template <typename ValType>
+    inline void
+    transform_nodal_matrix_to_global(const RealMatrixX& R,
+                                     const unsigned int n_nodes,
+                                     const ValType& local_mat,
+                                     ValType& global_mat,
+                                     ValType& work) {
+        
+        libmesh_assert_equal_to(R.rows(), 3);
+        libmesh_assert_equal_to(R.cols(), 3);
+        libmesh_assert_equal_to(local_mat.rows(), 6*n_nodes);
+        libmesh_assert_equal_to(local_mat.cols(), 6*n_nodes);
+        
+        const unsigned int n = n_nodes;
+        
+        work.setZero(6*n, 6*n);
+        global_mat.setZero(6*n, 6*n);
+        
+        // left multiply with T
+        for (unsigned int g=0; g<2; g++)
+            for (unsigned int j=0; j<3; j++)
+                for (unsigned int k=0; k<3; k++)
+                    if (R(j,k) != 0.)
+                        work.middleRows((3*g+j)*n, n) +=
+                        R(j,k) * local_mat.middleRows((3*g+k)*n, n);
+        
+        // right multiply with T^T
+        for (unsigned int g=0; g<2; g++)
+            for (unsigned int j=0; j<3; j++)
+                for (unsigned int k=0; k<3; k++)
+                    if (R(j,k) != 0.)
+                        global_mat.middleCols((3*g+j)*n, n) +=
+                        R(j,k) * work.middleCols((3*g+k)*n, n);
+    }
+}
+
+
+#endif // __mast__nodal_transformation_h__
@@ -0,0 +1,189 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// MAST includes
+#include "numerics/scratch_arena.h"
+
+
+MAST::ScratchArena::ScratchArena():
+_n_matrices(0),
+_n_vectors(0),
+_n_used_operators(0) {
+    
+}
+
+
+
+MAST::ScratchArena::~ScratchArena() {
+    
+    this->clear();
+}
+
+
+
+void
+MAST::ScratchArena::clear() {
+    
+    // make sure that no scope is currently using the objects
+    libmesh_assert(_used_matrices.empty());
+    libmesh_assert(_used_vectors.empty());
+    libmesh_assert_equal_to(_n_used_operators, 0);
+    
+    std::map<std::pair<unsigned int, unsigned int>, std::vector<RealMatrixX*> >::iterator
+    m_it  = _matrix_pools.begin(),
+    m_end = _matrix_pools.end();
+    for ( ; m_it != m_end; m_it++)
+        for (unsigned int i=0; i<m_it->second.size(); i++)
+            delete m_it->second[i];
+    
+    std::map<unsigned int, std::vector<RealVectorX*> >::iterator
+    v_it  = _vector_pools.begin(),
+    v_end = _vector_pools.end();
+    for ( ; v_it != v_end; v_it++)
+        for (unsigned int i=0; i<v_it->second.size(); i++)
+            delete v_it->second[i];
+    
+    for (unsigned int i=0; i<_operators.size(); i++)
+        delete _operators[i];
+    
+    _matrix_pools.clear();
+    _vector_pools.clear();
+    _operators.clear();
+    
+    _n_matrices = 0;
+    _n_vectors  = 0;
+}
+
+
+
+MAST::ScratchArena&
+MAST::ScratchArena::thread_arena() {
+    
+    static thread_local MAST::ScratchArena arena;
+    
+    return arena;
+}
+
+
+
+template <typename T>
+T&
+MAST::ScratchArena::_take(std::vector<T*>& pool,
+                          std::vector<std::pair<std::vector<T*>*, T*> >& used,
+                          unsigned int& n_objects) {
+    
+    T* obj = nullptr;
+    
+    if (pool.empty()) {
+        obj = new T;
+        n_objects++;
+    }
+    else {
+        obj = pool.back();
+        pool.pop_back();
+    }
+    
+    used.push_back(std::pair<std::vector<T*>*, T*>(&pool, obj));
+    
+    return *obj;
+}
+
+
+
+template <typename T>
+void
+MAST::ScratchArena::_release(std::vector<std::pair<std::vector<T*>*, T*> >& used,
+                             unsigned int begin) {
+    
+    // scopes are expected to be released in the reverse order of creation
+    libmesh_assert_greater_equal(used.size(), begin);
+    
+    // the objects are returned in the reverse order of their request, so
+    // that the same objects are handed out for the same sequence of
+    // requests
+    for (unsigned int i=(unsigned int)used.size(); i>begin; i--)
+        used[i-1].first->push_back(used[i-1].second);
+    
+    used.resize(begin);
+}
+
+
+
+MAST::ScratchArena::Scope::Scope(MAST::ScratchArena& arena):
+_arena          (arena),
+_matrix_begin   ((unsigned int)arena._used_matrices.size()),
+_vector_begin   ((unsigned int)arena._used_vectors.size()),
+_operator_begin (arena._n_used_operators) {
+    
+}
+
+
+
+MAST::ScratchArena::Scope::~Scope() {
+    
+    libmesh_assert_greater_equal(_arena._n_used_operators, _operator_begin);
+    
+    _arena._release(_arena._used_matrices, _matrix_begin);
+    _arena._release(_arena._used_vectors,  _vector_begin);
+    _arena._n_used_operators = _operator_begin;
+}
+
+
+
+RealMatrixX&
+MAST::ScratchArena::Scope::matrix(unsigned int m,
+                                  unsigned int n) {
+    
+    RealMatrixX&
+    mat = _arena._take(_arena._matrix_pools[std::make_pair(m, n)],
+                       _arena._used_matrices,
+                       _arena._n_matrices);
+    
+    // this reallocates only if the user resized the matrix during its
+    // previous use
+    mat.setZero(m, n);
+    
+    return mat;
+}
+
+
+
+RealVectorX&
+MAST::ScratchArena::Scope::vector(unsigned int n) {
+    
+    RealVectorX&
+    vec = _arena._take(_arena._vector_pools[n],
+                       _arena._used_vectors,
+                       _arena._n_vectors);
+    
+    vec.setZero(n);
+    
+    return vec;
+}
+
+
+
+MAST::FEMOperatorMatrix&
+MAST::ScratchArena::Scope::operator_matrix() {
+    
+    if (_arena._n_used_operators == _arena._operators.size())
+        _arena._operators.push_back(new MAST::FEMOperatorMatrix);
+    
+    return *_arena._operators[_arena._n_used_operators++];
+}
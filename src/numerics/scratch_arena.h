@@ -0,0 +1,194 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef __mast__scratch_arena_h__
+#define __mast__scratch_arena_h__
+
+// C++ includes
+#include <vector>
+#include <map>
+
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "numerics/fem_operator_matrix.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Provides reusable workspace matrices, vectors and operator matrices
+     *   for element calculations. The arena keeps a pool of free objects
+     *   for each requested size, and a Scope returns all objects obtained
+     *   through it to the pools they were drawn from when it goes out of
+     *   scope. A request is served by an object that was last requested
+     *   with the same size, so that its storage is reused without
+     *   reallocation irrespective of the order in which the element
+     *   routines are called. Operator matrices retain the storage of the
+     *   largest operator they have been initialized with. Once the pools
+     *   have been populated, the workspace of the element routines that
+     *   use the arena does not allocate memory.
+     *
+     *   The arena is not thread-safe. thread_arena() provides a separate
+     *   arena for each thread.
+     */
+    class ScratchArena {
+        
+    public:
+        
+        ScratchArena();
+        
+        ~ScratchArena();
+        
+        
+        /*!
+         *   Scope over which objects are drawn from the arena. Scopes may
+         *   be nested, and must be destroyed in the reverse order of their
+         *   creation. The references returned by a scope remain valid only
+         *   for the lifetime of the scope.
+         */
+        class Scope {
+            
+        public:
+            
+            Scope(MAST::ScratchArena& arena);
+            
+            ~Scope();
+            
+            /*!
+             *   @returns a zero matrix of size \par m x \par n. The matrix
+             *   may be resized by the user, but is returned to the pool
+             *   of size \par m x \par n.
+             */
+            RealMatrixX& matrix(unsigned int m, unsigned int n);
+            
+            /*!
+             *   @returns a zero vector of size \par n. The vector is
+             *   returned to the pool of size \par n.
+             */
+            RealVectorX& vector(unsigned int n);
+            
+            /*!
+             *   @returns an operator matrix. The user must reinit the
+             *   operator before use.
+             */
+            MAST::FEMOperatorMatrix& operator_matrix();
+            
+        protected:
+            
+            MAST::ScratchArena& _arena;
+            
+            unsigned int _matrix_begin;
+            
+            unsigned int _vector_begin;
+            
+            unsigned int _operator_begin;
+        };
+        
+        
+        /*!
+         *   @returns the arena for the calling thread
+         */
+        static MAST::ScratchArena& thread_arena();
+        
+        
+        /*!
+         *   @returns the number of matrices owned by the arena
+         */
+        unsigned int n_matrices() const {
+            return _n_matrices;
+        }
+        
+        
+        /*!
+         *   @returns the number of vectors owned by the arena
+         */
+        unsigned int n_vectors() const {
+            return _n_vectors;
+        }
+        
+        
+        /*!
+         *   deletes all pooled objects. This may not be called while a scope
+         *   is active.
+         */
+        void clear();
+        
+    protected:
+        
+        /*!
+         *   @returns an object from \par pool, after creating it if the
+         *   pool is empty. The object is recorded in \par used along with
+         *   its pool, so that it can be returned by the scope.
+         */
+        template <typename T>
+        T& _take(std::vector<T*>& pool,
+                 std::vector<std::pair<std::vector<T*>*, T*> >& used,
+                 unsigned int& n_objects);
+        
+        
+        /*!
+         *   returns the objects in \par used beyond \par begin to their
+         *   pools.
+         */
+        template <typename T>
+        void _release(std::vector<std::pair<std::vector<T*>*, T*> >& used,
+                      unsigned int begin);
+        
+        
+        /*!
+         *   free matrices for each requested size
+         */
+        std::map<std::pair<unsigned int, unsigned int>, std::vector<RealMatrixX*> >
+        _matrix_pools;
+        
+        /*!
+         *   free vectors for each requested size
+         */
+        std::map<unsigned int, std::vector<RealVectorX*> >
+        _vector_pools;
+        
+        /*!
+         *   matrices currently in use, with the pools they were drawn from,
+         *   in the order of their request
+         */
+        std::vector<std::pair<std::vector<RealMatrixX*>*, RealMatrixX*> >
+        _used_matrices;
+        
+        /*!
+         *   vectors currently in use, with the pools they were drawn from,
+         *   in the order of their request
+         */
+        std::vector<std::pair<std::vector<RealVectorX*>*, RealVectorX*> >
+        _used_vectors;
+        
+        /*!
+         *   operator matrices, which are handed out in sequence
+         */
+        std::vector<MAST::FEMOperatorMatrix*>    _operators;
+        
+        unsigned int                             _n_matrices;
+        
+        unsigned int                             _n_vectors;
+        
+        unsigned int                             _n_used_operators;
+    };
+}
+
+
+#endif // __mast__scratch_arena_h__
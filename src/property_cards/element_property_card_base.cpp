@@ -0,0 +1,119 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// MAST includes
+#include "property_cards/element_property_card_base.h"
+#include "base/cached_field_function.h"
+
+
+
+MAST::ElementPropertyCardBase::~ElementPropertyCardBase() {
+    
+    this->clear_property_matrices();
+}
+
+
+
+const MAST::FieldFunction<RealMatrixX>&
+MAST::ElementPropertyCardBase::property_matrix(MAST::PropertyMatrixType t,
+                                               const MAST::ElementBase& e) const {
+    
+    libmesh_assert_less(t, MAST::N_PROPERTY_MATRIX_TYPES);
+    
+    // the functions are created on first request, which may happen
+    // concurrently during threaded assembly
+    {
+        libMesh::Threads::spin_mutex::scoped_lock lock(_property_matrix_mutex);
+        
+        if (_property_matrices[t])
+            return *_property_matrices[t];
+    }
+    
+    // the function is created without holding the lock, since the
+    // material card locks its own mutex during creation
+    std::auto_ptr<MAST::FieldFunction<RealMatrixX> > f;
+    
+    switch (t) {
+        case MAST::STIFFNESS_A_MATRIX:
+            f = this->stiffness_A_matrix(e);
+            break;
+            
+        case MAST::STIFFNESS_B_MATRIX:
+            f = this->stiffness_B_matrix(e);
+            break;
+            
+        case MAST::STIFFNESS_D_MATRIX:
+            f = this->stiffness_D_matrix(e);
+            break;
+            
+        case MAST::TRANSVERSE_SHEAR_STIFFNESS_MATRIX:
+            f = this->transverse_shear_stiffness_matrix(e);
+            break;
+            
+        case MAST::INERTIA_MATRIX:
+            f = this->inertia_matrix(e);
+            break;
+            
+        case MAST::THERMAL_EXPANSION_A_MATRIX:
+            f = this->thermal_expansion_A_matrix(e);
+            break;
+            
+        case MAST::THERMAL_EXPANSION_B_MATRIX:
+            f = this->thermal_expansion_B_matrix(e);
+            break;
+            
+        case MAST::THERMAL_CONDUCTANCE_MATRIX:
+            f = this->thermal_conductance_matrix(e);
+            break;
+            
+        case MAST::THERMAL_CAPACITANCE_MATRIX:
+            f = this->thermal_capacitance_matrix(e);
+            break;
+            
+        default:
+            // should not get here
+            libmesh_error();
+    }
+    
+    std::auto_ptr<MAST::CachedFieldFunction<RealMatrixX> >
+    cached(new MAST::CachedFieldFunction<RealMatrixX>(f));
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_property_matrix_mutex);
+    
+    // another thread may have created the function in the meantime, in
+    // which case this one is discarded
+    if (!_property_matrices[t])
+        _property_matrices[t] = cached.release();
+    
+    return *_property_matrices[t];
+}
+
+
+
+void
+MAST::ElementPropertyCardBase::clear_property_matrices() {
+    
+    for (unsigned int i=0; i<_property_matrices.size(); i++) {
+        
+        if (_property_matrices[i])
+            delete _property_matrices[i];
+        _property_matrices[i] = nullptr;
+    }
+}
+
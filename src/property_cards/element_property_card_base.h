@@ -21,6 +21,10 @@
 #define __mast__element_property_card_base__
 
 
+// C++ includes
+#include <vector>
+
+
 // MAST includes
 #include "base/function_set_base.h"
 #include "elasticity/bending_operator.h"
@@ -28,6 +32,7 @@
 // libMesh includes
 #include "libmesh/elem.h"
 #include "libmesh/fe_type.h"
+#include "libmesh/threads.h"
 
 
 namespace MAST
@@ -36,6 +41,7 @@ namespace MAST
     class MaterialPropertyCardBase;
     class ElementBase;
     template <typename ValType> class FieldFunction;
+    template <typename ValType> class CachedFieldFunction;
     
     
     enum StrainType {
@@ -44,6 +50,24 @@ namespace MAST
     };
     
     
+    /*!
+     *   section property matrices that are cached by the element
+     *   property card
+     */
+    enum PropertyMatrixType {
+        STIFFNESS_A_MATRIX,
+        STIFFNESS_B_MATRIX,
+        STIFFNESS_D_MATRIX,
+        TRANSVERSE_SHEAR_STIFFNESS_MATRIX,
+        INERTIA_MATRIX,
+        THERMAL_EXPANSION_A_MATRIX,
+        THERMAL_EXPANSION_B_MATRIX,
+        THERMAL_CONDUCTANCE_MATRIX,
+        THERMAL_CAPACITANCE_MATRIX,
+        N_PROPERTY_MATRIX_TYPES
+    };
+    
+    
     
     class ElementPropertyCardBase:
     public MAST::FunctionSetBase {
@@ -52,13 +76,14 @@ namespace MAST
         ElementPropertyCardBase():
         MAST::FunctionSetBase(),
         _strain_type(MAST::LINEAR_STRAIN),
-        _diagonal_mass(false)
+        _diagonal_mass(false),
+        _property_matrices(MAST::N_PROPERTY_MATRIX_TYPES, nullptr)
         { }
         
         /*!
          *   virtual destructor
          */
-        virtual ~ElementPropertyCardBase() { }
+        virtual ~ElementPropertyCardBase();
         
         /*!
          *   returns the bending model to be used for the element. Should be
@@ -113,6 +138,29 @@ namespace MAST
         virtual std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
         thermal_capacitance_matrix(const MAST::ElementBase& e) const= 0;
 
+        
+        /*!
+         *   @returns a reference to the property matrix of type \p t. The
+         *   function is created by the corresponding virtual method on the
+         *   first call, and is then shared by all elements of this card.
+         *   If the matrix is constant in space and time, its value is
+         *   computed once and reused until one of the parameters that it
+         *   depends on changes value. The matrix types in
+         *   MAST::PropertyMatrixType do not depend on the element, so
+         *   \p e is only used for the first call.
+         */
+        const MAST::FieldFunction<RealMatrixX>&
+        property_matrix(MAST::PropertyMatrixType t,
+                        const MAST::ElementBase& e) const;
+        
+        
+        /*!
+         *   deletes the property matrices created by property_matrix().
+         *   This should be called if the functions of this card are
+         *   changed after the matrices have been requested.
+         */
+        void clear_property_matrices();
+        
                 
         /*!
          *   return true if the property is isotropic
@@ -189,6 +237,19 @@ namespace MAST
          *    flag to use a diagonal mass matrix. By default, this is false
          */
         bool _diagonal_mass;
+        
+        /*!
+         *    property matrices created by property_matrix()
+         */
+        mutable std::vector<MAST::CachedFieldFunction<RealMatrixX>*>
+        _property_matrices;
+        
+        /*!
+         *    guards the insertion into \p _property_matrices. This is
+         *    specific to the card so that threads using different cards
+         *    do not contend for the same lock.
+         */
+        mutable libMesh::Threads::spin_mutex _property_matrix_mutex;
     };
     
 }
@@ -183,9 +183,20 @@ namespace MAST {
 
 
 bool
-MAST::IsotropicElementPropertyCard3D::depends_on(const MAST::FunctionBase& f) const {
+MAST::IsotropicElementPropertyCard3D::_depends_on(const MAST::FunctionBase& f) const {
     return _material->depends_on(f) ||            // check if the material property depends on the function
-    MAST::ElementPropertyCardBase::depends_on(f); // check with this property card
+    MAST::ElementPropertyCardBase::_depends_on(f); // check with this property card
+}
+
+
+
+void
+MAST::IsotropicElementPropertyCard3D::_add_dependencies(std::vector<bool>& bits) const {
+    
+    _material->freeze_dependencies();
+    _material->add_dependencies(bits);
+    
+    MAST::ElementPropertyCardBase::_add_dependencies(bits);
 }
 
 
@@ -196,6 +207,7 @@ MAST::FieldFunction<RealMatrixX> ("StiffnessMatrix3D"),
 _material_stiffness(mat) {
     
     _functions.insert(&mat);
+    _is_composite = true;
 }
 
 
@@ -228,6 +240,7 @@ InertiaMatrix::InertiaMatrix(const MAST::FieldFunction<RealMatrixX>& mat):
 MAST::FieldFunction<RealMatrixX>("InertiaMatrix3D"),
 _material_inertia(mat) {
     _functions.insert(&mat);
+    _is_composite = true;
 }
 
 
@@ -265,6 +278,7 @@ _material_stiffness(mat_stiff),
 _material_expansion(mat_expansion) {
     _functions.insert(&mat_stiff);
     _functions.insert(&mat_expansion);
+    _is_composite = true;
 }
 
 
@@ -338,6 +352,7 @@ MAST::FieldFunction<RealMatrixX>("ThermalConductanceMatrix"),
 _mat_cond(mat_cond) {
     
     _functions.insert(&mat_cond);
+    _is_composite = true;
 }
 
 
@@ -379,6 +394,7 @@ MAST::FieldFunction<RealMatrixX>("ThermalCapacitanceMatrix"),
 _mat_cap(mat_cap) {
     
     _functions.insert(&mat_cap);
+    _is_composite = true;
 }
 
 
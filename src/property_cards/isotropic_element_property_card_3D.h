@@ -95,11 +95,6 @@ namespace MAST
             libmesh_assert(false);
         }
 
-        /*!
-         *  returns true if the property card depends on the function \p f
-         */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
-
         
         virtual std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
         stiffness_A_matrix(const MAST::ElementBase& e) const;
@@ -139,6 +134,17 @@ namespace MAST
         
     protected:
         
+        /*!
+         *  returns true if the property card depends on the function \p f
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
+        
+        
+        /*!
+         *  adds the dependencies of the material card and of this card
+         */
+        virtual void _add_dependencies(std::vector<bool>& bits) const;
+        
         /*!
          *    pointer to the material property card
          */
@@ -22,6 +22,9 @@
 #include "property_cards/isotropic_material_property_card.h"
 #include "base/field_function_base.h"
 
+// libMesh includes
+#include "libmesh/threads.h"
+
 
 namespace MAST {
     namespace IsotropicMaterialProperty {
@@ -164,6 +167,7 @@ namespace MAST {
             _dim(dim),
             _alpha(alpha) {
                 _functions.insert(&_alpha);
+                _is_composite = true;
             }
             
 
@@ -198,6 +202,7 @@ namespace MAST {
             _dim(dim),
             _k(k) {
                 _functions.insert(&_k);
+                _is_composite = true;
             }
             
             
@@ -235,6 +240,7 @@ namespace MAST {
                 
                 _functions.insert(&_rho);
                 _functions.insert(&_cp);
+                _is_composite = true;
             }
             
             
@@ -273,6 +279,7 @@ _nu(nu)
 {
     _functions.insert(&E);
     _functions.insert(&nu);
+    _is_composite = true;
 }
 
 
@@ -332,6 +339,7 @@ _kappa(kappa)
     _functions.insert(&E);
     _functions.insert(&nu);
     _functions.insert(&kappa);
+    _is_composite = true;
 }
 
 
@@ -397,6 +405,7 @@ _plane_stress(plane_stress) {
     
     _functions.insert(&E);
     _functions.insert(&nu);
+    _is_composite = true;
 }
 
 
@@ -471,6 +480,7 @@ _nu(nu) {
     
     _functions.insert(&E);
     _functions.insert(&nu);
+    _is_composite = true;
 }
 
 
@@ -542,6 +552,7 @@ MAST::FieldFunction<RealMatrixX>("InertiaMatrix3D"),
 _rho(rho) {
     
     _functions.insert(&rho);
+    _is_composite = true;
 }
 
 
@@ -766,6 +777,10 @@ const MAST::FieldFunction<RealMatrixX>&
 MAST::IsotropicMaterialPropertyCard::stiffness_matrix(const unsigned int dim,
                                                       const bool plane_stress) {
     
+    // the functions are created on first request, which may happen
+    // concurrently during threaded assembly
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
     MAST::FieldFunction<RealMatrixX> *rval = nullptr;
     
     switch (dim) {
@@ -826,6 +841,8 @@ MAST::IsotropicMaterialPropertyCard::damping_matrix(const unsigned int dim) {
 const MAST::FieldFunction<RealMatrixX>&
 MAST::IsotropicMaterialPropertyCard::inertia_matrix(const unsigned int dim) {
     
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
     switch (dim) {
         case 3: {
             
@@ -852,6 +869,8 @@ MAST::IsotropicMaterialPropertyCard::inertia_matrix(const unsigned int dim) {
 
 const MAST::FieldFunction<RealMatrixX>&
 MAST::IsotropicMaterialPropertyCard::thermal_expansion_matrix(const unsigned int dim) {
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
 
     switch (dim) {
         case 3: {
@@ -906,6 +925,8 @@ MAST::IsotropicMaterialPropertyCard::thermal_expansion_matrix(const unsigned int
 const MAST::FieldFunction<RealMatrixX>&
 MAST::IsotropicMaterialPropertyCard::transverse_shear_stiffness_matrix() {
     
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
     if (!_transverse_shear_mat)
         _transverse_shear_mat =
         new MAST::IsotropicMaterialProperty::TransverseShearStiffnessMatrix
@@ -921,6 +942,8 @@ MAST::IsotropicMaterialPropertyCard::transverse_shear_stiffness_matrix() {
 const MAST::FieldFunction<RealMatrixX>&
 MAST::IsotropicMaterialPropertyCard::capacitance_matrix(const unsigned int dim) {
     
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
     switch (dim) {
             
         case 1: {
@@ -978,6 +1001,8 @@ MAST::IsotropicMaterialPropertyCard::capacitance_matrix(const unsigned int dim)
 const MAST::FieldFunction<RealMatrixX>&
 MAST::IsotropicMaterialPropertyCard::conductance_matrix(const unsigned int dim) {
     
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
     switch (dim) {
             
         case 1: {
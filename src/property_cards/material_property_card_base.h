@@ -26,6 +26,9 @@
 // MAST includes
 #include "base/function_set_base.h"
 
+// libMesh includes
+#include "libmesh/threads.h"
+
 
 namespace MAST
 {
@@ -68,6 +71,13 @@ namespace MAST
 
     protected:
         
+        /*!
+         *    guards the creation of the property matrix functions, which
+         *    may be requested concurrently during threaded assembly. This
+         *    is specific to the card so that threads using different
+         *    materials do not contend for the same lock.
+         */
+        libMesh::Threads::spin_mutex _mutex;
     };
     
     
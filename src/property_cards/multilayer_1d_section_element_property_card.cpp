@@ -223,7 +223,7 @@ MAST::Multilayer1DSectionElementPropertyCard::if_isotropic() const {
 
 
 bool
-MAST::Multilayer1DSectionElementPropertyCard::depends_on(const MAST::FunctionBase& f) const {
+MAST::Multilayer1DSectionElementPropertyCard::_depends_on(const MAST::FunctionBase& f) const {
     
     // ask each layer for the dependence
     for (unsigned int i=0; i<_layers.size(); i++)
@@ -241,6 +241,24 @@ MAST::Multilayer1DSectionElementPropertyCard::depends_on(const MAST::FunctionBas
 
 
 
+void
+MAST::Multilayer1DSectionElementPropertyCard::_add_dependencies(std::vector<bool>& bits) const {
+    
+    for (unsigned int i=0; i<_layers.size(); i++) {
+        
+        _layers[i]->freeze_dependencies();
+        _layers[i]->add_dependencies(bits);
+    }
+    
+    for (unsigned int i=0; i<_layer_offsets.size(); i++) {
+        
+        _layer_offsets[i]->freeze_dependencies();
+        _layer_offsets[i]->add_dependencies(bits);
+    }
+}
+
+
+
 std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
 MAST::Multilayer1DSectionElementPropertyCard::
 stiffness_A_matrix(const MAST::ElementBase& e) {
@@ -70,11 +70,6 @@ namespace MAST {
         virtual bool if_isotropic() const;
         
 
-        /*!
-         *  returns true if the property card depends on the function \p f
-         */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
-        
         
         virtual std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
         stiffness_A_matrix(const MAST::ElementBase& e);
@@ -108,6 +103,17 @@ namespace MAST {
 
         
     protected:
+        
+        /*!
+         *  returns true if the property card depends on the function \p f
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
+        
+        
+        /*!
+         *  adds the dependencies of the layers and offsets
+         */
+        virtual void _add_dependencies(std::vector<bool>& bits) const;
 
         std::vector<MAST::FieldFunction<Real>*> _layer_offsets;
         
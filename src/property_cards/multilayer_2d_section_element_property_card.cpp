@@ -231,7 +231,7 @@ MAST::Multilayer2DSectionElementPropertyCard::if_isotropic() const {
 
 
 bool
-MAST::Multilayer2DSectionElementPropertyCard::depends_on(const MAST::FunctionBase& f) const {
+MAST::Multilayer2DSectionElementPropertyCard::_depends_on(const MAST::FunctionBase& f) const {
     // ask each layer for the dependence
     for (unsigned int i=0; i<_layers.size(); i++)
         if (_layers[i]->depends_on(f))
@@ -248,6 +248,24 @@ MAST::Multilayer2DSectionElementPropertyCard::depends_on(const MAST::FunctionBas
 
 
 
+void
+MAST::Multilayer2DSectionElementPropertyCard::_add_dependencies(std::vector<bool>& bits) const {
+    
+    for (unsigned int i=0; i<_layers.size(); i++) {
+        
+        _layers[i]->freeze_dependencies();
+        _layers[i]->add_dependencies(bits);
+    }
+    
+    for (unsigned int i=0; i<_layer_offsets.size(); i++) {
+        
+        _layer_offsets[i]->freeze_dependencies();
+        _layer_offsets[i]->add_dependencies(bits);
+    }
+}
+
+
+
 std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
 MAST::Multilayer2DSectionElementPropertyCard::
 stiffness_A_matrix(const MAST::ElementBase& e) {
@@ -195,9 +195,20 @@ namespace MAST {
 
 
 bool
-MAST::OrthotropicElementPropertyCard3D::depends_on(const MAST::FunctionBase& f) const {
+MAST::OrthotropicElementPropertyCard3D::_depends_on(const MAST::FunctionBase& f) const {
     return _material->depends_on(f) ||            // check if the material property depends on the function
-    MAST::ElementPropertyCardBase::depends_on(f); // check with this property card
+    MAST::ElementPropertyCardBase::_depends_on(f); // check with this property card
+}
+
+
+
+void
+MAST::OrthotropicElementPropertyCard3D::_add_dependencies(std::vector<bool>& bits) const {
+    
+    _material->freeze_dependencies();
+    _material->add_dependencies(bits);
+    
+    MAST::ElementPropertyCardBase::_add_dependencies(bits);
 }
 
 
@@ -108,11 +108,6 @@ namespace MAST
             libmesh_assert(false);
         }
         
-        /*!
-         *  returns true if the property card depends on the function \p f
-         */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
-        
         
         virtual std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
         stiffness_A_matrix(const MAST::ElementBase& e) const;
@@ -151,6 +146,17 @@ namespace MAST
         thermal_capacitance_matrix(const MAST::ElementBase& e) const;
         
     protected:
+        
+        /*!
+         *  returns true if the property card depends on the function \p f
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
+        
+        
+        /*!
+         *  adds the dependencies of the material card and of this card
+         */
+        virtual void _add_dependencies(std::vector<bool>& bits) const;
 
         /*!
          *    pointer to the material property card
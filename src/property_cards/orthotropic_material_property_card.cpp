@@ -22,6 +22,9 @@
 #include "property_cards/orthotropic_material_property_card.h"
 #include "base/field_function_base.h"
 
+// libMesh includes
+#include "libmesh/threads.h"
+
 
 namespace MAST {
     namespace OrthotropicMaterialProperty {
@@ -942,6 +945,10 @@ const MAST::FieldFunction<RealMatrixX>&
 MAST::OrthotropicMaterialPropertyCard::stiffness_matrix(const unsigned int dim,
                                                       const bool plane_stress) {
     
+    // the functions are created on first request, which may happen
+    // concurrently during threaded assembly
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
     switch (dim) {
             
         case 1: {
@@ -1011,6 +1018,8 @@ MAST::OrthotropicMaterialPropertyCard::damping_matrix(const unsigned int dim) {
 const MAST::FieldFunction<RealMatrixX>&
 MAST::OrthotropicMaterialPropertyCard::inertia_matrix(const unsigned int dim) {
     
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
     switch (dim) {
         case 3: {
             
@@ -1037,6 +1046,8 @@ MAST::OrthotropicMaterialPropertyCard::inertia_matrix(const unsigned int dim) {
 
 const MAST::FieldFunction<RealMatrixX>&
 MAST::OrthotropicMaterialPropertyCard::thermal_expansion_matrix(const unsigned int dim) {
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
 
     switch (dim) {
         case 1: {
@@ -1089,6 +1100,8 @@ MAST::OrthotropicMaterialPropertyCard::thermal_expansion_matrix(const unsigned i
 const MAST::FieldFunction<RealMatrixX>&
 MAST::OrthotropicMaterialPropertyCard::transverse_shear_stiffness_matrix() {
     
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
     if (!_transverse_shear_mat)
         _transverse_shear_mat =
         new MAST::OrthotropicMaterialProperty::TransverseShearStiffnessMatrix
@@ -1105,6 +1118,8 @@ MAST::OrthotropicMaterialPropertyCard::transverse_shear_stiffness_matrix() {
 const MAST::FieldFunction<RealMatrixX>&
 MAST::OrthotropicMaterialPropertyCard::capacitance_matrix(const unsigned int dim) {
     
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
     switch (dim) {
             
         case 1: {
@@ -1162,6 +1177,8 @@ MAST::OrthotropicMaterialPropertyCard::capacitance_matrix(const unsigned int dim
 const MAST::FieldFunction<RealMatrixX>&
 MAST::OrthotropicMaterialPropertyCard::conductance_matrix(const unsigned int dim) {
     
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
     switch (dim) {
             
         case 1: {
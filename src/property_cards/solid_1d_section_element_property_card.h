@@ -178,15 +178,21 @@ namespace MAST {
          */
         virtual MAST::FieldFunction<RealMatrixX>& I();
 
+        
+        virtual void init();
+        
+    protected:
+        
         /*!
          *  returns true if the property card depends on the function \p f
          */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
-
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
         
-        virtual void init();
         
-    protected:
+        /*!
+         *  adds the dependencies of the material card and of this card
+         */
+        virtual void _add_dependencies(std::vector<bool>& bits) const;
 
         bool _initialized;
         
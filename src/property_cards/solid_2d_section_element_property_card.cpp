@@ -115,6 +115,7 @@ namespace MAST {
             _h(h) {
                 _functions.insert(&mat);
                 _functions.insert(&h);
+                _is_composite = true;
             }
             
             
@@ -362,10 +363,21 @@ namespace MAST {
 
 
 bool
-MAST::Solid2DSectionElementPropertyCard::depends_on(const MAST::FunctionBase& f) const {
+MAST::Solid2DSectionElementPropertyCard::_depends_on(const MAST::FunctionBase& f) const {
     
     return _material->depends_on(f) ||            // check if the material property depends on the function
-    MAST::ElementPropertyCardBase::depends_on(f); // check with this property card
+    MAST::ElementPropertyCardBase::_depends_on(f); // check with this property card
+}
+
+
+
+void
+MAST::Solid2DSectionElementPropertyCard::_add_dependencies(std::vector<bool>& bits) const {
+    
+    _material->freeze_dependencies();
+    _material->add_dependencies(bits);
+    
+    MAST::ElementPropertyCardBase::_add_dependencies(bits);
 }
 
 
@@ -379,6 +391,7 @@ _material_stiffness(mat),
 _h(h) {
     _functions.insert(&mat);
     _functions.insert(&h);
+    _is_composite = true;
 }
 
 
@@ -432,6 +445,7 @@ _off(off) {
     _functions.insert(&mat);
     _functions.insert(&h);
     _functions.insert(&off);
+    _is_composite = true;
 }
 
 
@@ -483,6 +497,7 @@ _off(off) {
     _functions.insert(&mat);
     _functions.insert(&h);
     _functions.insert(&off);
+    _is_composite = true;
 }
 
 
@@ -538,6 +553,7 @@ _off(off) {
     _functions.insert(&rho);
     _functions.insert(&h);
     _functions.insert(&off);
+    _is_composite = true;
 }
 
 
@@ -614,6 +630,7 @@ _h(h) {
     _functions.insert(&mat_stiff);
     _functions.insert(&mat_expansion);
     _functions.insert(&h);
+    _is_composite = true;
 }
 
 
@@ -680,6 +697,7 @@ _off(off) {
     _functions.insert(&mat_expansion);
     _functions.insert(&h);
     _functions.insert(&off);
+    _is_composite = true;
 }
 
 
@@ -928,6 +946,7 @@ _mat_cond(mat_cond),
 _h(h) {
     _functions.insert(&mat_cond);
     _functions.insert(&h);
+    _is_composite = true;
 }
 
 
@@ -982,6 +1001,7 @@ _mat_cap(mat_cap),
 _h(h) {
     _functions.insert(&mat_cap);
     _functions.insert(&h);
+    _is_composite = true;
 }
 
 
@@ -80,11 +80,6 @@ namespace MAST {
         }
 
         
-        /*!
-         *  returns true if the property card depends on the function \p f
-         */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
-        
         
         virtual std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
         stiffness_A_matrix(const MAST::ElementBase& e) const;
@@ -126,6 +121,17 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *  returns true if the property card depends on the function \p f
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
+        
+        
+        /*!
+         *  adds the dependencies of the material card and of this card
+         */
+        virtual void _add_dependencies(std::vector<bool>& bits) const;
+        
         /*!
          *   material property card
          */
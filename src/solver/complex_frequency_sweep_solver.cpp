@@ -0,0 +1,344 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// MAST includes
+#include "solver/complex_frequency_sweep_solver.h"
+#include "base/complex_assembly_base.h"
+#include "base/nonlinear_system.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+#include "libmesh/sparse_matrix.h"
+
+// PETSc includes
+#include <petsctime.h>
+
+
+
+namespace MAST {
+    
+    /*!
+     *   sets the use of a nonzero initial guess by a KSP, and restores the
+     *   previous setting on destruction, so that the setting is restored
+     *   on all exits from the scope, including exceptions
+     */
+    class KSPInitialGuessNonzeroScope {
+    public:
+        
+        KSPInitialGuessNonzeroScope(KSP ksp, PetscBool flg):
+        _ksp(ksp),
+        _prev(PETSC_FALSE) {
+            
+            PetscErrorCode ierr;
+            ierr = KSPGetInitialGuessNonzero(_ksp, &_prev);
+            CHKERRABORT(PetscObjectComm((PetscObject)_ksp), ierr);
+            ierr = KSPSetInitialGuessNonzero(_ksp, flg);
+            CHKERRABORT(PetscObjectComm((PetscObject)_ksp), ierr);
+        }
+        
+        
+        ~KSPInitialGuessNonzeroScope() {
+            
+            PetscErrorCode ierr;
+            ierr = KSPSetInitialGuessNonzero(_ksp, _prev);
+            CHKERRABORT(PetscObjectComm((PetscObject)_ksp), ierr);
+        }
+        
+    protected:
+        
+        KSP       _ksp;
+        
+        PetscBool _prev;
+    };
+}
+
+
+MAST::ComplexFrequencySweepSolver::ComplexFrequencySweepSolver():
+MAST::ComplexSolverBase(),
+n_recycle                          (5),
+if_compare_independent_solves      (false),
+_recycle_head                      (0),
+_sweep_time                        (0.),
+_independent_time                  (0.) {
+    
+}
+
+
+
+MAST::ComplexFrequencySweepSolver::~ComplexFrequencySweepSolver() {
+    
+    this->_clear_recycled_solutions();
+}
+
+
+
+void
+MAST::ComplexFrequencySweepSolver::
+sweep(MAST::ComplexFrequencySweepSolver::FrequencyUpdate& update,
+      unsigned int n_freq) {
+    
+    START_LOG("sweep()", "ComplexFrequencySweep");
+    
+    // get reference to the system
+    MAST::NonlinearSystem& sys =
+    dynamic_cast<MAST::NonlinearSystem&>(_assembly->system());
+    
+    // the block matrix, and hence its sparsity pattern and symbolic
+    // factorization, are shared by all frequencies
+    this->_init_block_matrix();
+    this->_clear_recycled_solutions();
+    
+    PetscErrorCode   ierr;
+    KSPType          ksp_type;
+    PetscBool        if_direct;
+    PetscLogDouble   t0, t1;
+    PetscInt         its;
+    unsigned int     ind_its = 0;
+    
+    // the initial guess is ignored by direct solvers
+    ierr = KSPGetType(_block_ksp, &ksp_type);          CHKERRABORT(sys.comm().get(), ierr);
+    ierr = PetscStrcmp(ksp_type, KSPPREONLY, &if_direct); CHKERRABORT(sys.comm().get(), ierr);
+    
+    // the recycled initial guess is used only during the sweep, and the
+    // setting of the KSP is restored on exit
+    MAST::KSPInitialGuessNonzeroScope
+    guess_scope(_block_ksp, if_direct?PETSC_FALSE:PETSC_TRUE);
+    
+    // the residual is evaluated about a zero solution
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    zero(_block_sol_vec->zero_clone().release());
+    
+    _sweep_time       = 0.;
+    _independent_time = 0.;
+    
+    for (unsigned int i=0; i<n_freq; i++) {
+        
+        // ask the user to set the frequency
+        update.init_frequency(i);
+        
+        zero->zero();
+        zero->close();
+        
+        _assembly->residual_and_jacobian_blocked(*zero,
+                                                 *_block_res_vec,
+                                                 *_block_jac,
+                                                 sys,
+                                                 nullptr);
+        
+        START_LOG("KSPSolve", "ComplexFrequencySweep");
+        
+        ierr = PetscTime(&t0);                               CHKERRABORT(sys.comm().get(), ierr);
+        ierr = KSPSetOperators(_block_ksp, _block_mat, _block_mat);
+        CHKERRABORT(sys.comm().get(), ierr);
+        
+        if (!if_direct)
+            this->_init_recycled_guess();
+        
+        ierr = KSPSolve(_block_ksp, _block_res, _block_sol); CHKERRABORT(sys.comm().get(), ierr);
+        ierr = PetscTime(&t1);                               CHKERRABORT(sys.comm().get(), ierr);
+        ierr = KSPGetIterationNumber(_block_ksp, &its);      CHKERRABORT(sys.comm().get(), ierr);
+        
+        STOP_LOG("KSPSolve", "ComplexFrequencySweep");
+        
+        _sweep_time += t1 - t0;
+        
+        libMesh::out
+        << "Frequency: " << i
+        << " : iterations = " << its
+        << " , solve time = " << t1 - t0 << " s";
+        
+        if (if_compare_independent_solves) {
+            
+            Real t = this->_independent_solve(ind_its);
+            _independent_time += t;
+            
+            libMesh::out
+            << " : independent iterations = " << ind_its
+            << " , solve time = " << t << " s";
+        }
+        libMesh::out << std::endl;
+        
+        if (!if_direct)
+            this->_add_recycled_solution();
+        
+        // copy the solution to separate real and imaginary vectors
+        this->_extract_block_solution(*_block_sol_vec, false);
+        
+        // let the user process the solution at this frequency
+        update.process_solution(i);
+    }
+    
+    libMesh::out
+    << "Frequency sweep: " << n_freq << " frequencies"
+    << " : solve time = " << _sweep_time << " s";
+    if (if_compare_independent_solves && _sweep_time > 0.)
+        libMesh::out
+        << " : independent solve time = " << _independent_time << " s"
+        << " , speedup = " << _independent_time/_sweep_time;
+    libMesh::out << std::endl;
+    
+    STOP_LOG("sweep()", "ComplexFrequencySweep");
+}
+
+
+
+void
+MAST::ComplexFrequencySweepSolver::_init_recycled_guess() {
+    
+    PetscErrorCode  ierr;
+    MPI_Comm        comm = PetscObjectComm((PetscObject)_block_mat);
+    PetscScalar     h;
+    PetscReal       nrm0, nrm;
+    
+    unsigned int
+    n       = (unsigned int)_recycle.size(),
+    n_basis = 0;
+    
+    ierr = VecZeroEntries(_block_sol);                   CHKERRABORT(comm, ierr);
+    
+    // the products of the operator with the recycled solutions are
+    // orthonormalized by modified Gram-Schmidt, and the same combinations
+    // of the solutions are stored in _recycle_basis. Solutions that are
+    // linearly dependent on the previous ones are skipped.
+    for (unsigned int k=0; k<n; k++) {
+        
+        Vec
+        &w  = _recycle_basis[n_basis],
+        &Aw = _recycle_op[n_basis];
+        
+        ierr = VecCopy(_recycle[k], w);                  CHKERRABORT(comm, ierr);
+        ierr = MatMult(_block_mat, w, Aw);               CHKERRABORT(comm, ierr);
+        ierr = VecNorm(Aw, NORM_2, &nrm0);               CHKERRABORT(comm, ierr);
+        
+        for (unsigned int l=0; l<n_basis; l++) {
+            
+            ierr = VecDot(Aw, _recycle_op[l], &h);       CHKERRABORT(comm, ierr);
+            ierr = VecAXPY(Aw, -h, _recycle_op[l]);      CHKERRABORT(comm, ierr);
+            ierr = VecAXPY( w, -h, _recycle_basis[l]);   CHKERRABORT(comm, ierr);
+        }
+        
+        ierr = VecNorm(Aw, NORM_2, &nrm);                CHKERRABORT(comm, ierr);
+        
+        if (nrm <= 1.e-10 * nrm0)
+            continue;
+        
+        ierr = VecScale(Aw, 1./nrm);                     CHKERRABORT(comm, ierr);
+        ierr = VecScale( w, 1./nrm);                     CHKERRABORT(comm, ierr);
+        n_basis++;
+    }
+    
+    // the initial guess minimizes the residual over the recycled space
+    for (unsigned int l=0; l<n_basis; l++) {
+        
+        ierr = VecDot(_block_res, _recycle_op[l], &h);   CHKERRABORT(comm, ierr);
+        ierr = VecAXPY(_block_sol, h, _recycle_basis[l]); CHKERRABORT(comm, ierr);
+    }
+}
+
+
+
+void
+MAST::ComplexFrequencySweepSolver::_add_recycled_solution() {
+    
+    if (!n_recycle)
+        return;
+    
+    PetscErrorCode  ierr;
+    MPI_Comm        comm = PetscObjectComm((PetscObject)_block_mat);
+    
+    if (_recycle.size() < n_recycle) {
+        
+        Vec v, w, Aw;
+        
+        ierr = VecDuplicate(_block_sol, &v);             CHKERRABORT(comm, ierr);
+        ierr = VecDuplicate(_block_sol, &w);             CHKERRABORT(comm, ierr);
+        ierr = VecDuplicate(_block_sol, &Aw);            CHKERRABORT(comm, ierr);
+        
+        _recycle.push_back(v);
+        _recycle_basis.push_back(w);
+        _recycle_op.push_back(Aw);
+        
+        _recycle_head = (unsigned int)_recycle.size() % n_recycle;
+        
+        ierr = VecCopy(_block_sol, v);                   CHKERRABORT(comm, ierr);
+    }
+    else {
+        
+        // replace the oldest solution
+        ierr = VecCopy(_block_sol, _recycle[_recycle_head]); CHKERRABORT(comm, ierr);
+        _recycle_head = (_recycle_head + 1) % n_recycle;
+    }
+}
+
+
+
+Real
+MAST::ComplexFrequencySweepSolver::_independent_solve(unsigned int& n_its) {
+    
+    PetscErrorCode  ierr;
+    MPI_Comm        comm = PetscObjectComm((PetscObject)_block_mat);
+    KSP             ksp;
+    Vec             x;
+    PetscInt        its;
+    PetscLogDouble  t0, t1;
+    
+    ierr = KSPCreate(comm, &ksp);                        CHKERRABORT(comm, ierr);
+    
+    if (libMesh::on_command_line("--solver_system_names")) {
+        
+        std::string nm = _assembly->system().name() + "_complex_";
+        KSPSetOptionsPrefix(ksp, nm.c_str());
+    }
+    
+    ierr = KSPSetOperators(ksp, _block_mat, _block_mat); CHKERRABORT(comm, ierr);
+    ierr = KSPSetFromOptions(ksp);                       CHKERRABORT(comm, ierr);
+    ierr = VecDuplicate(_block_sol, &x);                 CHKERRABORT(comm, ierr);
+    
+    ierr = PetscTime(&t0);                               CHKERRABORT(comm, ierr);
+    ierr = KSPSetUp(ksp);                                CHKERRABORT(comm, ierr);
+    ierr = KSPSolve(ksp, _block_res, x);                 CHKERRABORT(comm, ierr);
+    ierr = PetscTime(&t1);                               CHKERRABORT(comm, ierr);
+    ierr = KSPGetIterationNumber(ksp, &its);             CHKERRABORT(comm, ierr);
+    
+    ierr = KSPDestroy(&ksp);                             CHKERRABORT(comm, ierr);
+    ierr = VecDestroy(&x);                               CHKERRABORT(comm, ierr);
+    
+    n_its = its;
+    
+    return t1 - t0;
+}
+
+
+
+void
+MAST::ComplexFrequencySweepSolver::_clear_recycled_solutions() {
+    
+    for (unsigned int i=0; i<_recycle.size(); i++) {
+        
+        VecDestroy(&_recycle[i]);
+        VecDestroy(&_recycle_basis[i]);
+        VecDestroy(&_recycle_op[i]);
+    }
+    
+    _recycle.clear();
+    _recycle_basis.clear();
+    _recycle_op.clear();
+    _recycle_head = 0;
+}
+
@@ -0,0 +1,166 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__complex_frequency_sweep_solver_h__
+#define __mast__complex_frequency_sweep_solver_h__
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "solver/complex_solver_base.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   solves the complex system of equations at a sequence of
+     *   frequencies. The block matrix and its symbolic factorization are
+     *   shared by all frequencies. For iterative solvers, the initial guess
+     *   at each frequency minimizes the residual over the space spanned by
+     *   the solutions at the previous frequencies.
+     */
+    class ComplexFrequencySweepSolver:
+    public MAST::ComplexSolverBase {
+        
+    public:
+        
+        /*!
+         *   This class provides the interface to set the frequency in the
+         *   assembly, and to process the solution at each frequency.
+         */
+        class FrequencyUpdate {
+            
+        public:
+            
+            FrequencyUpdate() { }
+            
+            virtual ~FrequencyUpdate() { }
+            
+            /*!
+             *   sets the \par i^th frequency of the sweep in the assembly
+             */
+            virtual void init_frequency(unsigned int i) = 0;
+            
+            /*!
+             *   called after the solution at the \par i^th frequency has
+             *   been copied to real_solution() and imag_solution().
+             */
+            virtual void process_solution(unsigned int i) = 0;
+        };
+        
+        
+        ComplexFrequencySweepSolver();
+        
+        
+        virtual ~ComplexFrequencySweepSolver();
+        
+        
+        /*!
+         *   solves the system at \par n_freq frequencies set by \par update.
+         *   The initial guess setting of the KSP is restored on return.
+         */
+        void sweep(MAST::ComplexFrequencySweepSolver::FrequencyUpdate& update,
+                   unsigned int n_freq);
+        
+        
+        /*!
+         *   @returns the linear solve time of the last sweep, including
+         *   the setup of the preconditioner
+         */
+        Real sweep_solve_time() const {
+            
+            return _sweep_time;
+        }
+        
+        
+        /*!
+         *   @returns the time of independent linear solves at each
+         *   frequency of the last sweep. This is zero unless
+         *   \p if_compare_independent_solves is true.
+         */
+        Real independent_solve_time() const {
+            
+            return _independent_time;
+        }
+        
+        
+        /*!
+         *   number of solutions at previous frequencies used for the
+         *   initial guess of iterative solvers
+         */
+        unsigned int n_recycle;
+        
+        /*!
+         *   if true, each frequency is also solved with a new KSP and a zero
+         *   initial guess to report the speedup of the sweep
+         */
+        bool if_compare_independent_solves;
+        
+    protected:
+        
+        
+        /*!
+         *   sets the initial guess in \p _block_sol as the combination of
+         *   the recycled solutions that minimizes the residual of the
+         *   current operator
+         */
+        void _init_recycled_guess();
+        
+        
+        /*!
+         *   adds the current solution to the recycled solutions, replacing
+         *   the oldest one if \p n_recycle solutions are stored
+         */
+        void _add_recycled_solution();
+        
+        
+        /*!
+         *   @returns the time for the solution of the current system with a
+         *   new KSP and a zero initial guess
+         */
+        Real _independent_solve(unsigned int& n_its);
+        
+        
+        /*!
+         *   destroys the recycled solutions and the work vectors
+         */
+        void _clear_recycled_solutions();
+        
+        
+        /*!
+         *   solutions at previous frequencies, with the most recent one at
+         *   \p _recycle_head - 1
+         */
+        std::vector<Vec> _recycle;
+        
+        unsigned int     _recycle_head;
+        
+        /*!
+         *   work vectors for the products of the operator with the
+         *   recycled solutions, and their orthonormalized combinations
+         */
+        std::vector<Vec> _recycle_op, _recycle_basis;
+        
+        Real             _sweep_time, _independent_time;
+    };
+}
+
+
+#endif // __mast__complex_frequency_sweep_solver_h__
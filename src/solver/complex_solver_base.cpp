@@ -39,7 +39,11 @@
 MAST::ComplexSolverBase::ComplexSolverBase():
 _assembly(nullptr),
 tol(1.0e-3),
-max_iters(20) {
+max_iters(20),
+_block_mat(PETSC_NULL),
+_block_res(PETSC_NULL),
+_block_sol(PETSC_NULL),
+_block_ksp(PETSC_NULL) {
     
 }
 
@@ -47,6 +51,7 @@ max_iters(20) {
 
 MAST::ComplexSolverBase::~ComplexSolverBase() {
     
+    this->clear_block_matrix();
 }
 
 
@@ -63,11 +68,35 @@ MAST::ComplexSolverBase::set_assembly(MAST::ComplexAssemblyBase& assembly) {
 void
 MAST::ComplexSolverBase::clear_assembly() {
     
+    this->clear_block_matrix();
+    
     _assembly = nullptr;
 }
 
 
 
+void
+MAST::ComplexSolverBase::clear_block_matrix() {
+    
+    if (!_block_mat)
+        return;
+    
+    // the wrappers do not own the PETSc objects
+    _block_jac.reset();
+    _block_res_vec.reset();
+    _block_sol_vec.reset();
+    
+    PetscErrorCode ierr;
+    MPI_Comm       comm = PetscObjectComm((PetscObject)_block_mat);
+    
+    ierr = KSPDestroy(&_block_ksp);           CHKERRABORT(comm, ierr);
+    ierr = MatDestroy(&_block_mat);           CHKERRABORT(comm, ierr);
+    ierr = VecDestroy(&_block_res);           CHKERRABORT(comm, ierr);
+    ierr = VecDestroy(&_block_sol);           CHKERRABORT(comm, ierr);
+}
+
+
+
 
 libMesh::NumericVector<Real>&
 MAST::ComplexSolverBase::real_solution(bool if_sens) {
@@ -146,6 +175,14 @@ MAST::ComplexSolverBase::imag_solution(bool if_sens) const {
 void
 MAST::ComplexSolverBase::solve() {
     
+    this->solve_block_matrix();
+}
+
+
+
+void
+MAST::ComplexSolverBase::solve_gauss_seidel() {
+    
     
     //  The complex system of equations
     //     (J_R + i J_I) (x_R + i x_I) + (r_R + i r_I) = 0
@@ -377,10 +414,180 @@ MAST::ComplexSolverBase::solve_pc_fieldsplit() {
 
 
 
+namespace MAST {
+    
+    /*!
+     *   right-hand side update used by solve_block_matrix() for a single
+     *   excitation that is already set in the assembly
+     */
+    class ComplexSolverSingleRHS:
+    public MAST::ComplexSolverBase::RHSUpdate {
+        
+    public:
+        
+        ComplexSolverSingleRHS() { }
+        
+        virtual ~ComplexSolverSingleRHS() { }
+        
+        virtual void init_rhs(unsigned int i) { }
+        
+        virtual void process_solution(unsigned int i) { }
+    };
+}
+
+
+
 void
 MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     
-    START_LOG("solve_block_matrix()", "ComplexSolve");
+    MAST::ComplexSolverSingleRHS rhs;
+    
+    this->solve_block_matrix_multiple_rhs(rhs, 1, p);
+}
+
+
+
+
+void
+MAST::ComplexSolverBase::
+solve_block_matrix_multiple_rhs(MAST::ComplexSolverBase::RHSUpdate& rhs,
+                                unsigned int n_rhs,
+                                MAST::Parameter* p)  {
+    
+    START_LOG("solve_block_matrix_multiple_rhs()", "ComplexSolve");
+    
+    // get reference to the system
+    MAST::NonlinearSystem& sys =
+    dynamic_cast<MAST::NonlinearSystem&>(_assembly->system());
+    
+    // the operator is assembled and the preconditioner is set up for the
+    // first right-hand side only, after which each new excitation requires
+    // only a residual assembly and a KSPSolve. The matrix and KSP are
+    // retained from the previous call, so that a new operator with the same
+    // sparsity reuses the symbolic factorization.
+    this->_init_block_matrix();
+    
+    PetscErrorCode   ierr;
+    
+    Mat
+    mat     = _block_mat;
+    
+    Vec
+    res_vec = _block_res,
+    sol_vec = _block_sol;
+    
+    KSP
+    ksp     = _block_ksp;
+    
+    libMesh::SparseMatrix<Real>
+    *jac_mat = _block_jac.get();
+    
+    libMesh::NumericVector<Real>
+    *res     = _block_res_vec.get(),
+    *sol     = _block_sol_vec.get();
+    
+    
+    for (unsigned int i_rhs=0; i_rhs<n_rhs; i_rhs++) {
+        
+        // ask the user to set the excitation for this right-hand side
+        rhs.init_rhs(i_rhs);
+        
+        sol->zero();
+        
+        // if sensitivity analysis is requested, then set the complex solution in
+        // the solution vector. The RHS object is expected to have set the
+        // solution corresponding to this right-hand side in real_solution()
+        // and imag_solution().
+        if (p) {
+            
+            // copy the solution to separate real and imaginary vectors
+            libMesh::NumericVector<Real>
+            &sol_R = this->real_solution(),
+            &sol_I = this->imag_solution();
+            
+            unsigned int
+            first = sol_R.first_local_index(),
+            last  = sol_I.last_local_index();
+            
+            for (unsigned int i=first; i<last; i++) {
+                
+                sol->set(  2*i, sol_R(i));
+                sol->set(2*i+1, sol_I(i));
+            }
+        }
+        
+        sol->close();
+        
+        
+        if (i_rhs == 0) {
+            
+            // assemble the matrix and the first residual
+            _assembly->residual_and_jacobian_blocked(*sol,
+                                                     *res,
+                                                     *jac_mat,
+                                                     sys,
+                                                     p);
+            
+            // the nonzero pattern of the matrix is unchanged from a
+            // previous call, so that the PC performs only a numeric
+            // refactorization.
+            ierr = KSPSetOperators(ksp, mat, mat);    CHKERRABORT(sys.comm().get(), ierr);
+            ierr = KSPSetUp(ksp);                     CHKERRABORT(sys.comm().get(), ierr);
+        }
+        else
+            _assembly->residual_blocked(*sol, *res, sys, p);
+        
+        
+        START_LOG("KSPSolve", "ComplexSolve");
+        
+        // now solve
+        ierr = KSPSolve(ksp, res_vec, sol_vec);
+        
+        STOP_LOG("KSPSolve", "ComplexSolve");
+        
+        
+        // copy the solution to separate real and imaginary vectors
+        this->_extract_block_solution(*sol, p != nullptr);
+        
+        // let the user process the solution for this right-hand side
+        rhs.process_solution(i_rhs);
+    }
+    
+    STOP_LOG("solve_block_matrix_multiple_rhs()", "ComplexSolve");
+}
+
+
+
+
+void
+MAST::ComplexSolverBase::
+_extract_block_solution(libMesh::NumericVector<Real>& sol,
+                        bool if_sens) {
+    
+    libMesh::NumericVector<Real>
+    &sol_R = this->real_solution(if_sens),
+    &sol_I = this->imag_solution(if_sens);
+    
+    unsigned int
+    first = sol_R.first_local_index(),
+    last  = sol_R.last_local_index();
+    
+    for (unsigned int i=first; i<last; i++) {
+        sol_R.set(i, sol(  2*i));
+        sol_I.set(i, sol(2*i+1));
+    }
+    
+    sol_R.close();
+    sol_I.close();
+    sol.close();
+}
+
+
+
+void
+MAST::ComplexSolverBase::_init_block_matrix() {
+    
+    libmesh_assert(_assembly);
     
     // get reference to the system
     MAST::NonlinearSystem& sys =
@@ -388,12 +595,27 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     
     libMesh::DofMap& dof_map = sys.get_dof_map();
     
+    PetscErrorCode   ierr;
+    
     const PetscInt
     my_m = dof_map.n_dofs(),
     my_n = my_m,
     n_l  = dof_map.n_dofs_on_processor(sys.processor_id()),
     m_l  = n_l;
     
+    // the retained matrix is reused if the system size has not changed
+    if (_block_mat) {
+        
+        PetscInt m, n;
+        
+        ierr = MatGetSize(_block_mat, &m, &n);  CHKERRABORT(sys.comm().get(), ierr);
+        
+        if (m == 2*my_m && n == 2*my_n)
+            return;
+        
+        this->clear_block_matrix();
+    }
+    
     const std::vector<libMesh::dof_id_type>
     & n_nz       = dof_map.get_n_nz(),
     & n_oz       = dof_map.get_n_oz();
@@ -418,7 +640,6 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     
     
     // create the matrix
-    PetscErrorCode   ierr;
     Mat              mat;
     
     ierr = MatCreate(sys.comm().get(), &mat);                      CHKERRABORT(sys.comm().get(), ierr);
@@ -458,48 +679,17 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     ierr = MatCreateVecs(mat, &sol_vec, PETSC_NULL);               CHKERRABORT(sys.comm().get(), ierr);
     
     
-    std::auto_ptr<libMesh::SparseMatrix<Real> >
-    jac_mat(new libMesh::PetscMatrix<Real>(mat, sys.comm()));
+    _block_jac.reset(new libMesh::PetscMatrix<Real>(mat, sys.comm()));
+    _block_res_vec.reset(new libMesh::PetscVector<Real>(res_vec, sys.comm()));
+    _block_sol_vec.reset(new libMesh::PetscVector<Real>(sol_vec, sys.comm()));
     
-    std::auto_ptr<libMesh::NumericVector<Real> >
-    res(new libMesh::PetscVector<Real>(res_vec, sys.comm())),
-    sol(new libMesh::PetscVector<Real>(sol_vec, sys.comm()));
+    _block_mat = mat;
+    _block_res = res_vec;
+    _block_sol = sol_vec;
     
     
-    // if sensitivity analysis is requested, then set the complex solution in
-    // the solution vector
-    if (p) {
-        
-        // copy the solution to separate real and imaginary vectors
-        libMesh::NumericVector<Real>
-        &sol_R = this->real_solution(),
-        &sol_I = this->imag_solution();
-        
-        unsigned int
-        first = sol_R.first_local_index(),
-        last  = sol_I.last_local_index();
-        
-        for (unsigned int i=first; i<last; i++) {
-            
-            sol->set(  2*i, sol_R(i));
-            sol->set(2*i+1, sol_I(i));
-        }
-        
-        sol->close();
-    }
-    
-    
-    // assemble the matrix
-    _assembly->residual_and_jacobian_blocked(*sol,
-                                             *res,
-                                             *jac_mat,
-                                             sys,
-                                             p);
-    
-    
-    // now initialize the KSP and ask for solution.
+    // the KSP is created once and shared by all subsequent solves
     KSP        ksp;
-    PC         pc;
     
     // setup the KSP
     ierr = KSPCreate(sys.comm().get(), &ksp); CHKERRABORT(sys.comm().get(), ierr);
@@ -510,54 +700,7 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
         KSPSetOptionsPrefix(ksp, nm.c_str());
     }
     
-    ierr = KSPSetOperators(ksp, mat, mat);    CHKERRABORT(sys.comm().get(), ierr);
     ierr = KSPSetFromOptions(ksp);            CHKERRABORT(sys.comm().get(), ierr);
     
-    // setup the PC
-    ierr = KSPGetPC(ksp, &pc);                CHKERRABORT(sys.comm().get(), ierr);
-    ierr = PCSetFromOptions(pc);              CHKERRABORT(sys.comm().get(), ierr);
-    
-    
-    START_LOG("KSPSolve", "ComplexSolve");
-    
-    // now solve
-    ierr = KSPSolve(ksp, res_vec, sol_vec);
-
-    STOP_LOG("KSPSolve", "ComplexSolve");
-    
-    // evaluate the residual again
-    //_assembly->residual_and_jacobian_blocked(*sol,
-    //                                         *res,
-    //                                         *jac_mat,
-    //                                         sys);
-    
-    
-    // copy the solution to separate real and imaginary vectors
-    libMesh::NumericVector<Real>
-    &sol_R = this->real_solution(p != nullptr),
-    &sol_I = this->imag_solution(p != nullptr);
-    
-    unsigned int
-    first = sol_R.first_local_index(),
-    last  = sol_R.last_local_index();
-    
-    for (unsigned int i=first; i<last; i++) {
-        sol_R.set(i, (*sol)(  2*i));
-        sol_I.set(i, (*sol)(2*i+1));
-    }
-    
-    sol_R.close();
-    sol_I.close();
-    sol->close();
-    
-    ierr = KSPDestroy(&ksp);                  CHKERRABORT(sys.comm().get(), ierr);
-    ierr = MatDestroy(&mat);                  CHKERRABORT(sys.comm().get(), ierr);
-    ierr = VecDestroy(&res_vec);              CHKERRABORT(sys.comm().get(), ierr);
-    ierr = VecDestroy(&sol_vec);              CHKERRABORT(sys.comm().get(), ierr);
-    
-    STOP_LOG("solve_block_matrix()", "ComplexSolve");
+    _block_ksp = ksp;
 }
-
-
-
-
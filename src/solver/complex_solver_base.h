@@ -25,6 +25,11 @@
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
+#include "libmesh/sparse_matrix.h"
+
+// PETSc includes
+#include <petscmat.h>
+#include <petscksp.h>
 
 
 namespace MAST {
@@ -36,13 +41,42 @@ namespace MAST {
     class Parameter;
     
     /*!
-     *   uses a Gauss-Siedel method to solve the complex system of equations
-     *   for a system.
+     *   solves the complex system of equations for a system using the
+     *   real-equivalent 2x2 block form of the complex operator.
      */
     class ComplexSolverBase {
         
     public:
         
+        /*!
+         *   This class provides the interface to set up successive
+         *   right-hand sides for solve_block_matrix_multiple_rhs(), and
+         *   to process the solution of each.
+         */
+        class RHSUpdate {
+            
+        public:
+            
+            RHSUpdate() { }
+            
+            virtual ~RHSUpdate() { }
+            
+            /*!
+             *   initializes the excitation in the assembly for the
+             *   \par i^th right-hand side. For sensitivity solves, the
+             *   solution about which the sensitivity is computed is read
+             *   from real_solution() and imag_solution() after this call.
+             */
+            virtual void init_rhs(unsigned int i) = 0;
+            
+            /*!
+             *   called after the solution of the \par i^th right-hand side
+             *   has been copied to real_solution() and imag_solution().
+             */
+            virtual void process_solution(unsigned int i) = 0;
+        };
+        
+        
         /*!
          *  default constructor
          */
@@ -78,11 +112,21 @@ namespace MAST {
         
         
         /*!
-         *  solves the complex system of equations
+         *  solves the complex system of equations in a single solve of the
+         *  block system. This is the same as solve_block_matrix() without
+         *  a parameter.
          */
         virtual void solve();
 
         
+        /*!
+         *  solves the complex system of equations by alternating between
+         *  the real and imaginary parts until the complex residual is
+         *  below \p tol, or \p max_iters is reached.
+         */
+        virtual void solve_gauss_seidel();
+
+        
         /*!
          *  solves the complex system of equations using PCFieldSplit
          */
@@ -93,11 +137,27 @@ namespace MAST {
          *  solves the complex system of equations using block matrices. If 
          *  no argument is specified for \par p, then the system is solved. 
          *  Otherwise, the sensitivity of the system is solved with respect
-         *  to the parameter p
+         *  to the parameter p. The block matrix and the KSP are retained
+         *  between calls, so that successive solves, for example at
+         *  different frequencies, reuse the sparsity pattern and the
+         *  symbolic factorization of the operator.
          */
         virtual void solve_block_matrix(MAST::Parameter* p = nullptr);
 
         
+        /*!
+         *  solves the complex system of equations for \par n_rhs
+         *  right-hand sides that share the same operator. The block matrix
+         *  and the preconditioner are assembled and set up only once, and
+         *  only the residual is reassembled for each subsequent right-hand
+         *  side provided by \par rhs. \par p has the same meaning as in
+         *  solve_block_matrix().
+         */
+        virtual void solve_block_matrix_multiple_rhs(MAST::ComplexSolverBase::RHSUpdate& rhs,
+                                                     unsigned int n_rhs,
+                                                     MAST::Parameter* p = nullptr);
+
+        
         /*!
          *  @returns a reference to the real part of the solution. If 
          *  \par if_sens is true, the the sensitivity vector is returned. Note,
@@ -134,6 +194,13 @@ namespace MAST {
         const libMesh::NumericVector<Real>& imag_solution(bool if_sens=false) const;
 
 
+        /*!
+         *  destroys the block matrix, vectors and KSP retained between the
+         *  block solves. This is called when the assembly is cleared.
+         */
+        void clear_block_matrix();
+        
+
         Real tol;
         
         unsigned int max_iters;
@@ -141,6 +208,41 @@ namespace MAST {
     protected:
         
         
+        /*!
+         *   creates the block matrix, vectors and KSP for the system of the
+         *   current assembly, unless they already exist for a system of the
+         *   same size.
+         */
+        void _init_block_matrix();
+        
+        
+        /*!
+         *   copies the interleaved solution \p sol of the block system to
+         *   real_solution(if_sens) and imag_solution(if_sens)
+         */
+        void _extract_block_solution(libMesh::NumericVector<Real>& sol,
+                                     bool if_sens);
+        
+        
+        /*!
+         *   block matrix of the real-equivalent system, with the real and
+         *   imaginary components of each dof interleaved
+         */
+        Mat _block_mat;
+        
+        Vec _block_res, _block_sol;
+        
+        KSP _block_ksp;
+        
+        /*!
+         *   libMesh wrappers of the block matrix and vectors
+         */
+        std::auto_ptr<libMesh::SparseMatrix<Real> > _block_jac;
+        
+        std::auto_ptr<libMesh::NumericVector<Real> > _block_res_vec, _block_sol_vec;
+        
+        
+        
         /*!
          *   Associated ComplexAssembly object that provides the
          *   element level quantities
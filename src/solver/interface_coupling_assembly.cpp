@@ -0,0 +1,185 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "solver/interface_coupling_assembly.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "base/nonlinear_system.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/sparse_matrix.h"
+
+
+MAST::InterfaceCouplingAssembly::
+InterfaceCouplingAssembly(MAST::MultiphysicsNonlinearSolverBase& solver):
+_solver  (solver) {
+    
+}
+
+
+
+MAST::InterfaceCouplingAssembly::~InterfaceCouplingAssembly() {
+    
+}
+
+
+
+void
+MAST::InterfaceCouplingAssembly::
+add_coupled_dofs(unsigned int i,
+                 unsigned int j,
+                 const std::set<libMesh::dof_id_type>& rows,
+                 const std::set<libMesh::dof_id_type>& cols) {
+    
+    libmesh_assert_less(i, _solver.n_disciplines());
+    libmesh_assert_less(j, _solver.n_disciplines());
+    libmesh_assert_not_equal_to(i, j);
+    
+    CoupledDofs& dofs = _blocks[std::make_pair(i, j)];
+    
+    dofs.rows.insert(rows.begin(), rows.end());
+    dofs.cols.insert(cols.begin(), cols.end());
+    
+    // all processors probe the same columns, while each processor
+    // uses the rows that it owns
+    _solver.comm().set_union(dofs.rows);
+    _solver.comm().set_union(dofs.cols);
+}
+
+
+
+bool
+MAST::InterfaceCouplingAssembly::if_assemble_block(unsigned int i,
+                                                   unsigned int j) const {
+    
+    return _blocks.count(std::make_pair(i, j)) > 0;
+}
+
+
+
+void
+MAST::InterfaceCouplingAssembly::
+block_sparsity(unsigned int i,
+               unsigned int j,
+               std::vector<libMesh::numeric_index_type>& n_nz,
+               std::vector<libMesh::numeric_index_type>& n_oz) {
+    
+    std::map<std::pair<unsigned int, unsigned int>, CoupledDofs>::const_iterator
+    it = _blocks.find(std::make_pair(i, j));
+    libmesh_assert(it != _blocks.end());
+    
+    const libMesh::DofMap
+    &dof_map_i = _solver.get_system_assembly(i).system().get_dof_map(),
+    &dof_map_j = _solver.get_system_assembly(j).system().get_dof_map();
+    
+    const libMesh::dof_id_type
+    first_i = dof_map_i.first_dof(),
+    end_i   = dof_map_i.end_dof(),
+    first_j = dof_map_j.first_dof(),
+    end_j   = dof_map_j.end_dof();
+    
+    // number of coupled columns in the diagonal and off-diagonal parts
+    // of the local rows
+    libMesh::numeric_index_type
+    n_local_cols = 0;
+    
+    std::set<libMesh::dof_id_type>::const_iterator
+    dof_it  = it->second.cols.begin(),
+    dof_end = it->second.cols.end();
+    
+    for ( ; dof_it != dof_end; dof_it++)
+        if (*dof_it >= first_j && *dof_it < end_j)
+            n_local_cols++;
+    
+    n_nz.assign(end_i - first_i, 0);
+    n_oz.assign(end_i - first_i, 0);
+    
+    dof_it  = it->second.rows.lower_bound(first_i);
+    dof_end = it->second.rows.lower_bound(end_i);
+    
+    for ( ; dof_it != dof_end; dof_it++) {
+        
+        n_nz[*dof_it - first_i] = n_local_cols;
+        n_oz[*dof_it - first_i] = it->second.cols.size() - n_local_cols;
+    }
+}
+
+
+
+void
+MAST::InterfaceCouplingAssembly::
+block_jacobian(unsigned int i,
+               unsigned int j,
+               std::vector<libMesh::NumericVector<Real>*>& sol_vecs,
+               libMesh::SparseMatrix<Real>& J) {
+    
+    std::map<std::pair<unsigned int, unsigned int>, CoupledDofs>::const_iterator
+    it = _blocks.find(std::make_pair(i, j));
+    libmesh_assert(it != _blocks.end());
+    
+    MAST::NonlinearSystem
+    &sys_i = _solver.get_system_assembly(i).system(),
+    &sys_j = _solver.get_system_assembly(j).system();
+    
+    const libMesh::dof_id_type
+    first_i = sys_i.get_dof_map().first_dof(),
+    end_i   = sys_i.get_dof_map().end_dof(),
+    first_j = sys_j.get_dof_map().first_dof(),
+    end_j   = sys_j.get_dof_map().end_dof();
+    
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    dX (sys_j.solution->zero_clone().release()),
+    JdX(sys_i.solution->zero_clone().release());
+    
+    std::set<libMesh::dof_id_type>::const_iterator
+    col_it   = it->second.cols.begin(),
+    col_end  = it->second.cols.end(),
+    row_begin= it->second.rows.lower_bound(first_i),
+    row_end  = it->second.rows.lower_bound(end_i),
+    row_it;
+    
+    Real
+    v = 0.;
+    
+    // each column of the block is the product with the unit perturbation
+    // of the corresponding dof of the j^th discipline
+    for ( ; col_it != col_end; col_it++) {
+        
+        dX->zero();
+        if (*col_it >= first_j && *col_it < end_j)
+            dX->set(*col_it, 1.);
+        dX->close();
+        
+        sys_j.get_dof_map().enforce_constraints_exactly(sys_j, dX.get(),
+                                                        true /* homogeneous = true */);
+        
+        _solver.linearized_block_product(i, j, sol_vecs, *dX, *JdX);
+        
+        for (row_it = row_begin; row_it != row_end; row_it++) {
+            
+            v = (*JdX)(*row_it);
+            if (v != 0.)
+                J.set(*row_it, *col_it, v);
+        }
+    }
+}
+
@@ -0,0 +1,113 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__interface_coupling_assembly_h__
+#define __mast__interface_coupling_assembly_h__
+
+// C++ includes
+#include <map>
+#include <set>
+#include <vector>
+
+// MAST includes
+#include "solver/multiphysics_nonlinear_solver.h"
+
+// libMesh includes
+#include "libmesh/id_types.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Assembles the off-diagonal coupling blocks of a multiphysics
+     *   Jacobian from the matrix-free products of the solver. The dofs
+     *   of the i^th discipline that depend on the j^th discipline, and
+     *   the dofs of the j^th discipline that they depend on, are specified
+     *   for each block. This is the case for the dofs on the interface of
+     *   the fluid and structural meshes in an FSI analysis. Each column of
+     *   a block is obtained from one linearized product of the i^th
+     *   discipline, so the number of coupled columns should be small
+     *   compared to the size of the discipline.
+     */
+    class InterfaceCouplingAssembly:
+    public MAST::MultiphysicsNonlinearSolverBase::CouplingAssembly {
+        
+    public:
+        
+        InterfaceCouplingAssembly(MAST::MultiphysicsNonlinearSolverBase& solver);
+        
+        virtual ~InterfaceCouplingAssembly();
+        
+        
+        /*!
+         *   specifies that the block (i,j) couples the dofs \p rows of the
+         *   i^th discipline with the dofs \p cols of the j^th discipline.
+         *   Each processor may provide only the dofs of its elements, since
+         *   the dofs are combined from all processors. This must be called
+         *   on all processors.
+         */
+        void add_coupled_dofs(unsigned int i,
+                              unsigned int j,
+                              const std::set<libMesh::dof_id_type>& rows,
+                              const std::set<libMesh::dof_id_type>& cols);
+        
+        
+        virtual bool if_assemble_block(unsigned int i,
+                                       unsigned int j) const;
+        
+        
+        virtual void
+        block_sparsity(unsigned int i,
+                       unsigned int j,
+                       std::vector<libMesh::numeric_index_type>& n_nz,
+                       std::vector<libMesh::numeric_index_type>& n_oz);
+        
+        
+        virtual void
+        block_jacobian(unsigned int i,
+                       unsigned int j,
+                       std::vector<libMesh::NumericVector<Real>*>& sol_vecs,
+                       libMesh::SparseMatrix<Real>& J);
+        
+    protected:
+        
+        /*!
+         *   coupled rows and columns of a block
+         */
+        struct CoupledDofs {
+            
+            std::set<libMesh::dof_id_type>   rows;
+            std::set<libMesh::dof_id_type>   cols;
+        };
+        
+        /*!
+         *   solver that provides the linearized products
+         */
+        MAST::MultiphysicsNonlinearSolverBase&  _solver;
+        
+        /*!
+         *   coupled dofs of each assembled block (i,j)
+         */
+        std::map<std::pair<unsigned int, unsigned int>, CoupledDofs>  _blocks;
+    };
+}
+
+
+#endif // __mast__interface_coupling_assembly_h__
@@ -29,6 +29,9 @@
 #include "libmesh/petsc_matrix.h"
 #include "libmesh/petsc_vector.h"
 
+// PETSc includes
+#include <petsctime.h>
+
 
 //---------------------------------------------------------------
 // method for matrix vector multiplicaiton of the off-diagonal component y=Ax
@@ -71,6 +74,10 @@ __mast_multiphysics_petsc_mat_mult(Mat mat,Vec dx,Vec y) {
     
     ierr = SNESGetSolution(mat_ctx->snes, &x);              CHKERRABORT(solver->comm().get(), ierr);
 
+    // the localized solutions retained by the assemblies from previous
+    // products are reused unless the nonlinear solution has changed
+    solver->update_linearization_solution(x);
+    
     
     const unsigned int
     nd = solver->n_disciplines();
@@ -79,8 +86,7 @@ __mast_multiphysics_petsc_mat_mult(Mat mat,Vec dx,Vec y) {
     sol (nd);
     
     std::vector<libMesh::NumericVector<Real>*>
-    sys_sols (nd, nullptr),
-    sys_dsols(nd, nullptr);
+    sys_sols (nd, nullptr);
     
     
     //////////////////////////////////////////////////////////////////
@@ -97,45 +103,28 @@ __mast_multiphysics_petsc_mat_mult(Mat mat,Vec dx,Vec y) {
         // extract the subvector for this system
         ierr = VecGetSubVector( x, sys_is,  &sol[i]);      CHKERRABORT(solver->comm().get(), ierr);
 
-        // use the nonlinear sol of all disciplines, by the perturbed sol of only
-        // one should be nonzero.
         sys_sols[i]   = new libMesh::PetscVector<Real>( sol[i], sys.comm());
-        if (i == mat_ctx->j) {
-            sys_dsols[i]  = new libMesh::PetscVector<Real>(dx, sys.comm());
-            
-            // Enforce constraints (if any) exactly on the
-            // current_local_solution.  This is the solution vector that is
-            // actually used in the computation of the residual below, and is
-            // not locked by debug-enabled PETSc the way that "x" is.
-            sys.get_dof_map().enforce_constraints_exactly(sys, sys_dsols[i],
-                                                          true /* homogeneous = true */);
-        }
-        else
-            sys_dsols[i]  = sys_sols[i]->zero_clone().release();
     }
     
-    //////////////////////////////////////////////////////////////////
-    // initialize the data structures before calculation of residuals
-    //////////////////////////////////////////////////////////////////
-    if (solver->get_pre_residual_update_object())
-        solver->get_pre_residual_update_object()->update_at_perturbed_solution(sys_sols,
-                                                                               sys_dsols);
-    
     //////////////////////////////////////////////////////////////////
     // calculate the matrix-vector product
     //////////////////////////////////////////////////////////////////
     
     std::auto_ptr<libMesh::NumericVector<Real> >
-    res(new libMesh::PetscVector<Real>(y, solver->comm()));
+    dsol(new libMesh::PetscVector<Real>(dx, solver->comm())),
+    res (new libMesh::PetscVector<Real>( y, solver->comm()));
     
-    // system for this discipline
-    MAST::NonlinearSystem& sys = solver->get_system_assembly(mat_ctx->i).system();
-
-    solver->get_system_assembly(mat_ctx->i).linearized_jacobian_solution_product
-    (*sys_sols [mat_ctx->i],
-     *sys_dsols[mat_ctx->i],
-     *res,
-     sys);
+    // Enforce constraints (if any) exactly on the perturbation, which
+    // is not locked by debug-enabled PETSc the way that "x" is.
+    MAST::NonlinearSystem& sys_j = solver->get_system_assembly(mat_ctx->j).system();
+    sys_j.get_dof_map().enforce_constraints_exactly(sys_j, dsol.get(),
+                                                    true /* homogeneous = true */);
+    
+    solver->linearized_block_product(mat_ctx->i,
+                                     mat_ctx->j,
+                                     sys_sols,
+                                     *dsol,
+                                     *res);
     
     res->close();
     
@@ -144,15 +133,11 @@ __mast_multiphysics_petsc_mat_mult(Mat mat,Vec dx,Vec y) {
     //////////////////////////////////////////////////////////////////
     for (unsigned int i=0; i< nd; i++) {
         
-        // system for this discipline
-        MAST::NonlinearSystem& sys = solver->get_system_assembly(i).system();
-        
         // get the IS for this system
         IS sys_is = solver->index_sets()[i];
         
         // delete the NumericVector wrappers
         delete sys_sols[i];
-        delete sys_dsols[i];
         
         // now restore the subvectors
         ierr = VecRestoreSubVector(x, sys_is, &sol[i]);  CHKERRABORT(solver->comm().get(), ierr);
@@ -162,6 +147,72 @@ __mast_multiphysics_petsc_mat_mult(Mat mat,Vec dx,Vec y) {
 }
 
 
+//---------------------------------------------------------------
+// records the start time of a linear solve of a fieldsplit block
+PetscErrorCode
+__mast_multiphysics_block_pre_solve(KSP ksp, Vec b, Vec x, void* ctx) {
+    
+    PetscErrorCode ierr=0;
+    PetscLogDouble t;
+    
+    MAST::MultiphysicsNonlinearSolverBase::BlockSolveStatistics
+    *stats = static_cast<MAST::MultiphysicsNonlinearSolverBase::BlockSolveStatistics*>(ctx);
+    
+    ierr = PetscTime(&t);                      CHKERRQ(ierr);
+    stats->start_time = t;
+    
+    return ierr;
+}
+
+
+
+//---------------------------------------------------------------
+// adds the iterations and wall time of a linear solve of a fieldsplit
+// block to its statistics
+PetscErrorCode
+__mast_multiphysics_block_post_solve(KSP ksp, Vec b, Vec x, void* ctx) {
+    
+    PetscErrorCode ierr=0;
+    PetscLogDouble t;
+    PetscInt       its;
+    
+    MAST::MultiphysicsNonlinearSolverBase::BlockSolveStatistics
+    *stats = static_cast<MAST::MultiphysicsNonlinearSolverBase::BlockSolveStatistics*>(ctx);
+    
+    ierr = PetscTime(&t);                      CHKERRQ(ierr);
+    ierr = KSPGetIterationNumber(ksp, &its);   CHKERRQ(ierr);
+    
+    stats->n_solves++;
+    stats->n_iterations += its;
+    stats->wall_time    += t - stats->start_time;
+    
+    return ierr;
+}
+
+
+
+//---------------------------------------------------------------
+// called before each solve of the coupled linear system. The sub-KSPs
+// of the fieldsplit, and of the Schur complement in particular, exist
+// only after the preconditioner has been setup for the new Jacobian.
+PetscErrorCode
+__mast_multiphysics_ksp_pre_solve(KSP ksp, Vec b, Vec x, void* ctx) {
+    
+    PetscErrorCode ierr=0;
+    PC             pc;
+    
+    MAST::MultiphysicsNonlinearSolverBase
+    *solver = static_cast<MAST::MultiphysicsNonlinearSolverBase*>(ctx);
+    
+    ierr = KSPSetUp(ksp);                      CHKERRQ(ierr);
+    ierr = KSPGetPC(ksp, &pc);                 CHKERRQ(ierr);
+    solver->attach_block_monitors(pc);
+    
+    return ierr;
+}
+
+
+
 //---------------------------------------------------------------
 // this function is called by PETSc to evaluate the residual at X
 PetscErrorCode
@@ -360,6 +411,38 @@ __mast_multiphysics_petsc_snes_jacobian(SNES snes, Vec x, Mat jac, Mat pc, void
         sys.matrix->close();
     }
 
+    //////////////////////////////////////////////////////////////////
+    // calculate the assembled coupling blocks
+    //////////////////////////////////////////////////////////////////
+    MAST::MultiphysicsNonlinearSolverBase::CouplingAssembly
+    *coupling = solver->get_coupling_assembly();
+    
+    // the products used by the coupling assembly reuse the localized
+    // solutions of the disciplines at x
+    if (coupling)
+        solver->update_linearization_solution(x);
+    
+    for (unsigned int i=0; i< nd; i++)
+        for (unsigned int j=0; j< nd; j++) {
+            
+            libMesh::PetscMatrix<Real>
+            *m = (i != j)? solver->coupling_matrix(i, j) : nullptr;
+            
+            if (m) {
+                
+                libmesh_assert(coupling);
+                
+                // the previous block may have left the update object at a
+                // perturbed solution
+                if (solver->get_pre_residual_update_object())
+                    solver->get_pre_residual_update_object()->update_at_solution(sys_sols);
+                
+                m->zero();
+                coupling->block_jacobian(i, j, sys_sols, *m);
+                m->close();
+            }
+        }
+    
     //////////////////////////////////////////////////////////////////
     // resotre the subvectors
     //////////////////////////////////////////////////////////////////
@@ -380,6 +463,11 @@ __mast_multiphysics_petsc_snes_jacobian(SNES snes, Vec x, Mat jac, Mat pc, void
     ierr = MatAssemblyBegin(jac, MAT_FINAL_ASSEMBLY);  CHKERRABORT(solver->comm().get(), ierr);
     ierr = MatAssemblyEnd(jac, MAT_FINAL_ASSEMBLY);    CHKERRABORT(solver->comm().get(), ierr);
     
+    if (pc != jac) {
+        
+        ierr = MatAssemblyBegin(pc, MAT_FINAL_ASSEMBLY);  CHKERRABORT(solver->comm().get(), ierr);
+        ierr = MatAssemblyEnd(pc, MAT_FINAL_ASSEMBLY);    CHKERRABORT(solver->comm().get(), ierr);
+    }
     
     return ierr;
 }
@@ -399,7 +487,12 @@ _update                       (nullptr),
 _discipline_assembly          (n, nullptr),
 _is                           (_n_disciplines, PETSC_NULL),
 _sub_mats                     (_n_disciplines*_n_disciplines, PETSC_NULL),
-_n_dofs                       (0) {
+_n_dofs                       (0),
+_coupling                     (nullptr),
+_coupling_type                (MAST::MultiphysicsNonlinearSolverBase::MATRIX_FREE_COUPLING),
+_pc_mat                       (PETSC_NULL),
+_fieldsplit_type              (MAST::MultiphysicsNonlinearSolverBase::FIELDSPLIT_FROM_OPTIONS),
+_sol_state                    (-1) {
     
 }
 
@@ -445,6 +538,190 @@ get_system_assembly(unsigned int i) {
 
 
 
+MAST::MultiphysicsNonlinearSolverBase::ZeroPerturbationScope::
+ZeroPerturbationScope(MAST::MultiphysicsNonlinearSolverBase& solver):
+_solver(solver) {
+    
+    libmesh_assert(_solver._zero_dsols.empty());
+    
+    _solver._zero_dsols.resize(_solver._n_disciplines, nullptr);
+    
+    for (unsigned int i=0; i<_solver._n_disciplines; i++) {
+        
+        _solver._zero_dsols[i] =
+        _solver._discipline_assembly[i]->system().solution->zero_clone().release();
+        _solver._discipline_assembly[i]->set_retain_localized_solution(true);
+    }
+}
+
+
+
+MAST::MultiphysicsNonlinearSolverBase::ZeroPerturbationScope::
+~ZeroPerturbationScope() {
+    
+    for (unsigned int i=0; i<_solver._zero_dsols.size(); i++) {
+        
+        _solver._discipline_assembly[i]->set_retain_localized_solution(false);
+        delete _solver._zero_dsols[i];
+    }
+    
+    _solver._zero_dsols.clear();
+}
+
+
+
+libMesh::NumericVector<Real>&
+MAST::MultiphysicsNonlinearSolverBase::zero_perturbation(unsigned int i) {
+    
+    libmesh_assert_less(i, _zero_dsols.size());
+    libmesh_assert(_zero_dsols[i]);
+    
+    return *_zero_dsols[i];
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::update_linearization_solution(Vec x) {
+    
+    PetscErrorCode   ierr;
+    PetscObjectState state;
+    
+    ierr = PetscObjectStateGet((PetscObject)x, &state);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    if (state == _sol_state)
+        return;
+    
+    for (unsigned int i=0; i<_n_disciplines; i++)
+        _discipline_assembly[i]->clear_localized_solution();
+    
+    _sol_state = state;
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::
+linearized_block_product(unsigned int i,
+                         unsigned int j,
+                         std::vector<libMesh::NumericVector<Real>*>& sol_vecs,
+                         libMesh::NumericVector<Real>& dX_j,
+                         libMesh::NumericVector<Real>& JdX_i) {
+
+    libmesh_assert_less(i, _n_disciplines);
+    libmesh_assert_less(j, _n_disciplines);
+    libmesh_assert_equal_to(sol_vecs.size(), _n_disciplines);
+
+    // use the nonlinear sol of all disciplines, but the perturbed sol of
+    // only the j^th discipline is nonzero.
+    std::vector<libMesh::NumericVector<Real>*>
+    dsol_vecs(_n_disciplines, nullptr);
+
+    for (unsigned int k=0; k<_n_disciplines; k++)
+        dsol_vecs[k] = (k == j)? &dX_j : &this->zero_perturbation(k);
+
+    // initialize the data structures before calculation of residuals
+    if (_update)
+        _update->update_at_perturbed_solution(sol_vecs, dsol_vecs);
+
+    MAST::NonlinearImplicitAssembly& assembly = *_discipline_assembly[i];
+
+    assembly.linearized_jacobian_solution_product(*sol_vecs [i],
+                                                  *dsol_vecs[i],
+                                                  JdX_i,
+                                                  assembly.system());
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::
+set_coupling_assembly(MAST::MultiphysicsNonlinearSolverBase::CouplingAssembly& coupling,
+                      MAST::MultiphysicsNonlinearSolverBase::CouplingJacobianType t) {
+    
+    _coupling      = &coupling;
+    _coupling_type = t;
+}
+
+
+
+libMesh::PetscMatrix<Real>*
+MAST::MultiphysicsNonlinearSolverBase::coupling_matrix(unsigned int i,
+                                                       unsigned int j) {
+    
+    libmesh_assert_less(i, _n_disciplines);
+    libmesh_assert_less(j, _n_disciplines);
+    
+    if (_coupling_mats.empty())
+        return nullptr;
+    
+    return _coupling_mats[i*_n_disciplines+j];
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::attach_block_monitors(PC pc) {
+    
+    PetscErrorCode ierr;
+    PetscBool      flg;
+    PetscInt       n_ksp = 0;
+    KSP           *sub_ksp = PETSC_NULL;
+    
+    ierr = PetscObjectTypeCompare((PetscObject)pc, PCFIELDSPLIT, &flg);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    if (!flg)
+        return;
+    
+    ierr = PCFieldSplitGetSubKSP(pc, &n_ksp, &sub_ksp);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    // the statistics are the contexts of the monitors, so the vector is
+    // resized only if the number of blocks changes
+    if (static_cast<PetscInt>(_block_stats.size()) != n_ksp)
+        _block_stats.resize(n_ksp);
+    
+    for (PetscInt i=0; i<n_ksp; i++) {
+        
+        ierr = KSPSetPreSolve(sub_ksp[i],
+                              __mast_multiphysics_block_pre_solve,
+                              &_block_stats[i]);
+        CHKERRABORT(this->comm().get(), ierr);
+        ierr = KSPSetPostSolve(sub_ksp[i],
+                               __mast_multiphysics_block_post_solve,
+                               &_block_stats[i]);
+        CHKERRABORT(this->comm().get(), ierr);
+    }
+    
+    ierr = PetscFree(sub_ksp);
+    CHKERRABORT(this->comm().get(), ierr);
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::_set_fieldsplit_is(PC pc) {
+    
+    PetscErrorCode ierr;
+    std::string    nm;
+    const bool     sys_name = libMesh::on_command_line("--solver_system_names");
+    
+    for (unsigned int i=0; i<_n_disciplines; i++) {
+        
+        if (sys_name) {
+            
+            nm = _discipline_assembly[i]->system().name();
+            ierr = PCFieldSplitSetIS(pc, nm.c_str(), _is[i]); CHKERRABORT(this->comm().get(), ierr);
+        }
+        else
+            ierr = PCFieldSplitSetIS(pc, nullptr, _is[i]);CHKERRABORT(this->comm().get(), ierr);
+    }
+}
+
+
+
 void
 MAST::MultiphysicsNonlinearSolverBase::solve() {
     
@@ -477,7 +754,15 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
     
     
     // all diagonal blocks use the system matrcices, while shell matrices
-    // are created for the off-diagonal terms.
+    // are created for the off-diagonal terms, unless they are replaced
+    // by the assembled coupling blocks.
+    const bool
+    if_coupling_mats = (_coupling &&
+                        _coupling_type != MAST::MultiphysicsNonlinearSolverBase::MATRIX_FREE_COUPLING),
+    if_coupling_jac  = (_coupling &&
+                        _coupling_type == MAST::MultiphysicsNonlinearSolverBase::ASSEMBLED_COUPLING);
+    
+    _coupling_mats.resize(_n_disciplines*_n_disciplines, nullptr);
     _n_dofs = 0.;
     for (unsigned int i=0; i<_n_disciplines; i++) {
         
@@ -505,6 +790,29 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
                 mat_j_m    = sys_j.get_dof_map().n_dofs(),
                 mat_j_n_l  = sys_j.get_dof_map().n_dofs_on_processor(sys.processor_id());
                 
+                if (if_coupling_mats && _coupling->if_assemble_block(i, j)) {
+                    
+                    std::vector<libMesh::numeric_index_type>
+                    n_nz,
+                    n_oz;
+                    
+                    _coupling->block_sparsity(i, j, n_nz, n_oz);
+                    libmesh_assert_equal_to(static_cast<PetscInt>(n_nz.size()), mat_i_n_l);
+                    libmesh_assert_equal_to(static_cast<PetscInt>(n_oz.size()), mat_i_n_l);
+                    
+                    libMesh::PetscMatrix<Real>
+                    *m = new libMesh::PetscMatrix<Real>(this->comm());
+                    m->init(mat_i_m, mat_j_m, mat_i_n_l, mat_j_n_l, n_nz, n_oz);
+                    _coupling_mats[i*_n_disciplines+j] = m;
+                    
+                    if (if_coupling_jac) {
+                        
+                        // the assembled block replaces the shell matrix
+                        _sub_mats[i*_n_disciplines+j] = m->mat();
+                        continue;
+                    }
+                }
+                
                 // the off-diagonal matrix
                 ierr = MatCreateShell(this->comm().get(),
                                       mat_i_n_l,
@@ -563,6 +871,33 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
     ierr  =    MatNestGetISs(_mat, &_is[0], PETSC_NULL);
     CHKERRABORT(this->comm().get(), ierr);
     
+    // the preconditioning matrix uses the assembled coupling blocks, while
+    // the Jacobian uses the matrix-free products. The coupling blocks that
+    // are not assembled are zero in the preconditioning matrix.
+    if (if_coupling_mats && !if_coupling_jac) {
+        
+        std::vector<Mat>
+        pc_sub_mats(_n_disciplines*_n_disciplines, PETSC_NULL);
+        
+        for (unsigned int i=0; i<_n_disciplines; i++)
+            for (unsigned int j=0; j<_n_disciplines; j++) {
+                
+                if (i == j)
+                    pc_sub_mats[i*_n_disciplines+j] = _sub_mats[i*_n_disciplines+j];
+                else if (_coupling_mats[i*_n_disciplines+j])
+                    pc_sub_mats[i*_n_disciplines+j] = _coupling_mats[i*_n_disciplines+j]->mat();
+            }
+        
+        ierr = MatCreateNest(this->comm().get(),
+                             _n_disciplines, _is.data(),
+                             _n_disciplines, _is.data(),
+                             &pc_sub_mats[0],
+                             &_pc_mat);
+        CHKERRABORT(this->comm().get(), ierr);
+    }
+    else
+        _pc_mat = _mat;
+    
     //////////////////////////////////////////////////////////////////////
     // setup the vector for solution
     //////////////////////////////////////////////////////////////////////
@@ -639,7 +974,7 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
                             this);
     ierr = SNESSetJacobian(snes,
                            _mat,
-                           _mat,
+                           _pc_mat,
                            __mast_multiphysics_petsc_snes_jacobian,
                            this);
     
@@ -652,39 +987,101 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
     
     
     
-    // setup the ksp
+    // setup the ksp and pc. A fieldsplit configuration set for this solver
+    // is applied before the options, so that it can be modified from the
+    // command line.
     ierr = SNESGetKSP (snes, &ksp);                   CHKERRABORT(this->comm().get(), ierr);
-    ierr = SNESSetFromOptions(snes);                  CHKERRABORT(this->comm().get(), ierr);
-    
-    
-    
-    // setup the pc
     ierr = KSPGetPC(ksp, &pc);                        CHKERRABORT(this->comm().get(), ierr);
     
-    for (unsigned int i=0; i<_n_disciplines; i++) {
+    if (_fieldsplit_type != MAST::MultiphysicsNonlinearSolverBase::FIELDSPLIT_FROM_OPTIONS) {
         
-        if (sys_name) {
-            
-            nm = _discipline_assembly[i]->system().name();
-            ierr = PCFieldSplitSetIS(pc, nm.c_str(), _is[i]); CHKERRABORT(this->comm().get(), ierr);
+        ierr = PCSetType(pc, PCFIELDSPLIT);           CHKERRABORT(this->comm().get(), ierr);
+        this->_set_fieldsplit_is(pc);
+        
+        switch (_fieldsplit_type) {
+                
+            case MAST::MultiphysicsNonlinearSolverBase::BLOCK_GAUSS_SEIDEL_FIELDSPLIT: {
+                
+                ierr = PCFieldSplitSetType(pc, PC_COMPOSITE_MULTIPLICATIVE);
+                CHKERRABORT(this->comm().get(), ierr);
+            }
+                break;
+                
+            case MAST::MultiphysicsNonlinearSolverBase::SCHUR_FIELDSPLIT: {
+                
+                // the Schur complement is defined for a 2x2 block system
+                libmesh_assert_equal_to(_n_disciplines, 2);
+                
+                // the approximation A11 - A10 diag(A00)^-1 A01 needs both
+                // coupling blocks in the preconditioning matrix.
+                const bool
+                if_selfp = _coupling_mats[1] && _coupling_mats[2];
+                
+                ierr = PCFieldSplitSetType(pc, PC_COMPOSITE_SCHUR);
+                CHKERRABORT(this->comm().get(), ierr);
+                ierr = PCFieldSplitSetSchurFactType(pc, PC_FIELDSPLIT_SCHUR_FACT_FULL);
+                CHKERRABORT(this->comm().get(), ierr);
+                ierr = PCFieldSplitSetSchurPre(pc,
+                                               if_selfp?
+                                               PC_FIELDSPLIT_SCHUR_PRE_SELFP:
+                                               PC_FIELDSPLIT_SCHUR_PRE_A11,
+                                               PETSC_NULL);
+                CHKERRABORT(this->comm().get(), ierr);
+            }
+                break;
+                
+            default:
+                libmesh_error();
         }
-        else
-            ierr = PCFieldSplitSetIS(pc, nullptr, _is[i]);CHKERRABORT(this->comm().get(), ierr);
     }
     
+    ierr = SNESSetFromOptions(snes);                  CHKERRABORT(this->comm().get(), ierr);
+    
+    if (_fieldsplit_type == MAST::MultiphysicsNonlinearSolverBase::FIELDSPLIT_FROM_OPTIONS)
+        this->_set_fieldsplit_is(pc);
+    
+    // the statistics of the fieldsplit blocks are recorded by monitors
+    // attached before each linear solve
+    _block_stats.clear();
+    ierr = KSPSetPreSolve(ksp, __mast_multiphysics_ksp_pre_solve, this);
+    CHKERRABORT(this->comm().get(), ierr);
+    
 
     //ierr = SNESSetSolution(snes, _sol);
     //this->verify_gateaux_derivatives(snes);
     
     //////////////////////////////////////////////////////////////////////
-    // now, solve
+    // the matrix-free products of the off-diagonal blocks use a zero
+    // perturbation for the disciplines other than the perturbed one, and
+    // reuse the localized solution of each discipline until the nonlinear
+    // solution changes.
     //////////////////////////////////////////////////////////////////////
-    START_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
+    _sol_state = -1;
     
-    // now solve
-    ierr = SNESSolve(snes, PETSC_NULL, _sol);
+    {
+        MAST::MultiphysicsNonlinearSolverBase::ZeroPerturbationScope
+        zero_dsols(*this);
+        
+        //////////////////////////////////////////////////////////////////
+        // now, solve
+        //////////////////////////////////////////////////////////////////
+        START_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
+        
+        // now solve
+        ierr = SNESSolve(snes, PETSC_NULL, _sol);
+        CHKERRABORT(this->comm().get(), ierr);
+        
+        STOP_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
+    }
     
-    STOP_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
+    // write the statistics of the fieldsplit blocks
+    for (unsigned int i=0; i<_block_stats.size(); i++) {
+        
+        libMesh::out
+        << "FieldSplit block " << i << " : solves = " << _block_stats[i].n_solves
+        << " , iterations = " << _block_stats[i].n_iterations
+        << " , wall time = " << _block_stats[i].wall_time << " s" << std::endl;
+    }
     
     
     //////////////////////////////////////////////////////////////////////
@@ -729,12 +1126,27 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
     
     // destroy the Petsc contexts
     ierr = SNESDestroy(&snes);                        CHKERRABORT(this->comm().get(), ierr);
+    if (_pc_mat != _mat) {
+        
+        ierr = MatDestroy(&_pc_mat);                   CHKERRABORT(this->comm().get(), ierr);
+    }
+    _pc_mat = PETSC_NULL;
+    
     for (unsigned int i=0; i<_n_disciplines; i++)
         for (unsigned int j=0; j<_n_disciplines; j++)
             if (i != j) {
-                ierr = MatDestroy(&_sub_mats[i*_n_disciplines+j]);
-                CHKERRABORT(this->comm().get(), ierr);
+                
+                // assembled blocks used in the Jacobian are owned by the
+                // coupling matrices
+                if (!if_coupling_jac || !_coupling_mats[i*_n_disciplines+j]) {
+                    ierr = MatDestroy(&_sub_mats[i*_n_disciplines+j]);
+                    CHKERRABORT(this->comm().get(), ierr);
+                }
+                _sub_mats[i*_n_disciplines+j] = PETSC_NULL;
+                
+                delete _coupling_mats[i*_n_disciplines+j];
             }
+    _coupling_mats.clear();
     
     ierr = MatDestroy(&_mat);                          CHKERRABORT(this->comm().get(), ierr);
     ierr = VecDestroy(&_sol);                          CHKERRABORT(this->comm().get(), ierr);
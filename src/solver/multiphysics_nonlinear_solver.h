@@ -30,10 +30,17 @@
 // libMesh includes
 #include "libmesh/parallel_object.h"
 #include "libmesh/numeric_vector.h"
+#include "libmesh/sparse_matrix.h"
 
 // PETSc includes
 #include <petscmat.h>
 #include <petscsnes.h>
+#include <petscpc.h>
+
+
+namespace libMesh {
+    template <typename T> class PetscMatrix;
+}
 
 
 namespace MAST {
@@ -174,11 +181,224 @@ namespace MAST {
         }
 
         
+        /*!
+         *    Interface for assembly of the off-diagonal coupling blocks of
+         *    the multiphysics Jacobian. The block (i,j) is the derivative of
+         *    the residual of the i^th discipline with respect to the
+         *    solution of the j^th discipline.
+         */
+        class CouplingAssembly {
+            
+        public:
+            
+            virtual ~CouplingAssembly() {}
+            
+            /*!
+             *    @returns true if this object assembles the coupling block
+             *    (i,j). Blocks that are not assembled are only available
+             *    through the matrix-free products.
+             */
+            virtual bool if_assemble_block(unsigned int i,
+                                           unsigned int j) const = 0;
+            
+            /*!
+             *    sets the number of nonzeros in each local row of block
+             *    (i,j) in \p n_nz for the columns local to this processor,
+             *    and in \p n_oz for the remaining columns.
+             */
+            virtual void
+            block_sparsity(unsigned int i,
+                           unsigned int j,
+                           std::vector<libMesh::numeric_index_type>& n_nz,
+                           std::vector<libMesh::numeric_index_type>& n_oz) = 0;
+            
+            /*!
+             *    assembles block (i,j) in \p J for the solutions in
+             *    \p sol_vecs. \p J is zeroed before this call. The
+             *    PreResidualUpdate object, if provided, has already been
+             *    updated for \p sol_vecs.
+             */
+            virtual void
+            block_jacobian(unsigned int i,
+                           unsigned int j,
+                           std::vector<libMesh::NumericVector<Real>*>& sol_vecs,
+                           libMesh::SparseMatrix<Real>& J) = 0;
+        };
+        
+        
+        /*!
+         *    defines the use of the coupling blocks assembled by the
+         *    CouplingAssembly object
+         */
+        enum CouplingJacobianType {
+            MATRIX_FREE_COUPLING,           // shell matrices only
+            ASSEMBLED_COUPLING_PC,          // assembled blocks in the preconditioner
+            ASSEMBLED_COUPLING              // assembled blocks in the Jacobian
+        };
+        
+        
+        /*!
+         *   assigns the object that assembles the off-diagonal coupling
+         *   blocks, and the use of these blocks specified by \p t.
+         *   With \p ASSEMBLED_COUPLING_PC the Jacobian uses the exact
+         *   matrix-free products, while the preconditioning matrix uses
+         *   the assembled blocks. With \p ASSEMBLED_COUPLING the assembled
+         *   blocks replace the matrix-free products. In both cases the
+         *   blocks not assembled by \p coupling use the matrix-free
+         *   products in the Jacobian and are zero in the preconditioning
+         *   matrix.
+         */
+        void
+        set_coupling_assembly
+        (MAST::MultiphysicsNonlinearSolverBase::CouplingAssembly& coupling,
+         MAST::MultiphysicsNonlinearSolverBase::CouplingJacobianType t);
+        
+        
+        /*!
+         *   @returns a pointer to the coupling assembly object
+         */
+        MAST::MultiphysicsNonlinearSolverBase::CouplingAssembly*
+        get_coupling_assembly() {
+            
+            return _coupling;
+        }
+        
+        
+        /*!
+         *   @returns the assembled coupling block (i,j), or nullptr if the
+         *   block is not assembled. This is available only during solve().
+         */
+        libMesh::PetscMatrix<Real>* coupling_matrix(unsigned int i,
+                                                    unsigned int j);
+        
+        
+        /*!
+         *   configurations of PCFieldSplit set up by this solver
+         */
+        enum FieldSplitType {
+            FIELDSPLIT_FROM_OPTIONS,         // only the index sets are provided
+            BLOCK_GAUSS_SEIDEL_FIELDSPLIT,   // multiplicative fieldsplit
+            SCHUR_FIELDSPLIT                 // full Schur-complement factorization
+        };
+        
+        
+        /*!
+         *   sets the fieldsplit preconditioner configuration. The Schur
+         *   complement is available only for two disciplines, and uses
+         *   the assembled coupling blocks to precondition the Schur
+         *   complement if both are available. Options provided on the
+         *   command line take precedence over this configuration.
+         */
+        void set_fieldsplit_type(MAST::MultiphysicsNonlinearSolverBase::FieldSplitType t) {
+            
+            _fieldsplit_type = t;
+        }
+        
+        
+        /*!
+         *    statistics of the linear solves of a fieldsplit block
+         */
+        struct BlockSolveStatistics {
+            
+            BlockSolveStatistics():
+            n_solves      (0),
+            n_iterations  (0),
+            wall_time     (0.),
+            start_time    (0.)
+            { }
+            
+            unsigned int   n_solves;
+            unsigned int   n_iterations;
+            Real           wall_time;
+            Real           start_time;
+        };
+        
+        
+        /*!
+         *   @returns the statistics of the linear solves of each fieldsplit
+         *   block during the last call to solve(). For the Schur-complement
+         *   fieldsplit the second block is the Schur complement.
+         */
+        const std::vector<MAST::MultiphysicsNonlinearSolverBase::BlockSolveStatistics>&
+        block_statistics() const {
+            
+            return _block_stats;
+        }
+        
+        
+        /*!
+         *   attaches the monitors that record the block statistics to the
+         *   sub-KSPs of \p pc, if it is a fieldsplit preconditioner.
+         */
+        void attach_block_monitors(PC pc);
+        
+        
         void verify_gateaux_derivatives(SNES snes);
         
         
+        /*!
+         *   @returns the zero vector used as the perturbation of the
+         *   i^th discipline in the matrix-free products of the off-diagonal
+         *   blocks in which the i^th discipline is not perturbed. This is
+         *   available only during solve().
+         */
+        libMesh::NumericVector<Real>& zero_perturbation(unsigned int i);
+        
+        
+        /*!
+         *   called with the current nonlinear solution \p x before the
+         *   matrix-free products of the off-diagonal blocks. If \p x has
+         *   been modified since the last call, the localized solutions
+         *   retained by the discipline assemblies are cleared.
+         */
+        void update_linearization_solution(Vec x);
+
+
+        /*!
+         *   calculates in \p JdX_i the product of the off-diagonal block
+         *   (i,j) with the perturbation \p dX_j of the j^th discipline,
+         *   linearized about the discipline solutions in \p sol_vecs. The
+         *   PreResidualUpdate object, if provided, is updated with the
+         *   perturbed solution. This is available only during solve().
+         */
+        void
+        linearized_block_product(unsigned int i,
+                                 unsigned int j,
+                                 std::vector<libMesh::NumericVector<Real>*>& sol_vecs,
+                                 libMesh::NumericVector<Real>& dX_j,
+                                 libMesh::NumericVector<Real>& JdX_i);
+
+
     protected:
         
+        
+        /*!
+         *   creates the zero perturbations of the disciplines and tells the
+         *   discipline assemblies to retain their localized solutions for
+         *   the lifetime of this object. Both are reverted on destruction,
+         *   so that they are cleared on all exits from solve(), including
+         *   errors.
+         */
+        class ZeroPerturbationScope {
+            
+        public:
+            
+            ZeroPerturbationScope(MAST::MultiphysicsNonlinearSolverBase& solver);
+            
+            ~ZeroPerturbationScope();
+            
+        protected:
+            
+            MAST::MultiphysicsNonlinearSolverBase& _solver;
+        };
+        
+        
+        /*!
+         *   provides the index sets of the disciplines to the fieldsplit
+         *   preconditioner \p pc
+         */
+        void _set_fieldsplit_is(PC pc);
+        
 
         /*!
          *  name of this multiphysics solution
@@ -208,6 +428,40 @@ namespace MAST {
 
         Mat              _mat;
         Vec              _sol, _res;
+        
+        /*!
+         *   zero perturbations of each discipline used in the matrix-free
+         *   products of the off-diagonal blocks
+         */
+        std::vector<libMesh::NumericVector<Real>*> _zero_dsols;
+        
+        /*!
+         *   object that assembles the coupling blocks, and its use
+         */
+        MAST::MultiphysicsNonlinearSolverBase::CouplingAssembly  *_coupling;
+        
+        MAST::MultiphysicsNonlinearSolverBase::CouplingJacobianType _coupling_type;
+        
+        /*!
+         *   assembled coupling blocks in row-major ordering, and the
+         *   preconditioning matrix that uses them
+         */
+        std::vector<libMesh::PetscMatrix<Real>*> _coupling_mats;
+        
+        Mat              _pc_mat;
+        
+        /*!
+         *   fieldsplit configuration and the statistics of its blocks
+         */
+        MAST::MultiphysicsNonlinearSolverBase::FieldSplitType _fieldsplit_type;
+        
+        std::vector<MAST::MultiphysicsNonlinearSolverBase::BlockSolveStatistics> _block_stats;
+        
+        /*!
+         *   PETSc object state of the nonlinear solution for which the
+         *   assemblies retain the localized solutions
+         */
+        PetscObjectState _sol_state;
 
     };
 }
@@ -46,8 +46,12 @@ MAST::SecondOrderNewmarkTransientSolver::solve() {
     // make sure that the system has been specified
     libmesh_assert_msg(_system, "System pointer is nullptr.");
     
-    // ask the Newton solver to solve for the system solution
-    _system->solve();
+    // ask the Newton solver to solve for the system solution, unless the
+    // Jacobian from a previous iterate is to be reused
+    if (_jac_update == MAST::TransientSolverBase::FULL_NEWTON)
+        _system->solve();
+    else
+        this->_solve_with_lagged_jacobian();
     
 }
 
@@ -107,6 +107,15 @@ namespace MAST {
             return 2;
         }
         
+        /*!
+         *    adds the Newmark parameters, which scale the Jacobian
+         *    contributions of the time derivatives
+         */
+        virtual void _jacobian_parameters(std::vector<Real>& p) const {
+            p.push_back(beta);
+            p.push_back(gamma);
+        }
+        
         /*!
          *    provides the element with the transient data for calculations
          */
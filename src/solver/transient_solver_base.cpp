@@ -28,12 +28,24 @@
 #include "libmesh/dof_map.h"
 #include "libmesh/sparse_matrix.h"
 #include "libmesh/linear_solver.h"
+#include "libmesh/petsc_matrix.h"
 
 
 
 MAST::TransientSolverBase::TransientSolverBase():
 dt(0.),
+nonlinear_rel_tol(1.e-8),
+nonlinear_abs_tol(1.e-10),
+max_nonlinear_iters(20),
+lagged_jacobian_rate(0.5),
+max_lagged_iters(10),
 _first_step(true),
+_jac_update(MAST::TransientSolverBase::FULL_NEWTON),
+_if_jac_current(false),
+_jac_dt(0.),
+_jac_matrix_state(0),
+_n_lagged_iters(0),
+_linear_solver(nullptr),
 _assembly(nullptr),
 _system(nullptr),
 _if_highest_derivative_solution(false) {
@@ -134,6 +146,13 @@ MAST::TransientSolverBase::clear_assembly() {
         }
     }
     
+    if (_linear_solver) {
+        
+        _system->release_linear_solver(_linear_solver);
+        _linear_solver = nullptr;
+    }
+    _if_jac_current = false;
+    
     _assembly   = nullptr;
     _system     = nullptr;
     _first_step = true;
@@ -141,6 +160,151 @@ MAST::TransientSolverBase::clear_assembly() {
 
 
 
+void
+MAST::TransientSolverBase::
+set_jacobian_update(MAST::TransientSolverBase::JacobianUpdateType t) {
+    
+    _jac_update     = t;
+    _if_jac_current = false;
+}
+
+
+
+void
+MAST::TransientSolverBase::_solve_with_lagged_jacobian() {
+    
+    // make sure that the system has been specified
+    libmesh_assert_msg(_system, "System pointer is nullptr.");
+    libmesh_assert(_jac_update != MAST::TransientSolverBase::FULL_NEWTON);
+    
+    START_LOG("solve_with_lagged_jacobian()", "TransientSolver");
+    
+    MAST::NonlinearSystem& sys = *_system;
+    
+    // the linear solver is retained so that its preconditioner can be
+    // reused for subsequent time steps
+    if (!_linear_solver)
+        _linear_solver = sys.get_linear_solver();
+    
+    std::pair<unsigned int, Real>
+    solver_params = sys.get_linear_solve_parameters();
+    
+    libMesh::SparseMatrix<Real> *
+    pc = sys.request_matrix("Preconditioner");
+    
+    libMesh::PetscMatrix<Real>*
+    p_mat = dynamic_cast<libMesh::PetscMatrix<Real>*>(sys.matrix);
+    
+    libMesh::NumericVector<Real>
+    &sol = *sys.solution;
+    
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    dvec(sol.zero_clone().release());
+    
+    Real
+    res_l2      = 0.,
+    res0_l2     = 0.,
+    prev_res_l2 = 0.;
+    
+    std::vector<Real>
+    jac_params;
+    this->_jacobian_parameters(jac_params);
+    
+    bool
+    if_jac      = false;
+    
+    PetscErrorCode ierr;
+    PetscObjectState mat_state = 0;
+    
+    for (unsigned int i=0; i<max_nonlinear_iters; i++) {
+        
+        // the matrix may have been reassembled by another analysis using
+        // the same system since the Jacobian was computed
+        if (_if_jac_current && p_mat) {
+            
+            ierr = PetscObjectStateGet((PetscObject)p_mat->mat(), &mat_state);
+            CHKERRABORT(sys.comm().get(), ierr);
+            
+            if (mat_state != _jac_matrix_state)
+                _if_jac_current = false;
+        }
+        
+        // the Jacobian is updated if it is not available for this time step
+        // size and integration parameters, or if the lagged Jacobian has
+        // not been effective
+        if_jac = (!_if_jac_current           ||
+                  _jac_dt != dt              ||
+                  _jac_params != jac_params  ||
+                  (_jac_update == MAST::TransientSolverBase::MODIFIED_NEWTON &&
+                   (_n_lagged_iters >= max_lagged_iters ||
+                    (i > 1 && res_l2 > lagged_jacobian_rate * prev_res_l2))));
+        
+        // the residual is evaluated at the current local solution
+        sys.update();
+        sys.assembly(true, if_jac);
+        
+        prev_res_l2 = res_l2;
+        res_l2      = sys.rhs->l2_norm();
+        if (i == 0)
+            res0_l2 = res_l2;
+        
+        libMesh::out
+        << "Iter: " << i
+        << "   Residual L2-norm: " << res_l2
+        << (if_jac?"   (Jacobian updated)":"") << std::endl;
+        
+        if (res_l2 <= nonlinear_abs_tol ||
+            (i > 0 && res_l2 <= nonlinear_rel_tol * res0_l2))
+            break;
+        
+        if (if_jac) {
+            
+            _if_jac_current = true;
+            _jac_dt         = dt;
+            _jac_params     = jac_params;
+            _n_lagged_iters = 0;
+        }
+        
+        // the preconditioner is rebuilt only with the Jacobian
+        _linear_solver->reuse_preconditioner(!if_jac);
+        
+        _linear_solver->solve (*sys.matrix, pc,
+                               *dvec,
+                               *sys.rhs,
+                               solver_params.second,
+                               solver_params.first);
+        
+        // the state is recorded after the solve, since the linear solver
+        // closes the matrix, which also changes its state
+        if (p_mat) {
+            
+            ierr = PetscObjectStateGet((PetscObject)p_mat->mat(),
+                                       &_jac_matrix_state);
+            CHKERRABORT(sys.comm().get(), ierr);
+        }
+        
+        sol.add(-1., *dvec);
+        
+        // The linear solver may not have fit our constraints exactly
+#ifdef LIBMESH_ENABLE_CONSTRAINTS
+        sys.get_dof_map().enforce_constraints_exactly(sys, &sol);
+#endif
+        sol.close();
+        
+        _n_lagged_iters++;
+        
+        // the residual of a linear problem is not checked after the update
+        if (_jac_update == MAST::TransientSolverBase::LINEAR)
+            break;
+    }
+    
+    sys.update();
+    
+    STOP_LOG("solve_with_lagged_jacobian()", "TransientSolver");
+}
+
+
+
 
 libMesh::NumericVector<Real>&
 MAST::TransientSolverBase::solution(unsigned int prev_iter) const {
@@ -213,14 +377,22 @@ MAST::TransientSolverBase::solve_highest_derivative_and_advance_time_step() {
     // highest time derivative
     _if_highest_derivative_solution = true;
     
-    // Build the residual and Jacobian
+    // Build the residual and Jacobian. This replaces the Jacobian retained
+    // for the time step solutions.
     _system->assembly(true, true);
+    _if_jac_current = false;
 
     // reset the solution flag
     _if_highest_derivative_solution = false;
     
     // The sensitivity problem is linear
     libMesh::LinearSolver<Real> * linear_solver = _system->get_linear_solver();
+    linear_solver->reuse_preconditioner(false);
+    
+    // the retained solver should not reuse its preconditioner with the
+    // new matrix
+    if (_linear_solver)
+        _linear_solver->reuse_preconditioner(false);
     
     std::pair<unsigned int, Real>
     solver_params = _system->get_linear_solve_parameters();
@@ -21,12 +21,20 @@
 #ifndef __mast__transient_solver_base__
 #define __mast__transient_solver_base__
 
+// C++ includes
+#include <vector>
+
+
 // MAST includes
 #include "base/mast_data_types.h"
 
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
+#include "libmesh/linear_solver.h"
+
+// PETSc includes
+#include <petscsys.h>
 
 
 namespace MAST {
@@ -58,6 +66,50 @@ namespace MAST {
          *   time step
          */
         Real dt;
+        
+        
+        /*!
+         *   defines how the Jacobian is updated during the solution of a
+         *   time step
+         */
+        enum JacobianUpdateType {
+            FULL_NEWTON,       // system solve with a new Jacobian at each iterate
+            LINEAR,            // single linear solve with the lagged Jacobian
+            MODIFIED_NEWTON    // Newton iterations with the lagged Jacobian
+        };
+        
+        
+        /*!
+         *   sets the Jacobian update used by solve(). With \p LINEAR the
+         *   problem is declared to be linear, and each time step needs only
+         *   the assembly of the residual and a linear solve with the
+         *   Jacobian and preconditioner from the first time step. With
+         *   \p MODIFIED_NEWTON the Jacobian and preconditioner are reused
+         *   across iterates and time steps, and are updated only if the
+         *   residual does not decrease by \p lagged_jacobian_rate, or after
+         *   \p max_lagged_iters iterates. A linear problem then converges
+         *   in a single iterate per time step. The Jacobian is always
+         *   updated if \p dt or the parameters of the integration scheme
+         *   change.
+         */
+        void set_jacobian_update(MAST::TransientSolverBase::JacobianUpdateType t);
+        
+        
+        /*!
+         *   tolerances and maximum iterations for the time step solutions
+         *   with a lagged Jacobian
+         */
+        Real nonlinear_rel_tol, nonlinear_abs_tol;
+        
+        unsigned int max_nonlinear_iters;
+        
+        /*!
+         *   maximum ratio of successive residual norms, and maximum number
+         *   of iterates, before the lagged Jacobian is updated
+         */
+        Real lagged_jacobian_rate;
+        
+        unsigned int max_lagged_iters;
 
         /*!
          *    @returns the highest order time derivative that the solver 
@@ -191,6 +243,59 @@ namespace MAST {
          */
         virtual unsigned int _n_iters_to_store() const = 0;
         
+        /*!
+         *    adds to \p p the parameters of the integration scheme, other
+         *    than the time step, that the Jacobian depends on. A change in
+         *    these invalidates the lagged Jacobian.
+         */
+        virtual void _jacobian_parameters(std::vector<Real>& p) const = 0;
+        
+        /*!
+         *    solves the current time step with a lagged Jacobian for the
+         *    \p LINEAR and \p MODIFIED_NEWTON Jacobian updates
+         */
+        void _solve_with_lagged_jacobian();
+        
+        
+        /*!
+         *    Jacobian update used by solve()
+         */
+        MAST::TransientSolverBase::JacobianUpdateType _jac_update;
+        
+        /*!
+         *    true if the system matrix and preconditioner hold the Jacobian
+         *    of this solver for the time step \p _jac_dt
+         */
+        bool  _if_jac_current;
+        
+        Real  _jac_dt;
+        
+        /*!
+         *    parameters of the integration scheme for which the Jacobian
+         *    was computed
+         */
+        std::vector<Real> _jac_params;
+        
+        /*!
+         *    PETSc state of the system matrix after the Jacobian was
+         *    computed. A different state implies that the matrix was
+         *    modified outside of this solver, for example by an
+         *    assembly for another analysis, and that the Jacobian must be
+         *    recomputed.
+         */
+        PetscObjectState _jac_matrix_state;
+        
+        /*!
+         *    number of iterates since the Jacobian was updated
+         */
+        unsigned int _n_lagged_iters;
+        
+        /*!
+         *    linear solver retained for the solutions with a lagged Jacobian
+         */
+        libMesh::LinearSolver<Real>* _linear_solver;
+        
+        
         /*!
          *    provides the element with the transient data for calculations
          */
@@ -0,0 +1,271 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "tests/structural/build_structural_elem_2D.h"
+#include "tests/base/test_comparisons.h"
+#include "numerics/scratch_arena.h"
+#include "elasticity/structural_system_initialization.h"
+#include "elasticity/structural_element_base.h"
+#include "elasticity/structural_discipline.h"
+#include "property_cards/solid_2d_section_element_property_card.h"
+#include "base/boundary_condition_base.h"
+#include "base/nonlinear_system.h"
+
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+
+
+// These tests are built as a separate executable, since they replace the C
+// allocation functions of the whole program to count the heap allocations.
+
+namespace MAST {
+    
+    namespace AllocationTests {
+        
+        // the allocations are counted only on the thread that sets this
+        // flag, so that allocations by other threads are not attributed
+        // to the element calculations
+        thread_local bool           if_count       = false;
+        
+        std::atomic<unsigned long>  n_allocations(0);
+    }
+}
+
+
+#ifdef __GLIBC__
+
+// the global operator new and Eigen both allocate through malloc, so the
+// allocations are counted by replacing the C allocation functions, which
+// forward to the glibc implementations.
+extern "C" {
+    
+    void* __libc_malloc(std::size_t n);
+    void* __libc_calloc(std::size_t n, std::size_t s);
+    void* __libc_realloc(void* p, std::size_t n);
+    
+    
+    void* malloc(std::size_t n) {
+        
+        if (MAST::AllocationTests::if_count)
+            MAST::AllocationTests::n_allocations.fetch_add(1, std::memory_order_relaxed);
+        return __libc_malloc(n);
+    }
+    
+    
+    void* calloc(std::size_t n, std::size_t s) {
+        
+        if (MAST::AllocationTests::if_count)
+            MAST::AllocationTests::n_allocations.fetch_add(1, std::memory_order_relaxed);
+        return __libc_calloc(n, s);
+    }
+    
+    
+    void* realloc(void* p, std::size_t n) {
+        
+        if (MAST::AllocationTests::if_count)
+            MAST::AllocationTests::n_allocations.fetch_add(1, std::memory_order_relaxed);
+        return __libc_realloc(p, n);
+    }
+}
+
+#endif // __GLIBC__
+
+
+
+namespace MAST {
+    
+    namespace AllocationTests {
+        
+        /*!
+         *   counts the heap allocations made by the calling thread between
+         *   construction and the call to count()
+         */
+        class Counter {
+            
+        public:
+            
+            Counter() {
+                
+                n_allocations.store(0);
+                if_count = true;
+            }
+            
+            ~Counter() {
+                
+                if_count = false;
+            }
+            
+            unsigned long count() {
+                
+                if_count = false;
+                return n_allocations.load();
+            }
+        };
+        
+        
+        /*!
+         *   creates the element for the first element of the mesh in
+         *   \p v, and sets a nonzero solution and acceleration
+         */
+        std::auto_ptr<MAST::StructuralElementBase>
+        build_element(MAST::BuildStructural2DElem& v,
+                      RealVectorX& f,
+                      RealMatrixX& jac) {
+            
+            const libMesh::Elem& elem = **(v._mesh->local_elements_begin());
+            
+            std::auto_ptr<MAST::StructuralElementBase>
+            e(MAST::build_structural_element(*v._structural_sys,
+                                             elem,
+                                             *v._p_card).release());
+            
+            std::vector<unsigned int> dof_ids;
+            v._sys->get_dof_map().dof_indices(&elem, dof_ids);
+            
+            const unsigned int ndofs = (unsigned int)dof_ids.size();
+            
+            RealVectorX
+            sol         = RealVectorX::Zero(ndofs);
+            
+            // a deformation with nonzero values in all degrees of freedom
+            for (unsigned int i=0; i<ndofs; i++)
+                sol(i) = 1.e-2 * (1. + (Real)(i % 7)) / 7.;
+            
+            e->set_solution(sol);
+            e->set_acceleration(sol);
+            
+            f           = RealVectorX::Zero(ndofs);
+            jac         = RealMatrixX::Zero(ndofs, ndofs);
+            
+            return e;
+        }
+    }
+}
+
+
+BOOST_FIXTURE_TEST_SUITE  (ElementAllocationTests, MAST::BuildStructural2DElem)
+
+BOOST_AUTO_TEST_CASE   (InternalResidualDoesNotAllocate) {
+    
+    this->init(false, true, libMesh::QUAD4);
+    
+    RealVectorX f;
+    RealMatrixX jac;
+    std::auto_ptr<MAST::StructuralElementBase>
+    e(MAST::AllocationTests::build_element(*this, f, jac));
+    
+    // the first call populates the arena and creates the property
+    // matrix functions of the property card
+    e->internal_residual(true, f, jac);
+    const RealVectorX f0 = f;
+    
+    f.setZero();
+    jac.setZero();
+    
+    MAST::AllocationTests::Counter counter;
+    e->internal_residual(true, f, jac);
+    const unsigned long n_allocs = counter.count();
+    
+    BOOST_TEST_MESSAGE("  ** allocations in internal_residual() : "
+                       << n_allocs << " **");
+    
+    BOOST_CHECK_EQUAL(n_allocs, 0);
+    
+    // the reused workspace does not change the result
+    BOOST_CHECK(MAST::compare_vector(f0, f, 1.e-12));
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (InertialResidualDoesNotAllocate) {
+    
+    this->init(false, false, libMesh::QUAD4);
+    
+    RealVectorX f;
+    RealMatrixX jac, jac_xdot, jac_xddot;
+    std::auto_ptr<MAST::StructuralElementBase>
+    e(MAST::AllocationTests::build_element(*this, f, jac));
+    
+    jac_xdot  = jac;
+    jac_xddot = jac;
+    
+    e->inertial_residual(true, f, jac_xddot, jac_xdot, jac);
+    const RealVectorX f0 = f;
+    
+    f.setZero();
+    
+    MAST::AllocationTests::Counter counter;
+    e->inertial_residual(true, f, jac_xddot, jac_xdot, jac);
+    const unsigned long n_allocs = counter.count();
+    
+    BOOST_TEST_MESSAGE("  ** allocations in inertial_residual() : "
+                       << n_allocs << " **");
+    
+    BOOST_CHECK_EQUAL(n_allocs, 0);
+    BOOST_CHECK(MAST::compare_vector(f0, f, 1.e-12));
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (ThermalResidualDoesNotAllocate) {
+    
+    this->init(false, true, libMesh::QUAD4);
+    
+    _discipline->add_volume_load(0, *_thermal_load);
+    
+    RealVectorX f;
+    RealMatrixX jac, jac_xdot;
+    std::auto_ptr<MAST::StructuralElementBase>
+    e(MAST::AllocationTests::build_element(*this, f, jac));
+    
+    jac_xdot  = jac;
+    
+    e->volume_external_residual(true, f, jac_xdot, jac,
+                                _discipline->volume_loads());
+    const RealVectorX f0 = f;
+    
+    f.setZero();
+    
+    MAST::AllocationTests::Counter counter;
+    e->volume_external_residual(true, f, jac_xdot, jac,
+                                _discipline->volume_loads());
+    const unsigned long n_allocs = counter.count();
+    
+    BOOST_TEST_MESSAGE("  ** allocations in thermal_residual() : "
+                       << n_allocs << " **");
+    
+    BOOST_CHECK_EQUAL(n_allocs, 0);
+    BOOST_CHECK(MAST::compare_vector(f0, f, 1.e-12));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
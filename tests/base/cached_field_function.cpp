@@ -0,0 +1,244 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// C++ includes
+#include <thread>
+#include <atomic>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "tests/base/test_comparisons.h"
+#include "base/cached_field_function.h"
+#include "base/constant_field_function.h"
+#include "base/parameter.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   matrix valued function of two scalar functions that counts the
+     *   number of evaluations
+     */
+    class TestCompositeMatrixFunction:
+    public MAST::FieldFunction<RealMatrixX> {
+        
+    public:
+        
+        TestCompositeMatrixFunction(const MAST::FieldFunction<Real>& a,
+                                    const MAST::FieldFunction<Real>& b):
+        MAST::FieldFunction<RealMatrixX>("composite"),
+        _a(a),
+        _b(b) {
+            _functions.insert(&a);
+            _functions.insert(&b);
+            _is_composite = true;
+        }
+        
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 RealMatrixX& m) const {
+            
+            n_evaluations++;
+            
+            Real a, b;
+            _a(p, t, a);
+            _b(p, t, b);
+            
+            m = RealMatrixX::Zero(2, 2);
+            m(0,0) = a;
+            m(1,1) = b;
+            m(0,1) = m(1,0) = a*b;
+        }
+        
+        static unsigned int n_evaluations;
+        
+    protected:
+        
+        const MAST::FieldFunction<Real>& _a;
+        const MAST::FieldFunction<Real>& _b;
+    };
+    
+    unsigned int TestCompositeMatrixFunction::n_evaluations = 0;
+    
+    
+    /*!
+     *   spatially varying scalar function
+     */
+    class TestVaryingFunction:
+    public MAST::FieldFunction<Real> {
+        
+    public:
+        
+        TestVaryingFunction():
+        MAST::FieldFunction<Real>("varying")
+        { }
+        
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 Real& v) const {
+            v = 1. + p(0);
+        }
+    };
+}
+
+
+
+BOOST_AUTO_TEST_SUITE  (CachedFieldFunctionTests)
+
+BOOST_AUTO_TEST_CASE   (ConstantDependencyGraph) {
+    
+    MAST::Parameter a("a", 2.), b("b", 3.);
+    MAST::ConstantFieldFunction a_f("a", a), b_f("b", b);
+    MAST::TestVaryingFunction v_f;
+    
+    MAST::TestCompositeMatrixFunction
+    constant(a_f, b_f),
+    varying(a_f, v_f);
+    
+    BOOST_CHECK(a.is_spatially_constant());
+    BOOST_CHECK(a_f.is_spatially_constant());
+    BOOST_CHECK(a_f.is_temporally_constant());
+    BOOST_CHECK(constant.is_spatially_constant());
+    BOOST_CHECK(constant.is_temporally_constant());
+    BOOST_CHECK(!v_f.is_spatially_constant());
+    BOOST_CHECK(!varying.is_spatially_constant());
+    
+    std::set<const MAST::Parameter*> params;
+    constant.parameter_dependencies(params);
+    BOOST_CHECK_EQUAL(params.size(), 2);
+    BOOST_CHECK(params.count(&a));
+    BOOST_CHECK(params.count(&b));
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (ConstantValueIsReusedUntilParameterChanges) {
+    
+    MAST::Parameter a("a", 2.), b("b", 3.);
+    MAST::ConstantFieldFunction a_f("a", a), b_f("b", b);
+    
+    std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
+    f(new MAST::TestCompositeMatrixFunction(a_f, b_f));
+    MAST::CachedFieldFunction<RealMatrixX> cached(f);
+    
+    BOOST_CHECK(cached.if_constant());
+    BOOST_CHECK(cached.depends_on(a));
+    
+    MAST::TestCompositeMatrixFunction::n_evaluations = 0;
+    
+    std::vector<libMesh::Point> p(4);
+    std::vector<RealMatrixX> v;
+    RealMatrixX m;
+    
+    for (unsigned int i=0; i<5; i++) {
+        cached(p, 0., v);
+        cached(libMesh::Point(1., 2., 0.), 1., m);
+    }
+    
+    BOOST_CHECK_EQUAL(MAST::TestCompositeMatrixFunction::n_evaluations, 1);
+    BOOST_CHECK_EQUAL(v.size(), p.size());
+    BOOST_CHECK(MAST::compare_value(6., v[3](0,1), 1.e-12));
+    BOOST_CHECK(MAST::compare_value(6., m(1,0), 1.e-12));
+    
+    // changing a parameter value requires a new evaluation
+    b = 4.;
+    cached(libMesh::Point(), 0., m);
+    cached(p, 0., v);
+    BOOST_CHECK_EQUAL(MAST::TestCompositeMatrixFunction::n_evaluations, 2);
+    BOOST_CHECK(MAST::compare_value(8., m(0,1), 1.e-12));
+    BOOST_CHECK(MAST::compare_value(4., v[2](1,1), 1.e-12));
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (VaryingFunctionIsNotCached) {
+    
+    MAST::Parameter a("a", 2.);
+    MAST::ConstantFieldFunction a_f("a", a);
+    MAST::TestVaryingFunction v_f;
+    
+    std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
+    f(new MAST::TestCompositeMatrixFunction(a_f, v_f));
+    MAST::CachedFieldFunction<RealMatrixX> cached(f);
+    
+    BOOST_CHECK(!cached.if_constant());
+    
+    MAST::TestCompositeMatrixFunction::n_evaluations = 0;
+    
+    std::vector<libMesh::Point> p;
+    p.push_back(libMesh::Point(0., 0., 0.));
+    p.push_back(libMesh::Point(1., 0., 0.));
+    std::vector<RealMatrixX> v;
+    
+    cached(p, 0., v);
+    
+    BOOST_CHECK_EQUAL(MAST::TestCompositeMatrixFunction::n_evaluations, 2);
+    BOOST_CHECK(MAST::compare_value(1., v[0](1,1), 1.e-12));
+    BOOST_CHECK(MAST::compare_value(2., v[1](1,1), 1.e-12));
+}
+
+
+BOOST_AUTO_TEST_CASE   (ConcurrentReadsAfterParameterChange) {
+    
+    MAST::Parameter a("a", 2.), b("b", 3.);
+    MAST::ConstantFieldFunction a_f("a", a), b_f("b", b);
+    
+    std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
+    f(new MAST::TestCompositeMatrixFunction(a_f, b_f));
+    MAST::CachedFieldFunction<RealMatrixX> cached(f);
+    
+    const unsigned int
+    n_threads = 4,
+    n_reads   = 2000;
+    
+    std::atomic<unsigned int> n_wrong(0);
+    
+    // as in a threaded assembly after a design update, the first reads
+    // of all threads find a changed parameter
+    for (unsigned int k=0; k<20; k++) {
+        
+        b = 3. + k;
+        const Real ab = a()*b();
+        
+        std::vector<std::thread> threads;
+        
+        for (unsigned int i=0; i<n_threads; i++)
+            threads.push_back(std::thread([&]() {
+                
+                RealMatrixX m;
+                
+                for (unsigned int j=0; j<n_reads; j++) {
+                    
+                    cached(libMesh::Point(), 0., m);
+                    if (m(0,1) != ab || m(1,1) != b())
+                        n_wrong++;
+                }
+            }));
+        
+        for (unsigned int i=0; i<n_threads; i++)
+            threads[i].join();
+    }
+    
+    BOOST_CHECK_EQUAL(n_wrong.load(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "tests/base/test_comparisons.h"
+#include "base/constant_field_function.h"
+#include "base/parameter.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   linear field function that counts the number of point evaluations
+     */
+    class TestLinearFieldFunction:
+    public MAST::FieldFunction<Real> {
+        
+    public:
+        
+        TestLinearFieldFunction(const MAST::Parameter& a):
+        MAST::FieldFunction<Real>("linear"),
+        n_evaluations(0),
+        _a(a) {
+            _functions.insert(&a);
+        }
+        
+        using MAST::FieldFunction<Real>::operator();
+        using MAST::FieldFunction<Real>::derivative;
+        
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 Real& v) const {
+            n_evaluations++;
+            v = _a() * (p(0) + 2.*p(1));
+        }
+        
+        virtual void derivative (const MAST::FunctionBase& f,
+                                 const libMesh::Point& p,
+                                 const Real t,
+                                 Real& v) const {
+            n_evaluations++;
+            v = (&f == &_a)? (p(0) + 2.*p(1)) : 0.;
+        }
+        
+        mutable unsigned int n_evaluations;
+        
+    protected:
+        
+        const MAST::Parameter& _a;
+    };
+}
+
+
+
+BOOST_AUTO_TEST_SUITE  (FieldFunctionBatchEvaluation)
+
+BOOST_AUTO_TEST_CASE   (BatchEvaluationMatchesPointEvaluation) {
+    
+    MAST::Parameter a("a", 3.);
+    MAST::TestLinearFieldFunction f(a);
+    
+    std::vector<libMesh::Point> p;
+    for (unsigned int i=0; i<9; i++)
+        p.push_back(libMesh::Point(0.1*i, -0.3*i, 0.));
+    
+    std::vector<Real> v, dv;
+    f(p, 0., v);
+    f.derivative(a, p, 0., dv);
+    
+    BOOST_CHECK(!f.is_spatially_constant());
+    BOOST_CHECK_EQUAL(v.size(),  p.size());
+    BOOST_CHECK_EQUAL(dv.size(), p.size());
+    BOOST_CHECK_EQUAL(f.n_evaluations, 2*p.size());
+    
+    for (unsigned int i=0; i<p.size(); i++) {
+        BOOST_CHECK(MAST::compare_value(a() * (p[i](0) + 2.*p[i](1)), v[i], 1.e-12));
+        BOOST_CHECK(MAST::compare_value(p[i](0) + 2.*p[i](1), dv[i], 1.e-12));
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (ConstantFunctionIsBroadcast) {
+    
+    MAST::Parameter a("a", 3.), b("b", 1.);
+    MAST::ConstantFieldFunction f("a", a);
+    
+    std::vector<libMesh::Point> p(4);
+    std::vector<Real> v, dv;
+    
+    BOOST_CHECK(f.is_spatially_constant());
+    
+    f(p, 0., v);
+    BOOST_CHECK_EQUAL(v.size(), p.size());
+    for (unsigned int i=0; i<p.size(); i++)
+        BOOST_CHECK(MAST::compare_value(3., v[i], 1.e-12));
+    
+    f.derivative(a, p, 0., dv);
+    for (unsigned int i=0; i<p.size(); i++)
+        BOOST_CHECK(MAST::compare_value(1., dv[i], 1.e-12));
+    
+    f.derivative(b, p, 0., dv);
+    for (unsigned int i=0; i<p.size(); i++)
+        BOOST_CHECK(MAST::compare_value(0., dv[i], 1.e-12));
+    
+    // an empty set of points returns an empty set of values
+    p.clear();
+    f(p, 0., v);
+    BOOST_CHECK(v.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,171 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "base/function_set_base.h"
+#include "base/constant_field_function.h"
+#include "base/parameter.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   scalar function that depends on two other functions
+     */
+    class TestSumFunction:
+    public MAST::FieldFunction<Real> {
+        
+    public:
+        
+        TestSumFunction(const std::string& nm,
+                        const MAST::FieldFunction<Real>& a,
+                        const MAST::FieldFunction<Real>& b):
+        MAST::FieldFunction<Real>(nm),
+        _a(a),
+        _b(b) {
+            _functions.insert(&a);
+            _functions.insert(&b);
+            _is_composite = true;
+        }
+        
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 Real& v) const {
+            Real a, b;
+            _a(p, t, a);
+            _b(p, t, b);
+            v = a + b;
+        }
+        
+    protected:
+        
+        const MAST::FieldFunction<Real>& _a;
+        const MAST::FieldFunction<Real>& _b;
+    };
+}
+
+
+
+BOOST_AUTO_TEST_SUITE  (FunctionDependencyGraphTests)
+
+BOOST_AUTO_TEST_CASE   (FrozenGraphMatchesRecursiveSearch) {
+    
+    MAST::Parameter
+    a("a", 1.),
+    b("b", 2.),
+    c("c", 3.),
+    d("d", 4.);
+    
+    MAST::ConstantFieldFunction
+    a_f("a_f", a),
+    b_f("b_f", b),
+    c_f("c_f", c);
+    
+    MAST::TestSumFunction
+    ab("ab", a_f, b_f),
+    abc("abc", ab, c_f);
+    
+    std::vector<const MAST::FunctionBase*> funcs;
+    funcs.push_back(&a);
+    funcs.push_back(&b);
+    funcs.push_back(&c);
+    funcs.push_back(&d);
+    funcs.push_back(&a_f);
+    funcs.push_back(&b_f);
+    funcs.push_back(&c_f);
+    funcs.push_back(&ab);
+    funcs.push_back(&abc);
+    
+    // dependencies from the recursive search
+    std::vector<bool> deps;
+    for (unsigned int i=0; i<funcs.size(); i++)
+        for (unsigned int j=0; j<funcs.size(); j++)
+            deps.push_back(funcs[i]->depends_on(*funcs[j]));
+    
+    abc.freeze_dependencies();
+    
+    BOOST_CHECK(abc.if_frozen());
+    BOOST_CHECK(ab.if_frozen());
+    BOOST_CHECK(a_f.if_frozen());
+    
+    for (unsigned int i=0; i<funcs.size(); i++)
+        funcs[i]->freeze_dependencies();
+    
+    for (unsigned int i=0; i<funcs.size(); i++)
+        for (unsigned int j=0; j<funcs.size(); j++)
+            BOOST_CHECK_EQUAL(funcs[i]->depends_on(*funcs[j]),
+                              deps[i*funcs.size()+j]);
+    
+    BOOST_CHECK(abc.depends_on(a));
+    BOOST_CHECK(abc.depends_on(ab));
+    BOOST_CHECK(!abc.depends_on(d));
+    BOOST_CHECK(!ab.depends_on(c));
+    
+    // the parameters are enumerated from the frozen graph
+    std::set<const MAST::Parameter*> params;
+    abc.parameter_dependencies(params);
+    BOOST_CHECK_EQUAL(params.size(), 3);
+    BOOST_CHECK(params.count(&a));
+    BOOST_CHECK(params.count(&b));
+    BOOST_CHECK(params.count(&c));
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (FrozenFunctionSet) {
+    
+    MAST::Parameter
+    a("a", 1.),
+    b("b", 2.),
+    c("c", 3.);
+    
+    MAST::ConstantFieldFunction
+    a_f("a_f", a),
+    b_f("b_f", b),
+    c_f("c_f", c);
+    
+    MAST::TestSumFunction ab("ab", a_f, b_f);
+    
+    MAST::FunctionSetBase set;
+    set.add(ab);
+    set.add(a);
+    
+    set.freeze_dependencies();
+    
+    BOOST_CHECK(set.if_frozen());
+    BOOST_CHECK(set.depends_on(a));
+    BOOST_CHECK(set.depends_on(b));
+    BOOST_CHECK(set.depends_on(a_f));
+    BOOST_CHECK(!set.depends_on(c));
+    
+    // adding a function clears the frozen graph
+    set.add(c_f);
+    BOOST_CHECK(!set.if_frozen());
+    BOOST_CHECK(set.depends_on(c));
+    
+    set.freeze_dependencies();
+    BOOST_CHECK(set.depends_on(c));
+    BOOST_CHECK(!set.depends_on(c_f));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -27,6 +27,8 @@
 #include "base/nonlinear_system.h"
 #include "base/parameter.h"
 #include "tests/base/test_comparisons.h"
+#include "fluid/frequency_domain_linearized_complex_assembly.h"
+#include "solver/complex_frequency_sweep_solver.h"
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
@@ -163,5 +165,130 @@ BOOST_AUTO_TEST_CASE   (FreqDomainSensitivityWrtOmega) {
 
 
 
+BOOST_AUTO_TEST_CASE   (FrequencySweepMatchesIndependentSolves) {
+    
+    const Real
+    tol      = 1.e-6;
+    
+    const unsigned int
+    n_freq   = 3;
+    
+    const Real
+    omega[n_freq] = {50., 100., 150.};
+    
+    std::string
+    nm_re      = _sys->name() + "real_sol",
+    nm_im      = _sys->name() + "imag_sol";
+    
+    std::vector<RealVectorX>
+    sol_re(n_freq),
+    sol_im(n_freq);
+    
+    // independent solution at each frequency. This also initializes the
+    // base solution used by the sweep below.
+    for (unsigned int i=0; i<n_freq; i++) {
+        
+        (*_omega)() = omega[i];
+        solve();
+        
+        libMesh::NumericVector<Real>
+        & sol_vec_re = _sys->get_vector(nm_re),
+        & sol_vec_im = _sys->get_vector(nm_im);
+        
+        const unsigned int
+        n_dofs     = sol_vec_re.size();
+        
+        sol_re[i]  = RealVectorX::Zero(n_dofs);
+        sol_im[i]  = RealVectorX::Zero(n_dofs);
+        
+        for (unsigned int j=0; j<n_dofs; j++) {
+            
+            sol_re[i](j)  = sol_vec_re(j);
+            sol_im[i](j)  = sol_vec_im(j);
+        }
+    }
+    
+    // sets the frequency, and copies the swept solution at each frequency
+    class SweepUpdate:
+    public MAST::ComplexFrequencySweepSolver::FrequencyUpdate {
+        
+    public:
+        
+        SweepUpdate(MAST::ComplexFrequencySweepSolver& solver,
+                    MAST::Parameter&                   omega,
+                    const Real*                        omega_vals,
+                    std::vector<RealVectorX>&          re,
+                    std::vector<RealVectorX>&          im):
+        _solver(solver),
+        _omega(omega),
+        _omega_vals(omega_vals),
+        _re(re),
+        _im(im)
+        { }
+        
+        virtual void init_frequency(unsigned int i) {
+            
+            _omega() = _omega_vals[i];
+        }
+        
+        virtual void process_solution(unsigned int i) {
+            
+            const libMesh::NumericVector<Real>
+            &re  = _solver.real_solution(),
+            &im  = _solver.imag_solution();
+            
+            const unsigned int
+            n_dofs     = re.size();
+            
+            _re[i]  = RealVectorX::Zero(n_dofs);
+            _im[i]  = RealVectorX::Zero(n_dofs);
+            
+            for (unsigned int j=0; j<n_dofs; j++) {
+                
+                _re[i](j)  = re(j);
+                _im[i](j)  = im(j);
+            }
+        }
+        
+    protected:
+        
+        MAST::ComplexFrequencySweepSolver& _solver;
+        MAST::Parameter&                   _omega;
+        const Real*                        _omega_vals;
+        std::vector<RealVectorX>           &_re, &_im;
+    };
+    
+    std::vector<RealVectorX>
+    sweep_re(n_freq),
+    sweep_im(n_freq);
+    
+    {
+        MAST::FrequencyDomainLinearizedComplexAssembly   assembly;
+        MAST::ComplexFrequencySweepSolver                solver;
+        
+        assembly.attach_discipline_and_system(*_discipline,
+                                              solver,
+                                              *_fluid_sys);
+        assembly.set_base_solution(_sys->get_vector("fluid_base_solution"));
+        assembly.set_frequency_function(*_freq_function);
+        
+        SweepUpdate update(solver, *_omega, omega, sweep_re, sweep_im);
+        solver.sweep(update, n_freq);
+        
+        assembly.clear_discipline_and_system();
+    }
+    
+    for (unsigned int i=0; i<n_freq; i++) {
+        
+        BOOST_TEST_MESSAGE("  ** X_re at omega = " << omega[i] << " **");
+        BOOST_CHECK(MAST::compare_vector( sol_re[i],  sweep_re[i], tol));
+        
+        BOOST_TEST_MESSAGE("  ** X_im at omega = " << omega[i] << " **");
+        BOOST_CHECK(MAST::compare_vector( sol_im[i],  sweep_im[i], tol));
+    }
+}
+
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
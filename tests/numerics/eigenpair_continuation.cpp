@@ -0,0 +1,117 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "tests/base/test_comparisons.h"
+#include "numerics/eigenpair_continuation.h"
+
+
+
+BOOST_AUTO_TEST_SUITE  (EigenpairContinuationTests)
+
+BOOST_AUTO_TEST_CASE   (ContinuationOfPerturbedPencil) {
+    
+    const unsigned int n = 6;
+    const Real
+    eps   = 1.e-3,
+    tol   = 1.e-8;
+    
+    // pencil with known eigenpairs: A0 = S D S^-1, B = I
+    ComplexMatrixX
+    S     = ComplexMatrixX::Identity(n, n),
+    E     = ComplexMatrixX::Zero(n, n),
+    B     = ComplexMatrixX::Identity(n, n);
+    ComplexVectorX
+    D     = ComplexVectorX::Zero(n);
+    
+    for (unsigned int i=0; i<n; i++) {
+        D(i) = Complex(-0.1*(i+1), 1.+i);
+        for (unsigned int j=0; j<n; j++) {
+            if (i != j)
+                S(i,j) = Complex(0.1*sin(1.+i+2.*j), 0.05*cos(3.+i+j));
+            E(i,j) = Complex(cos(1.+3.*i+j), sin(2.+i+j));
+        }
+    }
+    
+    const ComplexMatrixX
+    A0    = S * D.asDiagonal() * S.inverse(),
+    A     = A0 + eps * E,
+    VL0   = S.inverse().adjoint();
+    
+    MAST::EigenpairContinuation cont;
+    cont.set_tolerances(tol, 0.9, 20);
+    
+    BOOST_CHECK(cont.compute(A, B, D, S, VL0));
+    
+    const ComplexVectorX&
+    lambda = cont.eigenvalues();
+    const ComplexMatrixX
+    &VR    = cont.right_eigenvectors(),
+    &VL    = cont.left_eigenvectors();
+    
+    for (unsigned int i=0; i<n; i++) {
+        
+        // the eigenpair satisfies the perturbed problem, and follows the
+        // eigenvalue of the unperturbed problem
+        const ComplexVectorX
+        r     = A * VR.col(i) - lambda(i) * B * VR.col(i),
+        l     = A.adjoint() * VL.col(i) - std::conj(lambda(i)) * B.adjoint() * VL.col(i);
+        
+        BOOST_CHECK(r.norm() <= 1.e-6 * VR.col(i).norm());
+        BOOST_CHECK(l.norm() <= 1.e-6 * VL.col(i).norm());
+        BOOST_CHECK(std::abs(lambda(i)-D(i)) < 10.*eps*E.norm());
+        
+        // unit inner product with respect to B
+        BOOST_CHECK(MAST::compare_value(1., std::real(VL.col(i).dot(B*VR.col(i))), tol));
+        BOOST_CHECK(MAST::compare_value(0., std::imag(VL.col(i).dot(B*VR.col(i))), tol));
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (ContinuationDetectsBranchJump) {
+    
+    const unsigned int n = 4;
+    
+    ComplexMatrixX
+    A     = ComplexMatrixX::Zero(n, n),
+    B     = ComplexMatrixX::Identity(n, n),
+    V0    = ComplexMatrixX::Identity(n, n);
+    ComplexVectorX
+    D     = ComplexVectorX::Zero(n);
+    
+    for (unsigned int i=0; i<n; i++) {
+        D(i)   = Complex(-0.1, 1.+i);
+        A(i,i) = D(i) + 1.e-4;
+    }
+    
+    // the previous vectors of the first two modes are swapped, so the
+    // iterations follow the wrong eigenvalues
+    V0.col(0).swap(V0.col(1));
+    
+    MAST::EigenpairContinuation cont;
+    BOOST_CHECK(!cont.compute(A, B, D, V0, V0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,111 +17,191 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-//#include "numerics/fem_operator_matrix.h"
-//
-//int main_fem_operator (int argc, char* const argv[])
-//{
-//    DenseRealVector vec1, vec2, shp;
-//    DenseRealMatrix mat1, mat2, bmat1, bmat2, tmp;
-//    
-//    vec1.resize(12); shp.resize(4);
-//    
-//    for (unsigned int i=0; i<shp.size(); i++)
-//        shp(i) = i+1;
-//    
-//    for (unsigned int i=0; i<vec1.size(); i++)
-//        vec1(i) = i+100;
-//    
-//    shp.print(libMesh::out);
-//    vec1.print(libMesh::out);
-//    mat1.print(libMesh::out);
-//    
-//    MAST::FEMOperatorMatrix b1, b2;
-//    b1.reinit(3, shp); b2.reinit(3, shp);
-//    bmat1.resize(3, shp.size()*3); bmat2.resize(3, shp.size()*3);
-//    for (unsigned int i=0; i<3; i++)
-//        for (unsigned int j=0; j<shp.size(); j++) {
-//            bmat1(i, i*shp.size()+j) = shp(j);
-//            bmat2(i, i*shp.size()+j) = shp(j);
-//        }
-//    
-//    
-//    vec2.resize(3);
-//    b1.vector_mult(vec2, vec1);
-//    libMesh::out << "FEMOperator: " << std::endl; vec2.print(libMesh::out);
-//    bmat1.vector_mult(vec2, vec1);
-//    libMesh::out << "Matrix:      " << std::endl; vec2.print(libMesh::out);
-//    
-//    vec1.resize(3);
-//    for (unsigned int i=0; i<vec1.size(); i++)
-//        vec1(i) = 100+i;
-//    vec2.resize(12);
-//    b1.vector_mult_transpose(vec2, vec1);
-//    libMesh::out << "FEMOperator: " << std::endl; vec2.print(libMesh::out);
-//    bmat1.vector_mult_transpose(vec2, vec1);
-//    libMesh::out << "Matrix:      " << std::endl; vec2.print(libMesh::out);
-//    
-//    
-//    mat1.resize(5,3);
-//    mat2.resize(5, 12);
-//    for (unsigned int i=0; i<5; i++)
-//        for (unsigned int j=0; j<3; j++)
-//            mat1(i,j) = (i+1)*(j+1);
-//    libMesh::out << "multiply matrix" << std::endl;  mat1.print();
-//    b1.left_multiply(mat2, mat1);
-//    libMesh::out << "FEMOperator: " << std::endl;  mat2.print();
-//    tmp = bmat1;
-//    tmp.left_multiply(mat1);
-//    libMesh::out << "Matrix:      " << std::endl;  tmp.print();
-//    
-//    
-//    mat1.resize(5,12);
-//    mat2.resize(5, 3);
-//    for (unsigned int i=0; i<5; i++)
-//        for (unsigned int j=0; j<12; j++)
-//            mat1(i,j) = (i+1)*(j+1);
-//    libMesh::out << "multiply matrix" << std::endl;  mat1.print();
-//    b1.left_multiply_transpose(mat2, mat1);
-//    libMesh::out << "FEMOperator: " << std::endl;  mat2.print();
-//    bmat1.get_transpose(tmp);
-//    tmp.left_multiply(mat1);
-//    libMesh::out << "Matrix:      " << std::endl;  tmp.print();
-//    
-//    
-//    mat1.resize(12,5);
-//    mat2.resize(3, 5);
-//    for (unsigned int i=0; i<12; i++)
-//        for (unsigned int j=0; j<5; j++)
-//            mat1(i,j) = (i+1)*(j+1);
-//    libMesh::out << "multiply matrix" << std::endl;  mat1.print();
-//    b1.right_multiply(mat2, mat1);
-//    libMesh::out << "FEMOperator: " << std::endl;  mat2.print();
-//    tmp = bmat1;
-//    tmp.right_multiply(mat1);
-//    libMesh::out << "Matrix:      " << std::endl;  tmp.print();
-//    
-//    
-//    mat1.resize(3, 5);
-//    mat2.resize(12, 5);
-//    for (unsigned int i=0; i<3; i++)
-//        for (unsigned int j=0; j<5; j++)
-//            mat1(i,j) = (i+1)*(j+1);
-//    libMesh::out << "multiply matrix" << std::endl;  mat1.print();
-//    b1.right_multiply_transpose(mat2, mat1);
-//    libMesh::out << "FEMOperator: " << std::endl;  mat2.print();
-//    bmat1.get_transpose(tmp);
-//    tmp.right_multiply(mat1);
-//    libMesh::out << "Matrix:      " << std::endl;  tmp.print();
-//    
-//    
-//    mat2.resize(12, 12);
-//    b1.right_multiply_transpose(mat2, b1);
-//    libMesh::out << "FEMOperator: " << std::endl;  mat2.print();
-//    bmat1.get_transpose(tmp);
-//    tmp.right_multiply(bmat1);
-//    libMesh::out << "Matrix:      " << std::endl;  tmp.print();
-//    
-//    return 0;
-//}
-//
-//
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "tests/base/test_comparisons.h"
+#include "numerics/fem_operator_matrix.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   sets the blocks of \p op from the dense operator \p b, which has
+     *   nonzero blocks only where \p pattern is true
+     */
+    void
+    build_test_operators(const unsigned int n_ivars,
+                         const unsigned int n_dvars,
+                         const unsigned int n_dofs,
+                         const std::vector<bool>& pattern,
+                         MAST::FEMOperatorMatrix& op,
+                         RealMatrixX& b) {
+        
+        RealVectorX shp = RealVectorX::Zero(n_dofs);
+        
+        op.reinit(n_ivars, n_dvars, n_dofs);
+        b.setZero(n_ivars, n_dvars*n_dofs);
+        
+        for (unsigned int j=0; j<n_dvars; j++)
+            for (unsigned int i=0; i<n_ivars; i++)
+                if (pattern[j*n_ivars+i]) {
+                    
+                    for (unsigned int k=0; k<n_dofs; k++)
+                        shp(k) = cos(1.+i+2.*j+3.*k);
+                    
+                    op.set_shape_function(i, j, shp);
+                    b.block(i, j*n_dofs, 1, n_dofs) = shp.transpose();
+                }
+    }
+}
+
+
+
+BOOST_AUTO_TEST_SUITE  (FEMOperatorMatrixTests)
+
+BOOST_AUTO_TEST_CASE   (SparseOperatorProducts) {
+    
+    const unsigned int
+    n_ivars = 3,
+    n_dvars = 4,
+    n_dofs  = 5,
+    n_cols  = 2;
+    
+    std::vector<bool> pattern(n_ivars*n_dvars, false);
+    pattern[0] = pattern[4] = pattern[5] = pattern[9] = pattern[11] = true;
+    
+    MAST::FEMOperatorMatrix op;
+    RealMatrixX b;
+    
+    // reinitialize twice to make sure that stale values from a previous
+    // operator with a different sparsity are not retained
+    std::vector<bool> full(n_ivars*n_dvars, true);
+    MAST::build_test_operators(n_ivars, n_dvars, n_dofs, full, op, b);
+    MAST::build_test_operators(n_ivars, n_dvars, n_dofs, pattern, op, b);
+    
+    const unsigned int n = n_dvars*n_dofs;
+    
+    RealVectorX
+    v_n  = RealVectorX::Zero(n),
+    v_m  = RealVectorX::Zero(n_ivars),
+    r_n  = RealVectorX::Zero(n),
+    r_m  = RealVectorX::Zero(n_ivars);
+    RealMatrixX
+    m_nc = RealMatrixX::Zero(n, n_cols),
+    m_mc = RealMatrixX::Zero(n_ivars, n_cols),
+    m_cm = RealMatrixX::Zero(n_cols, n_ivars),
+    m_cn = RealMatrixX::Zero(n_cols, n),
+    r_mat;
+    
+    for (unsigned int i=0; i<n; i++) {
+        v_n(i) = sin(1.+i);
+        for (unsigned int j=0; j<n_cols; j++) {
+            m_nc(i,j) = sin(2.+i+3.*j);
+            m_cn(j,i) = cos(1.+2.*i+j);
+        }
+    }
+    
+    for (unsigned int i=0; i<n_ivars; i++) {
+        v_m(i) = cos(2.+i);
+        for (unsigned int j=0; j<n_cols; j++) {
+            m_mc(i,j) = sin(3.+i+j);
+            m_cm(j,i) = cos(3.+2.*i+j);
+        }
+    }
+    
+    op.vector_mult(r_m, v_n);
+    BOOST_CHECK(MAST::compare_vector(RealVectorX(b * v_n), r_m, 1.e-12));
+    
+    op.vector_mult_transpose(r_n, v_m);
+    BOOST_CHECK(MAST::compare_vector(RealVectorX(b.transpose() * v_m), r_n, 1.e-12));
+    
+    r_mat.setZero(n_ivars, n_cols);
+    op.right_multiply(r_mat, m_nc);
+    BOOST_CHECK(MAST::compare_matrix(RealMatrixX(b * m_nc), r_mat, 1.e-12));
+    
+    r_mat.setZero(n, n_cols);
+    op.right_multiply_transpose(r_mat, m_mc);
+    BOOST_CHECK(MAST::compare_matrix(RealMatrixX(b.transpose() * m_mc), r_mat, 1.e-12));
+    
+    r_mat.setZero(n_cols, n);
+    op.left_multiply(r_mat, m_cm);
+    BOOST_CHECK(MAST::compare_matrix(RealMatrixX(m_cm * b), r_mat, 1.e-12));
+    
+    r_mat.setZero(n_cols, n_ivars);
+    op.left_multiply_transpose(r_mat, m_cn);
+    BOOST_CHECK(MAST::compare_matrix(RealMatrixX(m_cn * b.transpose()), r_mat, 1.e-12));
+    
+    r_mat.setZero(n, n);
+    op.right_multiply_transpose(r_mat, op);
+    BOOST_CHECK(MAST::compare_matrix(RealMatrixX(b.transpose() * b), r_mat, 1.e-12));
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (SharedShapeFunctionProducts) {
+    
+    const unsigned int
+    n_vars  = 3,
+    n_dofs  = 4,
+    n       = n_vars*n_dofs;
+    
+    RealVectorX shp = RealVectorX::Zero(n_dofs);
+    for (unsigned int k=0; k<n_dofs; k++)
+        shp(k) = 1.+k;
+    
+    MAST::FEMOperatorMatrix op;
+    op.reinit(n_vars, shp);
+    
+    RealMatrixX b = RealMatrixX::Zero(n_vars, n);
+    for (unsigned int i=0; i<n_vars; i++)
+        b.block(i, i*n_dofs, 1, n_dofs) = shp.transpose();
+    
+    ComplexVectorX
+    v_n  = ComplexVectorX::Zero(n),
+    v_m  = ComplexVectorX::Zero(n_vars),
+    r_n  = ComplexVectorX::Zero(n),
+    r_m  = ComplexVectorX::Zero(n_vars);
+    
+    for (unsigned int i=0; i<n; i++)
+        v_n(i) = Complex(sin(1.+i), cos(2.+i));
+    for (unsigned int i=0; i<n_vars; i++)
+        v_m(i) = Complex(cos(3.+i), sin(1.+2.*i));
+    
+    const ComplexMatrixX bc = b.cast<Complex>();
+    
+    // complex products are checked through their real and imaginary parts
+    op.vector_mult(r_m, v_n);
+    const ComplexVectorX r_m_dense = bc * v_n;
+    BOOST_CHECK(MAST::compare_vector(RealVectorX(r_m_dense.real()), RealVectorX(r_m.real()), 1.e-12));
+    BOOST_CHECK(MAST::compare_vector(RealVectorX(r_m_dense.imag()), RealVectorX(r_m.imag()), 1.e-12));
+    
+    op.vector_mult_transpose(r_n, v_m);
+    const ComplexVectorX r_n_dense = bc.transpose() * v_m;
+    BOOST_CHECK(MAST::compare_vector(RealVectorX(r_n_dense.real()), RealVectorX(r_n.real()), 1.e-12));
+    BOOST_CHECK(MAST::compare_vector(RealVectorX(r_n_dense.imag()), RealVectorX(r_n.imag()), 1.e-12));
+    
+    RealMatrixX r_mat = RealMatrixX::Zero(n, n);
+    op.right_multiply_transpose(r_mat, op);
+    BOOST_CHECK(MAST::compare_matrix(RealMatrixX(b.transpose() * b), r_mat, 1.e-12));
+    
+    // overwriting a block with a different shape function falls back to
+    // the general products
+    RealVectorX shp2 = 2.*shp;
+    op.set_shape_function(1, 0, shp2);
+    b.block(1, 0, 1, n_dofs) = shp2.transpose();
+    
+    RealVectorX
+    v_nr = v_n.real(),
+    r_mr = RealVectorX::Zero(n_vars);
+    op.vector_mult(r_mr, v_nr);
+    BOOST_CHECK(MAST::compare_vector(RealVectorX(b * v_nr), r_mr, 1.e-12));
+    
+    op.right_multiply_transpose(r_mat, op);
+    BOOST_CHECK(MAST::compare_matrix(RealMatrixX(b.transpose() * b), r_mat, 1.e-12));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "tests/base/test_comparisons.h"
+#include "aeroelasticity/gaf_rational_function_approximation.h"
+
+
+
+BOOST_AUTO_TEST_SUITE  (GAFRationalFunctionApproximationTests)
+
+BOOST_AUTO_TEST_CASE   (RogerApproximationRecovery) {
+    
+    const unsigned int
+    n     = 3,
+    n_kr  = 10;
+    
+    const Real
+    delta = 1.e-6,
+    tol   = 1.e-4;
+    
+    // create a GAF that is exactly represented by the approximation
+    std::vector<Real> lags(2);
+    lags[0] = 0.2;
+    lags[1] = 0.6;
+    
+    std::vector<RealMatrixX> coeffs(3+lags.size());
+    for (unsigned int j=0; j<coeffs.size(); j++) {
+        coeffs[j].setZero(n, n);
+        for (unsigned int r=0; r<n; r++)
+            for (unsigned int c=0; c<n; c++)
+                coeffs[j](r,c) = sin(1.+j+2.*r+3.*c);
+    }
+    
+    std::map<Real, ComplexMatrixX> data;
+    const Complex iota(0., 1.);
+    
+    for (unsigned int i=0; i<n_kr; i++) {
+        
+        const Real kr = 0.05 + 0.1*i;
+        const Complex s = iota*kr;
+        
+        ComplexMatrixX mat =
+        coeffs[0].cast<Complex>() +
+        s * coeffs[1].cast<Complex>() +
+        s * s * coeffs[2].cast<Complex>();
+        
+        for (unsigned int l=0; l<lags.size(); l++)
+            mat += s/(s+lags[l]) * coeffs[3+l].cast<Complex>();
+        
+        data[kr] = mat;
+    }
+    
+    MAST::GAFRationalFunctionApproximation rfa;
+    rfa.init(data, lags);
+    
+    BOOST_CHECK(rfa.fit_error() < tol);
+    for (unsigned int j=0; j<coeffs.size(); j++)
+        BOOST_CHECK(MAST::compare_matrix(coeffs[j], rfa.coefficient(j), tol));
+    
+    // compare the analytical derivative with finite differencing at a
+    // frequency in between the tabulated values
+    const Real kr = 0.33;
+    ComplexMatrixX v_p, v_m, dv;
+    rfa.value(kr+delta, v_p);
+    rfa.value(kr-delta, v_m);
+    rfa.derivative(kr, dv);
+    
+    ComplexMatrixX dv_fd = (v_p - v_m)/(2.*delta);
+    
+    BOOST_CHECK(MAST::compare_matrix(dv_fd.real(), dv.real(), tol));
+    BOOST_CHECK(MAST::compare_matrix(dv_fd.imag(), dv.imag(), tol));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
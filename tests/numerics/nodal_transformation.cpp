@@ -0,0 +1,130 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "tests/base/test_comparisons.h"
+#include "numerics/nodal_transformation.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   rotation matrix from three Euler angles
+     */
+    RealMatrixX
+    test_rotation_matrix(const Real a, const Real b, const Real c) {
+        
+        RealMatrixX
+        Rx = RealMatrixX::Identity(3, 3),
+        Ry = RealMatrixX::Identity(3, 3),
+        Rz = RealMatrixX::Identity(3, 3);
+        
+        Rx(1,1) =  cos(a); Rx(1,2) = -sin(a); Rx(2,1) = sin(a); Rx(2,2) = cos(a);
+        Ry(0,0) =  cos(b); Ry(0,2) =  sin(b); Ry(2,0) =-sin(b); Ry(2,2) = cos(b);
+        Rz(0,0) =  cos(c); Rz(0,1) = -sin(c); Rz(1,0) = sin(c); Rz(1,1) = cos(c);
+        
+        return Rz * Ry * Rx;
+    }
+    
+    
+    /*!
+     *   the dense transformation matrix that the structured methods replace
+     */
+    RealMatrixX
+    test_dense_transformation(const RealMatrixX& R,
+                              const unsigned int n_nodes) {
+        
+        RealMatrixX T = RealMatrixX::Zero(6*n_nodes, 6*n_nodes);
+        
+        for (unsigned int i=0; i<n_nodes; i++)
+            for (unsigned int j=0; j<3; j++)
+                for (unsigned int k=0; k<3; k++) {
+                    T(j*n_nodes+i, k*n_nodes+i)         = R(j,k);
+                    T((j+3)*n_nodes+i, (k+3)*n_nodes+i) = R(j,k);
+                }
+        
+        return T;
+    }
+}
+
+
+
+BOOST_AUTO_TEST_SUITE  (NodalTransformationTests)
+
+BOOST_AUTO_TEST_CASE   (StructuredTransformationMatchesDense) {
+    
+    const RealMatrixX R = MAST::test_rotation_matrix(0.3, -0.7, 1.1);
+    
+    // EDGE2, EDGE3, QUAD4 and QUAD9
+    const unsigned int n_nodes[] = {2, 3, 4, 9};
+    
+    for (unsigned int i_elem=0; i_elem<4; i_elem++) {
+        
+        const unsigned int
+        n  = n_nodes[i_elem],
+        n2 = 6*n;
+        
+        const RealMatrixX T = MAST::test_dense_transformation(R, n);
+        
+        RealMatrixX
+        local_mat  = RealMatrixX::Zero(n2, n2),
+        global_mat,
+        work;
+        RealVectorX
+        local_vec  = RealVectorX::Zero(n2),
+        global_vec,
+        vec;
+        
+        for (unsigned int i=0; i<n2; i++) {
+            local_vec(i) = sin(1.+i);
+            for (unsigned int j=0; j<n2; j++)
+                local_mat(i,j) = cos(1.+i+2.*j);
+        }
+        
+        MAST::transform_nodal_matrix_to_global(R, n, local_mat, global_mat, work);
+        BOOST_CHECK(MAST::compare_matrix(RealMatrixX(T * local_mat * T.transpose()),
+                                         global_mat, 1.e-12));
+        
+        MAST::transform_nodal_vector_to_global(R, n, local_vec, global_vec);
+        BOOST_CHECK(MAST::compare_vector(RealVectorX(T * local_vec), global_vec, 1.e-12));
+        
+        MAST::transform_nodal_vector_to_local(R, n, global_vec, vec);
+        BOOST_CHECK(MAST::compare_vector(local_vec, vec, 1.e-12));
+        
+        // complex matrices are transformed in the same way
+        ComplexMatrixX
+        local_cmat  = ComplexMatrixX::Zero(n2, n2),
+        global_cmat,
+        cwork;
+        local_cmat.real() = local_mat;
+        local_cmat.imag() = local_mat.transpose();
+        MAST::transform_nodal_matrix_to_global(R, n, local_cmat, global_cmat, cwork);
+        BOOST_CHECK(MAST::compare_matrix(RealMatrixX(T * local_mat * T.transpose()),
+                                         RealMatrixX(global_cmat.real()), 1.e-12));
+        BOOST_CHECK(MAST::compare_matrix(RealMatrixX(T * local_mat.transpose() * T.transpose()),
+                                         RealMatrixX(global_cmat.imag()), 1.e-12));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
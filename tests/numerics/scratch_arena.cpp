@@ -0,0 +1,75 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "numerics/scratch_arena.h"
+
+
+
+BOOST_AUTO_TEST_SUITE  (ScratchArenaTests)
+
+BOOST_AUTO_TEST_CASE   (ScopesReturnObjectsToArena) {
+    
+    // a local arena is used so that the pool sizes do not depend on
+    // other tests that use the thread arena
+    MAST::ScratchArena arena;
+    
+    const Real* data = nullptr;
+    
+    {
+        MAST::ScratchArena::Scope s1(arena);
+        RealMatrixX& m1 = s1.matrix(2, 2);
+        m1.setConstant(1.);
+        
+        {
+            MAST::ScratchArena::Scope s2(arena);
+            RealMatrixX& m = s2.matrix(3, 3);
+            m.setConstant(2.);
+            data = m.data();
+        }
+        
+        // the inner scope object is reused with its storage and zeroed,
+        // while the outer one is still in use
+        RealMatrixX& m2 = s1.matrix(3, 3);
+        BOOST_CHECK(&m1 != &m2);
+        BOOST_CHECK(m2.data() == data);
+        BOOST_CHECK_EQUAL(m2.norm(), 0.);
+        BOOST_CHECK_EQUAL(m1.sum(), 4.);
+        
+        // a request of a different size does not take the storage of
+        // the objects in the pool of another size
+        {
+            MAST::ScratchArena::Scope s2(arena);
+            RealMatrixX& m = s2.matrix(4, 4);
+            BOOST_CHECK(&m != &m1);
+            BOOST_CHECK(&m != &m2);
+        }
+    }
+    
+    BOOST_CHECK_EQUAL(arena.n_matrices(), 3);
+    
+    arena.clear();
+    BOOST_CHECK_EQUAL(arena.n_matrices(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -139,6 +139,29 @@ void check_internal_force_and_jacobian_sensitivity (ValType& v,
         BOOST_TEST_MESSAGE("  ** djac/dp (partial) wrt : " << f.name() << " **");
         BOOST_CHECK(MAST::compare_matrix(   djacdp_fd,  djacdp,   tol));
     }
+    
+    // the sensitivity for all parameters computed together should be
+    // the same as that computed for each parameter individually
+    const unsigned int n_params = (unsigned int)v._params_for_sensitivity.size();
+    std::vector<const MAST::FunctionBase*> params(n_params);
+    std::vector<RealVectorX> dresdp_all(n_params, RealVectorX::Zero(ndofs));
+    
+    for (unsigned int i=0; i<n_params; i++)
+        params[i] = v._params_for_sensitivity[i];
+    
+    e->internal_residual_multiparameter_sensitivity(params, dresdp_all);
+    
+    for (unsigned int i=0; i<n_params; i++) {
+        
+        e->sensitivity_param  = params[i];
+        dresdp.setZero();
+        e->internal_residual_sensitivity(false, dresdp, dummy);
+        e->sensitivity_param  = nullptr;
+        
+        BOOST_TEST_MESSAGE("  ** dres/dp (multiparameter) wrt : "
+                           << v._params_for_sensitivity[i]->name() << " **");
+        BOOST_CHECK(MAST::compare_vector(  dresdp,  dresdp_all[i],    tol));
+    }
 }
 
 
@@ -0,0 +1,79 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// C++ includes
+#include <vector>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "examples/thermal/bar_transient/bar_transient.h"
+#include "tests/base/test_comparisons.h"
+#include "solver/transient_solver_base.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (BarTransientJacobianUpdate,
+                           MAST::BarTransient)
+
+BOOST_AUTO_TEST_CASE   (LaggedJacobianModes) {
+    
+    this->init(libMesh::EDGE2, false);
+    
+    const Real
+    tol      = 1.e-6;
+    
+    std::vector<Real>
+    full_newton,
+    linear,
+    modified_newton;
+    
+    // the heat conduction of the bar is linear, so all three Jacobian
+    // updates should converge to the same solution at each time step
+    this->solve(false, MAST::TransientSolverBase::FULL_NEWTON).localize(full_newton);
+    this->solve(false, MAST::TransientSolverBase::LINEAR).localize(linear);
+    this->solve(false, MAST::TransientSolverBase::MODIFIED_NEWTON).localize(modified_newton);
+    
+    const unsigned int n = (unsigned int)full_newton.size();
+    
+    BOOST_REQUIRE(n > 0);
+    BOOST_REQUIRE_EQUAL(linear.size(),          n);
+    BOOST_REQUIRE_EQUAL(modified_newton.size(), n);
+    
+    const RealVectorX
+    v0 = Eigen::Map<const RealVectorX>(&full_newton[0],     n),
+    v1 = Eigen::Map<const RealVectorX>(&linear[0],          n),
+    v2 = Eigen::Map<const RealVectorX>(&modified_newton[0], n);
+    
+    // the solution must have changed from the zero initial condition for
+    // the comparison to be meaningful
+    BOOST_CHECK(v0.norm() > 0.);
+    
+    BOOST_CHECK(MAST::compare_vector(v0, v1, tol));
+    BOOST_CHECK(MAST::compare_vector(v0, v2, tol));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+